@@ -9,6 +9,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 // http://stackoverflow.com/questions/30419153/hdr-bloom-effect-rendering-pipeline-using-opengl-glsl
@@ -207,10 +208,10 @@ void Scene::onDrawFrame()
     m_FBOimage->onDraw(GL_COLOR_ATTACHMENT0);
 
     // superposer l'image floue des zones brillantes
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
     m_FBO2->onDraw(GL_COLOR_ATTACHMENT0);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -10,6 +10,7 @@
 
 
 #include <PoissonBlur.h>
+#include <GLState.h>
 
 
 /**
@@ -85,7 +86,7 @@ void PoissonBlur::findUniformLocations()
 
     // initialiser le tableau des constantes (erreur : arrays may not be declared constant since they cannot be initialized)
     GLint PoissonSamplesLoc = glGetUniformLocation(m_ShaderId, "PoissonSamples");
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     GLfloat PoissonSamples[] = {
         +0.79636, -0.56051,
         -0.64373, +0.68863,
@@ -105,7 +106,7 @@ void PoissonBlur::findUniformLocations()
         +0.02771, +0.26856,
     };
     glUniform2fv(PoissonSamplesLoc, 16, PoissonSamples);
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
@@ -12,6 +12,7 @@
 
 
 #include <DepthOfFieldBlur.h>
+#include <GLState.h>
 
 
 DepthOfFieldBlur::DepthOfFieldBlur():
@@ -137,7 +138,7 @@ void DepthOfFieldBlur::findUniformLocations()
 
     // initialiser le tableau des constantes (erreur : arrays may not be declared constant since they cannot be initialized)
     GLint PoissonSamplesLoc = glGetUniformLocation(m_ShaderId, "PoissonSamples");
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     GLfloat PoissonSamples[] = {
         +0.79636, -0.56051,
         -0.64373, +0.68863,
@@ -157,7 +158,7 @@ void DepthOfFieldBlur::findUniformLocations()
         +0.02771, +0.26856,
     };
     glUniform2fv(PoissonSamplesLoc, 16, PoissonSamples);
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
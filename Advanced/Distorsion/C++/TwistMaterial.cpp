@@ -6,6 +6,7 @@
 
 #include <utils.h>
 #include <TwistMaterial.h>
+#include <GLState.h>
 
 
 /**
@@ -117,13 +118,13 @@ VBOset* TwistMaterial::createVBOset()
 void TwistMaterial::setMaxAngle(float anglemax)
 {
     // activer le shader
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
 
     // fournir le nouvel angle
     glUniform1f(m_MaxAngleLoc, anglemax);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
@@ -6,6 +6,7 @@
 
 #include <utils.h>
 #include <MirrorMaterial.h>
+#include <GLState.h>
 
 /**
  * Cette fonction définit un matériau pour dessiner le maillage
@@ -106,7 +107,7 @@ VBOset* MirrorMaterial::createVBOset()
 void MirrorMaterial::enable(mat4 mat4Projection, mat4 mat4ModelViewTeapot)
 {
     // activer le shader
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
 
     // fournir les matrices MV et P
     mat4::glUniformMatrix(m_MatModelViewTeapotLoc, mat4ModelViewTeapot);
@@ -138,7 +139,7 @@ void MirrorMaterial::setModelViewScene(mat4 mat4ModelViewScene)
     // pas d'inversion car c'est une matrice pour aller dans le repère de la scène
 
     // fournir la matrice mat3NormalScene au shader
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     mat3::glUniformMatrix(m_MatNormalSceneLoc, mat3NormalScene);
 }
 
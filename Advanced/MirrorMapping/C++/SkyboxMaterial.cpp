@@ -6,6 +6,7 @@
 
 #include <utils.h>
 #include <SkyboxMaterial.h>
+#include <GLState.h>
 
 /**
  * Cette fonction définit un matériau pour dessiner le skybox
@@ -97,7 +98,7 @@ void SkyboxMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
 void SkyboxMaterial::disable()
 {
     // désactiver les textures
-    glActiveTexture(GL_TEXTURE0);
+    GLState::activeTexture(GL_TEXTURE0);
     m_Texture->setTextureUnit(GL_TEXTURE0);
 
     // appeler la méthode de la superclasse
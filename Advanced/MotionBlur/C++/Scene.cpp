@@ -7,6 +7,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -163,13 +164,13 @@ void Scene::onDrawFrame()
 
     // superposer les images des FBO, avec un facteur de 1/m_NbImages
     m_FBOimages[0]->onDraw(GL_COLOR_ATTACHMENT0);
-    glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+    GLState::blendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
     glBlendColor(0.0, 0.0, 0.0, 1.0/(IMAGES_COUNT-1));
-    glEnable(GL_BLEND);
+    GLState::enable(GL_BLEND);
     for (int i=1; i<IMAGES_COUNT; i++) {
         m_FBOimages[i]->onDraw(GL_COLOR_ATTACHMENT0);
     }
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     // passer à l'image suivante
     m_CurrentFBOnumber = (m_CurrentFBOnumber + 1) % IMAGES_COUNT;
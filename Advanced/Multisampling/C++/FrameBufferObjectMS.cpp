@@ -11,6 +11,7 @@
 #include <math.h>
 
 #include <FrameBufferObjectMS.h>
+#include <GLState.h>
 
 
 /**
@@ -42,7 +43,7 @@ FrameBufferObjectMS::FrameBufferObjectMS(int width, int height, int samplesnb, G
 
     // créer le FBO
     glGenFramebuffers(1, &m_FBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 
     // identifiant du buffer courant
     GLuint bufferId = 0;
@@ -53,7 +54,7 @@ FrameBufferObjectMS::FrameBufferObjectMS(int width, int height, int samplesnb, G
     case GL_TEXTURE_2D:
         // créer une texture 2D pour recevoir les dessins faits via le FBO
         glGenTextures(1, &bufferId);
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
         glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_SamplesNumber, GL_RGBA, width, height, GL_TRUE);
 
         // attacher la texture au FBO
@@ -87,7 +88,7 @@ FrameBufferObjectMS::FrameBufferObjectMS(int width, int height, int samplesnb, G
     case GL_TEXTURE_2D:
         // lui ajouter un depth buffer de type texture
         glGenTextures(1, &m_DepthBufferId);
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_DepthBufferId);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_DepthBufferId);
         glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_SamplesNumber, GL_DEPTH_COMPONENT, width, height, GL_TRUE);
 
         // couleur du bord
@@ -121,7 +122,7 @@ FrameBufferObjectMS::FrameBufferObjectMS(int width, int height, int samplesnb, G
 
         // créer une texture 2D pour recevoir les dessins (voir glFragData dans les shaders)
         glGenTextures(1, &bufferId);
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
         glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_SamplesNumber, GL_RGBA32F, width, height, GL_TRUE);
 
         // attacher la texture au FBO
@@ -137,9 +138,9 @@ FrameBufferObjectMS::FrameBufferObjectMS(int width, int height, int samplesnb, G
     checkStatus();
 
     // désactiver le FBO pour l'instant
-    glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+    GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 
@@ -167,11 +168,11 @@ void FrameBufferObjectMS::setTextureUnit(GLint unit, GLint locSampler, GLuint bu
         throw std::invalid_argument("FrameBufferObject::setTextureUnit: first parameter, unit is not GL_TEXTURE0 ... GL_TEXTURE7");
     }
     /*****DEBUG*****/
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
     if (locSampler < 0 || bufferId <= 0) {
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, bufferId);
         glUniform1i(locSampler, unit-GL_TEXTURE0);
     }
 }
@@ -8,6 +8,7 @@
 
 #include <FrameBufferObjectMS.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -177,17 +178,17 @@ void Scene::onDrawFrame()
     drawDeferredShading(m_Mat4Projection, mat4CameraScene);
 
     // afficher le FBO complet
-    glViewport(0, 0, m_Width, m_Height);
+    GLState::viewport(0, 0, m_Width, m_Height);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // variante en utilisant le traitement SubPicture
     //m_SubPicture->process(m_GBuffer, 0, 0, m_Width, m_Height);
 
     // variante en utilisant glBlitFramebuffer
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_GBuffer->getId());
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, m_GBuffer->getId());
     glReadBuffer(GL_COLOR_ATTACHMENT0);
 
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     glDrawBuffer(GL_BACK);
 
     glBlitFramebuffer(
@@ -196,7 +197,7 @@ void Scene::onDrawFrame()
         GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
     // afficher une vignette avec un zoom sur la partie centrale du FBO
-    glViewport(0, m_Height*3/5, m_Width*2/5, m_Height*2/5);
+    GLState::viewport(0, m_Height*3/5, m_Width*2/5, m_Height*2/5);
     glClear(GL_DEPTH_BUFFER_BIT);
     m_SubPicture->process(m_GBuffer, m_Width/2 - m_Width/8, m_Height/2 - m_Height/8, m_Width/8, m_Height/8);
 }
@@ -10,6 +10,7 @@
 
 
 #include <SubPicture.h>
+#include <GLState.h>
 
 
 SubPicture::SubPicture(int samplesnb):
@@ -135,11 +136,11 @@ void SubPicture::setTextureUnit(GLint unit, GLint locSampler, GLuint buffer)
     } else {
         texturetype = GL_TEXTURE_2D_MULTISAMPLE;
     }
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
     if (locSampler < 0 || buffer <= 0) {
-        glBindTexture(texturetype, 0);
+        GLState::bindTexture(texturetype, 0);
     } else {
-        glBindTexture(texturetype, buffer);
+        GLState::bindTexture(texturetype, buffer);
         glUniform1i(locSampler, unit-GL_TEXTURE0);
     }
 }
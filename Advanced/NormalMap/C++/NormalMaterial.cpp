@@ -184,7 +184,6 @@ void NormalMaterial::disable()
  */
 NormalMaterial::~NormalMaterial()
 {
-    Utils::deleteShaderProgram(m_ShaderId);
     delete m_DiffuseTexture;
     delete m_NormalTexture;
 }
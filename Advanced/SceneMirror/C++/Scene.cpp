@@ -9,6 +9,7 @@
 #include <SoftSpotLight.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -205,10 +206,10 @@ void Scene::onDrawFrame()
     /** étape 3 : la surface du miroir par dessus le reflet */
 
     // dessiner le miroir en mode fusion
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
     m_Mirror->onDrawSurface(m_Mat4Projection, mat4ModelViewMirror);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     /** étape 4 : la scène réelle **/
 
@@ -8,6 +8,7 @@
 
 #include "Scene.h"
 #include <SoftSpotLight.h>
+#include <GLState.h>
 
 
 /**
@@ -164,10 +165,10 @@ void Scene::onDrawFrame()
     /** étape 3 : la surface du miroir par dessus le reflet */
 
     // superposer le miroir quasi-transparent
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
     m_Mirror->onDraw(m_Mat4Projection, mat4ModelViewMirror);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     /** étape 4 : la scène réelle **/
 
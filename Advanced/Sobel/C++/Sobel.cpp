@@ -10,6 +10,7 @@
 #include <utils.h>
 
 #include <Sobel.h>
+#include <GLState.h>
 
 
 /**
@@ -33,9 +34,9 @@ Sobel::Sobel(int width, int height):
         compileShader(pass);
 
         // lui fournir la dimension de la fenêtre
-        glUseProgram(m_ShaderId[pass]);
+        GLState::useProgram(m_ShaderId[pass]);
         vec2::glUniform(m_TexelSizeLoc[pass], texelsize);
-        glUseProgram(0);
+        GLState::useProgram(0);
     }
 }
 
@@ -164,8 +165,9 @@ void Sobel::process(FrameBufferObject* fbo)
         // dessiner dans un FBO intermédiaire sauf au dernier passage
         if (pass < 3) m_FBO[pass%2]->enable();
 
-        // activer le shader de cette passe
-        glUseProgram(m_ShaderId[pass]);
+        // activer le shader de cette passe, les VBO sont liés sans VAO
+        GLState::useProgram(m_ShaderId[pass]);
+        GLState::bindVertexArray(0);
 
         // activer et lier le buffer contenant les coordonnées
         glEnableVertexAttribArray(m_VertexLoc[pass]);
@@ -198,7 +200,7 @@ void Sobel::process(FrameBufferObject* fbo)
         glDisableVertexAttribArray(m_TexCoordLoc[pass]);
 
         // désactiver le shader
-        glUseProgram(0);
+        GLState::useProgram(0);
 
         // termine les dessins dans le FBO intermédiaire et remet le précédent FBO
         if (pass < 3) m_FBO[pass%2]->disable();
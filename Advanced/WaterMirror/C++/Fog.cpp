@@ -10,6 +10,7 @@
 #include <utils.h>
 
 #include <Fog.h>
+#include <GLState.h>
 
 
 /**
@@ -24,10 +25,10 @@ Fog::Fog(vec4 color, float exponent):
     compileShader();
 
     // fournir la couleur d'effacement au shader
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     vec4::glUniform(m_BackgroundColorLoc, color);
     glUniform1f(m_ExponentLoc, exponent);
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
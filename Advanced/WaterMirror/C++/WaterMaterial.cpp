@@ -12,6 +12,7 @@
 
 
 #include <WaterMaterial.h>
+#include <GLState.h>
 
 /**
  * Cette classe réalise la fusion du reflet et de la vue sous-surface.
@@ -269,8 +270,8 @@ void WaterMaterial::disable()
     // désactiver les textures
     while (m_Unit > GL_TEXTURE0) {
         m_Unit--;
-        glActiveTexture(m_Unit);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::activeTexture(m_Unit);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
     } ;
 
     // appeler la méthode de la superclasse
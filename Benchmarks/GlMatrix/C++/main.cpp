@@ -0,0 +1,207 @@
+// Mesure des performances des fonctions de gl-matrix les plus utilisées
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gl-matrix.h>
+
+
+/*
+ * Versions de référence : ce sont les anciennes définitions, compilées à part et
+ * recevant leurs paramètres par valeur. Elles servent à vérifier que les nouvelles
+ * fonctions donnent les mêmes résultats et à comparer les durées.
+ */
+
+__attribute__((noinline)) static void refMultiply(mat4& out, mat4 a, mat4 b)
+{
+    for (int c=0; c<4; c++) {
+        GLfloat b0 = b[c*4+0], b1 = b[c*4+1], b2 = b[c*4+2], b3 = b[c*4+3];
+        for (int l=0; l<4; l++) {
+            out[c*4+l] = b0*a[l] + b1*a[4+l] + b2*a[8+l] + b3*a[12+l];
+        }
+    }
+}
+
+__attribute__((noinline)) static void refInvert(mat4& out, mat4 a)
+{
+    GLfloat a00 = a[0], a01 = a[1], a02 = a[2], a03 = a[3],
+    a10 = a[4], a11 = a[5], a12 = a[6], a13 = a[7],
+    a20 = a[8], a21 = a[9], a22 = a[10], a23 = a[11],
+    a30 = a[12], a31 = a[13], a32 = a[14], a33 = a[15],
+    b00 = a00 * a11 - a01 * a10,
+    b01 = a00 * a12 - a02 * a10,
+    b02 = a00 * a13 - a03 * a10,
+    b03 = a01 * a12 - a02 * a11,
+    b04 = a01 * a13 - a03 * a11,
+    b05 = a02 * a13 - a03 * a12,
+    b06 = a20 * a31 - a21 * a30,
+    b07 = a20 * a32 - a22 * a30,
+    b08 = a20 * a33 - a23 * a30,
+    b09 = a21 * a32 - a22 * a31,
+    b10 = a21 * a33 - a23 * a31,
+    b11 = a22 * a33 - a23 * a32,
+    det = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+    if (!det) return;
+    det = 1.0 / det;
+    out[0] = (a11 * b11 - a12 * b10 + a13 * b09) * det;
+    out[1] = (a02 * b10 - a01 * b11 - a03 * b09) * det;
+    out[2] = (a31 * b05 - a32 * b04 + a33 * b03) * det;
+    out[3] = (a22 * b04 - a21 * b05 - a23 * b03) * det;
+    out[4] = (a12 * b08 - a10 * b11 - a13 * b07) * det;
+    out[5] = (a00 * b11 - a02 * b08 + a03 * b07) * det;
+    out[6] = (a32 * b02 - a30 * b05 - a33 * b01) * det;
+    out[7] = (a20 * b05 - a22 * b02 + a23 * b01) * det;
+    out[8] = (a10 * b10 - a11 * b08 + a13 * b06) * det;
+    out[9] = (a01 * b08 - a00 * b10 - a03 * b06) * det;
+    out[10] = (a30 * b04 - a31 * b02 + a33 * b00) * det;
+    out[11] = (a21 * b02 - a20 * b04 - a23 * b00) * det;
+    out[12] = (a11 * b07 - a10 * b09 - a12 * b06) * det;
+    out[13] = (a00 * b09 - a01 * b07 + a02 * b06) * det;
+    out[14] = (a31 * b01 - a30 * b03 - a32 * b00) * det;
+    out[15] = (a20 * b03 - a21 * b01 + a22 * b00) * det;
+}
+
+__attribute__((noinline)) static void refTransformVec3(vec3& out, vec3 a, mat4 m)
+{
+    GLfloat x = a[0], y = a[1], z = a[2];
+    for (int l=0; l<3; l++) {
+        out[l] = m[l] * x + m[4+l] * y + m[8+l] * z + m[12+l];
+    }
+}
+
+__attribute__((noinline)) static void refTransformVec4(vec4& out, vec4 a, mat4 m)
+{
+    GLfloat x = a[0], y = a[1], z = a[2], w = a[3];
+    for (int l=0; l<4; l++) {
+        out[l] = m[l] * x + m[4+l] * y + m[8+l] * z + m[12+l] * w;
+    }
+}
+
+
+/// nombre d'éléments des tableaux de données
+static const int COUNT = 4096;
+
+/// données aléatoires
+static std::vector<mat4> matrices(COUNT);
+static std::vector<vec3> points(COUNT);
+static std::vector<vec4> vectors(COUNT);
+
+/// nombre d'écarts trouvés entre les versions de référence et les nouvelles
+static int errors = 0;
+
+
+/**
+ * chronomètre plusieurs passes d'une fonction sur les tableaux de données
+ * et retourne la meilleure durée par appel
+ * @param repeat : nombre de passes
+ * @param function : traitement d'un élément, reçoit son rang
+ * @return durée en nanosecondes par appel
+ */
+template <typename F> static double measure(int repeat, F function)
+{
+    double best = 1e38;
+    for (int r=0; r<repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i=0; i<COUNT; i++) function(i);
+        auto stop = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        if (seconds < best) best = seconds;
+    }
+    return best * 1e9 / COUNT;
+}
+
+
+/**
+ * affiche une ligne de résultats
+ * @param name : nom de la fonction
+ * @param before : durée par appel de la version de référence
+ * @param after : durée par appel de la nouvelle version
+ */
+static void report(std::string name, double before, double after)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "    " << std::left << std::setw(20) << name << std::right;
+    std::cout << std::setw(8) << before << " ns -> " << std::setw(8) << after << " ns  (x" << (before/after) << ")" << std::endl;
+}
+
+
+/**
+ * compare deux tableaux de flottants et compte les écarts
+ * NB : les résultats sont identiques, sauf si le compilateur fusionne des
+ * multiplications et additions (FMA), d'où une petite tolérance relative
+ * @param a : premier tableau
+ * @param b : second tableau
+ * @param n : nombre de flottants
+ */
+static void compare(const GLfloat* a, const GLfloat* b, int n)
+{
+    for (int i=0; i<n; i++) {
+        if (fabs(a[i] - b[i]) > 1e-4 * (fabs(a[i]) + 1.0)) errors++;
+    }
+}
+
+
+/** point d'entrée du programme : main [nombre de passes] */
+int main(int argc, char **argv)
+{
+    // nombre de passes
+    int repeat = 200;
+    if (argc > 1) repeat = atoi(argv[1]);
+    if (repeat < 1) repeat = 1;
+
+    // données aléatoires, les matrices sont inversibles presque à coup sûr
+    srand(1);
+    for (int i=0; i<COUNT; i++) {
+        for (int j=0; j<16; j++) matrices[i][j] = rand() / (float)RAND_MAX - 0.5f;
+        for (int j=0; j<3; j++) points[i][j] = rand() / (float)RAND_MAX - 0.5f;
+        for (int j=0; j<4; j++) vectors[i][j] = rand() / (float)RAND_MAX - 0.5f;
+    }
+    mat4 ref, res;
+    vec3 ref3, res3;
+    vec4 ref4, res4;
+
+    // vérification des résultats
+    for (int i=0; i<COUNT; i++) {
+        const mat4& a = matrices[i];
+        const mat4& b = matrices[(i+1)%COUNT];
+        refMultiply(ref, a, b); mat4::multiply(res, a, b);
+        compare(&ref[0], &res[0], 16);
+        refInvert(ref, a); mat4::invert(res, a);
+        compare(&ref[0], &res[0], 16);
+        refTransformVec3(ref3, points[i], a); vec3::transformMat4(res3, points[i], a);
+        compare(&ref3[0], &res3[0], 3);
+        refTransformVec4(ref4, vectors[i], a); vec4::transformMat4(res4, vectors[i], a);
+        compare(&ref4[0], &res4[0], 4);
+    }
+    std::cout << "gl-matrix, " << COUNT << " elements, best of " << repeat << " passes, per call:" << std::endl;
+
+    // mesures, chaque appel dépend du précédent pour qu'aucun ne soit éliminé
+    mat4 acc = mat4::create();
+    report("mat4::multiply",
+        measure(repeat, [&](int i) { refMultiply(acc, matrices[i], acc); }),
+        measure(repeat, [&](int i) { mat4::multiply(acc, matrices[i], acc); }));
+    report("mat4::invert",
+        measure(repeat, [&](int i) { refInvert(res, matrices[i]); acc[0] += res[0]; }),
+        measure(repeat, [&](int i) { mat4::invert(res, matrices[i]); acc[0] += res[0]; }));
+    report("vec3::transformMat4",
+        measure(repeat, [&](int i) { refTransformVec3(res3, points[i], matrices[i]); acc[0] += res3[0]; }),
+        measure(repeat, [&](int i) { vec3::transformMat4(res3, points[i], matrices[i]); acc[0] += res3[0]; }));
+    report("vec4::transformMat4",
+        measure(repeat, [&](int i) { refTransformVec4(res4, vectors[i], matrices[i]); acc[0] += res4[0]; }),
+        measure(repeat, [&](int i) { vec4::transformMat4(res4, vectors[i], matrices[i]); acc[0] += res4[0]; }));
+
+    if (errors > 0) {
+        std::cerr << "Error : " << errors << " values differ from the reference functions" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "(" << acc[0] << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
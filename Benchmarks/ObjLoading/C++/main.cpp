@@ -0,0 +1,84 @@
+// Mesure des performances du chargement des fichiers OBJ
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+#include <utils.h>
+#include <Mesh.h>
+#include <MeshModuleLoading.h>
+
+
+/**
+ * charge plusieurs fois le fichier OBJ et affiche les meilleurs débits obtenus
+ * @param filename : nom du fichier OBJ à charger
+ * @param repeat : nombre de chargements à effectuer
+ * @param threads : nombre de threads d'analyse, 0 pour autant que de coeurs
+ */
+static void benchmark(std::string filename, int repeat, int threads)
+{
+    // taille du fichier
+    Utils::MappedFile file(filename);
+    if (! file.isOpen()) {
+        std::cerr << "Error : \"" << filename << "\" cannot be loaded" << std::endl;
+        return;
+    }
+    double megabytes = file.getSize() / (1024.0 * 1024.0);
+
+    // garder le meilleur temps parmi tous les chargements
+    double best = 1e38;
+    int triangle_count = 0;
+    int vertex_count = 0;
+    for (int i=0; i<repeat; i++) {
+        Mesh* mesh = new Mesh(filename);
+        MeshModuleLoading loader(mesh);
+        loader.setThreadCount(threads);
+        auto start = std::chrono::steady_clock::now();
+        loader.loadObjFile(filename, "", 1.0);
+        auto stop = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        if (seconds < best) best = seconds;
+        triangle_count = mesh->getTriangleCount();
+        vertex_count = mesh->getVertexCount();
+        delete mesh;
+    }
+
+    // affichage des résultats
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << filename << ": " << megabytes << " MB, " << vertex_count << " vertices, " << triangle_count << " triangles" << std::endl;
+    std::cout << "    " << ((threads > 0) ? std::to_string(threads) : "all") << " thread(s), best of " << repeat << ": " << (best*1000.0) << " ms, ";
+    std::cout << (megabytes / best) << " MB/s, ";
+    std::cout << (triangle_count / best / 1e6) << " Mtriangles/s" << std::endl;
+}
+
+
+/** point d'entrée du programme : main [nombre de répétitions] [fichiers.obj...] */
+int main(int argc, char **argv)
+{
+    // nombre de répétitions
+    int repeat = 5;
+    if (argc > 1) repeat = atoi(argv[1]);
+    if (repeat < 1) repeat = 1;
+
+    // fichiers à charger
+    std::vector<std::string> filenames;
+    for (int i=2; i<argc; i++) filenames.push_back(argv[i]);
+    if (filenames.empty()) {
+        filenames.push_back("data/models/Divers/dragon.obj");
+        filenames.push_back("data/models/Divers/bunny.obj");
+    }
+
+    // mesures en séquentiel puis avec tous les coeurs
+    for (std::string filename: filenames) {
+        benchmark(filename, repeat, 1);
+        benchmark(filename, repeat, 0);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+# mesure toutes les scènes C++ des exemples et rassemble les résultats dans benchmark.json
+# usage : ./benchall.sh [nombre d'images]
+FRAMES=${1:-100}
+OUTPUT=benchmark.json
+
+echo "[" > $OUTPUT
+first=1
+for scene in ../../../*/*/C++/Scene.cpp
+do
+    name=$(echo "$scene" | sed -e 's#^\.\./\.\./\.\./##' -e 's#/C++/Scene.cpp$##')
+    if [ "$(dirname "$name")" = "Benchmarks" ] ; then continue ; fi
+    echo "$name" 1>&2
+    if ! make -j4 SCENE="$name" bin/$(echo "$name" | tr / -) 1>&2 ; then continue ; fi
+    result=$(make -s SCENE="$name" FRAMES=$FRAMES run) || continue
+    if [ $first -eq 0 ] ; then echo "," >> $OUTPUT ; fi
+    echo "$result" >> $OUTPUT
+    first=0
+done
+echo "]" >> $OUTPUT
@@ -0,0 +1,267 @@
+// Mesure du temps de dessin des images de la Scene d'un exemple, sans fenêtre
+// Le programme est construit par le Makefile pour un exemple (make SCENE=Lights/Omni)
+// et doit être lancé dans le dossier de cet exemple afin de trouver data/
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <SDL_image.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <stdlib.h>
+
+#include <utils.h>
+#include <FrameStats.h>
+#include <Profiler.h>
+#include <GLState.h>
+#include <SceneBase.h>
+#include <MeshObjectFromObj.h>
+#include <DeferredShadingMaterial.h>
+#include "Scene.h"
+
+#ifndef SCENE_NAME
+#define SCENE_NAME "Scene"
+#endif
+
+
+/**
+ * crée un contexte OpenGL sans fenêtre ni surface (EGL surfaceless, par exemple Mesa llvmpipe)
+ * @return true si le contexte est actif
+ */
+static bool createHeadlessContext()
+{
+    // affichage sans serveur graphique si possible
+    EGLDisplay display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay != nullptr) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    }
+    if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (!eglInitialize(display, &major, &minor)) return false;
+    if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+    // même genre de contexte que celui de GLFW par défaut : profil compatibilité, sinon core
+    EGLint profiles[] = { EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT };
+    for (EGLint profile: profiles) {
+        EGLint attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, profile,
+            EGL_NONE };
+        EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+        if (context == EGL_NO_CONTEXT) continue;
+        if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) return true;
+        eglDestroyContext(display, context);
+    }
+    return false;
+}
+
+
+/**
+ * fait tourner la caméra des scènes qui dérivent de SceneBase, comme un glissement de la souris
+ * @param scene : scène à modifier
+ * @param dx : déplacement horizontal en pixels
+ * @param width : largeur de la vue
+ * @param height : hauteur de la vue
+ */
+static void rotateCamera(SceneBase* scene, float dx, int width, int height)
+{
+    scene->onRotate(width/2, height/2, width/2 + dx, height/2, width, height);
+}
+
+/** les autres scènes n'ont pas de caméra manipulable */
+static void rotateCamera(void* scene, float dx, int width, int height)
+{
+}
+
+
+/**
+ * retourne l'instant présent en secondes
+ */
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ * affiche une chaîne au format JSON
+ * @param text : chaîne à afficher entre guillemets
+ */
+static std::string json(std::string text)
+{
+    std::string result = "\"";
+    for (char c: text) {
+        if (c == '"' || c == '\\') result += '\\';
+        if (c >= 0 && c < ' ') continue;
+        result += c;
+    }
+    return result + "\"";
+}
+
+
+/**
+ * point d'entrée du programme : main [nombre d'images [largeur hauteur [fichier trace.json]]]
+ * la variable d'environnement MESH_LAYOUT=triangles range les triangles des fichiers OBJ
+ * dans l'ordre optimisé pour le cache des sommets au lieu de rubans, et VERTEX_FORMAT=compact
+ * stocke leurs attributs dans les formats compacts, voir DeferredShadingMaterial::setCompactAttributes
+ */
+int main(int argc, char **argv)
+{
+    // paramètres du banc d'essai
+    int frames = 100;
+    int width = 640;
+    int height = 480;
+    if (argc > 1) frames = std::max(atoi(argv[1]), 1);
+    if (argc > 3) {
+        width  = std::max(atoi(argv[2]), 1);
+        height = std::max(atoi(argv[3]), 1);
+    }
+    std::string trace = argc > 4 ? argv[4] : "";
+    const char* layout = getenv("MESH_LAYOUT");
+    std::string meshlayout = (layout != nullptr && std::string(layout) == "triangles") ? "triangles" : "strips";
+    MeshObjectFromObj::setLayout(meshlayout == "triangles" ? MeshObjectFromObj::LAYOUT_TRIANGLES : MeshObjectFromObj::LAYOUT_STRIPS);
+    const char* format = getenv("VERTEX_FORMAT");
+    std::string vertexformat = (format != nullptr && std::string(format) == "compact") ? "compact" : "float";
+    DeferredShadingMaterial::setCompactAttributes(vertexformat == "compact");
+    const int warmup = 5;
+    const double timestep = 1.0 / 60.0;
+    const float rotation = 4.0;
+
+    // contexte OpenGL et glew
+    if (!createHeadlessContext()) {
+        std::cerr << "Unable to create an EGL surfaceless OpenGL context" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    glewExperimental = GL_TRUE;
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // glew construit pour GLX : les fonctions OpenGL sont quand même chargées
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) err = GLEW_OK;
+#endif
+    if (err != GLEW_OK) {
+        std::cerr << "Unable to initialize Glew : " << glewGetErrorString(err) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    glGetError();
+
+    // le profil core exige un VAO, les scènes simples n'en créent pas
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    GLState::bindVertexArray(vao);
+
+    // initialisation de SDL_Image
+    if (!IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG)) {
+        std::cerr << "Unable to initialize SDL" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // initialisations statiques
+    FrameBufferObject::staticinit();
+    ShadowMap::staticinit();
+    Process::staticinit();
+
+    // FBO qui remplace l'écran
+    FrameBufferObject* screen = new FrameBufferObject(width, height, GL_RENDERBUFFER, GL_RENDERBUFFER);
+    screen->enable();
+
+    // les messages des scènes vont sur la sortie d'erreur, la sortie standard est réservée au JSON
+    std::streambuf* stdout_buffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+    // création de la scène
+    Scene* scene = nullptr;
+    std::vector<double> times;
+    try {
+        scene = new Scene();
+        debugGLFatal("new Scene()");
+        scene->onSurfaceChanged(width, height);
+
+        // dessiner les images avec une horloge et une caméra déterministes
+        for (int frame=0; frame<warmup+frames; frame++) {
+            if (frame == warmup) {
+                FrameStats::setEnabled(true);
+                Profiler::setEnabled(true);
+            }
+            Utils::Time = frame * timestep;
+            rotateCamera(scene, rotation, width, height);
+
+            // les FBO des scènes se désactivent en revenant au framebuffer 0, qui n'existe pas ici
+            screen->enable();
+            GLState::bindVertexArray(vao);
+
+            double start = now();
+            FrameStats::beginFrame();
+            Profiler::beginFrame();
+            scene->onDrawFrame();
+            Profiler::endFrame();
+            FrameStats::endFrame();
+            glFinish();
+            if (frame >= warmup) times.push_back(now() - start);
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Something went wrong with " << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // libération des ressources
+    std::string renderer = (const char*) glGetString(GL_RENDERER);
+    if (!trace.empty() && !Profiler::exportTrace(trace)) exit(EXIT_FAILURE);
+    FrameStats::setEnabled(false);
+    Profiler::setEnabled(false);
+    delete scene;
+    delete screen;
+    FrameBufferObject::staticdestroy();
+    Process::staticdestroy();
+    IMG_Quit();
+    std::cerr << std::endl;
+    std::cout.rdbuf(stdout_buffer);
+
+    // statistiques des durées des images entières, GPU compris
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t: times) total += t;
+    double n = times.size();
+
+    // affichage des résultats en JSON, en millisecondes et par image
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "{" << std::endl;
+    std::cout << "  \"scene\": " << json(SCENE_NAME) << "," << std::endl;
+    std::cout << "  \"renderer\": " << json(renderer) << "," << std::endl;
+    std::cout << "  \"width\": " << width << ", \"height\": " << height << "," << std::endl;
+    std::cout << "  \"mesh_layout\": " << json(meshlayout) << "," << std::endl;
+    std::cout << "  \"vertex_format\": " << json(vertexformat) << "," << std::endl;
+    std::cout << "  \"frames\": " << frames << ", \"warmup\": " << warmup << ", \"timestep\": " << timestep << "," << std::endl;
+    std::cout << "  \"frame_ms\": { \"mean\": " << total/n*1000.0
+              << ", \"min\": " << sorted.front()*1000.0
+              << ", \"median\": " << sorted[sorted.size()/2]*1000.0
+              << ", \"p95\": " << sorted[std::min(int(n*0.95), int(n)-1)]*1000.0
+              << ", \"max\": " << sorted.back()*1000.0 << " }," << std::endl;
+    std::cout << "  \"cpu_submit_ms\": " << FrameStats::getFrameTime()/n*1000.0 << "," << std::endl;
+    std::cout << "  \"gpu_timers\": " << (FrameStats::hasGpuTimers() ? "true" : "false") << "," << std::endl;
+    std::cout << "  \"stages\": {" << std::endl;
+    for (int stage=0; stage<FrameStats::STAGES_COUNT; stage++) {
+        std::cout << "    " << json(FrameStats::getStageName(stage)) << ": { \"cpu_ms\": " << FrameStats::getCpuTime(stage)/n*1000.0;
+        if (FrameStats::hasGpuTimers()) std::cout << ", \"gpu_ms\": " << FrameStats::getGpuTime(stage)/n*1000.0;
+        std::cout << " }" << (stage+1 < FrameStats::STAGES_COUNT ? "," : "") << std::endl;
+    }
+    std::cout << "  }," << std::endl;
+    std::cout << std::setprecision(1);
+    for (int counter=0; counter<Profiler::COUNTERS_COUNT; counter++) {
+        std::cout << "  " << json(Profiler::getCounterName(counter)) << ": " << Profiler::getCounter(counter)/n;
+        std::cout << (counter+1 < Profiler::COUNTERS_COUNT ? "," : "") << std::endl;
+    }
+    std::cout << "}" << std::endl;
+
+    return EXIT_SUCCESS;
+}
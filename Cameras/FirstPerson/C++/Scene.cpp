@@ -19,6 +19,11 @@ Scene::Scene() : SceneBase(true)
     m_Lorry    = new MeshObjectFromObj("data/models/Camion", "camion.obj", "camion.mtl", 2.0);
     m_PalmTree = new MeshObjectFromObj("data/models/Palm_Tree", "Palm_Tree.obj", "Palm_Tree.mtl", 0.4);
 
+    // niveaux de détail des camions : moitié, quart et dixième des triangles quand ils s'éloignent ;
+    // ils sont recalculés à chaque lancement (relecture du fichier OBJ et réduction), ce qui
+    // prend quelques dizaines de millisecondes pour ce camion de 1350 triangles
+    m_Lorry->createLevelsOfDetail({0.5, 0.25, 0.1});
+
     // définir une lampe directionnelle
     m_Light0 = new OmniLight();
     m_Light0->setPosition(vec4::fromValues(10, 5, 10, 0));
@@ -37,6 +42,9 @@ Scene::Scene() : SceneBase(true)
     m_Light2->setColor(vec3::fromValues(1.0,1.0,1.0));
     addLight(m_Light2);
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
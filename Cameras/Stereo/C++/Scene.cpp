@@ -6,6 +6,7 @@
 #include <utils.h>
 #include "Scene.h"
 #include <MeshObjectFromObj.h>
+#include <GLState.h>
 
 
 /**
@@ -26,6 +27,55 @@ Scene::Scene() : TurnTableScene(true)
     m_Lorry    = new MeshObjectFromObj("data/models/Camion", "camion.obj", "camion.mtl", 2.0);
     m_PalmTree = new MeshObjectFromObj("data/models/Palm_Tree", "Palm_Tree.obj", "Palm_Tree.mtl", 2.0);
 
+    // les palmiers et les camions sont dessinés en plusieurs exemplaires à la fois
+    m_PalmTree->setInstanced(true);
+    m_Lorry->setInstanced(true);
+
+    // placer les palmiers
+    mat4 transform = mat4::create();
+    mat4::fromTranslation(transform, vec3::fromValues(2.5,0,-1.0));
+    mat4::rotateY(transform, transform, Utils::radians(120.0));
+    mat4::scale(transform, transform, vec3::fromValues(0.2, 0.2, 0.2));
+    m_PalmTreeTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(3.0,0,1.5));
+    mat4::rotateY(transform, transform, Utils::radians(20.0));
+    mat4::scale(transform, transform, vec3::fromValues(0.2, 0.2, 0.2));
+    m_PalmTreeTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(-1,0,-2.0));
+    mat4::rotate(transform, transform, Utils::radians(80.0), vec3::fromValues(-1,0,-1));
+    mat4::scale(transform, transform, vec3::fromValues(0.2, 0.2, 0.2));
+    m_PalmTreeTransforms.push_back(transform);
+
+    // placer les camions
+    mat4::fromTranslation(transform, vec3::fromValues(1.5,0.5,-1.5));
+    mat4::rotateY(transform, transform, Utils::radians(-70.0));
+    mat4::rotate(transform, transform, Utils::radians(82.0), vec3::fromValues(0,0,1));
+    m_LorryTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(-2,0,0.5));
+    mat4::rotateY(transform, transform, Utils::radians(120.0));
+    m_LorryTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(-1,0,-1));
+    mat4::rotateY(transform, transform, Utils::radians(320.0));
+    mat4::scale(transform, transform, vec3::fromValues(1.5,3.0,0.5));
+    m_LorryTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(1.15,1.0,0.7));
+    mat4::rotateY(transform, transform, Utils::radians(60.0));
+    m_LorryTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(1,0,1));
+    mat4::rotateY(transform, transform, Utils::radians(-20.0));
+    mat4::scale(transform, transform, vec3::fromValues(2.0, 2.0, 2.0));
+    m_LorryTransforms.push_back(transform);
+
+    mat4::fromTranslation(transform, vec3::fromValues(-1,0,2));
+    mat4::rotateY(transform, transform, Utils::radians(200.0));
+    m_LorryTransforms.push_back(transform);
+
     // définir une lampe directionnelle
     m_Light0 = new OmniLight();
     m_Light0->setPosition(vec4::fromValues(10, 5, 10, 0));
@@ -94,49 +144,9 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     mat4::scale(mat4ModelView, mat4View, vec3::fromValues(2.0, 2.0, 2.0));
     m_Ground->onDraw(mat4Projection, mat4ModelView);
 
-    // dessiner les palmiers
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(2.5,0,-1.0));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(120.0));
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(0.2, 0.2, 0.2));
-    m_PalmTree->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(3.0,0,1.5));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(20.0));
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(0.2, 0.2, 0.2));
-    m_PalmTree->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-1,0,-2.0));
-    mat4::rotate(mat4ModelView, mat4ModelView, Utils::radians(80.0), vec3::fromValues(-1,0,-1));
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(0.2, 0.2, 0.2));
-    m_PalmTree->onDraw(mat4Projection, mat4ModelView);
-
-    // dessiner les camions
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(1.5,0.5,-1.5));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(-70.0));
-    mat4::rotate(mat4ModelView, mat4ModelView, Utils::radians(82.0), vec3::fromValues(0,0,1));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-2,0,0.5));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(120.0));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-1,0,-1));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(320.0));
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(1.5,3.0,0.5));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(1.15,1.0,0.7));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(60.0));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(1,0,1));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(-20.0));
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(2.0, 2.0, 2.0));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
-
-    mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-1,0,2));
-    mat4::rotateY(mat4ModelView, mat4ModelView, Utils::radians(200.0));
-    m_Lorry->onDraw(mat4Projection, mat4ModelView);
+    // dessiner tous les palmiers, puis tous les camions
+    m_PalmTree->drawInstanced(mat4Projection, mat4View, m_PalmTreeTransforms);
+    m_Lorry->drawInstanced(mat4Projection, mat4View, m_LorryTransforms);
 }
 
 
@@ -163,7 +173,7 @@ void Scene::onDrawFrame()
     prepareLights(mat4View);
 
     // vue gauche
-    glViewport(0, 0, m_WindowWidth2, m_WindowHeight);
+    GLState::viewport(0, 0, m_WindowWidth2, m_WindowHeight);
     mat4::fromTranslation(mat4ViewTmp, vec3::fromValues(-EyeSeparation, 0.0, 0.0));
     mat4::multiply(mat4ViewTmp, mat4ViewTmp, mat4View);
 
@@ -174,7 +184,7 @@ void Scene::onDrawFrame()
     addLightings();
 
     // vue droite
-    glViewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight);
+    GLState::viewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight);
     mat4::fromTranslation(mat4ViewTmp, vec3::fromValues(+EyeSeparation, 0.0, 0.0));
     mat4::multiply(mat4ViewTmp, mat4ViewTmp, mat4View);
 
@@ -3,6 +3,8 @@
 
 // Définition de la classe Scene
 
+#include <vector>
+
 #include <gl-matrix.h>
 #include <utils.h>
 #include <TurnTableScene.h>
@@ -19,6 +21,10 @@ private:
     MeshObject* m_PalmTree;
     MeshObject* m_Ground;
 
+    // positionnement de chaque exemplaire des palmiers et des camions
+    std::vector<mat4> m_PalmTreeTransforms;
+    std::vector<mat4> m_LorryTransforms;
+
     OmniLight* m_Light0;
     OmniLight* m_Light1;
     OmniLight* m_Light2;
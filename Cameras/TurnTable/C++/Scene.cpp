@@ -38,6 +38,9 @@ Scene::Scene() : SceneBase(true)
     m_Light2->setColor(vec3::fromValues(1.0,1.0,1.0));
     addLight(m_Light2);
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
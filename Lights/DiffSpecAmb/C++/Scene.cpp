@@ -7,6 +7,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -98,19 +99,19 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
     mat4::rotateY(mat4ModelViewApple, mat4ModelView, Utils::radians(Utils::Time * 15.0 + 100.0));
 
     // dessiner l'éclairement ambiant dans le coin haut gauche
-    glViewport(0, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(0, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
     m_AppleAmbiant->onDraw(mat4Projection, mat4ModelViewApple);
 
     // dessiner l'éclairement diffus dans le coin haut droit
-    glViewport(m_WindowWidth2, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth2, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
     m_AppleDiffuse->onDraw(mat4Projection, mat4ModelViewApple);
 
     // dessiner l'éclairement spéculaire dans le coin bas gauche
-    glViewport(0, 0, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(0, 0, m_WindowWidth2, m_WindowHeight2);
     m_SpecularApple->onDraw(mat4Projection, mat4ModelViewApple);
 
     // dessiner les éclairements superposés dans le coin bas droit
-    glViewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight2);
     m_AppleBlinn->onDraw(mat4Projection, mat4ModelViewApple);
 }
 
@@ -7,6 +7,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -124,40 +125,40 @@ void Scene::onDrawFrame()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // dessiner le diffuse buffer dans le coin haut gauche
-    glViewport(0, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(0, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
     m_GBuffer->onDraw(GL_COLOR_ATTACHMENT0);
 
     // dessiner le specular buffer au milieu haut
-    glViewport(m_WindowWidth3, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth3, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
     m_GBuffer->onDraw(GL_COLOR_ATTACHMENT1);
 
     // dessiner le position buffer dans le coin bas gauche
-    glViewport(0, 0, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(0, 0, m_WindowWidth3, m_WindowHeight2);
     m_GBuffer->onDraw(GL_COLOR_ATTACHMENT2);
 
     // dessiner le normal buffer au milieu bas
-    glViewport(m_WindowWidth3, 0, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth3, 0, m_WindowWidth3, m_WindowHeight2);
     m_GBuffer->onDraw(GL_COLOR_ATTACHMENT3);
 
     // dessiner le depth buffer dans le coin haut droit
-    glViewport(m_WindowWidth3*2, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth3*2, m_WindowHeight2, m_WindowWidth3, m_WindowHeight2);
     m_GBuffer->onDraw(GL_DEPTH_ATTACHMENT);
 
     // dessiner dans le coin bas droite
-    glViewport(m_WindowWidth3*2, 0, m_WindowWidth3, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth3*2, 0, m_WindowWidth3, m_WindowHeight2);
 
     // dessiner l'éclairement de la première lampe
     m_Light0->process(m_GBuffer);
 
     // passer en mode blending pour additionner les éclairements
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
 
     // rajouter les éclairements des lampes suivantes
     m_Light1->process(m_GBuffer);
 
     // revenir en mode normal
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     debugGLFatal("Scene::onDrawFrame");
 }
@@ -7,6 +7,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -130,27 +131,27 @@ void Scene::onDrawFrame()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // dessiner l'éclairement de la première lampe dans le coin haut gauche
-    glViewport(0, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(0, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
     m_Light0->process(m_GBuffer);
 
     // dessiner l'éclairement de la deuxième lampe dans le coin haut droit
-    glViewport(m_WindowWidth2, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth2, m_WindowHeight2, m_WindowWidth2, m_WindowHeight2);
     m_Light1->process(m_GBuffer);
 
     // dessiner l'éclairement de la troisième lampe dans le coin bas gauche
-    glViewport(0, 0, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(0, 0, m_WindowWidth2, m_WindowHeight2);
     m_Light2->process(m_GBuffer);
 
     // dessiner les éclairements des lampes superposés dans le coin bas droit
-    glViewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight2);
+    GLState::viewport(m_WindowWidth2, 0, m_WindowWidth2, m_WindowHeight2);
     m_Light0->process(m_GBuffer);
     // passer en mode blending pour additionner les éclairements des lampes suivantes
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE, GL_ONE);
     m_Light1->process(m_GBuffer);
     m_Light2->process(m_GBuffer);
     // revenir en mode normal
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -25,6 +25,9 @@ Scene::Scene() : TurnTableScene(true)
     m_Light->setPosition(vec4::fromValues(5, 5, 0, 1));
     m_Light->setColor(vec3::fromValues(60,60,60));
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
@@ -6,6 +6,7 @@
 #include <utils.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -130,7 +131,7 @@ void Scene::makeShadowMap(mat4& mat4ViewCamera)
 
     // remettre comme c'est normalement, mais ça crée des défauts
     glDisable(GL_POLYGON_OFFSET_FILL);
-    glCullFace(GL_BACK);
+    GLState::cullFace(GL_BACK);
 
 
     // défaut n°3 : "acné de surface"
@@ -157,7 +158,7 @@ void Scene::makeShadowMap(mat4& mat4ViewCamera)
     glDisable(GL_POLYGON_OFFSET_FILL);
 
     // remettre l'élimination des faces vues de dos
-    glCullFace(GL_BACK);
+    GLState::cullFace(GL_BACK);
 
     // revenir en mode dessin normal
     m_ShadowMap->disable();
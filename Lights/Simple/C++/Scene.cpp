@@ -22,6 +22,9 @@ Scene::Scene() : TurnTableScene(false)
     // créer les objets
     m_Apple = new MeshObjectFromObj("data/models/Apple", "apple.obj", m_Material, 0.01);
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
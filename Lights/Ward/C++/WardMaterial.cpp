@@ -193,5 +193,5 @@ void WardMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
  */
 WardMaterial::~WardMaterial()
 {
-    Utils::deleteShaderProgram(m_ShaderId);
+    // le shader est libéré par Material, qui le partage avec les autres matériaux
 }
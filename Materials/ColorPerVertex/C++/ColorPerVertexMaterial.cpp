@@ -72,5 +72,5 @@ VBOset* ColorPerVertexMaterial::createVBOset()
 
 ColorPerVertexMaterial::~ColorPerVertexMaterial()
 {
-    if (m_ShaderId > 0) Utils::deleteShaderProgram(m_ShaderId);
+    // le shader est libéré par Material, qui le partage avec les autres matériaux
 }
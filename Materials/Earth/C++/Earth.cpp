@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <Earth.h>
+#include <GLState.h>
 
 
 
@@ -144,7 +145,7 @@ Earth::Earth(int nblon, int nblat) throw (std::string)
  */
 void Earth::setLightPosition(vec4& position)
 {
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     vec4::glUniform(m_LightPositionLoc, position);
 }
 
@@ -156,8 +157,9 @@ void Earth::setLightPosition(vec4& position)
  */
 void Earth::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir les textures
     m_TxDiffuseDay->setTextureUnit(GL_TEXTURE0, m_TxDiffuseDayLoc);
@@ -201,7 +203,7 @@ void Earth::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
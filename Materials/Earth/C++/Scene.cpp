@@ -6,6 +6,7 @@
 #include <utils.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /**
@@ -35,7 +36,7 @@ Scene::Scene()
 void Scene::onSurfaceChanged(int width, int height)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 
     // matrice de projection (champ de vision)
     mat4::perspective(m_Mat4Projection, Utils::radians(20.0), (float)width / height, 0.1, 20.0);
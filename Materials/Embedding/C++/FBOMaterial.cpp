@@ -6,6 +6,7 @@
 
 #include <utils.h>
 #include <FBOMaterial.h>
+#include <GLState.h>
 
 /**
  * Constructeur
@@ -103,8 +104,8 @@ void FBOMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
     Material::enable(mat4Projection, mat4ModelView);
 
     // activer la texture sur l'unité 0
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_IdTexture);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, m_IdTexture);
     glUniform1i(m_TextureLoc, GL_TEXTURE0-GL_TEXTURE0);
 }
 
@@ -115,8 +116,8 @@ void FBOMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
 void FBOMaterial::disable()
 {
     // désactiver la texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
 
     // appeler la méthode de la superclasse
     Material::disable();
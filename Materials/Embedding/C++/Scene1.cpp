@@ -5,6 +5,7 @@
 
 #include <utils.h>
 #include <Scene1.h>
+#include <GLState.h>
 
 
 
@@ -25,7 +26,7 @@ Scene1::Scene1()
 void Scene1::onSurfaceChanged(int width, int height)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 
     // matrice de projection perspective
     mat4::perspective(m_Mat4Projection, Utils::radians(8.0), (float)width / height, 0.1, 20.0);
@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <Tetraedre.h>
+#include <GLState.h>
 
 
 
@@ -91,8 +92,9 @@ Tetraedre::Tetraedre() throw (std::string)
  */
 void Tetraedre::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir les matrices P et MV au shader
     mat4::glUniformMatrix(m_PMatrixLoc, mat4Projection);
@@ -122,7 +124,7 @@ void Tetraedre::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
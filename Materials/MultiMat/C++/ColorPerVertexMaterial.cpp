@@ -111,5 +111,5 @@ void ColorPerVertexMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
  */
 ColorPerVertexMaterial::~ColorPerVertexMaterial()
 {
-    if (m_ShaderId > 0) Utils::deleteShaderProgram(m_ShaderId);
+    // le shader est libéré par Material, qui le partage avec les autres matériaux
 }
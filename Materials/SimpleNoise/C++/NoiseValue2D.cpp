@@ -11,6 +11,7 @@
 #include <MeshModuleDrawing.h>
 
 #include <NoiseValue2D.h>
+#include <GLState.h>
 
 
 /**
@@ -172,7 +173,7 @@ NoiseValue2D::NoiseValue2D(int width, int height, int octaves): Texture2D()
     glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, pixmap);
 
     // libérer l'unité de texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
 }
 
 
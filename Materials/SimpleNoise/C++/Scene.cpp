@@ -6,6 +6,7 @@
 #include <utils.h>
 #include <Rectangle.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -30,7 +31,7 @@ Scene::Scene()
 void Scene::onSurfaceChanged(int width, int height)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 }
 
 
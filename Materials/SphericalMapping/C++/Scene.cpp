@@ -5,6 +5,7 @@
 
 #include <utils.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -116,7 +117,7 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
 
         // mode de transparence arrière
         glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::blendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
 
         // dessiner toutes les faces des objets
         glDisable(GL_CULL_FACE);
@@ -135,11 +136,11 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
             m_FBOcurrent->disable();
 
             // reporter cette couche sur le FBO du résultat en mode fusion arrière
-            glEnable(GL_BLEND);
+            GLState::enable(GL_BLEND);
             m_FBOresult->enable();
             m_FBOcurrent->onDraw(GL_COLOR_ATTACHMENT0);
             m_FBOresult->disable();
-            glDisable(GL_BLEND);
+            GLState::disable(GL_BLEND);
 
             // échanger les FBO
             FrameBufferObject* tmp = m_FBOcurrent;
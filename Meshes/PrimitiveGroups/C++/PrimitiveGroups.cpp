@@ -7,6 +7,7 @@
 #include <utils.h>
 
 #include <PrimitiveGroups.h>
+#include <GLState.h>
 
 PrimitiveGroups::PrimitiveGroups()
 {
@@ -83,8 +84,9 @@ PrimitiveGroups::PrimitiveGroups()
 /** Fonction de dessin */
 void PrimitiveGroups::onDraw()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -114,7 +116,7 @@ void PrimitiveGroups::onDraw()
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
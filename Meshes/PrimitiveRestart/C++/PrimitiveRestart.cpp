@@ -7,6 +7,7 @@
 #include <utils.h>
 
 #include <PrimitiveRestart.h>
+#include <GLState.h>
 
 
 /**
@@ -83,8 +84,9 @@ PrimitiveRestart::PrimitiveRestart()
 
 void PrimitiveRestart::onDraw()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -109,7 +111,7 @@ void PrimitiveRestart::onDraw()
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
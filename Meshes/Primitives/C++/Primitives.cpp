@@ -7,6 +7,7 @@
 #include <utils.h>
 
 #include <Primitives.h>
+#include <GLState.h>
 
 
 /**
@@ -76,8 +77,9 @@ Primitives::Primitives()
 
 void Primitives::onDraw()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -124,7 +126,7 @@ void Primitives::onDraw()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
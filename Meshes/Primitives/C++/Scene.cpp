@@ -6,6 +6,7 @@
 #include <utils.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -34,7 +35,7 @@ Scene::Scene()
 void Scene::onSurfaceChanged(int width, int height)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 }
 
 
@@ -62,6 +62,9 @@ Scene::Scene() : TurnTableScene(true)
     m_ElementLight1 = new SceneElement(m_Light1, m_ElementLorry);
     addLight(m_Light1);
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
@@ -31,6 +31,9 @@ Scene::Scene() : TurnTableScene(true)
     m_Light1->setColor(vec3::fromValues(20,20,20));
     addLight(m_Light1);
 
+    // regrouper les dessins par matériau, voir RenderQueue
+    setRenderQueue(true);
+
     // configurer les modes de dessin
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
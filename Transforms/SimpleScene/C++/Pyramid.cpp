@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <Pyramid.h>
+#include <GLState.h>
 
 
 /**
@@ -91,11 +92,12 @@ Pyramid::Pyramid()
 void Pyramid::onDraw(mat4& matProjection, mat4& matView, mat4& matModel)
 {
     // activer la transparence
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // calculer la matrice P * V * M
     mat4 matrix = mat4::create();
@@ -128,10 +130,10 @@ void Pyramid::onDraw(mat4& matProjection, mat4& matView, mat4& matModel)
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 
     // désactiver la transparence
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
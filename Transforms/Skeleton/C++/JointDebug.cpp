@@ -15,6 +15,7 @@
 #include <SkeletonMaterial.h>
 #include <VBOset.h>
 #include <JointDebug.h>
+#include <GLState.h>
 
 
 /**
@@ -169,8 +170,9 @@ void JointDebug::onDraw(mat4& mat4Projection, mat4& mat4View)
     GLboolean depthTestPrec = glIsEnabled(GL_DEPTH_TEST);
     if (m_IsBone) glDisable(GL_DEPTH_TEST);
 
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // décaler l'origine au pivot de la jointure
     mat4 mat4ModelView = mat4::create();
@@ -212,7 +214,7 @@ void JointDebug::onDraw(mat4& mat4Projection, mat4& mat4View)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_VertexLoc);
     glDisableVertexAttribArray(m_ColorLoc);
-    glUseProgram(0);
+    GLState::useProgram(0);
 
     if (cullFacePrec) glEnable(GL_CULL_FACE);
     if (depthTestPrec) glEnable(GL_DEPTH_TEST);
@@ -22,12 +22,7 @@
  */
 Ground::Ground(int points_count, GroundMaterial* material)
 {
-    // test sur la taille du terrain
-    // WebGL pose une grosse limite sur les paramètres de gl.drawElements : des ushort uniquement, pas de uint
-    if (points_count > 256) {
-        std::cout << "Ground : nombre de points trop grand, pas plus de 256" << std::endl;
-        points_count = 256;
-    }
+    // NB : pas de limite sur la taille du terrain, VBOset choisit le type des indices
 
     // créer le maillage : une grille hexagonale
     m_Mesh = new Mesh("Ground");
@@ -47,7 +42,7 @@ Ground::Ground(int points_count, GroundMaterial* material)
         }
     }
 
-    // créer le VBOset pour dessiner cet objet (attention, peut être très lent)
+    // créer le VBOset pour dessiner cet objet
     MeshModuleDrawing renderer(m_Mesh);
     m_VBOset = renderer.createStripVBOset(material, true);
 }
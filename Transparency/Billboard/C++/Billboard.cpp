@@ -8,6 +8,7 @@
 #include <MeshModuleDrawing.h>
 
 #include <Billboard.h>
+#include <GLState.h>
 
 
 /**
@@ -61,7 +62,7 @@ Billboard::Billboard(Texture360* texture360)
 void Billboard::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
 {
     // mettre en place le blending
-    glEnable(GL_BLEND);
+    GLState::enable(GL_BLEND);
 
     /** dessiner l'ombre */
 
@@ -125,7 +126,7 @@ void Billboard::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
     m_VBOset->onDraw(mat4Projection, m_ModelViewFixed);
 
     // arrêter le blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -148,13 +149,13 @@ void Billboard::onDraw2(mat4& mat4Projection, mat4& mat4ModelView)
     mat4ModelViewFixed[10] = 1.0;
 
     // mettre en place le blending
-    glEnable(GL_BLEND);
+    GLState::enable(GL_BLEND);
 
     // dessiner le rectangle face à la caméra
     m_VBOset->onDraw(mat4Projection, mat4ModelViewFixed);
 
     // arrêter le blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
  }
 
 
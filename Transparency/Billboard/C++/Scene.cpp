@@ -5,6 +5,7 @@
 
 #include <utils.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -25,7 +26,7 @@ Scene::Scene() : TurnTableScene(false)
     glDisable(GL_CULL_FACE);      // laisser voir le dos des billboards
 
     // formule de blending
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // couleur du fond
     glClearColor(0.6, 0.7, 1.0, 0.0);
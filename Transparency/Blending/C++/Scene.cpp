@@ -6,6 +6,7 @@
 #include <utils.h>
 #include <Rectangle.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -64,8 +65,8 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     m_Background->onDraw(mat4Projection, mat4ModelView);
 
     // activer le mode blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // dessiner les nuages
     mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-0.2,0.7,-0.5));
@@ -82,7 +83,7 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     m_SmallTree->onDraw(mat4Projection, mat4ModelView);
 
     // désactiver le mode blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -5,6 +5,7 @@
 
 #include <utils.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -69,8 +70,8 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // activer le mode blending permettant de fusionner d'avant en arrière
-    glEnable(GL_BLEND);
-    glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
 
     // dessiner l'arbuste
     mat4::translate(mat4ModelView, mat4View, vec3::fromValues(-0.2,-0.3,0.5));
@@ -94,13 +95,13 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     m_FBOlayers->disable();
 
     // changer l'équation de mélange
-    glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+    GLState::blendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
 
     // dessiner le résultat
     m_FBOlayers->onDraw(GL_COLOR_ATTACHMENT0);
 
     // désactiver le mode blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     // remettre la couleur d'effacement
     glClearColor(0.4, 0.4, 0.4, 0.0);
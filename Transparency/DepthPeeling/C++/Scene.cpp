@@ -8,6 +8,7 @@
 
 #include "Scene.h"
 #include <TransparentMaterial.h>
+#include <GLState.h>
 
 
 /** NOMBRE DE COUCHES À DESSINER, mettre entre 0 et 10, mais plus que 5 est peu utile **/
@@ -236,11 +237,11 @@ void Scene::onDrawFrame()
     glClearColor(0.0, 0.0, 0.0, 0.0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     m_SkyBackground->process(m_GBuffer);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_SRC_ALPHA);
     m_Light0->process(m_GBuffer);
     m_Light1->process(m_GBuffer);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     /// Cycles d'épluchage des transparences
 
@@ -266,22 +267,22 @@ void Scene::onDrawFrame()
         m_FBOlights->enable();
         glClearColor(0.0, 0.0, 0.0, 0.0);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        glEnable(GL_BLEND);
-        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
+        GLState::enable(GL_BLEND);
+        GLState::blendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
         m_Light0->process(m_CurrentGBuffer);
         m_Light1->process(m_CurrentGBuffer);
-        glDisable(GL_BLEND);
+        GLState::disable(GL_BLEND);
         m_FBOlights->disable();
         //m_FBOlights->onDraw(GL_COLOR_ATTACHMENT0);return;}/*
         //m_FBOlights->onDrawAlpha(GL_COLOR_ATTACHMENT0);return;}/*
 
         // mélanger cette couche à l'arrière du FBO des couches
         m_FBOlayers->enable();
-        glEnable(GL_BLEND);
+        GLState::enable(GL_BLEND);
         glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::blendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
         m_FBOlights->onDraw(GL_COLOR_ATTACHMENT0);
-        glDisable(GL_BLEND);
+        GLState::disable(GL_BLEND);
         m_FBOlayers->disable();
         //m_FBOlayers->onDraw(GL_COLOR_ATTACHMENT0);return;}/*
         //m_FBOlayers->onDrawAlpha(GL_COLOR_ATTACHMENT0);return;}/*
@@ -295,10 +296,10 @@ void Scene::onDrawFrame()
     //m_FBOlayers->onDrawAlpha(GL_COLOR_ATTACHMENT0);/*
 
     // superposer le FBO des couches transparentes sur l'écran
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
     m_FBOlayers->onDraw(GL_COLOR_ATTACHMENT0);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     //si on décommente l'une des lignes de mise au point*/
 }
@@ -10,6 +10,7 @@
 
 #include <utils.h>
 #include <TransparentMaterial.h>
+#include <GLState.h>
 
 
 /**
@@ -230,13 +231,13 @@ void TransparentMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
     DeferredShadingMaterial::enable(mat4Projection, mat4ModelView);
 
     // fournir et activer la DepthMapFar dans l'unité 2
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, m_DepthMapFar);
+    GLState::activeTexture(GL_TEXTURE2);
+    GLState::bindTexture(GL_TEXTURE_2D, m_DepthMapFar);
     glUniform1i(m_DepthMapFarLoc, GL_TEXTURE2-GL_TEXTURE0);
 
     // fournir et activer la DepthMapNear dans l'unité 3
-    glActiveTexture(GL_TEXTURE3);
-    glBindTexture(GL_TEXTURE_2D, m_DepthMapNear);
+    GLState::activeTexture(GL_TEXTURE3);
+    GLState::bindTexture(GL_TEXTURE_2D, m_DepthMapNear);
     glUniform1i(m_DepthMapNearLoc, GL_TEXTURE3-GL_TEXTURE0);
 
     // fournir les dimensions de la fenêtre
@@ -251,10 +252,10 @@ void TransparentMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
 void TransparentMaterial::disable()
 {
     // désactiver les depth maps
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glActiveTexture(GL_TEXTURE3);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::activeTexture(GL_TEXTURE2);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+    GLState::activeTexture(GL_TEXTURE3);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
 
     // appeler la méthode de la superclasse
     DeferredShadingMaterial::disable();
@@ -8,6 +8,7 @@
 
 #include "Scene.h"
 #include <TransparentMaterial.h>
+#include <GLState.h>
 
 
 /** NOMBRE DE COUCHES À DESSINER, mettre entre 0 et 10, mais plus que 5 est peu utile **/
@@ -210,7 +211,7 @@ void Scene::onDrawFrame()
 
     // mode de transparence arrière
     glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::blendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
 
     // dessiner toutes les faces des objets
     glDisable(GL_CULL_FACE);
@@ -233,9 +234,9 @@ void Scene::onDrawFrame()
 
         // mélanger cette couche à l'arrière du FBO des couches
         m_FBOlayers->enable();
-        glEnable(GL_BLEND);
+        GLState::enable(GL_BLEND);
         m_CurrentGBuffer->onDraw(GL_COLOR_ATTACHMENT0);
-        glDisable(GL_BLEND);
+        GLState::disable(GL_BLEND);
         m_FBOlayers->disable();
         //if (i==NumLayers-1){m_FBOlayers->onDraw(GL_COLOR_ATTACHMENT0);return;}
         //if (i==NumLayers-1){m_FBOlayers->onDrawAlpha(GL_COLOR_ATTACHMENT0);return;}
@@ -250,10 +251,10 @@ void Scene::onDrawFrame()
 
     // superposer le FBO des couches transparentes sur l'écran
     m_GBuffer->onDraw(GL_COLOR_ATTACHMENT0);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA);
     m_FBOlayers->onDraw(GL_COLOR_ATTACHMENT0);
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 
     //si on décommente l'une des lignes de mise au point*/
 }
@@ -11,6 +11,7 @@
 #include <utils.h>
 #include <VBOset.h>
 #include <TransparentMaterial.h>
+#include <GLState.h>
 
 
 /**
@@ -131,13 +132,13 @@ void TransparentMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
     Material::enable(mat4Projection, mat4ModelView);
 
     // fournir et activer la DepthMapFar dans l'unité 0
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_DepthMapFar);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, m_DepthMapFar);
     glUniform1i(m_DepthMapFarLoc, GL_TEXTURE0-GL_TEXTURE0);
 
     // fournir et activer la DepthMapNear dans l'unité 1
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_DepthMapNear);
+    GLState::activeTexture(GL_TEXTURE1);
+    GLState::bindTexture(GL_TEXTURE_2D, m_DepthMapNear);
     glUniform1i(m_DepthMapNearLoc, GL_TEXTURE1-GL_TEXTURE0);
 
     // fournir les dimensions de la fenêtre
@@ -152,10 +153,10 @@ void TransparentMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
 void TransparentMaterial::disable()
 {
     // désactiver les depth maps
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::activeTexture(GL_TEXTURE0);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+    GLState::activeTexture(GL_TEXTURE1);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
 
     // appeler la méthode de la superclasse
     Material::disable();
@@ -10,6 +10,7 @@
 #include <MeshModuleDrawing.h>
 
 #include <Billboard.h>
+#include <GLState.h>
 
 
 /**
@@ -72,13 +73,13 @@ void Billboard::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
     m_ModelViewFixed[10] = 1.0;
 
     // mettre en place le blending
-    glEnable(GL_BLEND);
+    GLState::enable(GL_BLEND);
 
     // dessiner le rectangle face à la caméra
     m_VBOset->onDraw(mat4Projection, m_ModelViewFixed);
 
     // arrêter le blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
  }
 
 
@@ -7,6 +7,7 @@
 #include <MeshObjectFromObj.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -37,7 +38,7 @@ Scene::Scene() : TurnTableScene(true)
     glDisable(GL_CULL_FACE);      // laisser voir le dos des billboards
 
     // formule de blending
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // couleur du fond
     glClearColor(0.3, 0.4, 0.5, 0.0);
@@ -5,19 +5,17 @@
 #include <sstream>
 
 #include <utils.h>
-#include <MeshModuleDrawing.h>
 
 #include <Billboard.h>
 
 
 /**
  * crée un billboard : un rectangle portant une texture360
- * @param texture360
  * @param position : vec3 donnant les coordonnées du bas du panneau
  * @param tx : float donnant la taille horizontale
  * @param ty : float donnant la taille verticale
  */
-Billboard::Billboard(Texture360* texture360, vec3 position, float tx, float ty)
+Billboard::Billboard(vec3 position, float tx, float ty)
 {
     // paramètres
     m_Position = position;
@@ -27,40 +25,44 @@ Billboard::Billboard(Texture360* texture360, vec3 position, float tx, float ty)
     // matrices pour stocker les ModelView
     m_ModelViewOrig = mat4::create();
     m_ModelViewFixed = mat4::create();
+    m_ModelViewShadow = mat4::create();
 
     // angle sous lequel on voit le billboard
     m_Angle = 0.0;
+    m_Distance = 0.0;
+}
+
 
-    // créer le maillage
-    m_Mesh = new Mesh("Billboard");
+/**
+ * crée le maillage commun à tous les billboards : un rectangle
+ * de largeur 1 et de hauteur 1, posé sur le milieu de sa base
+ * @return maillage à dessiner avec un Texture360Material
+ */
+Mesh* Billboard::createMesh()
+{
+    Mesh* mesh = new Mesh("Billboard");
 
     // sommets
-    MeshVertex* P0 = m_Mesh->addVertex("P0");
+    MeshVertex* P0 = mesh->addVertex("P0");
     P0->setCoord(vec3::fromValues(-0.5, 0.0, 0.0));
     P0->setTexCoord(vec2::fromValues(0.0, 0.0));
 
-    MeshVertex* P1 = m_Mesh->addVertex("P1");
+    MeshVertex* P1 = mesh->addVertex("P1");
     P1->setCoord(vec3::fromValues(+0.5, 0.0, 0.0));
     P1->setTexCoord(vec2::fromValues(1.0, 0.0));
 
-    MeshVertex* P2 = m_Mesh->addVertex("P2");
+    MeshVertex* P2 = mesh->addVertex("P2");
     P2->setCoord(vec3::fromValues(+0.5, 1.0, 0.0));
     P2->setTexCoord(vec2::fromValues(1.0, 1.0));
 
-    MeshVertex* P3 = m_Mesh->addVertex("P3");
+    MeshVertex* P3 = mesh->addVertex("P3");
     P3->setCoord(vec3::fromValues(-0.5, 1.0, 0.0));
     P3->setTexCoord(vec2::fromValues(0.0, 1.0));
 
     // quadrilatère
-    m_Mesh->addQuad(P0, P1, P2, P3);
+    mesh->addQuad(P0, P1, P2, P3);
 
-    // créer le matériau du rectangle
-    m_Material = new Texture360Material(texture360);
-    m_Material->select(m_Angle);
-
-    // créer les VBO pour afficher ce maillage
-    MeshModuleDrawing renderer(m_Mesh);
-    m_VBOset = renderer.createStripVBOset(m_Material, true);
+    return mesh;
 }
 
 
@@ -108,6 +110,11 @@ void Billboard::setModelView(mat4& mat4ModelView)
     m_ModelViewFixed[ 8] = 0.0;
     m_ModelViewFixed[ 9] = 0.0;
     m_ModelViewFixed[10] = 1.0;
+
+    /** ombre : le billboard pivoté à plat par terre, avec une hauteur réduite **/
+
+    mat4::rotateX(m_ModelViewShadow, m_ModelViewOrig, Utils::radians(-90));
+    mat4::scale(m_ModelViewShadow, m_ModelViewShadow, vec3::fromValues(m_SizeX, 0.7*m_SizeY, 1.0));
 }
 
 
@@ -135,80 +142,30 @@ bool Billboard::DistanceCompare(const Billboard* a, const Billboard* b)
 
 
 /**
- * dessin du billboard sur l'écran
- * @param mat4Projection : matrice de projection
+ * retourne l'angle sous lequel on voit le billboard, pour choisir sa texture
+ * @return angle entre 0 et 1
  */
-void Billboard::onDraw(mat4& mat4Projection)
+float Billboard::getAngle() const
 {
-    // mettre en place le blending
-    glEnable(GL_BLEND);
-
-    /** dessiner l'ombre */
-
-    // rendre le matériau noir et un peu transparent
-    m_Material->setCoefficients(0.0, 0.7);
-    // activer la texture d'angle 0 pour l'ombre (soleil tjrs même position)
-    m_Material->select(0.0);
-    // désactiver le test du depth buffer
-    glDisable(GL_DEPTH_TEST);
-    // faire pivoter le billboard à plat par terre
-    mat4 mat4ModelView = mat4::create();
-    mat4::rotateX(mat4ModelView, m_ModelViewOrig, Utils::radians(-90));
-    // réduire la hauteur du billboard
-    mat4::scale(mat4ModelView, mat4ModelView, vec3::fromValues(m_SizeX, 0.7*m_SizeY, 1.0));
-    // dessiner le rectangle
-    m_VBOset->onDraw(mat4Projection, mat4ModelView);
-    // réactiver le test du depth buffer
-    glEnable(GL_DEPTH_TEST);
-
-    /** dessiner le billboard */
-
-    // rendre le matériau normal
-    m_Material->setCoefficients(1.0, 1.0);
-    // activer la bonne texture
-    m_Material->select(m_Angle);
-    // dessiner le rectangle face à la caméra
-    m_VBOset->onDraw(mat4Projection, m_ModelViewFixed);
-
-    // arrêter le blending
-    glDisable(GL_BLEND);
+    return m_Angle;
 }
 
 
 /**
- * dessin du billboard sur l'écran, variante plus simple, sans positionnement préalable
- * @param mat4Projection : matrice de projection
- * @param mat4ModelView : matrice de vue
+ * retourne la matrice ModelView du rectangle, face à la caméra
+ * @return matrice calculée par setModelView
  */
-void Billboard::onDraw2(mat4& mat4Projection, mat4& mat4ModelView)
+mat4& Billboard::getModelView()
 {
-    mat4 mat4ModelViewFixed = mat4::clone(mat4ModelView);
-    mat4ModelViewFixed[ 0] = 1.0;
-    mat4ModelViewFixed[ 1] = 0.0;
-    mat4ModelViewFixed[ 2] = 0.0;
-    mat4ModelViewFixed[ 4] = 0.0;
-    mat4ModelViewFixed[ 5] = 1.0;
-    mat4ModelViewFixed[ 6] = 0.0;
-    mat4ModelViewFixed[ 8] = 0.0;
-    mat4ModelViewFixed[ 9] = 0.0;
-    mat4ModelViewFixed[10] = 1.0;
-
-    // mettre en place le blending
-    glEnable(GL_BLEND);
-
-    // dessiner le rectangle face à la caméra
-    m_VBOset->onDraw(mat4Projection, mat4ModelViewFixed);
-
-    // arrêter le blending
-    glDisable(GL_BLEND);
- }
+    return m_ModelViewFixed;
+}
+
 
 /**
- * Cette méthode supprime les ressources allouées
+ * retourne la matrice ModelView de l'ombre, à plat par terre
+ * @return matrice calculée par setModelView
  */
-Billboard::~Billboard()
+mat4& Billboard::getShadowModelView()
 {
-    delete m_Material;
-    delete m_VBOset;
-    delete m_Mesh;
+    return m_ModelViewShadow;
 }
@@ -9,58 +9,67 @@
 #include <gl-matrix.h>
 #include <utils.h>
 #include <Mesh.h>
-#include <VBOset.h>
-
-#include "Texture360.h"
-#include "Texture360Material.h"
 
 
+/**
+ * Un billboard est un rectangle portant une texture360. Tous les billboards ont le
+ * même maillage, voir createMesh, ils sont dessinés ensemble par instances : chacun
+ * ne fournit que les matrices ModelView de son rectangle et de son ombre.
+ */
 class Billboard
 {
 public:
 
     /**
      * crée un billboard : un rectangle portant une texture360
-     * @param texture360
      * @param position : vec3 donnant les coordonnées du bas du panneau
      * @param tx : float donnant la taille horizontale
      * @param ty : float donnant la taille verticale
      */
-    Billboard(Texture360* texture360, vec3 position, float tx=1.0, float ty=1.0);
+    Billboard(vec3 position, float tx=1.0, float ty=1.0);
 
-    /** destructeur */
-    ~Billboard();
+    /**
+     * crée le maillage commun à tous les billboards : un rectangle
+     * de largeur 1 et de hauteur 1, posé sur le milieu de sa base
+     * @return maillage à dessiner avec un Texture360Material
+     */
+    static Mesh* createMesh();
 
     /**
-     * recopie ModelView dans les matrices locales
+     * calcule les matrices ModelView du rectangle et de son ombre
      * @param mat4ModelView
      */
     void setModelView(mat4& mat4ModelView);
 
     /**
-     * retourne la distance du billboard à l'œil
-     * @return distance
+     * retourne l'angle sous lequel on voit le billboard, pour choisir sa texture
+     * @return angle entre 0 et 1
      */
-    float getDistance() const;
+    float getAngle() const;
 
     /**
-     * compare la distance entre deux billboard afin de pouvoir classer une liste
-     * du plus loin au plus proche
+     * retourne la matrice ModelView du rectangle, face à la caméra
+     * @return matrice calculée par setModelView
      */
-    static bool DistanceCompare(const Billboard* a, const Billboard* b);
+    mat4& getModelView();
 
     /**
-     * dessin du billboard sur l'écran
-     * @param mat4Projection : matrice de projection
+     * retourne la matrice ModelView de l'ombre, à plat par terre
+     * @return matrice calculée par setModelView
      */
-    void onDraw(mat4& mat4Projection);
+    mat4& getShadowModelView();
 
     /**
-     * dessin du billboard sur l'écran, variante plus simple, sans positionnement préalable
-     * @param mat4Projection : matrice de projection
-     * @param mat4ModelView : matrice de vue
+     * retourne la distance du billboard à l'œil
+     * @return distance
      */
-    void onDraw2(mat4& mat4Projection, mat4& mat4ModelView);
+    float getDistance() const;
+
+    /**
+     * compare la distance entre deux billboard afin de pouvoir classer une liste
+     * du plus loin au plus proche
+     */
+    static bool DistanceCompare(const Billboard* a, const Billboard* b);
 
 
 protected:
@@ -73,19 +82,11 @@ protected:
     // matrices ModelView associées
     mat4 m_ModelViewOrig;
     mat4 m_ModelViewFixed;
+    mat4 m_ModelViewShadow;
 
     // angle et distance de vue
     float m_Angle;
     float m_Distance;
-
-    // maillage
-    Mesh* m_Mesh;
-
-    // matériau
-    Texture360Material* m_Material;
-
-    // VBOset
-    VBOset* m_VBOset;
 };
 
 #endif
@@ -5,7 +5,9 @@
 #include <random>
 
 #include <utils.h>
+#include <MeshModuleDrawing.h>
 #include "Scene.h"
+#include <GLState.h>
 
 
 
@@ -17,8 +19,15 @@ Scene::Scene() : TurnTableScene(false)
     // crée les objets à dessiner
     m_Ground = new Ground();
 
-    // créer un ensemble de billboards
+    // créer le rectangle commun à tous les arbres, dessiné par instances
     m_TxTree = new Texture360("data/textures/Billboards/bb_arbre2", 8);
+    m_TreeMesh = Billboard::createMesh();
+    m_TreeMaterial = new Texture360Material(m_TxTree);
+    m_TreeMaterial->setInstanced(true);
+    MeshModuleDrawing renderer(m_TreeMesh);
+    m_TreeVBOset = renderer.createStripVBOset(m_TreeMaterial, true);
+
+    // créer un ensemble de billboards
     const int N = 13;
     std::default_random_engine generator;
     std::uniform_real_distribution<double> distribution(0.0, 1.0);
@@ -34,7 +43,7 @@ Scene::Scene() : TurnTableScene(false)
             float z = l*(9.0/(N-1)) - 4.5 +  (distribution(generator)-0.5)*0.003;
 
             // créer et mémoriser un billboard à cet emplacement
-            Billboard* tree = new Billboard(m_TxTree, vec3::fromValues(x,y,z), sx, sy);
+            Billboard* tree = new Billboard(vec3::fromValues(x,y,z), sx, sy);
 
             // ajouter ce nouvel arbre dans la forêt
             m_Forest.push_back(tree);
@@ -46,7 +55,7 @@ Scene::Scene() : TurnTableScene(false)
     glDisable(GL_CULL_FACE);      // laisser voir le dos des billboards
 
     // formule de blending
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // couleur du fond
     glClearColor(0.6, 0.7, 1.0, 0.0);
@@ -92,10 +101,52 @@ void Scene::onDraw(mat4& mat4Projection, mat4& mat4View)
     // classer par distance décroissante à l'oeil
     std::sort(m_Forest.begin(), m_Forest.end(), Billboard::DistanceCompare);
 
-    // dessiner l'ensemble des arbres
+    // matrices des ombres et des arbres, du plus loin au plus proche
+    m_ShadowModelViews.clear();
+    m_TreeModelViews.clear();
     for (Billboard* tree: m_Forest) {
-        tree->onDraw(mat4Projection);
+        m_ShadowModelViews.push_back(tree->getShadowModelView());
+        m_TreeModelViews.push_back(tree->getModelView());
     }
+    if (m_Forest.empty()) return;
+
+    // les matrices des instances sont déjà des ModelView complètes
+    mat4 mat4Identity = mat4::create();
+
+    // mettre en place le blending
+    GLState::enable(GL_BLEND);
+
+    /** dessiner les ombres */
+
+    // NB : toutes les ombres sont dessinées avant tous les arbres, alors qu'auparavant chaque
+    // arbre était dessiné juste après son ombre. Comme les ombres sont dessinées sans test de
+    // profondeur, l'ombre d'un arbre proche recouvrait autrefois les arbres plus lointains ;
+    // désormais les ombres restent sous tous les arbres. Les images ne diffèrent donc que là
+    // où l'ombre d'un arbre croise un arbre plus lointain.
+
+    // rendre le matériau noir et un peu transparent
+    m_TreeMaterial->setCoefficients(0.0, 0.7);
+    // activer la texture d'angle 0 pour l'ombre (soleil tjrs même position)
+    m_TreeMaterial->select(0.0);
+    // désactiver le test du depth buffer
+    glDisable(GL_DEPTH_TEST);
+    // dessiner toutes les ombres
+    m_TreeVBOset->onDrawInstanced(mat4Projection, mat4Identity, m_ShadowModelViews);
+    // réactiver le test du depth buffer
+    glEnable(GL_DEPTH_TEST);
+
+    /** dessiner les arbres */
+
+    // rendre le matériau normal
+    m_TreeMaterial->setCoefficients(1.0, 1.0);
+    // la vue ne fait que translater les arbres les uns par rapport aux autres,
+    // ils sont tous vus sous le même angle, donc avec la même texture
+    m_TreeMaterial->select(m_Forest[0]->getAngle());
+    // dessiner tous les arbres face à la caméra, les instances sont dessinées dans l'ordre
+    m_TreeVBOset->onDrawInstanced(mat4Projection, mat4Identity, m_TreeModelViews);
+
+    // arrêter le blending
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -108,5 +159,8 @@ Scene::~Scene()
     for (Billboard* tree: m_Forest) {
         delete tree;
     }
+    delete m_TreeVBOset;
+    delete m_TreeMaterial;
+    delete m_TreeMesh;
     delete m_TxTree;
 }
@@ -8,8 +8,12 @@
 #include <utils.h>
 #include <TurnTableScene.h>
 
+#include <Mesh.h>
+#include <VBOset.h>
+
 #include "Ground.h"
 #include "Texture360.h"
+#include "Texture360Material.h"
 #include "Billboard.h"
 
 
@@ -44,6 +48,15 @@ private:
     Texture360* m_TxTree;
     std::vector<Billboard*> m_Forest;
 
+    // maillage, matériau et VBOset communs à tous les arbres, dessinés par instances
+    Mesh* m_TreeMesh;
+    Texture360Material* m_TreeMaterial;
+    VBOset* m_TreeVBOset;
+
+    // matrices ModelView des arbres et de leurs ombres, dans l'ordre du dessin
+    std::vector<mat4> m_TreeModelViews;
+    std::vector<mat4> m_ShadowModelViews;
+
 };
 
 #endif
@@ -34,20 +34,21 @@ Texture360Material::Texture360Material(Texture360* texture360) :
  */
 std::string Texture360Material::getVertexShader()
 {
-    const char* srcVertexShader =
-        "#version 300 es\n"
-        "in vec3 glVertex;\n"
-        "in vec2 glTexCoord;\n"
-        "uniform mat4 mat4ModelView;\n"
-        "uniform mat4 mat4Projection;\n"
-        "out vec2 frgTexCoord;\n"
-        "\n"
-        "void main()\n"
-        "{\n"
-        "    gl_Position = mat4Projection * mat4ModelView * vec4(glVertex, 1.0);\n"
-        "    frgTexCoord = glTexCoord;\n"
-        "}";
-    return srcVertexShader;
+    std::ostringstream srcVertexShader;
+    srcVertexShader << "#version 300 es\n";
+    srcVertexShader << "in vec3 glVertex;\n";
+    srcVertexShader << "in vec2 glTexCoord;\n";
+    srcVertexShader << getInstancingShader();
+    srcVertexShader << "uniform mat4 mat4ModelView;\n";
+    srcVertexShader << "uniform mat4 mat4Projection;\n";
+    srcVertexShader << "out vec2 frgTexCoord;\n";
+    srcVertexShader << "\n";
+    srcVertexShader << "void main()\n";
+    srcVertexShader << "{\n";
+    srcVertexShader << "    gl_Position = mat4Projection * " << getModelViewShader() << " * vec4(glVertex, 1.0);\n";
+    srcVertexShader << "    frgTexCoord = glTexCoord;\n";
+    srcVertexShader << "}";
+    return srcVertexShader.str();
 }
 
 
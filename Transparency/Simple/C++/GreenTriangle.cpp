@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <GreenTriangle.h>
+#include <GLState.h>
 
 
 
@@ -59,8 +60,9 @@ GreenTriangle::GreenTriangle(float alpha) throw (std::string)
 /** dessiner l'objet */
 void GreenTriangle::onDraw()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -75,7 +77,7 @@ void GreenTriangle::onDraw()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
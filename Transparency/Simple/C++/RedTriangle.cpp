@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <RedTriangle.h>
+#include <GLState.h>
 
 
 
@@ -54,8 +55,9 @@ RedTriangle::RedTriangle() throw (std::string)
 /** dessiner l'objet */
 void RedTriangle::onDraw()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -70,7 +72,7 @@ void RedTriangle::onDraw()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     // désactiver le shader
-    glUseProgram(0);
+    GLState::useProgram(0);
 }
 
 
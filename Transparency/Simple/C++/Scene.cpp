@@ -6,6 +6,7 @@
 #include <utils.h>
 
 #include "Scene.h"
+#include <GLState.h>
 
 
 /** constructeur */
@@ -28,7 +29,7 @@ Scene::Scene()
 void Scene::onSurfaceChanged(int width, int height)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 }
 
 
@@ -44,18 +45,18 @@ void Scene::onDrawFrame()
     m_RedTriangle->onDraw();
 
     // mettre en place le blending
-    glEnable(GL_BLEND);
+    GLState::enable(GL_BLEND);
 
     // formule de blending
     glBlendEquation(GL_FUNC_ADD);
     //glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glBlendFunc(GL_ONE, GL_SRC_COLOR);
+    GLState::blendFunc(GL_ONE, GL_SRC_COLOR);
 
     // dessiner le triangle vert
     m_GreenTriangle->onDraw();
 
     // arrêter le blending
-    glDisable(GL_BLEND);
+    GLState::disable(GL_BLEND);
 }
 
 
@@ -0,0 +1,369 @@
+/**
+ * Définition de la classe ClusteredLights, l'éclairement de nombreuses lampes en une seule passe
+ * voir http://www.cse.chalmers.se/~uffe/clustered_shading_preprint.pdf
+ */
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <math.h>
+
+#include <gl-matrix.h>
+#include <utils.h>
+#include <ClusteredLights.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
+
+
+/**
+ * constructeur
+ * @param tilesize : taille en pixels du g-buffer des tuiles de l'écran
+ * @param slices : nombre de tranches de profondeur entre les plans near et far
+ */
+ClusteredLights::ClusteredLights(int tilesize, int slices):
+    Light()
+{
+    m_Name = "ClusteredLights";
+
+    // initialisation des variables membre spécifiques
+    m_TileSize = std::max(tilesize, 1);
+    m_SlicesCount = std::max(slices, 1);
+    m_TilesX = 0;
+    m_TilesY = 0;
+    m_Near = 1.0;
+    m_SliceScale = 0.0;
+    m_AssignmentsCount = 0;
+
+    // textures contenant les lampes et les clusters, lues avec texelFetch
+    GLuint textures[3];
+    glGenTextures(3, textures);
+    for (GLuint texture: textures) {
+        GLState::bindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+    m_LightsTextureId   = textures[0];
+    m_ClustersTextureId = textures[1];
+    m_IndicesTextureId  = textures[2];
+
+    // compiler le shader
+    compileShader();
+}
+
+
+/**
+ * destructeur
+ */
+ClusteredLights::~ClusteredLights()
+{
+    GLState::deleteTextures(1, &m_LightsTextureId);
+    GLState::deleteTextures(1, &m_ClustersTextureId);
+    GLState::deleteTextures(1, &m_IndicesTextureId);
+}
+
+
+/**
+ * définit les lampes à regrouper pour la prochaine passe d'éclairement
+ * @param lights : lampes à éclairer
+ */
+void ClusteredLights::setLights(const std::vector<OmniLight*>& lights)
+{
+    m_OmniLights = lights;
+}
+
+
+/**
+ * retourne le nombre de couples (lampe, cluster) de la dernière passe
+ * @return nombre d'affectations de lampes à des clusters
+ */
+int ClusteredLights::getAssignmentsCount()
+{
+    return m_AssignmentsCount;
+}
+
+
+/**
+ * retourne la tranche de profondeur d'une distance à la caméra, les tranches
+ * ont des épaisseurs qui croissent exponentiellement entre near et far
+ * @param distance : distance à la caméra, le long de l'axe -z
+ * @return numéro de tranche entre 0 et m_SlicesCount-1
+ */
+int ClusteredLights::getSlice(float distance)
+{
+    if (m_SliceScale <= 0.0) return 0;
+    int slice = floor(log(std::max(distance, m_Near) / m_Near) * m_SliceScale);
+    return std::min(std::max(slice, 0), m_SlicesCount-1);
+}
+
+
+/**
+ * répartit les lampes dans les clusters et remplit les textures
+ * @param width : largeur du g-buffer
+ * @param height : hauteur du g-buffer
+ * @param mat4Projection : matrice de projection de la scène
+ */
+void ClusteredLights::buildClusters(int width, int height, mat4& mat4Projection)
+{
+    // découpage de l'écran en tuiles
+    m_TilesX = (width  + m_TileSize - 1) / m_TileSize;
+    m_TilesY = (height + m_TileSize - 1) / m_TileSize;
+    const int clusterscount = m_TilesX * m_TilesY * m_SlicesCount;
+
+    // plans near et far d'une projection perspective, sinon une seule tranche
+    float near = 0.0;
+    float far = 0.0;
+    bool perspective = mat4Projection[11] != 0.0;
+    if (perspective) {
+        near = mat4Projection[14] / (mat4Projection[10] - 1.0);
+        far  = mat4Projection[14] / (mat4Projection[10] + 1.0);
+        if (!(far > near) || far > near * 10000.0) far = near * 10000.0;
+        m_Near = near;
+        m_SliceScale = m_SlicesCount / log(far / near);
+    } else {
+        m_Near = 1.0;
+        m_SliceScale = 0.0;
+    }
+
+    // début et nombre de lampes de chaque cluster, données des lampes visibles
+    std::vector<GLint> ranges(clusterscount*2, 0);
+    std::vector<GLfloat> lightsdata;
+    std::vector<int> bounds;
+
+    for (OmniLight* light: m_OmniLights) {
+        // rectangle écran de la sphère d'influence de la lampe, ignorer la lampe si elle est hors champ
+        vec4 rect;
+        if (!light->getScreenBounds(mat4Projection, rect)) continue;
+        float xmin = rect[0], ymin = rect[1], xmax = rect[2], ymax = rect[3];
+
+        // distances à la caméra couvertes par la sphère d'influence de la lampe
+        vec4 center = light->getPositionCamera();
+        float range = light->getRange();
+        vec3 color = light->getColor();
+        float dmin = -center[2] - range;
+        float dmax = -center[2] + range;
+
+        // tuiles et tranches touchées par la lampe
+        int x0 = std::max(int(floor((xmin*0.5+0.5) * m_TilesX)), 0);
+        int x1 = std::min(int(floor((xmax*0.5+0.5) * m_TilesX)), m_TilesX-1);
+        int y0 = std::max(int(floor((ymin*0.5+0.5) * m_TilesY)), 0);
+        int y1 = std::min(int(floor((ymax*0.5+0.5) * m_TilesY)), m_TilesY-1);
+        int s0 = getSlice(dmin);
+        int s1 = getSlice(dmax);
+        int bound[] = { x0, x1, y0, y1, s0, s1 };
+        bounds.insert(bounds.end(), bound, bound+6);
+
+        // compter cette lampe dans chacun de ses clusters
+        for (int s=s0; s<=s1; s++) {
+            for (int y=y0; y<=y1; y++) {
+                for (int x=x0; x<=x1; x++) {
+                    ranges[((s*m_TilesY + y)*m_TilesX + x)*2 + 1]++;
+                }
+            }
+        }
+
+        // position caméra et portée, puis couleur
+        GLfloat data[] = { center[0], center[1], center[2], range, color[0], color[1], color[2], 0.0 };
+        lightsdata.insert(lightsdata.end(), data, data+8);
+    }
+
+    // début de la liste de chaque cluster dans le tableau des indices
+    m_AssignmentsCount = 0;
+    for (int c=0; c<clusterscount; c++) {
+        ranges[c*2 + 0] = m_AssignmentsCount;
+        m_AssignmentsCount += ranges[c*2 + 1];
+        ranges[c*2 + 1] = 0;
+    }
+
+    // remplir les listes des clusters avec les numéros des lampes
+    int indicesrows = std::max((m_AssignmentsCount + ROW_SIZE - 1) / ROW_SIZE, 1);
+    std::vector<GLint> indices(indicesrows * ROW_SIZE, 0);
+    int lightscount = lightsdata.size() / 8;
+    for (int l=0; l<lightscount; l++) {
+        int* bound = &bounds[l*6];
+        for (int s=bound[4]; s<=bound[5]; s++) {
+            for (int y=bound[2]; y<=bound[3]; y++) {
+                for (int x=bound[0]; x<=bound[1]; x++) {
+                    GLint* range = &ranges[((s*m_TilesY + y)*m_TilesX + x)*2];
+                    indices[range[0] + range[1]] = l;
+                    range[1]++;
+                }
+            }
+        }
+    }
+
+    // fournir les données aux textures, deux texels RGBA par lampe
+    int lightsrows = std::max((lightscount*2 + ROW_SIZE - 1) / ROW_SIZE, 1);
+    lightsdata.resize(lightsrows * ROW_SIZE * 4, 0.0);
+    GLState::bindTexture(GL_TEXTURE_2D, m_LightsTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, ROW_SIZE, lightsrows, 0, GL_RGBA, GL_FLOAT, &lightsdata[0]);
+    GLState::bindTexture(GL_TEXTURE_2D, m_ClustersTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32I, m_TilesX, m_TilesY*m_SlicesCount, 0, GL_RG_INTEGER, GL_INT, &ranges[0]);
+    GLState::bindTexture(GL_TEXTURE_2D, m_IndicesTextureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32I, ROW_SIZE, indicesrows, 0, GL_RED_INTEGER, GL_INT, &indices[0]);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+}
+
+
+/**
+ * construit le Fragment Shader qui calcule l'éclairement des lampes
+ * @return source du shader
+ */
+std::string ClusteredLights::getFragmentShader()
+{
+    std::ostringstream srcFragmentShader;
+    srcFragmentShader << "#version 300 es\n";
+    srcFragmentShader << "precision mediump float;\n";
+    srcFragmentShader << "in vec2 frgTexCoord;\n";
+    srcFragmentShader << "out vec4 glFragColor;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << GBuffer::getDecoderShader();
+    srcFragmentShader << "\n";
+    srcFragmentShader << "// lampes : position caméra et portée, puis couleur\n";
+    srcFragmentShader << "uniform highp sampler2D MapLights;\n";
+    srcFragmentShader << "// début et nombre de lampes de chaque cluster, numéros des lampes\n";
+    srcFragmentShader << "uniform highp isampler2D MapClusters;\n";
+    srcFragmentShader << "uniform highp isampler2D MapIndices;\n";
+    srcFragmentShader << "// nombre de tuiles en x et y, nombre de tranches\n";
+    srcFragmentShader << "uniform ivec3 ClustersCount;\n";
+    srcFragmentShader << "// distance near et facteur des tranches de profondeur\n";
+    srcFragmentShader << "uniform vec2 SliceParams;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "const int ROW_SIZE = " << ROW_SIZE << ";\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "void main()\n";
+    srcFragmentShader << "{\n";
+    srcFragmentShader << "    // récupérer les infos du g-buffer\n";
+    srcFragmentShader << "    vec4 position = readPosition(frgTexCoord);\n";
+    srcFragmentShader << "    if (position.w != 1.0) discard;\n";
+    srcFragmentShader << "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n";
+    srcFragmentShader << "    vec4 normal = readNormal(frgTexCoord);\n";
+    srcFragmentShader << "    vec4 Kd = readDiffuse(frgTexCoord);\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "    // cluster contenant le fragment\n";
+    srcFragmentShader << "    ivec2 tile = clamp(ivec2(frgTexCoord * vec2(ClustersCount.xy)), ivec2(0), ClustersCount.xy-1);\n";
+    srcFragmentShader << "    int slice = int(log(max(-position.z, SliceParams.x) / SliceParams.x) * SliceParams.y);\n";
+    srcFragmentShader << "    slice = clamp(slice, 0, ClustersCount.z-1);\n";
+    srcFragmentShader << "    ivec2 range = texelFetch(MapClusters, ivec2(tile.x, slice*ClustersCount.y + tile.y), 0).xy;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "    // couleur spéculaire et coefficient ns\n";
+    srcFragmentShader << "    vec3 N = normal.xyz;\n";
+    srcFragmentShader << "    vec4 Ks = readSpecular(frgTexCoord);\n";
+    srcFragmentShader << "    float ns = Ks.a;\n";
+    srcFragmentShader << "    vec3 R = reflect(normalize(position.xyz), N);\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "    // ajouter l'éclairement des lampes du cluster\n";
+    srcFragmentShader << "    vec3 sum = vec3(0.0);\n";
+    srcFragmentShader << "    for (int i=range.x; i<range.x+range.y; i++) {\n";
+    srcFragmentShader << "        int num = texelFetch(MapIndices, ivec2(i % ROW_SIZE, i / ROW_SIZE), 0).r;\n";
+    srcFragmentShader << "        vec4 LightPosition = texelFetch(MapLights, ivec2((num*2) % ROW_SIZE, (num*2) / ROW_SIZE), 0);\n";
+    srcFragmentShader << "        vec3 LightColor = texelFetch(MapLights, ivec2((num*2+1) % ROW_SIZE, (num*2+1) / ROW_SIZE), 0).rgb;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "        // ignorer la lampe si le fragment est hors de sa portée\n";
+    srcFragmentShader << "        vec3 L = LightPosition.xyz - position.xyz;\n";
+    srcFragmentShader << "        float distance = length(L);\n";
+    srcFragmentShader << "        if (distance >= LightPosition.w) continue;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "        if (normal.w != 0.0) {\n";
+    srcFragmentShader << "            // éclairement diffus uniquement\n";
+    srcFragmentShader << "            sum += LightColor * Kd.rgb;\n";
+    srcFragmentShader << "            continue;\n";
+    srcFragmentShader << "        }\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "        // intensité de la lampe, annulée à sa portée\n";
+    srcFragmentShader << "        float x = distance / LightPosition.w;\n";
+    srcFragmentShader << "        float window = clamp(1.0 - x*x*x*x, 0.0, 1.0);\n";
+    srcFragmentShader << "        vec3 color = LightColor * (window * window) / (distance*distance);\n";
+    srcFragmentShader << "        L = L / distance;\n";
+    srcFragmentShader << "\n";
+    srcFragmentShader << "        // éclairement diffus et reflet spéculaire\n";
+    srcFragmentShader << "        float dotNL = clamp(dot(N,L), 0.0, 1.0);\n";
+    srcFragmentShader << "        vec3 lighting = Kd.rgb*dotNL;\n";
+    srcFragmentShader << "        if (ns > 0.0) {\n";
+    srcFragmentShader << "            float dotRL = clamp(dot(R,L), 0.0, 1.0);\n";
+    srcFragmentShader << "            lighting += Ks.rgb*pow(dotRL, ns);\n";
+    srcFragmentShader << "        }\n";
+    srcFragmentShader << "        sum += color * lighting;\n";
+    srcFragmentShader << "    }\n";
+    srcFragmentShader << "    glFragColor = vec4(sum, 1.0) * Kd.a;\n";
+    srcFragmentShader << "}";
+    return srcFragmentShader.str();
+}
+
+
+/**
+ * détermine où sont les variables uniform spécifiques
+ */
+void ClusteredLights::findUniformLocations()
+{
+    // obtenir les emplacements de la superclasse
+    Light::findUniformLocations();
+
+    // emplacement des variables uniform du shader
+    m_MapLightsLoc     = glGetUniformLocation(m_ShaderId, "MapLights");
+    m_MapClustersLoc   = glGetUniformLocation(m_ShaderId, "MapClusters");
+    m_MapIndicesLoc    = glGetUniformLocation(m_ShaderId, "MapIndices");
+    m_ClustersCountLoc = glGetUniformLocation(m_ShaderId, "ClustersCount");
+    m_SliceParamsLoc   = glGetUniformLocation(m_ShaderId, "SliceParams");
+}
+
+
+/**
+ * applique l'éclairement des lampes fournies à setLights
+ * @param gbuffer : g-buffer contenant la scène, ce doit être un GBuffer afin de connaître la projection
+ */
+void ClusteredLights::process(FrameBufferObject* gbuffer)
+{
+    GBuffer* scene = dynamic_cast<GBuffer*>(gbuffer);
+    if (scene == nullptr) {
+        throw std::invalid_argument("ClusteredLights::process: gbuffer must be a GBuffer");
+    }
+
+    // répartir les lampes dans les clusters
+    buildClusters(gbuffer->getWidth(), gbuffer->getHeight(), scene->getProjection());
+
+    // dessiner l'éclairement en une seule passe
+    Light::process(gbuffer);
+}
+
+
+/**
+ * active le shader, les VBO et les textures pour appliquer l'éclairement
+ * @param gbuffer : FBO MRT contenant toutes les informations de la scène à éclairer
+ */
+void ClusteredLights::startProcess(FrameBufferObject* gbuffer)
+{
+    // appeler la méthode de la superclasse
+    Light::startProcess(gbuffer);
+
+    // fournir les lampes et les clusters
+    setTextureUnit(GL_TEXTURE5, m_MapLightsLoc,   m_LightsTextureId);
+    setTextureUnit(GL_TEXTURE6, m_MapClustersLoc, m_ClustersTextureId);
+    setTextureUnit(GL_TEXTURE7, m_MapIndicesLoc,  m_IndicesTextureId);
+    glUniform3i(m_ClustersCountLoc, m_TilesX, m_TilesY, m_SlicesCount);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    glUniform2f(m_SliceParamsLoc, m_Near, m_SliceScale);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+}
+
+
+/**
+ * désactive shader, VBO et textures
+ */
+void ClusteredLights::endProcess()
+{
+    // libérer les unités de texture
+    setTextureUnit(GL_TEXTURE5);
+    setTextureUnit(GL_TEXTURE6);
+    setTextureUnit(GL_TEXTURE7);
+
+    // appeler la méthode de la superclasse
+    Light::endProcess();
+}
@@ -0,0 +1,124 @@
+#ifndef MATERIAL_CLUSTEREDLIGHTS_H
+#define MATERIAL_CLUSTEREDLIGHTS_H
+
+/**
+ * Définition de la classe ClusteredLights : elle calcule en une seule passe l'éclairement
+ * d'un grand nombre de lampes OmniLight de portée limitée (clustered deferred shading).
+ *
+ * L'écran est découpé en tuiles, elles-mêmes découpées en tranches de profondeur
+ * (clusters). Pour chaque image, le CPU cherche quelles lampes touchent chaque cluster
+ * d'après leur position caméra et leur portée, puis fournit ces listes au shader dans
+ * des textures. Chaque fragment n'examine alors que les lampes de son cluster.
+ */
+
+#include <vector>
+
+#include <gl-matrix.h>
+#include <utils.h>
+
+#include <Light.h>
+#include <OmniLight.h>
+
+
+class ClusteredLights: public Light
+{
+public:
+
+    /**
+     * constructeur
+     * @param tilesize : taille en pixels du g-buffer des tuiles de l'écran
+     * @param slices : nombre de tranches de profondeur entre les plans near et far
+     */
+    ClusteredLights(int tilesize=64, int slices=16);
+
+    /**
+     * destructeur
+     */
+    virtual ~ClusteredLights();
+
+    /**
+     * définit les lampes à regrouper pour la prochaine passe d'éclairement
+     * NB : elles doivent être déjà transformées et isClusterable() doit être vrai
+     * @param lights : lampes à éclairer
+     */
+    void setLights(const std::vector<OmniLight*>& lights);
+
+    /**
+     * applique l'éclairement des lampes fournies à setLights
+     * @param gbuffer : g-buffer contenant la scène, ce doit être un GBuffer afin de connaître la projection
+     */
+    virtual void process(FrameBufferObject* gbuffer);
+
+    /**
+     * retourne le nombre de couples (lampe, cluster) de la dernière passe, c'est
+     * le nombre de lampes que les fragments ont examinées, à un facteur près
+     * @return nombre d'affectations de lampes à des clusters
+     */
+    int getAssignmentsCount();
+
+    /// nombre de texels par ligne des textures des lampes et des indices
+    static const int ROW_SIZE = 1024;
+
+
+protected:
+
+    /** construit le Fragment Shader qui calcule l'éclairement des lampes */
+    virtual std::string getFragmentShader();
+
+    /** détermine où sont les variables uniform spécifiques */
+    virtual void findUniformLocations();
+
+    /** active le shader, les VBO et les textures pour appliquer l'éclairement */
+    virtual void startProcess(FrameBufferObject* gbuffer);
+
+    /** désactive shader, VBO et textures */
+    virtual void endProcess();
+
+    /**
+     * répartit les lampes dans les clusters et remplit les textures
+     * @param width : largeur du g-buffer
+     * @param height : hauteur du g-buffer
+     * @param mat4Projection : matrice de projection de la scène
+     */
+    void buildClusters(int width, int height, mat4& mat4Projection);
+
+    /**
+     * retourne la tranche de profondeur d'une distance à la caméra
+     * @param distance : distance à la caméra, le long de l'axe -z
+     * @return numéro de tranche entre 0 et m_SlicesCount-1
+     */
+    int getSlice(float distance);
+
+
+protected:
+
+    /// lampes à éclairer
+    std::vector<OmniLight*> m_OmniLights;
+
+    /// découpage de l'écran
+    int m_TileSize;
+    int m_SlicesCount;
+    int m_TilesX;
+    int m_TilesY;
+
+    /// paramètres des tranches : distance near et 1/log(far/near) multiplié par le nombre de tranches
+    float m_Near;
+    float m_SliceScale;
+
+    /// nombre d'affectations de lampes à des clusters
+    int m_AssignmentsCount;
+
+    /// textures : données des lampes, début et nombre de lampes par cluster, numéros des lampes
+    GLuint m_LightsTextureId;
+    GLuint m_ClustersTextureId;
+    GLuint m_IndicesTextureId;
+
+    /// emplacement des uniform
+    GLint m_MapLightsLoc;
+    GLint m_MapClustersLoc;
+    GLint m_MapIndicesLoc;
+    GLint m_ClustersCountLoc;
+    GLint m_SliceParamsLoc;
+};
+
+#endif
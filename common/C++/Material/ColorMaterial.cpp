@@ -10,6 +10,7 @@
 #include <utils.h>
 #include <ColorMaterial.h>
 #include <VBOset.h>
+#include <GBuffer.h>
 
 /**
  * constructeur pour une couleur aléatoire
@@ -45,6 +46,35 @@ ColorMaterial::~ColorMaterial()
 }
 
 
+/**
+ * recompile le shader du matériau
+ */
+void ColorMaterial::compileShader()
+{
+    // appeler la méthode de la superclasse
+    Material::compileShader();
+
+    // déterminer où sont les variables uniform spécifiques
+    m_ColorLoc = glGetUniformLocation(m_ShaderId, "Color");
+}
+
+
+/**
+ * Cette méthode active le matériau : met en place son shader,
+ * fournit les variables uniform qu'il demande
+ * @param mat4Projection : mat4 contenant la projection
+ * @param mat4ModelView : mat4 contenant la transformation vers la caméra
+ */
+void ColorMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
+{
+    // appeler la méthode de la superclasse
+    Material::enable(mat4Projection, mat4ModelView);
+
+    // fournir la couleur du matériau
+    vec4::glUniform(m_ColorLoc, m_Color);
+}
+
+
 /**
  * retourne le source du Vertex Shader
  */
@@ -90,9 +120,10 @@ std::string ColorMaterial::getFragmentShader()
         srcFragmentShader << "uniform vec4 ClipPlane;\n";
     }
     srcFragmentShader << "\n";
+    srcFragmentShader << "uniform vec4 Color;\n";
     srcFragmentShader << "in vec4 frgPosition;\n";
     srcFragmentShader << "in vec3 frgNormal;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "\n";
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
@@ -101,10 +132,7 @@ std::string ColorMaterial::getFragmentShader()
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
         srcFragmentShader << "\n";
     }
-    srcFragmentShader << "    glFragData[0] = "<<vec4::str(m_Color)<<";\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(frgNormal, 0.0);\n";
+    srcFragmentShader << "    writeGBuffer(Color, vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(frgNormal, 0.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
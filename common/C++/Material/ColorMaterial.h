@@ -40,9 +40,19 @@ public:
      */
     virtual VBOset* createVBOset();
 
+    /**
+     * Cette méthode active le matériau
+     * @param mat4Projection : fournir la matrice de projection
+     * @param mat4ModelView : fournir la matrice de vue
+     */
+    virtual void enable(mat4 mat4Projection, mat4 mat4ModelView);
+
 
 protected:
 
+    /** recompile le shader du matériau */
+    virtual void compileShader();
+
     virtual std::string getVertexShader();
     virtual std::string getFragmentShader();
 
@@ -51,6 +61,9 @@ protected:
 
     vec4 m_Color;
 
+    /** emplacement de la couleur dans le shader, c'est un uniform pour que tous les matériaux partagent le shader */
+    GLint m_ColorLoc;
+
 };
 
 #endif
@@ -11,6 +11,12 @@
 #include <utils.h>
 #include <DeferredShadingMaterial.h>
 #include <VBOset.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+
+
+bool DeferredShadingMaterial::m_CompactAttributes = false;
+
 
 /**
  * initialisations communes à tous les constructeurs
@@ -27,6 +33,11 @@ void DeferredShadingMaterial::init()
     m_TxDiffuseLoc = -1;
     m_TxSpecular = nullptr;
     m_TxSpecularLoc = -1;
+
+    // les couleurs sont des uniform afin que les matériaux ayant les mêmes options partagent leur shader
+    m_KdLoc = -1;
+    m_KsLoc = -1;
+    m_NsLoc = -1;
 }
 
 
@@ -140,6 +151,7 @@ std::string DeferredShadingMaterial::getVertexShader()
     srcVertexShader << "// attributs de sommets\n";
     srcVertexShader << "in vec3 glVertex;\n";
     srcVertexShader << "in vec3 glNormal;\n";
+    srcVertexShader << getInstancingShader();
     srcVertexShader << "\n";
     srcVertexShader << "// interpolation vers les fragments\n";
     srcVertexShader << "out vec4 frgPosition;\n";
@@ -162,9 +174,9 @@ std::string DeferredShadingMaterial::getVertexShader()
     srcVertexShader << "\n";
     srcVertexShader << "void main()\n";
     srcVertexShader << "{\n";
-    srcVertexShader << "    frgPosition = mat4ModelView * vec4(glVertex, 1.0);\n";
+    srcVertexShader << "    frgPosition = " << getModelViewShader() << " * vec4(glVertex, 1.0);\n";
     srcVertexShader << "    gl_Position = mat4Projection * frgPosition;\n";
-    srcVertexShader << "    frgNormal = mat3Normal * glNormal;\n";
+    srcVertexShader << "    frgNormal = " << getNormalMatrixShader() << " * glNormal;\n";
     if (m_KdIsInterpolated) {
         // interpoler la couleur diffuse
         srcVertexShader << "    frgColor = glColor;\n";
@@ -197,7 +209,7 @@ std::string DeferredShadingMaterial::getFragmentShader()
         // coordonnées de texture interpolées
         srcFragmentShader << "in vec2 frgTexCoord;\n";
     }
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
 
     srcFragmentShader << "\n";
     srcFragmentShader << "// caractéristiques du matériau\n";
@@ -208,7 +220,7 @@ std::string DeferredShadingMaterial::getFragmentShader()
     } else if (m_KdIsInterpolated) {
         srcFragmentShader << "in vec4 frgColor;\n";
     } else {
-        srcFragmentShader << "const vec4 Kd = "<<vec4::str(m_Kd)<<";\n";
+        srcFragmentShader << "uniform vec4 Kd;\n";
     }
 
     // couleur ou texture spéculaire
@@ -216,9 +228,9 @@ std::string DeferredShadingMaterial::getFragmentShader()
         if (m_TxSpecular != nullptr) {
             srcFragmentShader << "uniform sampler2D txSpecular;\n";
         } else {
-            srcFragmentShader << "const vec3 Ks = "<<vec3::str(m_Ks)<<";\n";
+            srcFragmentShader << "uniform vec3 Ks;\n";
         }
-        srcFragmentShader << "const float Ns = "<<m_Ns<<";\n";
+        srcFragmentShader << "uniform float Ns;\n";
     }
 
     // plan de coupe
@@ -251,14 +263,11 @@ std::string DeferredShadingMaterial::getFragmentShader()
 
     // remplir les buffers MRT avec les informations nécessaires pour Phong plus tard
     srcFragmentShader << "    // remplir les buffers avec les informations\n";
-    srcFragmentShader << "    glFragData[0] = Kd;\n";
     if (m_Ns >= 0.0) {
-        srcFragmentShader << "    glFragData[1] = vec4(Ks, Ns);\n";
+        srcFragmentShader << "    writeGBuffer(Kd, vec4(Ks, Ns), vec4(frgPosition.xyz, 1.0), vec4(normalize(frgNormal), 0.0));\n";
     } else {
-        srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
+        srcFragmentShader << "    writeGBuffer(Kd, vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(normalize(frgNormal), 0.0));\n";
     }
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(normalize(frgNormal), 0.0);\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
@@ -275,6 +284,9 @@ void DeferredShadingMaterial::compileShader()
     // déterminer où sont les variables uniform spécifiques
     m_TxDiffuseLoc  = glGetUniformLocation(m_ShaderId, "txDiffuse");
     m_TxSpecularLoc = glGetUniformLocation(m_ShaderId, "txSpecular");
+    m_KdLoc = glGetUniformLocation(m_ShaderId, "Kd");
+    m_KsLoc = glGetUniformLocation(m_ShaderId, "Ks");
+    m_NsLoc = glGetUniformLocation(m_ShaderId, "Ns");
 }
 
 
@@ -286,9 +298,17 @@ VBOset* DeferredShadingMaterial::createVBOset()
 {
     // créer le VBOset et spécifier les noms des attribute nécessaires à ce matériau
     VBOset* vboset = Material::createVBOset();
-    vboset->addAttribute(MeshVertex::ID_ATTR_COLOR,    Utils::VEC4, "glColor");
-    vboset->addAttribute(MeshVertex::ID_ATTR_NORMAL,   Utils::VEC3, "glNormal");
-    vboset->addAttribute(MeshVertex::ID_ATTR_TEXCOORD, Utils::VEC2, "glTexCoord");
+    if (m_CompactAttributes) {
+        // couleur sur 4 octets, normale normalisée par le shader sur 10 bits par
+        // composante, coordonnées de texture en demi-float car elles peuvent dépasser 1
+        vboset->addAttribute(MeshVertex::ID_ATTR_COLOR,    Utils::VEC4, "glColor",    VBOvar::FORMAT_UBYTE);
+        vboset->addAttribute(MeshVertex::ID_ATTR_NORMAL,   Utils::VEC3, "glNormal",   VBOvar::FORMAT_INT_2_10_10_10);
+        vboset->addAttribute(MeshVertex::ID_ATTR_TEXCOORD, Utils::VEC2, "glTexCoord", VBOvar::FORMAT_HALF);
+    } else {
+        vboset->addAttribute(MeshVertex::ID_ATTR_COLOR,    Utils::VEC4, "glColor");
+        vboset->addAttribute(MeshVertex::ID_ATTR_NORMAL,   Utils::VEC3, "glNormal");
+        vboset->addAttribute(MeshVertex::ID_ATTR_TEXCOORD, Utils::VEC2, "glTexCoord");
+    }
     return vboset;
 }
 
@@ -304,6 +324,14 @@ void DeferredShadingMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
     // appeler la méthode de la superclasse
     Material::enable(mat4Projection, mat4ModelView);
 
+    // fournir les couleurs du matériau
+    if (m_KdLoc >= 0) vec4::glUniform(m_KdLoc, m_Kd);
+    if (m_KsLoc >= 0) vec3::glUniform(m_KsLoc, m_Ks);
+    if (m_NsLoc >= 0) {
+        glUniform1f(m_NsLoc, m_Ns);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
+
     // prochaine unité de texture à utiliser
     GLenum unit = GL_TEXTURE0;
 
@@ -345,3 +373,35 @@ void DeferredShadingMaterial::disable()
     // appeler la méthode de la superclasse
     Material::disable();
 }
+
+
+/**
+ * retourne l'identifiant de la texture diffuse du matériau
+ * @return identifiant OpenGL de la texture, 0 s'il n'y en a pas
+ */
+GLuint DeferredShadingMaterial::getTextureId()
+{
+    if (m_TxDiffuse == nullptr) return 0;
+    return m_TxDiffuse->m_TextureID;
+}
+
+
+/**
+ * indique si le matériau est transparent
+ * @return true si le canal alpha de Kd est inférieur à 1
+ */
+bool DeferredShadingMaterial::isTransparent()
+{
+    return !m_KdIsInterpolated && m_Kd[3] < 1.0;
+}
+
+
+/**
+ * choisit le format des attributs des VBOsets créés ensuite par ces matériaux
+ * @param compact : true pour des couleurs RGBA8, des normales 10-10-10-2 et des coordonnées
+ * de texture en demi-float, 24 octets par sommet au lieu de 48 ; false (par défaut) pour des float
+ */
+void DeferredShadingMaterial::setCompactAttributes(bool compact)
+{
+    m_CompactAttributes = compact;
+}
@@ -67,6 +67,28 @@ public:
      */
     virtual void disable();
 
+    /**
+     * retourne l'identifiant de la texture diffuse du matériau, voir RenderQueue
+     * @return identifiant OpenGL de la texture, 0 s'il n'y en a pas
+     */
+    virtual GLuint getTextureId();
+
+    /**
+     * indique si le matériau est transparent, c'est à dire si le canal alpha
+     * de Kd (paramètre d du fichier MTL) est inférieur à 1
+     * @return true si le matériau est transparent
+     */
+    virtual bool isTransparent();
+
+    /**
+     * choisit le format des attributs des VBOsets créés ensuite par ces matériaux :
+     * - false (par défaut) : tous les attributs en float
+     * - true : couleurs RGBA8, normales 10-10-10-2 et coordonnées de texture en demi-float,
+     *   précises au millième tant qu'elles restent inférieures à 2
+     * @param compact : true pour les formats compacts
+     */
+    static void setCompactAttributes(bool compact);
+
 
 protected:
 
@@ -95,6 +117,12 @@ protected:
     /** identifiants liés au shader */
     GLint m_TxDiffuseLoc;
     GLint m_TxSpecularLoc;
+    GLint m_KdLoc;
+    GLint m_KsLoc;
+    GLint m_NsLoc;
+
+    /// format des attributs des VBOsets créés, voir setCompactAttributes
+    static bool m_CompactAttributes;
 };
 
 #endif
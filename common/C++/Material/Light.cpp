@@ -7,10 +7,16 @@
 
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <math.h>
 
 #include <gl-matrix.h>
 #include <utils.h>
 #include <Light.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -107,26 +113,23 @@ void Light::onDraw(mat4& mat4Projection, mat4& mat4View)
  */
 std::string Light::getFragmentShader()
 {
-    const char* srcFragmentShader =
+    return
         "#version 300 es\n"
         "precision mediump float;\n"
         "in vec2 frgTexCoord;\n"
         "out vec4 glFragColor;\n"
         "\n"
-        "uniform sampler2D MapDiffuse;\n"
-        "uniform sampler2D MapPosition;\n"
-        "uniform sampler2D MapDepth;\n"
+        + GBuffer::getDecoderShader() +
         "uniform vec3 LightColor;\n"
         "\n"
         "void main()\n"
         "{\n"
-        "    vec4 position = texture(MapPosition, frgTexCoord);\n"
+        "    vec4 position = readPosition(frgTexCoord);\n"
         "    if (position.w != 1.0) discard;\n"
         "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n"
-        "    vec4 color = texture(MapDiffuse, frgTexCoord);\n"
+        "    vec4 color = readDiffuse(frgTexCoord);\n"
         "    glFragColor = vec4(color.rgb * LightColor, 1.0) * color.a;\n"
         "}";
-    return srcFragmentShader;
 }
 
 
@@ -145,6 +148,9 @@ void Light::findUniformLocations()
     m_MapNormalLoc  = glGetUniformLocation(m_ShaderId, "MapNormale");
     m_MapDepthLoc    = glGetUniformLocation(m_ShaderId, "MapDepth");
 
+    // matrice pour retrouver la position à partir de la profondeur (g-buffer compact)
+    m_InvProjectionLoc = glGetUniformLocation(m_ShaderId, "mat4InvProjection");
+
     // emplacement de la couleur de la lampe
     m_LightColorLoc = glGetUniformLocation(m_ShaderId, "LightColor");
 }
@@ -163,33 +169,91 @@ void Light::startProcess(FrameBufferObject* gbuffer)
     vec3::glUniform(m_LightColorLoc, m_Color);
 
     // fournir les buffers du FBO MRT
-    setTextureUnit(GL_TEXTURE0, m_MapDiffuseLoc,  gbuffer->getColorBuffer(0));
-    setTextureUnit(GL_TEXTURE1, m_MapSpecularLoc, gbuffer->getColorBuffer(1));
-    setTextureUnit(GL_TEXTURE2, m_MapPositionLoc, gbuffer->getColorBuffer(2));
-    setTextureUnit(GL_TEXTURE3, m_MapNormalLoc,  gbuffer->getColorBuffer(3));
+    if (GBuffer::getLayout() == GBuffer::LAYOUT_COMPACT) {
+        // g-buffer compact : pas de buffer de position, elle est recalculée avec la profondeur
+        GBuffer* compact = dynamic_cast<GBuffer*>(gbuffer);
+        if (compact == nullptr || compact->getBufferLayout() != GBuffer::LAYOUT_COMPACT) {
+            throw std::invalid_argument("Light: shader expects a GBuffer with LAYOUT_COMPACT");
+        }
+        setTextureUnit(GL_TEXTURE0, m_MapDiffuseLoc,  gbuffer->getColorBuffer(GBuffer::COMPACT_DIFFUSE));
+        setTextureUnit(GL_TEXTURE1, m_MapSpecularLoc, gbuffer->getColorBuffer(GBuffer::COMPACT_SPECULAR));
+        setTextureUnit(GL_TEXTURE3, m_MapNormalLoc,  gbuffer->getColorBuffer(GBuffer::COMPACT_NORMAL));
+        mat4::glUniformMatrix(m_InvProjectionLoc, compact->getInverseProjection());
+    } else {
+        setTextureUnit(GL_TEXTURE0, m_MapDiffuseLoc,  gbuffer->getColorBuffer(0));
+        setTextureUnit(GL_TEXTURE1, m_MapSpecularLoc, gbuffer->getColorBuffer(1));
+        setTextureUnit(GL_TEXTURE2, m_MapPositionLoc, gbuffer->getColorBuffer(2));
+        setTextureUnit(GL_TEXTURE3, m_MapNormalLoc,  gbuffer->getColorBuffer(3));
+    }
     setTextureUnit(GL_TEXTURE4, m_MapDepthLoc,    gbuffer->getDepthBuffer());
 }
 
 
+/**
+ * calcule le rectangle de l'écran où cette lampe peut contribuer à l'éclairement
+ * @param mat4Projection : matrice de projection de la scène
+ * @param bounds : reçoit xmin, ymin, xmax, ymax en coordonnées normalisées [-1,+1]
+ * @return false si la lampe n'éclaire rien de ce qui est visible
+ */
+bool Light::getScreenBounds(mat4& mat4Projection, vec4& bounds)
+{
+    vec4::set(bounds, -1.0, -1.0, +1.0, +1.0);
+    return true;
+}
+
+
 /**
  * applique l'éclairement défini par cette lampe
+ * NB : lorsque l'éclairement s'ajoute à celui des lampes précédentes (blending actif)
+ * et que gbuffer est un GBuffer, le dessin est limité par un scissor au rectangle
+ * d'influence de la lampe, et il n'a pas lieu si la lampe n'éclaire rien de visible.
+ * La première lampe dessine toujours tout l'écran car elle l'initialise.
  * @param gbuffer : FBO MRT contenant toutes les informations de la scène à éclairer
  */
 void Light::process(FrameBufferObject* gbuffer)
 {
+    PROFILE_ZONE("Light::process");
+
+    // rectangle d'influence de la lampe, s'il est utile de le connaître
+    vec4 bounds = vec4::fromValues(-1.0, -1.0, +1.0, +1.0);
+    GBuffer* scene = dynamic_cast<GBuffer*>(gbuffer);
+    if (scene != nullptr && GLState::isEnabled(GL_BLEND)) {
+        if (!getScreenBounds(scene->getProjection(), bounds)) return;
+    }
+
+    // limiter le dessin aux pixels de la zone d'influence
+    bool scissor = bounds[0] > -1.0 || bounds[1] > -1.0 || bounds[2] < +1.0 || bounds[3] < +1.0;
+    bool scissor_test = GLState::isEnabled(GL_SCISSOR_TEST);
+    GLint scissor_box[4];
+    if (scissor) {
+        GLint viewport[4];
+        GLState::getViewport(viewport);
+        GLState::getScissor(scissor_box);
+        int x0 = floor((std::max(bounds[0], -1.0f)*0.5 + 0.5) * viewport[2]);
+        int y0 = floor((std::max(bounds[1], -1.0f)*0.5 + 0.5) * viewport[3]);
+        int x1 = ceil ((std::min(bounds[2], +1.0f)*0.5 + 0.5) * viewport[2]);
+        int y1 = ceil ((std::min(bounds[3], +1.0f)*0.5 + 0.5) * viewport[3]);
+        GLState::enable(GL_SCISSOR_TEST);
+        GLState::scissor(viewport[0] + x0, viewport[1] + y0, x1 - x0, y1 - y0);
+    }
+
     // préparer le shader pour le traitement
     startProcess(gbuffer);
 
     // mettre le depth test en mode <=
-    GLint depth_func;
-    glGetIntegerv(GL_DEPTH_FUNC, &depth_func);
-    glDepthFunc(GL_LEQUAL);
+    GLenum depth_func = GLState::getDepthFunc();
+    GLState::depthFunc(GL_LEQUAL);
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // remettre comme c'était
-    glDepthFunc(depth_func);
+    GLState::depthFunc(depth_func);
+    if (scissor) {
+        GLState::scissor(scissor_box[0], scissor_box[1], scissor_box[2], scissor_box[3]);
+        if (!scissor_test) GLState::disable(GL_SCISSOR_TEST);
+    }
 
     // libérer les ressources
     endProcess();
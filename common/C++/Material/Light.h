@@ -58,6 +58,15 @@ public:
      */
     vec3 getColor();
 
+    /**
+     * calcule le rectangle de l'écran où cette lampe peut contribuer à l'éclairement
+     * NB: une lampe générique éclaire tout l'écran
+     * @param mat4Projection : matrice de projection de la scène
+     * @param bounds : reçoit xmin, ymin, xmax, ymax en coordonnées normalisées [-1,+1]
+     * @return false si la lampe n'éclaire rien de ce qui est visible
+     */
+    virtual bool getScreenBounds(mat4& mat4Projection, vec4& bounds);
+
     /**
      * applique l'éclairement défini par cette lampe
      * @param gbuffer : FBO MRT contenant toutes les informations de la scène à éclairer
@@ -101,6 +110,7 @@ protected:
     GLint m_MapDiffuseLoc;
     GLint m_MapSpecularLoc;
     GLint m_MapDepthLoc;
+    GLint m_InvProjectionLoc;
     GLint m_LightColorLoc;
 };
 
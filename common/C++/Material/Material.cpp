@@ -18,6 +18,16 @@
 #include <VBOset.h>
 #include <Material.h>
 #include <DeferredShadingMaterial.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
+
+
+// programmes de shaders partagés et statistiques
+std::map<std::string, Material::SharedProgram> Material::m_ProgramCache;
+int Material::m_ProgramsCompiled = 0;
+int Material::m_ProgramsShared = 0;
+double Material::m_CompileTime = 0.0;
 
 
 /**
@@ -46,6 +56,9 @@ Material::Material(std::string nom)
     m_ClipPlane = vec4::fromValues(0,0,1,1e38);
     m_ClipPlaneLoc = -1;
 
+    // pas d'instances par défaut
+    m_InstancedOn = false;
+
     // note : ce constructeur ne compile pas le shader, c'est aux sous-classes de le faire
 }
 
@@ -53,8 +66,8 @@ Material::Material(std::string nom)
 /** destructeur */
 Material::~Material()
 {
-    // supprimer le shader
-    if (m_ShaderId > 0) Utils::deleteShaderProgram(m_ShaderId);
+    // libérer le shader
+    releaseShader();
 }
 
 
@@ -78,23 +91,44 @@ GLint Material::getShaderId()
 }
 
 
+/**
+ * retourne l'identifiant de la texture principale du matériau
+ * @return identifiant OpenGL de la texture, 0 s'il n'y en a pas
+ */
+GLuint Material::getTextureId()
+{
+    return 0;
+}
+
+
+/**
+ * indique si le matériau est transparent
+ * @return true si le matériau est transparent
+ */
+bool Material::isTransparent()
+{
+    return false;
+}
+
+
 /**
  * retourne le source du Vertex Shader
  */
 std::string Material::getVertexShader()
 {
-    const char* srcVertexShader =
-        "#version 300 es\n"
-        "in vec3 glVertex;\n"
-        "uniform mat4 mat4Projection;\n"
-        "uniform mat4 mat4ModelView;\n"
-        "out vec4 frgPosition;\n"
-        "void main()\n"
-        "{\n"
-        "    frgPosition = mat4ModelView * vec4(glVertex, 1.0);\n"
-        "    gl_Position = mat4Projection * frgPosition;\n"
-        "}";
-    return srcVertexShader;
+    std::ostringstream srcVertexShader;
+    srcVertexShader << "#version 300 es\n";
+    srcVertexShader << "in vec3 glVertex;\n";
+    srcVertexShader << getInstancingShader();
+    srcVertexShader << "uniform mat4 mat4Projection;\n";
+    srcVertexShader << "uniform mat4 mat4ModelView;\n";
+    srcVertexShader << "out vec4 frgPosition;\n";
+    srcVertexShader << "void main()\n";
+    srcVertexShader << "{\n";
+    srcVertexShader << "    frgPosition = " << getModelViewShader() << " * vec4(glVertex, 1.0);\n";
+    srcVertexShader << "    gl_Position = mat4Projection * frgPosition;\n";
+    srcVertexShader << "}";
+    return srcVertexShader.str();
 }
 
 
@@ -113,7 +147,7 @@ std::string Material::getFragmentShader()
     }
     srcFragmentShader << "\n";
     srcFragmentShader << "in vec4 frgPosition;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "\n";
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
@@ -122,10 +156,7 @@ std::string Material::getFragmentShader()
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
         srcFragmentShader << "\n";
     }
-    srcFragmentShader << "    glFragData[0] = vec4(1.0, 0.0, 1.0, 1.0);\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(1.0, 1.0, 1.0, 1.0);\n";
+    srcFragmentShader << "    writeGBuffer(vec4(1.0, 0.0, 1.0, 1.0), vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(1.0, 1.0, 1.0, 1.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
@@ -136,17 +167,36 @@ std::string Material::getFragmentShader()
  */
 void Material::compileShader()
 {
-    // supprimer l'ancien shader s'il y en avait un
-    if (m_ShaderId > 0) Utils::deleteShaderProgram(m_ShaderId);
-
     // construire le vertex shader
     std::string srcVertexShader = getVertexShader();
 
     // construire le fragment shader
     std::string srcFragmentShader = getFragmentShader();
 
-    // compiler et lier les shaders
-    m_ShaderId = Utils::makeShaderProgram(srcVertexShader, srcFragmentShader, m_Name);
+    // rien à faire si le shader actuel a les mêmes sources
+    std::string key = srcVertexShader + '\0' + srcFragmentShader;
+    if (m_ShaderId > 0 && key == m_ShaderKey) return;
+
+    // chercher un programme ayant les mêmes sources, sinon compiler et lier les shaders
+    GLint program;
+    auto it = m_ProgramCache.find(key);
+    if (it != m_ProgramCache.end()) {
+        program = it->second.id;
+        it->second.users++;
+        m_ProgramsShared++;
+    } else {
+        double start = Utils::getAbsoluteTime();
+        program = Utils::makeShaderProgram(srcVertexShader, srcFragmentShader, m_Name);
+        m_CompileTime += Utils::getAbsoluteTime() - start;
+        m_ProgramsCompiled++;
+        SharedProgram shared = { program, 1 };
+        m_ProgramCache[key] = shared;
+    }
+
+    // libérer l'ancien shader s'il y en avait un
+    releaseShader();
+    m_ShaderId = program;
+    m_ShaderKey = key;
 
     // déterminer où sont les variables uniform
     m_MatPloc      = glGetUniformLocation(m_ShaderId, "mat4Projection");
@@ -169,6 +219,33 @@ VBOset* Material::createVBOset()
 }
 
 
+/**
+ * libère le shader du matériau, il n'est supprimé que si aucun autre matériau ne l'emploie
+ */
+void Material::releaseShader()
+{
+    if (m_ShaderId <= 0) return;
+    auto it = m_ProgramCache.find(m_ShaderKey);
+    if (it != m_ProgramCache.end() && --it->second.users <= 0) {
+        Utils::deleteShaderProgram(it->second.id);
+        m_ProgramCache.erase(it);
+    }
+    m_ShaderId = 0;
+    m_ShaderKey.clear();
+}
+
+
+/**
+ * affiche le nombre de programmes de shaders compilés et partagés par les matériaux,
+ * ainsi que la durée totale des compilations
+ */
+void Material::printShaderStats()
+{
+    std::cout << "Materials: " << m_ProgramsCompiled << " shader programs compiled in " << int(m_CompileTime*1000.0) << " ms, ";
+    std::cout << m_ProgramsShared << " times shared, " << m_ProgramCache.size() << " in use" << std::endl;
+}
+
+
 /**
  * Cette méthode active le matériau : met en place son shader,
  * fournit les variables uniform qu'il demande
@@ -177,11 +254,29 @@ VBOset* Material::createVBOset()
  */
 void Material::enable(mat4 mat4Projection, mat4 mat4ModelView)
 {
+    PROFILE_ZONE("Material::enable");
+
     // activer le shader
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
 
-    // fournir les matrices MV et P
+    // fournir les matrices P, MV et normale
     mat4::glUniformMatrix(m_MatPloc, mat4Projection);
+    setModelView(mat4ModelView);
+
+    // si le plan de coupe est actif, alors le fournir
+    if (m_ClipPlaneOn && m_ClipPlaneLoc >= 0) {
+        vec4::glUniform(m_ClipPlaneLoc, m_ClipPlane);
+    }
+}
+
+
+/**
+ * Cette méthode fournit seulement la matrice ModelView et la matrice normale au
+ * matériau déjà activé par enable, pour dessiner un autre objet avec le même
+ * @param mat4ModelView : fournir la matrice de vue
+ */
+void Material::setModelView(mat4 mat4ModelView)
+{
     mat4::glUniformMatrix(m_MatMVloc, mat4ModelView);
 
     // calculer et fournir la matrice normale au shader
@@ -191,11 +286,6 @@ void Material::enable(mat4 mat4Projection, mat4 mat4ModelView)
         mat3::invert(m_Mat3Normal, m_Mat3Normal);
         mat3::glUniformMatrix(m_MatNloc, m_Mat3Normal);
     }
-
-    // si le plan de coupe est actif, alors le fournir
-    if (m_ClipPlaneOn && m_ClipPlaneLoc >= 0) {
-        vec4::glUniform(m_ClipPlaneLoc, m_ClipPlane);
-    }
 }
 
 
@@ -205,8 +295,8 @@ void Material::enable(mat4 mat4Projection, mat4 mat4ModelView)
  */
 void Material::disable()
 {
-    // désactiver le shader
-    glUseProgram(0);
+    // le shader reste actif : GLState évitera de le réactiver si le
+    // prochain matériau dessiné emploie le même, ce qui est fréquent
 }
 
 
@@ -258,6 +348,67 @@ void Material::resetClipPlane()
 }
 
 
+/**
+ * rend le matériau capable de dessiner des instances, voir VBOset::onDrawInstanced
+ * NB : les VBOsets déjà créés pour ce matériau doivent ensuite appeler updateLocations()
+ * @param active : true s'il faut compiler un shader gérant les instances
+ */
+void Material::setInstanced(bool active)
+{
+    bool recompile = (active != m_InstancedOn);
+    m_InstancedOn = active;
+    if (recompile) compileShader();
+}
+
+
+/**
+ * indique si le shader du matériau gère les instances
+ * @return true si setInstanced(true) a été appelée
+ */
+bool Material::isInstanced()
+{
+    return m_InstancedOn;
+}
+
+
+/**
+ * retourne les déclarations du vertex shader pour les instances : la matrice de
+ * chaque instance est une variable attribute qui change à chaque instance, voir VBOset
+ * @return source GLSL, vide si le matériau n'est pas instancié
+ */
+std::string Material::getInstancingShader()
+{
+    if (!m_InstancedOn) return "";
+    return
+        "\n"
+        "// matrice de l'instance, appliquée avant mat4ModelView\n"
+        "in mat4 glInstanceMatrix;\n";
+}
+
+
+/**
+ * retourne l'expression GLSL de la matrice ModelView d'un sommet
+ * @return mat4ModelView, multipliée par la matrice de l'instance si le matériau est instancié
+ */
+std::string Material::getModelViewShader()
+{
+    if (!m_InstancedOn) return "mat4ModelView";
+    return "(mat4ModelView * glInstanceMatrix)";
+}
+
+
+/**
+ * retourne l'expression GLSL de la matrice normale d'un sommet, c'est à dire la transposée
+ * de l'inverse de la matrice ModelView ; celle de l'instance est calculée dans le shader
+ * @return mat3Normal, multipliée par la matrice normale de l'instance si le matériau est instancié
+ */
+std::string Material::getNormalMatrixShader()
+{
+    if (!m_InstancedOn) return "mat3Normal";
+    return "(mat3Normal * transpose(inverse(mat3(glInstanceMatrix))))";
+}
+
+
 /**
  * Cette méthode crée une collection de DeferredShadingMaterial lue d'un fichier MTL pour un fichier OBJ.
  * NB : le chargement du fichier est fait en asynchrone, par une requête HTTP sur le serveur
@@ -345,6 +496,10 @@ std::map<std::string, Material*> Material::loadMTL(std::string folder, std::stri
     }
 
     // repasser sur tous les matériaux et les créer effectivement
+    double start = Utils::getAbsoluteTime();
+    int compiled = m_ProgramsCompiled;
+    int shared = m_ProgramsShared;
+    double compile_time = m_CompileTime;
     std::map<std::string, Material*> materials;
     for (auto const& it: mat_descriptions) {
         std::string mat_name = it.first;
@@ -356,6 +511,11 @@ std::map<std::string, Material*> Material::loadMTL(std::string folder, std::stri
         }
     }
 
+    // statistiques sur la création des matériaux et de leurs shaders
+    std::cout << mtlfilename << ": " << materials.size() << " materials created in " << int((Utils::getAbsoluteTime()-start)*1000.0) << " ms, ";
+    std::cout << (m_ProgramsCompiled-compiled) << " shader programs compiled in " << int((m_CompileTime-compile_time)*1000.0) << " ms, ";
+    std::cout << (m_ProgramsShared-shared) << " shared" << std::endl;
+
     // retourner la map des matériaux
     return materials;
 }
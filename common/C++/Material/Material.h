@@ -43,6 +43,13 @@ public:
      */
     virtual void enable(mat4 mat4Projection, mat4 mat4ModelView);
 
+    /**
+     * Cette méthode fournit seulement la matrice ModelView et la matrice normale au
+     * matériau déjà activé par enable, pour dessiner un autre objet avec le même
+     * @param mat4ModelView : fournir la matrice de vue
+     */
+    void setModelView(mat4 mat4ModelView);
+
     /**
      * Cette méthode désactive le matériau
      */
@@ -59,6 +66,19 @@ public:
      */
     GLint getShaderId();
 
+    /**
+     * retourne l'identifiant de la texture principale du matériau, voir RenderQueue
+     * @return identifiant OpenGL de la texture, 0 s'il n'y en a pas
+     */
+    virtual GLuint getTextureId();
+
+    /**
+     * indique si le matériau est transparent ; ses objets sont alors dessinés
+     * après les opaques, du plus loin au plus proche, voir RenderQueue
+     * @return true si le matériau est transparent
+     */
+    virtual bool isTransparent();
+
     /**
      * Cette méthode de classe retourne une collection de Material.
      * @param folder : contient le fichier mtl et les textures
@@ -85,6 +105,26 @@ public:
      */
     void resetClipPlane();
 
+    /**
+     * rend le matériau capable de dessiner des instances, voir VBOset::onDrawInstanced :
+     * son vertex shader reçoit en plus la matrice de chaque instance, appliquée avant mat4ModelView.
+     * NB : les VBOsets déjà créés pour ce matériau doivent ensuite appeler updateLocations()
+     * @param active : true s'il faut compiler un shader gérant les instances
+     */
+    void setInstanced(bool active);
+
+    /**
+     * indique si le shader du matériau gère les instances
+     * @return true si setInstanced(true) a été appelée
+     */
+    bool isInstanced();
+
+    /**
+     * affiche le nombre de programmes de shaders compilés et partagés par les matériaux,
+     * ainsi que la durée totale des compilations
+     */
+    static void printShaderStats();
+
 
 protected:
 
@@ -97,6 +137,27 @@ protected:
     virtual std::string getVertexShader();
     virtual std::string getFragmentShader();
 
+    /**
+     * libère le shader du matériau, il n'est supprimé que si aucun autre matériau ne l'emploie
+     */
+    void releaseShader();
+
+    /**
+     * retourne les déclarations du vertex shader pour les instances : la variable
+     * attribute glInstanceMatrix, ou rien si le matériau n'est pas instancié
+     */
+    std::string getInstancingShader();
+
+    /**
+     * retourne l'expression GLSL de la matrice ModelView d'un sommet, y compris celle de son instance
+     */
+    std::string getModelViewShader();
+
+    /**
+     * retourne l'expression GLSL de la matrice normale d'un sommet, y compris celle de son instance
+     */
+    std::string getNormalMatrixShader();
+
 protected:
 
     /** nom du matériau **/
@@ -117,6 +178,26 @@ protected:
     bool m_ClipPlaneOn;
     vec4 m_ClipPlane;
 
+    /** dessin d'instances */
+    bool m_InstancedOn;
+
+    /** sources du shader, clé de ce shader dans m_ProgramCache */
+    std::string m_ShaderKey;
+
+    /** programme de shader et nombre de matériaux qui l'emploient */
+    struct SharedProgram {
+        GLint id;
+        int users;
+    };
+
+    /** programmes compilés, indexés par leurs sources : les matériaux ayant les mêmes sources partagent le programme */
+    static std::map<std::string, SharedProgram> m_ProgramCache;
+
+    /** statistiques : nombre de programmes compilés, nombre de fois qu'un programme a été partagé, durée des compilations */
+    static int m_ProgramsCompiled;
+    static int m_ProgramsShared;
+    static double m_CompileTime;
+
 };
 
 #endif
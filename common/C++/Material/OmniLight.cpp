@@ -7,12 +7,15 @@
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 #include <gl-matrix.h>
 #include <utils.h>
 
 #include <OmniLight.h>
 #include <SceneBase.h>
+#include <GBuffer.h>
+#include <Profiler.h>
 
 /**
  * constructeur
@@ -26,9 +29,11 @@ OmniLight::OmniLight():
     // initialisation des variables membre spécifiques
     m_PositionScene = vec4::fromValues(0,0,1,0);
     m_PositionCamera = vec4::clone(m_PositionScene);
+    m_Range = 0.0;
 
     // compiler le shader
     m_LightPositionLoc = 0;
+    m_LightRangeLoc = -1;
     compileShader();
 }
 
@@ -125,6 +130,83 @@ vec4 OmniLight::getPositionCamera()
 }
 
 
+/**
+ * définit la portée de la lampe : son éclairement décroît jusqu'à s'annuler à cette distance
+ * @param range : distance dans le repère caméra, 0 pour une portée illimitée
+ */
+void OmniLight::setRange(float range)
+{
+    m_Range = std::max(range, 0.0f);
+}
+
+
+/**
+ * retourne la portée de la lampe
+ * @return distance à laquelle l'éclairement s'annule, 0 si elle est illimitée
+ */
+float OmniLight::getRange()
+{
+    return m_Range;
+}
+
+
+/**
+ * indique si l'éclairement de cette lampe peut être calculé par ClusteredLights
+ * @return true si la lampe est positionnelle et de portée limitée
+ */
+bool OmniLight::isClusterable()
+{
+    return m_Range > 0.0 && m_PositionScene[3] != 0.0;
+}
+
+
+/**
+ * calcule le rectangle de l'écran couvert par la boîte englobante de la sphère
+ * d'influence de la lampe, tout l'écran si la sphère traverse le plan near
+ * @param mat4Projection : matrice de projection de la scène
+ * @param bounds : reçoit xmin, ymin, xmax, ymax en coordonnées normalisées [-1,+1]
+ * @return false si la sphère est entièrement hors du champ de la caméra
+ */
+bool OmniLight::getScreenBounds(mat4& mat4Projection, vec4& bounds)
+{
+    vec4::set(bounds, -1.0, -1.0, +1.0, +1.0);
+    if (m_Range <= 0.0 || m_PositionCamera[3] == 0.0) return true;
+
+    // distances à la caméra couvertes par la sphère d'influence de la lampe
+    vec4 center = m_PositionCamera;
+    float dmin = -center[2] - m_Range;
+    float dmax = -center[2] + m_Range;
+
+    // plans near et far d'une projection perspective
+    bool perspective = mat4Projection[11] != 0.0;
+    if (perspective) {
+        float near = mat4Projection[14] / (mat4Projection[10] - 1.0);
+        float far  = mat4Projection[14] / (mat4Projection[10] + 1.0);
+        if (dmax < near) return false;
+        if (far > near && dmin > far) return false;
+        if (dmin <= near) return true;
+    }
+
+    // projeter les coins de la boîte englobante
+    float xmin = +1e38, xmax = -1e38, ymin = +1e38, ymax = -1e38;
+    for (int corner=0; corner<8; corner++) {
+        vec4 point = vec4::fromValues(
+            center[0] + ((corner & 1) ? m_Range : -m_Range),
+            center[1] + ((corner & 2) ? m_Range : -m_Range),
+            center[2] + ((corner & 4) ? m_Range : -m_Range),
+            1.0);
+        vec4::transformMat4(point, point, mat4Projection);
+        xmin = std::min(xmin, point[0]/point[3]);
+        xmax = std::max(xmax, point[0]/point[3]);
+        ymin = std::min(ymin, point[1]/point[3]);
+        ymax = std::max(ymax, point[1]/point[3]);
+    }
+    if (xmax < -1.0 || xmin > +1.0 || ymax < -1.0 || ymin > +1.0) return false;
+    vec4::set(bounds, std::max(xmin, -1.0f), std::max(ymin, -1.0f), std::min(xmax, +1.0f), std::min(ymax, +1.0f));
+    return true;
+}
+
+
 /**
  * construit le Fragment Shader qui calcule l'éclairement de cette lampe
  * @return source du shader
@@ -137,24 +219,24 @@ std::string OmniLight::getFragmentShader()
         "in vec2 frgTexCoord;\n"
         "out vec4 glFragColor;\n"
         "\n"
-        "uniform sampler2D MapPosition;\n"
-        "uniform sampler2D MapNormale;\n"
-        "uniform sampler2D MapDiffuse;\n"
-        "uniform sampler2D MapSpecular;\n"
-        "uniform sampler2D MapDepth;\n"
+        + GBuffer::getDecoderShader() +
         "uniform vec3 LightColor;\n"
         "uniform vec4 LightPosition;\n"
+        "uniform float LightRange;\n"
         "\n"
         "void main()\n"
         "{\n"
         "    // récupérer les infos du g-buffer\n"
-        "    vec4 position = texture(MapPosition, frgTexCoord);\n"
+        "    vec4 position = readPosition(frgTexCoord);\n"
         "    if (position.w != 1.0) discard;\n"
         "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n"
-        "    vec4 normal  = texture(MapNormale, frgTexCoord);\n"
-        "    vec4 Kd = texture(MapDiffuse, frgTexCoord);\n"
+        "    vec4 normal  = readNormal(frgTexCoord);\n"
+        "    vec4 Kd = readDiffuse(frgTexCoord);\n"
         "\n"
-        "    if (normal.w != 0.0) {\n"
+        "    if (LightRange > 0.0 && LightPosition.w != 0.0 && distance(LightPosition.xyz, position.xyz) >= LightRange) {\n"
+        "        // hors de portée de la lampe\n"
+        "        glFragColor = vec4(0.0, 0.0, 0.0, Kd.a);\n"
+        "    } else if (normal.w != 0.0) {\n"
         "        // éclairement diffus uniquement\n"
         "        glFragColor = vec4(LightColor * Kd.rgb, 1.0) * Kd.a;\n"
         "    } else {\n"
@@ -167,6 +249,12 @@ std::string OmniLight::getFragmentShader()
         "            float distance = length(L);\n"
         "            // diviser la couleur par la distance au carré\n"
         "            color = LightColor / (distance*distance);\n"
+        "            // puis l'annuler progressivement jusqu'à la portée de la lampe\n"
+        "            if (LightRange > 0.0) {\n"
+        "                float x = distance / LightRange;\n"
+        "                float window = clamp(1.0 - x*x*x*x, 0.0, 1.0);\n"
+        "                color *= window * window;\n"
+        "            }\n"
         "            L = L / distance;\n"
         "        } else {\n"
         "            // directionnelle\n"
@@ -178,7 +266,7 @@ std::string OmniLight::getFragmentShader()
         "        float dotNL = clamp(dot(N,L), 0.0, 1.0);\n"
         "\n"
         "        // couleur spéculaire et coefficient ns\n"
-        "        vec4 Ks = texture(MapSpecular, frgTexCoord);\n"
+        "        vec4 Ks = readSpecular(frgTexCoord);\n"
         "        float ns = Ks.a;\n"
         "        if (ns > 0.0) {\n"
         "            // reflet spéculaire\n"
@@ -205,6 +293,7 @@ void OmniLight::findUniformLocations()
 
     // emplacement de la position de la lampe
     m_LightPositionLoc = glGetUniformLocation(m_ShaderId, "LightPosition");
+    m_LightRangeLoc    = glGetUniformLocation(m_ShaderId, "LightRange");
 }
 
 
@@ -217,6 +306,8 @@ void OmniLight::startProcess(FrameBufferObject* gbuffer)
     // préparer le shader pour le traitement
     Light::startProcess(gbuffer);
 
-    // fournir la position de la lampe (la couleur est fournie par la superclasse)
+    // fournir la position et la portée de la lampe (la couleur est fournie par la superclasse)
     vec4::glUniform(m_LightPositionLoc, m_PositionCamera);
+    glUniform1f(m_LightRangeLoc, m_Range);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 }
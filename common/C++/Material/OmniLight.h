@@ -75,6 +75,34 @@ public:
      */
     vec4 getPositionCamera();
 
+    /**
+     * définit la portée de la lampe : son éclairement décroît jusqu'à s'annuler à cette distance
+     * @param range : distance dans le repère caméra, 0 pour une portée illimitée (par défaut)
+     */
+    void setRange(float range);
+
+    /**
+     * retourne la portée de la lampe
+     * @return distance à laquelle l'éclairement s'annule, 0 si elle est illimitée
+     */
+    float getRange();
+
+    /**
+     * indique si l'éclairement de cette lampe peut être calculé par ClusteredLights
+     * avec celui d'autres lampes, en une seule passe
+     * @return true si la lampe est positionnelle et de portée limitée
+     */
+    virtual bool isClusterable();
+
+    /**
+     * calcule le rectangle de l'écran couvert par la sphère d'influence de la lampe,
+     * tout l'écran si sa portée est illimitée
+     * @param mat4Projection : matrice de projection de la scène
+     * @param bounds : reçoit xmin, ymin, xmax, ymax en coordonnées normalisées [-1,+1]
+     * @return false si la sphère est entièrement hors du champ de la caméra
+     */
+    virtual bool getScreenBounds(mat4& mat4Projection, vec4& bounds);
+
 
 protected:
 
@@ -96,8 +124,12 @@ protected:
     /** position effective de la lampe : après transformation */
     vec4 m_PositionCamera;
 
+    /** portée de la lampe, 0 si elle est illimitée */
+    float m_Range;
+
     /** emplacement des uniform communs de ce type de lampe **/
     GLint m_LightPositionLoc;
+    GLint m_LightRangeLoc;
 
 };
 
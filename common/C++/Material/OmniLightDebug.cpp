@@ -13,6 +13,8 @@
 
 #include <OmniLightDebug.h>
 #include <SceneBase.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 /**
  * constructeur
@@ -106,8 +108,9 @@ OmniLightDebug::~OmniLightDebug()
  */
 void OmniLightDebug::onDraw(mat4& mat4Projection, mat4& mat4View, float scale)
 {
-    // activer le shader
-    glUseProgram(m_DebugShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_DebugShaderId);
+    GLState::bindVertexArray(0);
 
     // décaler l'origine à la position caméra de la lampe
     mat4 mat4ModelView = mat4::create();
@@ -125,11 +128,11 @@ void OmniLightDebug::onDraw(mat4& mat4Projection, mat4& mat4View, float scale)
 
     // dessiner le maillage
     glDrawArrays(GL_LINES, 0, m_DebugLineCount);
+    PROFILE_DRAW(GL_LINES, m_DebugLineCount);
 
-    // désactiver les buffers et le shader
+    // désactiver les buffers
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_DebugVertexLoc);
-    glUseProgram(0);
 }
 
 
@@ -14,6 +14,9 @@
 #include <gl-matrix.h>
 #include <utils.h>
 #include <SSAOLight.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -50,16 +53,13 @@ SSAOLight::~SSAOLight()
  */
 std::string SSAOLight::getFragmentShader()
 {
-    const char* srcFragmentShader =
+    return
         "#version 300 es\n"
         "precision mediump float;\n"
         "in vec2 frgTexCoord;\n"
         "out vec4 glFragColor;\n"
         "\n"
-        "uniform sampler2D MapDiffuse;\n"
-        "uniform sampler2D MapPosition;\n"
-        "uniform sampler2D MapNormale;\n"
-        "uniform sampler2D MapDepth;\n"
+        + GBuffer::getDecoderShader() +
         "uniform vec3 LightColor;\n"
         "\n"
         "// paramètres du traitement\n"
@@ -84,11 +84,11 @@ std::string SSAOLight::getFragmentShader()
         "void main()\n"
         "{\n"
         "    // coordonnées, profondeur, couleur et normale du fragment\n"
-        "    vec4 center = texture(MapPosition, frgTexCoord);\n"
+        "    vec4 center = readPosition(frgTexCoord);\n"
         "    if (center.w != 1.0) discard;\n"
         "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n"
-        "    vec4 color   = texture(MapDiffuse, frgTexCoord);\n"
-        "    vec3 N       = texture(MapNormale, frgTexCoord).xyz;\n"
+        "    vec4 color   = readDiffuse(frgTexCoord);\n"
+        "    vec3 N       = readNormal(frgTexCoord).xyz;\n"
         "\n"
         "    // initialiser l'échantillonnage aléatoire de Poisson\n"
         "    float angle = rand(frgTexCoord*gl_FragDepth) * 6.283285;\n"
@@ -101,7 +101,7 @@ std::string SSAOLight::getFragmentShader()
         "    for (int i=0; i<PoissonCount; i++) {\n"
         "        // échantillon courant\n"
         "        vec2 offset = RandomRotation * radius * PoissonSamples[i];\n"
-        "        vec4 neighbor = texture(MapPosition, frgTexCoord + offset);\n"
+        "        vec4 neighbor = readPosition(frgTexCoord + offset);\n"
         "\n"
         "        // direction et distance entre ce voisin et le fragment\n"
         "        vec3 D = neighbor.xyz - center.xyz;\n"
@@ -118,7 +118,6 @@ std::string SSAOLight::getFragmentShader()
         "    // couleur finale\n"
         "    glFragColor = vec4(occlusion * color.rgb * LightColor, 1.0) * color.a;\n"
         "}";
-    return srcFragmentShader;
 }
 
 
@@ -137,7 +136,7 @@ void SSAOLight::findUniformLocations()
 
     // initialiser le tableau des constantes (erreur : arrays may not be declared constant since they cannot be initialized)
     GLint PoissonSamplesLoc = glGetUniformLocation(m_ShaderId, "PoissonSamples");
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     GLfloat PoissonSamples[] = {
         +0.79636, -0.56051,
         -0.64373, +0.68863,
@@ -157,7 +156,8 @@ void SSAOLight::findUniformLocations()
         +0.02771, +0.26856,
     };
     glUniform2fv(PoissonSamplesLoc, 16, PoissonSamples);
-    glUseProgram(0);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    GLState::useProgram(0);
 }
 
 
@@ -172,6 +172,9 @@ void SSAOLight::startProcess(FrameBufferObject* gbuffer)
 
     // paramètres de l'ombre SSAO
     glUniform1f(m_RadiusLoc,      m_Radius);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
     glUniform1f(m_MinDistanceLoc, m_MinDistance);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
     glUniform1f(m_MaxDistanceLoc, m_MaxDistance);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 }
@@ -10,6 +10,7 @@
 #include <utils.h>
 #include <SimpleColorMaterial.h>
 #include <VBOset.h>
+#include <GBuffer.h>
 
 
 /**
@@ -46,6 +47,35 @@ SimpleColorMaterial::~SimpleColorMaterial()
 }
 
 
+/**
+ * recompile le shader du matériau
+ */
+void SimpleColorMaterial::compileShader()
+{
+    // appeler la méthode de la superclasse
+    Material::compileShader();
+
+    // déterminer où sont les variables uniform spécifiques
+    m_ColorLoc = glGetUniformLocation(m_ShaderId, "Color");
+}
+
+
+/**
+ * Cette méthode active le matériau : met en place son shader,
+ * fournit les variables uniform qu'il demande
+ * @param mat4Projection : mat4 contenant la projection
+ * @param mat4ModelView : mat4 contenant la transformation vers la caméra
+ */
+void SimpleColorMaterial::enable(mat4 mat4Projection, mat4 mat4ModelView)
+{
+    // appeler la méthode de la superclasse
+    Material::enable(mat4Projection, mat4ModelView);
+
+    // fournir la couleur du matériau
+    vec4::glUniform(m_ColorLoc, m_Color);
+}
+
+
 /**
  * retourne le source du Vertex Shader
  */
@@ -86,8 +116,9 @@ std::string SimpleColorMaterial::getFragmentShader()
         srcFragmentShader << "uniform vec4 ClipPlane;\n";
     }
     srcFragmentShader << "\n";
+    srcFragmentShader << "uniform vec4 Color;\n";
     srcFragmentShader << "in vec4 frgPosition;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "\n";
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
@@ -96,10 +127,7 @@ std::string SimpleColorMaterial::getFragmentShader()
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
         srcFragmentShader << "\n";
     }
-    srcFragmentShader << "    glFragData[0] = "<<vec4::str(m_Color)<<";\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(0.0,0.0,0.0, 1.0);\n";
+    srcFragmentShader << "    writeGBuffer(Color, vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(0.0,0.0,0.0, 1.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
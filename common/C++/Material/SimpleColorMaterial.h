@@ -33,8 +33,18 @@ public:
     /** destructeur */
     virtual ~SimpleColorMaterial();
 
+    /**
+     * Cette méthode active le matériau
+     * @param mat4Projection : fournir la matrice de projection
+     * @param mat4ModelView : fournir la matrice de vue
+     */
+    virtual void enable(mat4 mat4Projection, mat4 mat4ModelView);
+
 protected:
 
+    /** recompile le shader du matériau */
+    virtual void compileShader();
+
     virtual std::string getVertexShader();
     virtual std::string getFragmentShader();
 
@@ -43,6 +53,9 @@ protected:
 
     vec4 m_Color;
 
+    /** emplacement de la couleur dans le shader, c'est un uniform pour que tous les matériaux partagent le shader */
+    GLint m_ColorLoc;
+
 };
 
 #endif
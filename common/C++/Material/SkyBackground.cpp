@@ -12,6 +12,7 @@
 #include <utils.h>
 
 #include <SkyBackground.h>
+#include <GBuffer.h>
 
 
 /**
@@ -44,14 +45,14 @@ std::string SkyBackground::getFragmentShader()
     return
         "#version 300 es\n"
         "precision mediump float;\n"
-        "uniform sampler2D MapPosition;\n"
+        + GBuffer::getDecoderShader() +
         "in vec2 frgTexCoord;\n"
         "uniform vec3 LightColor;\n"
         "out vec4 glFragColor;\n"
         "\n"
         "void main()\n"
         "{\n"
-        "    vec4 position = texture(MapPosition, frgTexCoord);\n"
+        "    vec4 position = readPosition(frgTexCoord);\n"
         "    if (position.w > 0.8) discard;\n"
         "    gl_FragDepth = 1.0;\n"
         "    glFragColor = vec4(LightColor, 1.0);\n"
@@ -13,6 +13,9 @@
 #include <utils.h>
 #include <SoftSpotLight.h>
 #include <SceneBase.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -108,14 +111,11 @@ std::string SoftSpotLight::getFragmentShader()
     srcFragmentShader << "in vec2 frgTexCoord;\n";
     srcFragmentShader << "out vec4 glFragColor;\n";
     srcFragmentShader << "\n";
-    srcFragmentShader << "uniform sampler2D MapPosition;\n";
-    srcFragmentShader << "uniform sampler2D MapNormale;\n";
-    srcFragmentShader << "uniform sampler2D MapDiffuse;\n";
-    srcFragmentShader << "uniform sampler2D MapSpecular;\n";
-    srcFragmentShader << "uniform sampler2D MapDepth;\n";
+    srcFragmentShader << GBuffer::getDecoderShader();
     srcFragmentShader << "\n";
     srcFragmentShader << "uniform vec3 LightColor;\n";
     srcFragmentShader << "uniform vec4 LightPosition;\n";
+    srcFragmentShader << "uniform float LightRange;\n";
     srcFragmentShader << "uniform float cosmaxangle;\n";
     srcFragmentShader << "uniform float cosminangle;\n";
     srcFragmentShader << "uniform vec3 LightDirection;\n";
@@ -231,13 +231,16 @@ std::string SoftSpotLight::getFragmentShader()
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
     srcFragmentShader << "    // récupérer les infos du g-buffer\n";
-    srcFragmentShader << "    vec4 position = texture(MapPosition, frgTexCoord);\n";
+    srcFragmentShader << "    vec4 position = readPosition(frgTexCoord);\n";
     srcFragmentShader << "    if (position.w != 1.0) discard;\n";
     srcFragmentShader << "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n";
-    srcFragmentShader << "    vec4 normal = texture(MapNormale, frgTexCoord);\n";
-    srcFragmentShader << "    vec4 Kd = texture(MapDiffuse, frgTexCoord);\n";
+    srcFragmentShader << "    vec4 normal = readNormal(frgTexCoord);\n";
+    srcFragmentShader << "    vec4 Kd = readDiffuse(frgTexCoord);\n";
     srcFragmentShader << "\n";
-    srcFragmentShader << "    if (normal.w != 0.0) {\n";
+    srcFragmentShader << "    if (LightRange > 0.0 && LightPosition.w != 0.0 && distance(LightPosition.xyz, position.xyz) >= LightRange) {\n";
+    srcFragmentShader << "        // hors de portée de la lampe\n";
+    srcFragmentShader << "        glFragColor = vec4(0.0, 0.0, 0.0, Kd.a);\n";
+    srcFragmentShader << "    } else if (normal.w != 0.0) {\n";
     srcFragmentShader << "        // éclairement diffus uniquement\n";
     srcFragmentShader << "        glFragColor = vec4(LightColor * Kd.rgb, 1.0) * Kd.a;\n";
     srcFragmentShader << "    } else {\n";
@@ -250,6 +253,12 @@ std::string SoftSpotLight::getFragmentShader()
     srcFragmentShader << "            float distance = length(L);\n";
     srcFragmentShader << "            // diviser la couleur par la distance au carré\n";
     srcFragmentShader << "            color = LightColor / (distance*distance);\n";
+    srcFragmentShader << "            // puis l'annuler progressivement jusqu'à la portée de la lampe\n";
+    srcFragmentShader << "            if (LightRange > 0.0) {\n";
+    srcFragmentShader << "                float x = distance / LightRange;\n";
+    srcFragmentShader << "                float window = clamp(1.0 - x*x*x*x, 0.0, 1.0);\n";
+    srcFragmentShader << "                color *= window * window;\n";
+    srcFragmentShader << "            }\n";
     srcFragmentShader << "            L = L / distance;\n";
     srcFragmentShader << "        } else {\n";
     srcFragmentShader << "            // directionnelle\n";
@@ -274,7 +283,7 @@ std::string SoftSpotLight::getFragmentShader()
     srcFragmentShader << "            float dotNL = clamp(dot(N,L), 0.0, 1.0);\n";
     srcFragmentShader << "\n";
     srcFragmentShader << "            // couleur spéculaire et coefficient ns\n";
-    srcFragmentShader << "            vec4 Ks = texture(MapSpecular, frgTexCoord);\n";
+    srcFragmentShader << "            vec4 Ks = readSpecular(frgTexCoord);\n";
     srcFragmentShader << "            float ns = Ks.a;\n";
     srcFragmentShader << "            if (ns > 0.0) {\n";
     srcFragmentShader << "                // reflet spéculaire\n";
@@ -309,7 +318,7 @@ void SoftSpotLight::findUniformLocations()
 
     // initialiser le tableau des constantes (erreur : arrays may not be declared constant since they cannot be initialized)
     GLint PoissonLoc = glGetUniformLocation(m_ShaderId, "PoissonSamples");
-    glUseProgram(m_ShaderId);
+    GLState::useProgram(m_ShaderId);
     GLfloat PoissonSamples[] = {
         +0.79636, -0.56051,
         -0.64373, +0.68863,
@@ -329,7 +338,8 @@ void SoftSpotLight::findUniformLocations()
         +0.02771, +0.26856,
     };
     glUniform2fv(PoissonLoc, 16, PoissonSamples);
-    glUseProgram(0);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    GLState::useProgram(0);
 }
 
 
@@ -344,6 +354,7 @@ void SoftSpotLight::startProcess(FrameBufferObject* gbuffer)
 
     // étendue relative de la lampe
     glUniform1f(m_LightRadiusLoc, m_LightRadius / m_TanMaxAngle);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // axe de la lampe spot = position-target
     vec3::glUniform(m_DirectionLoc, m_Direction);
@@ -13,6 +13,9 @@
 #include <utils.h>
 #include <SpotLight.h>
 #include <SceneBase.h>
+#include <GBuffer.h>
+#include <FrameStats.h>
+#include <Profiler.h>
 
 
 /**
@@ -161,6 +164,7 @@ void SpotLight::makeShadowMap(SceneBase* scene, mat4& mat4ViewCamera)
 {
     // s'il n'y a pas de shadowmap, alors sortir sans rien faire
     if (m_ShadowMap == nullptr) return;
+    FrameStats::Stage stage(FrameStats::STAGE_PREPARE_LIGHTS);
 
     // construire une matrice de projection à partir de la lampe
     // TODO changer le type de perspective selon la nature de position et target (directions ou positions)
@@ -192,6 +196,16 @@ void SpotLight::makeShadowMap(SceneBase* scene, mat4& mat4ViewCamera)
 }
 
 
+/**
+ * indique si l'éclairement de cette lampe peut être calculé par ClusteredLights
+ * @return false, ClusteredLights ne gère ni le cône ni la shadow map
+ */
+bool SpotLight::isClusterable()
+{
+    return false;
+}
+
+
 /**
  * construit le Fragment Shader qui calcule l'éclairement de cette lampe
  * @return source du fragment shader
@@ -204,13 +218,10 @@ std::string SpotLight::getFragmentShader()
     srcFragmentShader << "in vec2 frgTexCoord;\n";
     srcFragmentShader << "out vec4 glFragColor;\n";
     srcFragmentShader << "\n";
-    srcFragmentShader << "uniform sampler2D MapPosition;\n";
-    srcFragmentShader << "uniform sampler2D MapNormale;\n";
-    srcFragmentShader << "uniform sampler2D MapDiffuse;\n";
-    srcFragmentShader << "uniform sampler2D MapSpecular;\n";
-    srcFragmentShader << "uniform sampler2D MapDepth;\n";
+    srcFragmentShader << GBuffer::getDecoderShader();
     srcFragmentShader << "uniform vec3 LightColor;\n";
     srcFragmentShader << "uniform vec4 LightPosition;\n";
+    srcFragmentShader << "uniform float LightRange;\n";
     srcFragmentShader << "uniform float cosmaxangle;\n";
     srcFragmentShader << "uniform float cosminangle;\n";
     srcFragmentShader << "uniform vec3 LightDirection;\n";
@@ -255,13 +266,16 @@ std::string SpotLight::getFragmentShader()
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
     srcFragmentShader << "    // récupérer les infos du g-buffer\n";
-    srcFragmentShader << "    vec4 position = texture(MapPosition, frgTexCoord);\n";
+    srcFragmentShader << "    vec4 position = readPosition(frgTexCoord);\n";
     srcFragmentShader << "    if (position.w != 1.0) discard;\n";
     srcFragmentShader << "    gl_FragDepth = texture(MapDepth, frgTexCoord).r;\n";
-    srcFragmentShader << "    vec4 normal = texture(MapNormale, frgTexCoord);\n";
-    srcFragmentShader << "    vec4 Kd = texture(MapDiffuse, frgTexCoord);\n";
+    srcFragmentShader << "    vec4 normal = readNormal(frgTexCoord);\n";
+    srcFragmentShader << "    vec4 Kd = readDiffuse(frgTexCoord);\n";
     srcFragmentShader << "\n";
-    srcFragmentShader << "    if (normal.w != 0.0) {\n";
+    srcFragmentShader << "    if (LightRange > 0.0 && LightPosition.w != 0.0 && distance(LightPosition.xyz, position.xyz) >= LightRange) {\n";
+    srcFragmentShader << "        // hors de portée de la lampe\n";
+    srcFragmentShader << "        glFragColor = vec4(0.0, 0.0, 0.0, Kd.a);\n";
+    srcFragmentShader << "    } else if (normal.w != 0.0) {\n";
     srcFragmentShader << "        // éclairement diffus uniquement\n";
     srcFragmentShader << "        glFragColor = vec4(LightColor * Kd.rgb, 1.0) * Kd.a;\n";
     srcFragmentShader << "    } else {\n";
@@ -274,6 +288,12 @@ std::string SpotLight::getFragmentShader()
     srcFragmentShader << "            float distance = length(L);\n";
     srcFragmentShader << "            // diviser la couleur par la distance au carré\n";
     srcFragmentShader << "            color = LightColor / (distance*distance);\n";
+    srcFragmentShader << "            // puis l'annuler progressivement jusqu'à la portée de la lampe\n";
+    srcFragmentShader << "            if (LightRange > 0.0) {\n";
+    srcFragmentShader << "                float x = distance / LightRange;\n";
+    srcFragmentShader << "                float window = clamp(1.0 - x*x*x*x, 0.0, 1.0);\n";
+    srcFragmentShader << "                color *= window * window;\n";
+    srcFragmentShader << "            }\n";
     srcFragmentShader << "            L = L / distance;\n";
     srcFragmentShader << "        } else {\n";
     srcFragmentShader << "            // directionnelle\n";
@@ -291,7 +311,7 @@ std::string SpotLight::getFragmentShader()
     srcFragmentShader << "            vec3 N = normal.xyz;\n";
     srcFragmentShader << "            float dotNL = clamp(dot(N,L), 0.0, 1.0);\n";
     srcFragmentShader << "            // couleur spéculaire et coefficient ns\n";
-    srcFragmentShader << "            vec4 Ks = texture(MapSpecular, frgTexCoord);\n";
+    srcFragmentShader << "            vec4 Ks = readSpecular(frgTexCoord);\n";
     srcFragmentShader << "            float ns = Ks.a;\n";
     srcFragmentShader << "            if (ns > 0.0) {\n";
     srcFragmentShader << "                // reflet spéculaire\n";
@@ -341,7 +361,9 @@ void SpotLight::startProcess(FrameBufferObject* gbuffer)
 
     // angles de la lampe spot
     glUniform1f(m_CosMaxAngleLoc, m_CosMaxAngle);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
     glUniform1f(m_CosMinAngleLoc, m_CosMinAngle);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // axe de la lampe spot = position-target
     vec3::glUniform(m_DirectionLoc, m_Direction);
@@ -69,6 +69,12 @@ public:
      */
     void makeShadowMap(SceneBase* scene, mat4& mat4ViewCamera);
 
+    /**
+     * indique si l'éclairement de cette lampe peut être calculé par ClusteredLights
+     * @return false, ClusteredLights ne gère ni le cône ni la shadow map
+     */
+    virtual bool isClusterable();
+
 
 protected:
 
@@ -13,6 +13,8 @@
 #include <utils.h>
 #include <SpotLightDebug.h>
 #include <SceneBase.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -126,8 +128,9 @@ SpotLightDebug::~SpotLightDebug()
  */
 void SpotLightDebug::onDraw(mat4& mat4Projection, mat4& mat4View)
 {
-    // activer le shader
-    glUseProgram(m_DebugShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_DebugShaderId);
+    GLState::bindVertexArray(0);
 
     // décaler l'origine à la position caméra de la lampe
     mat4 mat4ModelView = mat4::create();
@@ -145,11 +148,11 @@ void SpotLightDebug::onDraw(mat4& mat4Projection, mat4& mat4View)
 
     // dessiner le maillage
     glDrawArrays(GL_LINES, 0, m_DebugLineCount);
+    PROFILE_DRAW(GL_LINES, m_DebugLineCount);
 
-    // désactiver les buffers et le shader
+    // désactiver les buffers
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_DebugVertexLoc);
-    glUseProgram(0);
 }
 
 
@@ -19,6 +19,8 @@ SDL_Surface * flipSurface(SDL_Surface * surface);
 
 #include <utils.h>
 #include <Texture2D.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 
@@ -144,11 +146,11 @@ void Texture2D::loadTexture(const char* filename, GLenum filtering, GLenum repet
     }
 
     // faire charger l'image dans l'unité 0 (pb si utilisée par ailleurs)
-    glActiveTexture(GL_TEXTURE0);
+    GLState::activeTexture(GL_TEXTURE0);
 
     // création d'une texture OpenGL
     glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    GLState::bindTexture(GL_TEXTURE_2D, m_TextureID);
     glTexImage2D(GL_TEXTURE_2D, 0, internal_format, m_Width, m_Height, 0, texture_format, components_type, surface->pixels);
 
     // libération de l'image SDL
@@ -189,11 +191,11 @@ Texture2D::Texture2D(GLenum filtering, GLenum repetition)
     m_Height = -1;
 
     // faire charger l'image dans l'unité 0 (pb si utilisée par ailleurs)
-    glActiveTexture(GL_TEXTURE0);
+    GLState::activeTexture(GL_TEXTURE0);
 
     // création d'une texture OpenGL
     glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    GLState::bindTexture(GL_TEXTURE_2D, m_TextureID);
 
     // filtering antialiasing de la texture
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
@@ -213,7 +215,7 @@ Texture2D::Texture2D(GLenum filtering, GLenum repetition)
  */
 Texture2D::~Texture2D()
 {
-    glDeleteTextures(1,&m_TextureID);
+    GLState::deleteTextures(1,&m_TextureID);
 }
 
 
@@ -229,15 +231,15 @@ void Texture2D::setTextureUnit(GLenum unit, GLint locSampler)
     if (m_TextureID == 0) return;
 
     // activer l'unité de texture
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
 
     // la lier ou délier à la texture
     if (locSampler < 0) {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D, m_TextureID);
+        GLState::bindTexture(GL_TEXTURE_2D, m_TextureID);
         // lier à la variable uniform Sampler2D
-        glUniform1i(locSampler, unit-GL_TEXTURE0);
+        GLState::uniformSampler(locSampler, unit);
     }
 }
 
@@ -18,6 +18,8 @@
 #include <SDL_image.h>
 
 #include <TextureCube.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 
@@ -59,11 +61,11 @@ TextureCube::TextureCube(std::string dirname, GLenum filtering)
 void TextureCube::loadTexture(std::string dirname, GLenum filtering)
 {
     // faire charger les images dans l'unité 0 (pb si elle est utilisée par ailleurs)
-    glActiveTexture(GL_TEXTURE0);
+    GLState::activeTexture(GL_TEXTURE0);
 
     // création et sélection d'une texture OpenGL
     glGenTextures (1, &m_TextureID);
-    glBindTexture (GL_TEXTURE_CUBE_MAP, m_TextureID);
+    GLState::bindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
 
     // filtrage antialiasing de la texture
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, filtering);
@@ -85,7 +87,7 @@ void TextureCube::loadTexture(std::string dirname, GLenum filtering)
     loadImageFace(dirname+"/negz.jpg", GL_TEXTURE_CUBE_MAP_NEGATIVE_Z);
 
     // libérer l'unité de texture
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    GLState::bindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
 
@@ -176,15 +178,15 @@ void TextureCube::setTextureUnit(GLenum unit, GLint locSampler)
     if (m_TextureID == 0) return;
 
     // activer l'unité de texture
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
 
     // la lier ou délier à la texture
     if (locSampler < 0) {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, 0);
     } else {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
         // lier l'unité à la variable uniform Sampler2D
-        glUniform1i(locSampler, unit-GL_TEXTURE0);
+        GLState::uniformSampler(locSampler, unit);
     }
 }
 
@@ -194,5 +196,5 @@ void TextureCube::setTextureUnit(GLenum unit, GLint locSampler)
  */
 TextureCube::~TextureCube()
 {
-    glDeleteTextures(1, &m_TextureID);
+    GLState::deleteTextures(1, &m_TextureID);
 }
@@ -10,6 +10,7 @@
 #include <utils.h>
 #include <TextureMaterial.h>
 #include <VBOset.h>
+#include <GBuffer.h>
 
 /**
  * constructeur
@@ -77,7 +78,7 @@ std::string TextureMaterial::getFragmentShader()
     srcFragmentShader << "in vec4 frgPosition;\n";
     srcFragmentShader << "in vec3 frgNormal;\n";
     srcFragmentShader << "in vec2 frgTexCoord;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "\n";
     srcFragmentShader << "uniform sampler2D txColor;\n";
     srcFragmentShader << "\n";
@@ -88,10 +89,7 @@ std::string TextureMaterial::getFragmentShader()
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
         srcFragmentShader << "\n";
     }
-    srcFragmentShader << "    glFragData[0] = texture(txColor, frgTexCoord);\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(frgNormal, 0.0);\n";
+    srcFragmentShader << "    writeGBuffer(texture(txColor, frgTexCoord), vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(frgNormal, 0.0));\n";
     srcFragmentShader << "}\n";
     return srcFragmentShader.str();
 }
@@ -153,6 +151,16 @@ void TextureMaterial::disable()
 }
 
 
+/**
+ * retourne l'identifiant de la texture du matériau
+ * @return identifiant OpenGL de la texture
+ */
+GLuint TextureMaterial::getTextureId()
+{
+    return m_Texture->m_TextureID;
+}
+
+
 /**
  * Cette méthode supprime les ressources allouées
  */
@@ -44,6 +44,12 @@ public:
      */
     virtual void disable();
 
+    /**
+     * retourne l'identifiant de la texture du matériau, voir RenderQueue
+     * @return identifiant OpenGL de la texture
+     */
+    virtual GLuint getTextureId();
+
 
 protected:
 
@@ -15,9 +15,92 @@
 #include <iterator>
 #include <vector>
 #include <stdexcept>
+#include <string.h>
+#include <math.h>
 
 #include <utils.h>
 #include <VBOset.h>
+#include <Profiler.h>
+#include <GLState.h>
+
+// constantes absentes des anciennes versions de glew
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_INT_2_10_10_10_REV
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+
+
+/**
+ * convertit un float en demi-float IEEE 754, arrondi au plus proche pair
+ * @param value : nombre à convertir
+ * @return demi-float
+ */
+static GLushort floatToHalf(float value)
+{
+    GLuint bits;
+    memcpy(&bits, &value, sizeof(bits));
+    GLuint sign = (bits >> 16) & 0x8000;
+    GLuint mantissa = bits & 0x7FFFFF;
+    int exponent = int((bits >> 23) & 0xFF) - 127 + 15;
+
+    // infinis et NaN
+    if (((bits >> 23) & 0xFF) == 0xFF) return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+
+    // trop grand pour un demi-float
+    if (exponent >= 31) return sign | 0x7C00;
+
+    // trop petit, même pour un demi-float dénormalisé
+    if (exponent < -10) return sign;
+
+    // nombre de bits de mantisse à enlever, la mantisse d'un dénormalisé inclut le 1 implicite
+    int shift = 13;
+    GLuint half = 0;
+    if (exponent > 0) {
+        half = exponent << 10;
+    } else {
+        mantissa |= 0x800000;
+        shift = 14 - exponent;
+    }
+    half |= mantissa >> shift;
+
+    // arrondi, une retenue peut passer dans l'exposant, c'est correct
+    GLuint rest = mantissa & ((1 << shift) - 1);
+    GLuint halfway = 1 << (shift - 1);
+    if (rest > halfway || (rest == halfway && (half & 1))) half++;
+    return sign | half;
+}
+
+
+/**
+ * convertit un nombre en entier normalisé non signé
+ * @param value : nombre à convertir, ramené dans [0,1]
+ * @param max : valeur entière qui représente 1.0
+ * @return entier entre 0 et max
+ */
+static GLuint toUnsignedNormalized(float value, float max)
+{
+    if (!(value > 0.0f)) return 0;
+    if (value > 1.0f) value = 1.0f;
+    return (GLuint) lroundf(value * max);
+}
+
+
+/**
+ * convertit un nombre en entier normalisé signé, en complément à 2
+ * @param value : nombre à convertir, ramené dans [-1,1]
+ * @param bits : nombre de bits de l'entier
+ * @return bits de poids faible de l'entier
+ */
+static GLuint toSignedNormalized(float value, int bits)
+{
+    const GLuint mask = (1 << bits) - 1;
+    const float max = mask >> 1;
+    if (!(value > -1.0f)) value = -1.0f;
+    if (value > 1.0f) value = 1.0f;
+    return GLuint(lroundf(value * max)) & mask;
+}
 
 
 
@@ -26,13 +109,15 @@
  * @param shaderId : identifiant du shader employant cette variable attribute
  * @param name : nom de la variable attribute dans le shader
  * @param idattr : numéro de l'attribut, ex: MeshVertex.ID_ATTR_VERTEX
- * @param components : nombre de composantes float de la variable
+ * @param components : nombre de composantes de la variable
+ * @param format : stockage des composantes dans le VBO, ex: VBOvar::FORMAT_FLOAT
  */
-VBOvar::VBOvar(GLint shaderId, std::string name, int idattr, int components)
+VBOvar::VBOvar(GLint shaderId, std::string name, int idattr, int components, int format)
 {
     m_Name = name;
     m_IdAttr = idattr;
     m_ComponentsNumber = components;
+    m_Format = format;
     m_AttrLoc  = -1;
     m_VBOId = -1;
     m_IsOwned = false;
@@ -93,6 +178,25 @@ void VBOvar::setOffset(GLuint offset)
 }
 
 
+/**
+ * retourne la place occupée par cette variable dans un sommet, en mots de 4 octets
+ * @return nombre de mots, ex: 2 pour 3 composantes en FORMAT_HALF
+ */
+int VBOvar::getWordsCount()
+{
+    switch (m_Format) {
+    case FORMAT_HALF:
+    case FORMAT_USHORT:
+        return (m_ComponentsNumber + 1) / 2;
+    case FORMAT_INT_2_10_10_10:
+    case FORMAT_UBYTE:
+        return 1;
+    default:
+        return m_ComponentsNumber;
+    }
+}
+
+
 /**
  * vide le tableau m_Data
  */
@@ -112,16 +216,91 @@ void VBOvar::push(float value)
 }
 
 
+/**
+ * ajoute les composantes d'une valeur au tableau data, codées selon le format
+ * de la variable, en complétant le dernier mot de 4 octets avec des zéros
+ * @param value : valeur de l'attribut sur un sommet
+ * @param data : tableau qui reçoit getWordsCount() mots
+ */
+void VBOvar::pack(vec4& value, std::vector<GLfloat>& data)
+{
+    // octets des composantes codées, au plus 4 mots
+    GLubyte bytes[16] = { 0 };
+    switch (m_Format) {
+
+    case FORMAT_HALF:
+        for (int i=0; i<m_ComponentsNumber; i++) {
+            GLushort half = floatToHalf(value[i]);
+            memcpy(bytes + i*2, &half, 2);
+        }
+        break;
+
+    case FORMAT_INT_2_10_10_10: {
+        // x, y, z sur 10 bits et w sur 2 bits, w vaut 0 s'il n'y a que 3 composantes
+        GLuint packed = 0;
+        for (int i=0; i<std::min(m_ComponentsNumber, 3); i++) {
+            packed |= toSignedNormalized(value[i], 10) << (i*10);
+        }
+        if (m_ComponentsNumber > 3) packed |= toSignedNormalized(value[3], 2) << 30;
+        memcpy(bytes, &packed, 4);
+        break;
+    }
+
+    case FORMAT_USHORT:
+        for (int i=0; i<m_ComponentsNumber; i++) {
+            GLushort normalized = toUnsignedNormalized(value[i], 65535.0f);
+            memcpy(bytes + i*2, &normalized, 2);
+        }
+        break;
+
+    case FORMAT_UBYTE:
+        for (int i=0; i<m_ComponentsNumber; i++) {
+            bytes[i] = toUnsignedNormalized(value[i], 255.0f);
+        }
+        break;
+
+    default:
+        for (int i=0; i<m_ComponentsNumber; i++) {
+            memcpy(bytes + i*4, &value[i], 4);
+        }
+        break;
+    }
+
+    // ajouter les mots
+    const int count = getWordsCount();
+    for (int i=0; i<count; i++) {
+        GLfloat word;
+        memcpy(&word, bytes + i*4, 4);
+        data.push_back(word);
+    }
+}
+
+
 /**
  * Cette méthode effectue la liaison entre une variable attribute et un VBO
  * @param stride : grand pas des données dans le VBO
+ * @param base : numéro du sommet qui correspond à l'indice 0, voir VBOset::IndexRange
  */
-void VBOvar::bindVBO(int stride)
+void VBOvar::bindVBO(int stride, int base)
 {
     if (m_AttrLoc != -1 && m_VBOId != -1) {
+        // type des composantes dans le VBO
+        GLint size = m_ComponentsNumber;
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        switch (m_Format) {
+        case FORMAT_HALF:           type = GL_HALF_FLOAT; break;
+        case FORMAT_INT_2_10_10_10: type = GL_INT_2_10_10_10_REV; normalized = GL_TRUE; size = 4; break;
+        case FORMAT_USHORT:         type = GL_UNSIGNED_SHORT; normalized = GL_TRUE; break;
+        case FORMAT_UBYTE:          type = GL_UNSIGNED_BYTE; normalized = GL_TRUE; break;
+        }
+
+        // le pas vaut 0 si les données ne sont pas entrelacées, mais les mots sont complétés
+        // par des zéros, donc il faut le préciser, il sert aussi à décaler le premier sommet
+        int step = (stride != 0) ? stride : getWordsCount() * Utils::SIZEOF_FLOAT;
         glBindBuffer(GL_ARRAY_BUFFER, m_VBOId);
         glEnableVertexAttribArray(m_AttrLoc);
-        glVertexAttribPointer(m_AttrLoc, m_ComponentsNumber, GL_FLOAT, GL_FALSE, stride, (const GLvoid*) m_Offset);
+        glVertexAttribPointer(m_AttrLoc, size, type, normalized, step, (const GLvoid*) (m_Offset + base * step));
     }
 }
 
@@ -156,10 +335,16 @@ VBOset::VBOset(Material* material)
 {
     m_Material = material;
     m_VBOdataStride = 0;
+    m_VertexCount = 0;
     m_IndexBufferId = -1;
     m_IndexBufferSize = 0;
     m_DrawingPrimitive = GL_POINTS;
     m_VAO = -1;
+
+    // le VBO des matrices des instances est créé avec le premier VAO, si le shader en a besoin
+    m_InstanceLoc = glGetAttribLocation(m_Material->getShaderId(), "glInstanceMatrix");
+    m_InstanceBufferId = 0;
+    m_InstanceIdentity = false;
 }
 
 
@@ -171,8 +356,9 @@ VBOset::~VBOset()
         delete vbovar;
     }
 
-    // supprimer le VAO
-    if (m_VAO >= 0) glDeleteVertexArrays(1, &m_VAO);
+    // supprimer les VAO et le VBO des instances
+    deleteVAOs();
+    if (m_InstanceBufferId != 0) Utils::deleteVBO(m_InstanceBufferId);
 }
 
 
@@ -181,10 +367,11 @@ VBOset::~VBOset()
  * @param idattr : voir la classe MeshVertex et getAttribute, par exemple MeshVertex::ATTR_ID_VERTEX, MeshVertex::ATTR_ID_COLOR
  * @param components : ex: 2 ou mieux Utils::VEC2
  * @param name : nom de la variable concernée ex: "glTexCoord"
+ * @param format : stockage des composantes dans le VBO, ex: VBOvar::FORMAT_HALF
  */
-void VBOset::addAttribute(int idattr, int components, std::string name)
+void VBOset::addAttribute(int idattr, int components, std::string name, int format)
 {
-    m_VBOvariables.push_back(new VBOvar(m_Material->getShaderId(), name, idattr, components));
+    m_VBOvariables.push_back(new VBOvar(m_Material->getShaderId(), name, idattr, components, format));
 }
 
 
@@ -203,13 +390,11 @@ void VBOset::appendVertexComponents(MeshVertex* vertex, std::vector<GLfloat>& da
         if (components <= 0) continue;
 
         // valeur de cette variable sur le sommet courant
-        vec4 value = vertex->getAttribute(vbovar->getIdAttr());
+        vec4 value = vertex->readAttribute(vbovar->getIdAttr());
         if (value == vec4::null) continue;
 
-        // ajouter les coordonnées s'il le faut
-        for (int i=0; i<components; i++) {
-            data.push_back(value[i]);
-        }
+        // ajouter les coordonnées s'il le faut, codées selon le format de la variable
+        vbovar->pack(value, data);
     }
 }
 void VBOset::appendVertexComponents(MeshVertex* vertex)
@@ -221,13 +406,11 @@ void VBOset::appendVertexComponents(MeshVertex* vertex)
         if (components <= 0) continue;
 
         // valeur de cette variable sur le sommet courant
-        vec4 value = vertex->getAttribute(vbovar->getIdAttr());
+        vec4 value = vertex->readAttribute(vbovar->getIdAttr());
         if (value == vec4::null) continue;
 
-        // ajouter les coordonnées s'il le faut
-        for (int i=0; i<components; i++) {
-            vbovar->push(value[i]);
-        }
+        // ajouter les coordonnées s'il le faut, codées selon le format de la variable
+        vbovar->pack(value, vbovar->getData());
     }
 }
 
@@ -237,9 +420,20 @@ void VBOset::appendVertexComponents(MeshVertex* vertex)
  * @param data : données à placer dans le VBO entrelacé
  */
 void VBOset::createInterleavedDataAttributesVBO(std::vector<GLfloat>& data)
+{
+    createInterleavedDataAttributesVBO(data.data(), data.size());
+}
+
+
+/**
+ * Cette méthode crée le VBO contenant les attributs entrelacés
+ * @param data : adresse des données à placer dans le VBO entrelacé
+ * @param count : nombre de mots de 4 octets de data, voir VBOvar::pack
+ */
+void VBOset::createInterleavedDataAttributesVBO(const GLfloat* data, int count)
 {
     // allouer le VBO
-    GLint VBOid = Utils::makeFloatVBO(data,GL_ARRAY_BUFFER, GL_STATIC_DRAW);
+    GLint VBOid = Utils::makeRawVBO(data, count*sizeof(GLfloat), GL_ARRAY_BUFFER, GL_STATIC_DRAW);
 
     // calculer le grand pas global, mettre à jour les décalages
     m_VBOdataStride = 0;
@@ -247,21 +441,33 @@ void VBOset::createInterleavedDataAttributesVBO(std::vector<GLfloat>& data)
         vbovar->setId(VBOid);
         vbovar->setIsOwned((m_VBOdataStride == 0));
         vbovar->setOffset(m_VBOdataStride);
-        m_VBOdataStride += vbovar->getComponentsCount() * Utils::SIZEOF_FLOAT;
+        m_VBOdataStride += vbovar->getWordsCount() * Utils::SIZEOF_FLOAT;
     }
+    m_VertexCount = (m_VBOdataStride > 0) ? count * Utils::SIZEOF_FLOAT / m_VBOdataStride : 0;
 }
 
 
 /**
- * Cette méthode crée les VBO des attributs entrelacés
+ * Cette méthode numérote les sommets du maillage et rassemble leurs attributs entrelacés
  * @param mesh : fournit la liste des sommets à placer dans les VBO
+ * @param data : tableau qui reçoit les composantes des sommets
  */
-void VBOset::createInterleavedAttributesVBO(Mesh* mesh)
+void VBOset::collectInterleavedAttributes(Mesh* mesh, std::vector<GLfloat>& data)
+{
+    collectInterleavedAttributes(mesh->getVertexList(), data);
+}
+
+
+/**
+ * Cette méthode numérote les sommets dans l'ordre fourni et rassemble leurs attributs entrelacés
+ * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+ * @param data : tableau qui reçoit les composantes des sommets
+ */
+void VBOset::collectInterleavedAttributes(const std::vector<MeshVertex*>& vertexlist, std::vector<GLfloat>& data)
 {
     // rassembler les coordonnées, couleurs, normales et coordonnées de texture
-    std::vector<GLfloat> data;
     int iv = 0;
-    for (MeshVertex* vertex: mesh->getVertexList()) {
+    for (MeshVertex* vertex: vertexlist) {
         // renuméroter le sommet (numéro dans les VBOs)
         vertex->setNumber(iv);
         iv++;
@@ -269,6 +475,28 @@ void VBOset::createInterleavedAttributesVBO(Mesh* mesh)
         // ajouter les valeurs des variables attributs (VBOvar)
         appendVertexComponents(vertex, data);
     }
+}
+
+
+/**
+ * Cette méthode crée les VBO des attributs entrelacés
+ * @param mesh : fournit la liste des sommets à placer dans les VBO
+ */
+void VBOset::createInterleavedAttributesVBO(Mesh* mesh)
+{
+    createInterleavedAttributesVBO(mesh->getVertexList());
+}
+
+
+/**
+ * Cette méthode crée les VBO des attributs entrelacés, les sommets étant rangés dans l'ordre fourni
+ * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+ */
+void VBOset::createInterleavedAttributesVBO(const std::vector<MeshVertex*>& vertexlist)
+{
+    // rassembler les coordonnées, couleurs, normales et coordonnées de texture
+    std::vector<GLfloat> data;
+    collectInterleavedAttributes(vertexlist, data);
 
     // créer le VBO entrelacé
     createInterleavedDataAttributesVBO(data);
@@ -280,10 +508,20 @@ void VBOset::createInterleavedAttributesVBO(Mesh* mesh)
  * @param mesh : fournit la liste des sommets à placer dans les VBO
  */
 void VBOset::createMultipleAttributesVBO(Mesh* mesh)
+{
+    createMultipleAttributesVBO(mesh->getVertexList());
+}
+
+
+/**
+ * Cette méthode crée les VBO des attributs multiples, les sommets étant rangés dans l'ordre fourni
+ * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+ */
+void VBOset::createMultipleAttributesVBO(const std::vector<MeshVertex*>& vertexlist)
 {
     // rassembler les coordonnées, couleurs et/ou normales demandées
     int iv = 0;
-    for (MeshVertex* vertex: mesh->getVertexList()) {
+    for (MeshVertex* vertex: vertexlist) {
         // renuméroter le sommet (numéro dans les VBOs)
         vertex->setNumber(iv);
         iv++;
@@ -300,6 +538,7 @@ void VBOset::createMultipleAttributesVBO(Mesh* mesh)
         vbovar->setOffset(0);
         vbovar->clear();
     }
+    m_VertexCount = iv;
 }
 
 
@@ -309,12 +548,24 @@ void VBOset::createMultipleAttributesVBO(Mesh* mesh)
  * @param interleaved : true (par défaut) s'il faut entrelacer les données
  */
 void VBOset::createAttributesVBO(Mesh* mesh, bool interleaved)
+{
+    createAttributesVBO(mesh->getVertexList(), interleaved);
+}
+
+
+/**
+ * Cette méthode crée les VBO des attributs, les sommets étant rangés dans l'ordre fourni,
+ * par exemple celui de leur première utilisation par les triangles
+ * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+ * @param interleaved : true (par défaut) s'il faut entrelacer les données
+ */
+void VBOset::createAttributesVBO(const std::vector<MeshVertex*>& vertexlist, bool interleaved)
 {
     // création des VBOs
     if (interleaved) {
-        createInterleavedAttributesVBO(mesh);
+        createInterleavedAttributesVBO(vertexlist);
     } else {
-        createMultipleAttributesVBO(mesh);
+        createMultipleAttributesVBO(vertexlist);
     }
 }
 
@@ -332,20 +583,8 @@ void VBOset::createDirectPrimitiveVBO(int primitive, int number)
     m_IndexBufferSize = number;
 
     // création du VAO
-    if (m_VAO >= 0) glDeleteVertexArrays(1, &m_VAO);
-    glGenVertexArrays(1, &m_VAO);
-
-    // activation du VAO
-    glBindVertexArray(m_VAO);
-
-    // activer et lier les VBOs liés aux variables attribute
-    for (VBOvar* vbovar: m_VBOvariables) {
-        vbovar->bindVBO(m_VBOdataStride);
-    }
-
-    // désactivation du VAO et des VBO
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    deleteVAOs();
+    m_VAO = createVAO();
 }
 
 
@@ -356,39 +595,239 @@ void VBOset::createDirectPrimitiveVBO(int primitive, int number)
  * @return nombre d'indices présents dans le VBO
  */
 int VBOset::createIndexedPrimitiveVBO(int primitive, std::vector<int>& indexlist)
+{
+    return createIndexedPrimitiveVBO(primitive, (const GLuint*) indexlist.data(), indexlist.size());
+}
+
+
+/**
+ * Cette méthode initialise le VBOset pour dessiner la primitive avec les indices
+ * @param primitive : par exemple GL_TRIANGLES
+ * @param indexlist : adresse du tableau des indices
+ * @param count : nombre d'indices
+ * @return nombre d'indices présents dans le VBO
+ */
+int VBOset::createIndexedPrimitiveVBO(int primitive, const GLuint* indexlist, int count)
 {
     // initialisations
     m_DrawingPrimitive = primitive;
-    m_IndexBufferSize = indexlist.size();
-    if (m_IndexBufferSize > 65534) {
-        m_IndexBufferId = Utils::makeIntVBO(indexlist, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
-        m_IndexBufferType = GL_UNSIGNED_INT;
-    } else {
-        m_IndexBufferId = Utils::makeShortVBO(indexlist, GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
+    m_IndexBufferSize = count;
+    deleteVAOs();
+
+    // le type des indices dépend du plus grand, 0xFFFF est laissé aux redémarrages de primitives ;
+    // pas d'indices sur 8 bits, que beaucoup de cartes convertissent à chaque dessin
+    GLuint max_index = 0;
+    for (int i=0; i<count; i++) max_index = std::max(max_index, indexlist[i]);
+    std::vector<GLushort> shortlist;
+    if (max_index < 0xFFFF) {
+        shortlist.assign(indexlist, indexlist+count);
+        m_IndexBufferId = Utils::makeRawVBO(shortlist.data(), count*sizeof(GLushort), GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
+        m_IndexBufferType = GL_UNSIGNED_SHORT;
+    } else if (splitIndexRanges(primitive, indexlist, count, shortlist)) {
+        // parties indexées sur 16 bits, chacune a son VAO décalé sur son premier sommet
+        m_IndexBufferId = Utils::makeRawVBO(shortlist.data(), shortlist.size()*sizeof(GLushort), GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
         m_IndexBufferType = GL_UNSIGNED_SHORT;
+        for (IndexRange& range: m_IndexRanges) {
+            range.vao = createVAO(range.base);
+        }
+        m_VAO = m_IndexRanges[0].vao;
+        return m_IndexBufferSize;
+    } else {
+        m_IndexBufferId = Utils::makeRawVBO(indexlist, count*sizeof(GLuint), GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW);
+        m_IndexBufferType = GL_UNSIGNED_INT;
     }
 
     // création du VAO
-    if (m_VAO >= 0) glDeleteVertexArrays(1, &m_VAO);
-    glGenVertexArrays(1, &m_VAO);
+    m_VAO = createVAO();
+
+    return m_IndexBufferSize;
+}
 
-    // activation du VAO
-    glBindVertexArray(m_VAO);
+
+/**
+ * Cette méthode crée un VAO qui lie les VBOs aux variables attribute
+ * et au VBO des indices s'il y en a un
+ * @param base : numéro du sommet qui correspond à l'indice 0
+ * @return identifiant du VAO
+ */
+GLuint VBOset::createVAO(int base)
+{
+    // création et activation du VAO
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    GLState::bindVertexArray(vao);
 
     // activer et lier les VBOs liés aux variables attribute
     for (VBOvar* vbovar: m_VBOvariables) {
-        vbovar->bindVBO(m_VBOdataStride);
+        vbovar->bindVBO(m_VBOdataStride, base);
     }
 
+    // liaison du VBO des matrices des instances
+    if (m_InstanceLoc >= 0) bindInstanceVBO();
+
     // liaison du VBO des indices
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferId);
+    if (m_IndexBufferId >= 0) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferId);
 
     // désactivation du VAO et des VBO
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    return m_IndexBufferSize;
+    return vao;
+}
+
+
+/**
+ * Cette méthode supprime tous les VAO
+ */
+void VBOset::deleteVAOs()
+{
+    if (m_IndexRanges.empty()) {
+        if (m_VAO >= 0) GLState::deleteVertexArrays(1, &m_VAO);
+    } else {
+        for (IndexRange& range: m_IndexRanges) {
+            GLState::deleteVertexArrays(1, &range.vao);
+        }
+        m_IndexRanges.clear();
+    }
+    m_VAO = -1;
+}
+
+
+/**
+ * Cette méthode lie le VBO des matrices des instances à la variable glInstanceMatrix
+ * du VAO actif. Une mat4 occupe quatre emplacements consécutifs, un par colonne.
+ * Le VBO est créé vide au premier appel, il est rempli par onDrawInstanced.
+ */
+void VBOset::bindInstanceVBO()
+{
+    if (m_InstanceBufferId == 0) glGenBuffers(1, &m_InstanceBufferId);
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferId);
+    for (int column=0; column<4; column++) {
+        GLuint loc = m_InstanceLoc + column;
+        glEnableVertexAttribArray(loc);
+        glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, sizeof(mat4), (const GLvoid*) (column * 4 * sizeof(GLfloat)));
+        glVertexAttribDivisor(loc, 1);
+    }
+}
+
+
+/**
+ * Cette méthode découpe les indices en parties dont les indices, relatifs au plus petit
+ * d'entre eux, tiennent sur 16 bits. Les coupures sont faites entre deux primitives.
+ * @param primitive : GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_LINES ou GL_POINTS
+ * @param indexlist : adresse du tableau des indices
+ * @param count : nombre d'indices
+ * @param shortlist : reçoit les indices relatifs de toutes les parties, à la suite
+ * @return false si le découpage est impossible ou donnerait trop de parties
+ */
+bool VBOset::splitIndexRanges(int primitive, const GLuint* indexlist, int count, std::vector<GLushort>& shortlist)
+{
+    // nombre d'indices par primitive, et nombre d'indices répétés au début de la partie suivante
+    int step = 1;
+    int overlap = 0;
+    switch (primitive) {
+    case GL_TRIANGLES:      step = 3; break;
+    case GL_LINES:          step = 2; break;
+    case GL_POINTS:         step = 1; break;
+    case GL_TRIANGLE_STRIP: step = 1; overlap = 2; break;
+    default: return false;
+    }
+
+    // allonger chaque partie tant que l'écart entre ses indices extrêmes tient sur 16 bits
+    int start = 0;
+    while (start < count) {
+        GLuint lo = indexlist[start];
+        GLuint hi = lo;
+        int end = start;
+        while (end < count) {
+            GLuint unit_lo = lo, unit_hi = hi;
+            for (int i=end; i<end+step && i<count; i++) {
+                unit_lo = std::min(unit_lo, indexlist[i]);
+                unit_hi = std::max(unit_hi, indexlist[i]);
+            }
+            if (unit_hi - unit_lo >= 0xFFFF) break;
+            lo = unit_lo;
+            hi = unit_hi;
+            end = std::min(end+step, count);
+        }
+
+        // un ruban doit reprendre sur un indice pair pour garder l'orientation de ses triangles
+        if (overlap > 0 && end < count && (end - overlap) % 2 != 0) end--;
+
+        // une seule primitive trop étendue : le découpage est impossible
+        if (end - start < step + overlap) {
+            m_IndexRanges.clear();
+            return false;
+        }
+
+        // ajouter la partie
+        IndexRange range;
+        range.vao = -1;
+        range.offset = shortlist.size();
+        range.count = end - start;
+        range.base = lo;
+        m_IndexRanges.push_back(range);
+        for (int i=start; i<end; i++) {
+            shortlist.push_back(indexlist[i] - lo);
+        }
+        if (end >= count) break;
+        start = end - overlap;
+    }
+
+    // chaque partie coûte un appel de dessin, il faut qu'elles restent grandes
+    if (m_IndexRanges.size() * 4096 > (size_t) count) {
+        m_IndexRanges.clear();
+        shortlist.clear();
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * retourne une chaîne qui décrit les variables attributs de ce VBOset
+ * (numéros d'attributs, nombres de composantes et formats), pour vérifier que des
+ * données entrelacées enregistrées correspondent toujours au matériau
+ * @return signature, ex: "0:3,1:4/4,2:3/2"
+ */
+std::string VBOset::getAttributesSignature()
+{
+    std::ostringstream signature;
+    for (VBOvar* vbovar: m_VBOvariables) {
+        if (signature.tellp() > 0) signature << ",";
+        signature << vbovar->getIdAttr() << ":" << vbovar->getComponentsCount();
+        if (vbovar->getFormat() != VBOvar::FORMAT_FLOAT) signature << "/" << vbovar->getFormat();
+    }
+    return signature.str();
+}
+
+
+/**
+ * retourne la place occupée par un sommet dans les VBO
+ * @return nombre d'octets par sommet
+ */
+int VBOset::getVertexSize()
+{
+    int size = 0;
+    for (VBOvar* vbovar: m_VBOvariables) {
+        size += vbovar->getWordsCount() * Utils::SIZEOF_FLOAT;
+    }
+    return size;
+}
+
+
+/**
+ * retourne la place qu'occuperait un sommet si toutes ses composantes étaient des GL_FLOAT
+ * @return nombre d'octets par sommet
+ */
+int VBOset::getFloatVertexSize()
+{
+    int size = 0;
+    for (VBOvar* vbovar: m_VBOvariables) {
+        size += vbovar->getComponentsCount() * Utils::SIZEOF_FLOAT;
+    }
+    return size;
 }
 
 
@@ -398,7 +837,7 @@ int VBOset::createIndexedPrimitiveVBO(int primitive, std::vector<int>& indexlist
 void VBOset::enable()
 {
     // avec un VAO, il suffit d'activer le VAO
-    glBindVertexArray(m_VAO);
+    GLState::bindVertexArray(m_VAO);
 }
 
 
@@ -408,7 +847,7 @@ void VBOset::enable()
 void VBOset::disable()
 {
     // avec un VAO, il suffit de désactiver le VAO
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 
@@ -416,35 +855,134 @@ void VBOset::disable()
  * Cette méthode dessine le VBOset, avec les éléments demandés :
  * @param mat4Projection : matrice de projection
  * @param mat4ModelView : matrice de vue
+ * @param release : false pour laisser le matériau actif, quand le dessin suivant emploie le même
+ * @param acquire : false si le matériau est resté actif depuis le dessin précédent, voir release ;
+ * seule sa matrice ModelView est alors mise à jour
  */
-void VBOset::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
+void VBOset::onDraw(mat4 mat4Projection, mat4 mat4ModelView, bool release, bool acquire)
 {
+    PROFILE_ZONE("VBOset::onDraw");
     if (m_IndexBufferSize <= 0) return;
 
-    // activer le matériau (shader <-> VBOs)
-    m_Material->enable(mat4Projection, mat4ModelView);
+    // un matériau instancié lit la matrice de chaque instance : en dessiner une seule, sans
+    // transformation ; l'identité n'est envoyée que si le VBO des instances ne la contient pas déjà
+    if (m_InstanceLoc >= 0 && !m_InstanceIdentity) {
+        static mat4 identity = mat4::create();
+        glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferId);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(mat4), &identity[0], GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        m_InstanceIdentity = true;
+    }
+
+    // activer le matériau (shader <-> VBOs), ou seulement changer sa matrice s'il est encore actif
+    if (acquire) {
+        m_Material->enable(mat4Projection, mat4ModelView);
+    } else {
+        m_Material->setModelView(mat4ModelView);
+    }
 
     // activer et lier les VBO
     enable();
 
-    // dessin indexé ?
-    if (m_IndexBufferId >= 0) {
+    // dessiner les primitives
+    draw(m_InstanceLoc >= 0 ? 1 : 0);
 
-        // dessin des triangles
-        glDrawElements(m_DrawingPrimitive, m_IndexBufferSize, m_IndexBufferType, 0);
+    // libération du shader et des autres VBOs
+    disable();
+    if (release) m_Material->disable();
+}
 
-    } else {
 
-        // dessin non indexé
-        glDrawArrays(m_DrawingPrimitive, 0, m_IndexBufferSize);
+/**
+ * Cette méthode dessine plusieurs instances du VBOset en un seul appel de dessin.
+ * Si le matériau n'est pas instancié, voir Material::setInstanced, les instances
+ * sont dessinées une par une.
+ * @param mat4Projection : matrice de projection
+ * @param mat4View : matrice de vue, commune à toutes les instances
+ * @param transforms : matrice de chaque instance, appliquée avant mat4View
+ */
+void VBOset::onDrawInstanced(mat4 mat4Projection, mat4 mat4View, std::vector<mat4>& transforms)
+{
+    PROFILE_ZONE("VBOset::onDrawInstanced");
+    if (m_IndexBufferSize <= 0 || transforms.empty()) return;
+
+    // sans glInstanceMatrix dans le shader, dessiner les instances une par une
+    if (m_InstanceLoc < 0) {
+        mat4 mat4ModelView = mat4::create();
+        for (mat4& transform: transforms) {
+            mat4::multiply(mat4ModelView, mat4View, transform);
+            onDraw(mat4Projection, mat4ModelView);
+        }
+        return;
     }
 
+    // remplacer les matrices des instances, le pilote alloue un autre buffer si
+    // le précédent est encore employé par un dessin en cours
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBufferId);
+    glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(mat4), &transforms[0][0], GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_InstanceIdentity = false;
+
+    // activer le matériau avec la matrice de vue, puis les VBO
+    m_Material->enable(mat4Projection, mat4View);
+    enable();
+
+    // dessiner toutes les instances
+    draw(transforms.size());
+
     // libération du shader et des autres VBOs
     disable();
     m_Material->disable();
 }
 
 
+/**
+ * Cette méthode lance le dessin des primitives avec les VAO, le matériau étant actif
+ * @param instances : nombre d'instances à dessiner, 0 pour un dessin ordinaire
+ */
+void VBOset::draw(GLsizei instances)
+{
+    // dessin indexé ?
+    if (!m_IndexRanges.empty()) {
+
+        // dessin de chaque partie avec son VAO
+        for (IndexRange& range: m_IndexRanges) {
+            GLState::bindVertexArray(range.vao);
+            const GLvoid* offset = (const GLvoid*) (range.offset * sizeof(GLushort));
+            if (instances > 0) {
+                glDrawElementsInstanced(m_DrawingPrimitive, range.count, m_IndexBufferType, offset, instances);
+                PROFILE_DRAW_INSTANCED(m_DrawingPrimitive, range.count, instances);
+            } else {
+                glDrawElements(m_DrawingPrimitive, range.count, m_IndexBufferType, offset);
+                PROFILE_DRAW(m_DrawingPrimitive, range.count);
+            }
+        }
+
+    } else if (m_IndexBufferId >= 0) {
+
+        // dessin des triangles
+        if (instances > 0) {
+            glDrawElementsInstanced(m_DrawingPrimitive, m_IndexBufferSize, m_IndexBufferType, 0, instances);
+            PROFILE_DRAW_INSTANCED(m_DrawingPrimitive, m_IndexBufferSize, instances);
+        } else {
+            glDrawElements(m_DrawingPrimitive, m_IndexBufferSize, m_IndexBufferType, 0);
+            PROFILE_DRAW(m_DrawingPrimitive, m_IndexBufferSize);
+        }
+
+    } else {
+
+        // dessin non indexé
+        if (instances > 0) {
+            glDrawArraysInstanced(m_DrawingPrimitive, 0, m_IndexBufferSize, instances);
+            PROFILE_DRAW_INSTANCED(m_DrawingPrimitive, m_IndexBufferSize, instances);
+        } else {
+            glDrawArrays(m_DrawingPrimitive, 0, m_IndexBufferSize);
+            PROFILE_DRAW(m_DrawingPrimitive, m_IndexBufferSize);
+        }
+    }
+}
+
+
 /**
  * met à jour les emplacements des variables du VBOset suite à une recompilation du shader
  */
@@ -453,4 +991,17 @@ void VBOset::updateLocations()
     for (VBOvar* vbovar: m_VBOvariables) {
         vbovar->updateShader(m_Material->getShaderId());
     }
+    m_InstanceLoc = glGetAttribLocation(m_Material->getShaderId(), "glInstanceMatrix");
+
+    // les VAO mémorisent les emplacements, il faut les refaire
+    if (!m_IndexRanges.empty()) {
+        for (IndexRange& range: m_IndexRanges) {
+            GLState::deleteVertexArrays(1, &range.vao);
+            range.vao = createVAO(range.base);
+        }
+        m_VAO = m_IndexRanges[0].vao;
+    } else if (m_VAO != (GLuint) -1) {
+        GLState::deleteVertexArrays(1, &m_VAO);
+        m_VAO = createVAO();
+    }
 }
@@ -20,6 +20,15 @@
  */
 class VBOvar
 {
+public:
+
+    /// formats de stockage des composantes dans le VBO, voir VBOset::addAttribute
+    static const int FORMAT_FLOAT = 0;              // GL_FLOAT, 4 octets par composante
+    static const int FORMAT_HALF = 1;               // GL_HALF_FLOAT, 2 octets par composante
+    static const int FORMAT_INT_2_10_10_10 = 2;     // GL_INT_2_10_10_10_REV normalisé, 4 octets, valeurs dans [-1,1]
+    static const int FORMAT_USHORT = 3;             // GL_UNSIGNED_SHORT normalisé, 2 octets par composante, valeurs dans [0,1]
+    static const int FORMAT_UBYTE = 4;              // GL_UNSIGNED_BYTE normalisé, 1 octet par composante, valeurs dans [0,1]
+
 private:
 
     /// nom de la variable attribute
@@ -31,9 +40,12 @@ private:
     /// identifiant de l'attribut de vertex concerné, ex: MeshVertex.ID_ATTR_VERTEX
     int m_IdAttr;
 
-    /// nombre de composantes GL_FLOAT de cet attribut
+    /// nombre de composantes de cet attribut
     GLint m_ComponentsNumber;
 
+    /// format de stockage des composantes, ex: VBOvar::FORMAT_HALF
+    int m_Format;
+
     /// identifiant du VBO à lier avec la variable attribute
     GLuint m_VBOId;
 
@@ -58,9 +70,10 @@ public:
      * @param shaderId : identifiant du shader employant cette variable attribute
      * @param name : nom de la variable attribute dans le shader
      * @param idattr : numéro de l'attribut, ex: MeshVertex.ID_ATTR_VERTEX
-     * @param components : nombre de composantes float de la variable
+     * @param components : nombre de composantes de la variable
+     * @param format : stockage des composantes dans le VBO, ex: VBOvar::FORMAT_FLOAT
      */
-    VBOvar(GLint shaderId, std::string name, int idattr, int type);
+    VBOvar(GLint shaderId, std::string name, int idattr, int components, int format=FORMAT_FLOAT);
 
     /**
      * destructeur
@@ -94,6 +107,21 @@ public:
          return m_ComponentsNumber;
      }
 
+    /**
+     * retourne le format de stockage des composantes
+     * @return format, ex: VBOvar::FORMAT_HALF
+     */
+     int getFormat()
+     {
+         return m_Format;
+     }
+
+    /**
+     * retourne la place occupée par cette variable dans un sommet, en mots de 4 octets
+     * @return nombre de mots, ex: 2 pour 3 composantes en FORMAT_HALF
+     */
+    int getWordsCount();
+
     /**
      * retourne l'identifiant de VBO
      * @return identifiant OpenGL
@@ -145,11 +173,20 @@ public:
      */
     void push(float value);
 
+    /**
+     * ajoute les composantes d'une valeur au tableau data, codées selon le format
+     * de la variable, en complétant le dernier mot de 4 octets avec des zéros
+     * @param value : valeur de l'attribut sur un sommet
+     * @param data : tableau qui reçoit getWordsCount() mots
+     */
+    void pack(vec4& value, std::vector<GLfloat>& data);
+
     /**
      * Cette méthode effectue la liaison entre une variable attribute et un VBO
      * @param stride : grand pas des données dans le VBO
+     * @param base : numéro du sommet qui correspond à l'indice 0, voir VBOset::IndexRange
      */
-    void bindVBO(int stride);
+    void bindVBO(int stride, int base=0);
 
     /**
      * Désactive le VBO concerné
@@ -182,6 +219,9 @@ private:
     /// grand pas global
     GLint m_VBOdataStride;
 
+    /// nombre de sommets dans les VBO
+    int m_VertexCount;
+
     /// identifiant du VBO des indices
     GLint m_IndexBufferId;
 
@@ -197,6 +237,66 @@ private:
     /// identifiant du VAO
     GLuint m_VAO;
 
+    /**
+     * partie des indices qui est dessinée avec son propre VAO : ses indices sont
+     * relatifs au sommet base, ce qui permet de les coder sur 16 bits même
+     * quand le maillage a plus de 65535 sommets
+     */
+    struct IndexRange {
+        GLuint vao;
+        int offset;
+        int count;
+        int base;
+    };
+
+    /// parties du VBO des indices, vide si tous les indices sont dessinés avec m_VAO
+    std::vector<IndexRange> m_IndexRanges;
+
+    /// emplacement de la variable attribute glInstanceMatrix, -1 si le matériau n'est pas instancié
+    GLint m_InstanceLoc;
+
+    /// identifiant du VBO des matrices des instances, 0 s'il n'est pas encore créé
+    GLuint m_InstanceBufferId;
+
+    /// true si le VBO des instances contient seulement la matrice identité, voir onDraw
+    bool m_InstanceIdentity;
+
+    /**
+     * Cette méthode crée un VAO qui lie les VBOs aux variables attribute
+     * et au VBO des indices s'il y en a un
+     * @param base : numéro du sommet qui correspond à l'indice 0
+     * @return identifiant du VAO
+     */
+    GLuint createVAO(int base=0);
+
+    /**
+     * Cette méthode supprime tous les VAO
+     */
+    void deleteVAOs();
+
+    /**
+     * Cette méthode lie le VBO des matrices des instances à la variable glInstanceMatrix
+     * du VAO actif, une colonne par emplacement, avec un changement à chaque instance
+     */
+    void bindInstanceVBO();
+
+    /**
+     * Cette méthode lance le dessin des primitives avec les VAO
+     * @param instances : nombre d'instances à dessiner, 0 pour un dessin ordinaire
+     */
+    void draw(GLsizei instances);
+
+    /**
+     * Cette méthode découpe les indices en parties dont les indices, relatifs au plus petit
+     * d'entre eux, tiennent sur 16 bits. Les coupures sont faites entre deux primitives.
+     * @param primitive : GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_LINES ou GL_POINTS
+     * @param indexlist : adresse du tableau des indices
+     * @param count : nombre d'indices
+     * @param shortlist : reçoit les indices relatifs de toutes les parties, à la suite
+     * @return false si le découpage est impossible ou donnerait trop de parties
+     */
+    bool splitIndexRanges(int primitive, const GLuint* indexlist, int count, std::vector<GLushort>& shortlist);
+
 
 public:
 
@@ -216,8 +316,9 @@ public:
      * @param idattr : voir la classe MeshVertex et getAttribute, par exemple MeshVertex::ATTR_ID_VERTEX, MeshVertex::ATTR_ID_COLOR
      * @param components : ex: 2 ou mieux Utils::VEC2
      * @param name : nom de la variable concernée ex: "glTexCoord"
+     * @param format : stockage des composantes dans le VBO, ex: VBOvar::FORMAT_HALF
      */
-    void addAttribute(int idattr, int components, std::string name);
+    void addAttribute(int idattr, int components, std::string name, int format=VBOvar::FORMAT_FLOAT);
 
     /**
      * ajoute les composantes du vertex au tableau data, s'il est fourni (VBO entrelacé), sinon
@@ -234,18 +335,51 @@ public:
      */
     void createInterleavedDataAttributesVBO(std::vector<GLfloat>& data);
 
+    /**
+     * Cette méthode crée le VBO contenant les attributs entrelacés
+     * @param data : adresse des données à placer dans le VBO entrelacé
+     * @param count : nombre de mots de 4 octets de data, voir VBOvar::pack
+     */
+    void createInterleavedDataAttributesVBO(const GLfloat* data, int count);
+
+    /**
+     * Cette méthode numérote les sommets du maillage et rassemble leurs attributs entrelacés
+     * @param mesh : fournit la liste des sommets à placer dans les VBO
+     * @param data : tableau qui reçoit les composantes des sommets
+     */
+    void collectInterleavedAttributes(Mesh* mesh, std::vector<GLfloat>& data);
+
+    /**
+     * Cette méthode numérote les sommets dans l'ordre fourni et rassemble leurs attributs entrelacés
+     * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+     * @param data : tableau qui reçoit les composantes des sommets
+     */
+    void collectInterleavedAttributes(const std::vector<MeshVertex*>& vertexlist, std::vector<GLfloat>& data);
+
     /**
      * Cette méthode crée les VBO des attributs entrelacés
      * @param mesh : fournit la liste des sommets à placer dans les VBO
      */
     void createInterleavedAttributesVBO(Mesh* mesh);
 
+    /**
+     * Cette méthode crée les VBO des attributs entrelacés, les sommets étant rangés dans l'ordre fourni
+     * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+     */
+    void createInterleavedAttributesVBO(const std::vector<MeshVertex*>& vertexlist);
+
     /**
      * Cette méthode crée les VBO des attributs multiples
      * @param mesh : fournit la liste des sommets à placer dans les VBO
      */
     void createMultipleAttributesVBO(Mesh* mesh);
 
+    /**
+     * Cette méthode crée les VBO des attributs multiples, les sommets étant rangés dans l'ordre fourni
+     * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+     */
+    void createMultipleAttributesVBO(const std::vector<MeshVertex*>& vertexlist);
+
     /**
      * Cette méthode crée les VBO des attributs : coordonnées, couleurs, normales et coordonnées de texture
      * @param mesh : fournit la liste des sommets à placer dans les VBO
@@ -253,6 +387,14 @@ public:
      */
     void createAttributesVBO(Mesh* mesh, bool interleaved=true);
 
+    /**
+     * Cette méthode crée les VBO des attributs, les sommets étant rangés dans l'ordre fourni,
+     * par exemple celui de leur première utilisation par les triangles
+     * @param vertexlist : sommets à placer dans les VBO, dans l'ordre où ils doivent y être
+     * @param interleaved : true (par défaut) s'il faut entrelacer les données
+     */
+    void createAttributesVBO(const std::vector<MeshVertex*>& vertexlist, bool interleaved=true);
+
     /**
      * Cette méthode initialise le VBOset pour dessiner la primitive sans indices
      * @param primitive : par exemple GL_TRIANGLES
@@ -268,6 +410,55 @@ public:
      */
     int createIndexedPrimitiveVBO(int primitive, std::vector<int>& indexlist);
 
+    /**
+     * Cette méthode initialise le VBOset pour dessiner la primitive avec les indices.
+     * Les indices sont codés sur 8, 16 ou 32 bits selon le plus grand d'entre eux. Au delà
+     * de 16 bits, ils sont si possible découpés en parties indexables sur 16 bits.
+     * @param primitive : par exemple GL_TRIANGLES
+     * @param indexlist : adresse du tableau des indices
+     * @param count : nombre d'indices
+     * @return nombre d'indices présents dans le VBO
+     */
+    int createIndexedPrimitiveVBO(int primitive, const GLuint* indexlist, int count);
+
+    /**
+     * retourne le matériau avec lequel ce VBOset est dessiné
+     * @return matériau
+     */
+    Material* getMaterial()
+    {
+        return m_Material;
+    }
+
+    /**
+     * retourne le nombre de sommets placés dans les VBO
+     * @return nombre de sommets
+     */
+    int getVertexCount()
+    {
+        return m_VertexCount;
+    }
+
+    /**
+     * retourne la place occupée par un sommet dans les VBO
+     * @return nombre d'octets par sommet
+     */
+    int getVertexSize();
+
+    /**
+     * retourne la place qu'occuperait un sommet si toutes ses composantes étaient des GL_FLOAT
+     * @return nombre d'octets par sommet
+     */
+    int getFloatVertexSize();
+
+    /**
+     * retourne une chaîne qui décrit les variables attributs de ce VBOset
+     * (numéros d'attributs, nombres de composantes et formats), pour vérifier que des
+     * données entrelacées enregistrées correspondent toujours au matériau
+     * @return signature, ex: "0:3,1:4/4,2:3/2"
+     */
+    std::string getAttributesSignature();
+
     /**
      * Cette méthode active les VBOs et fait la liaison avec les attribute du shader
      */
@@ -282,11 +473,24 @@ public:
      * Cette méthode dessine le VBOset, avec les éléments demandés :
      * @param mat4Projection : matrice de projection
      * @param mat4ModelView : matrice de vue
+     * @param release : false pour laisser le matériau actif, quand le dessin suivant emploie le même
+     * @param acquire : false si le matériau est resté actif depuis le dessin précédent, voir release ;
+     * seule sa matrice ModelView est alors mise à jour
+     */
+    void onDraw(mat4 mat4Projection, mat4 mat4ModelView, bool release=true, bool acquire=true);
+
+    /**
+     * Cette méthode dessine plusieurs instances du VBOset en un seul appel de dessin.
+     * Si le matériau n'est pas instancié, voir Material::setInstanced, les instances
+     * sont dessinées une par une.
+     * @param mat4Projection : matrice de projection
+     * @param mat4View : matrice de vue, commune à toutes les instances
+     * @param transforms : matrice de chaque instance, appliquée avant mat4View
      */
-    void onDraw(mat4 mat4Projection, mat4 mat4ModelView);
+    void onDrawInstanced(mat4 mat4Projection, mat4 mat4View, std::vector<mat4>& transforms);
 
     /**
-     * met à jour les emplacements des variables du VBOset suite à une recompilation du shader
+     * met à jour les emplacements des variables du VBOset et ses VAO suite à une recompilation du shader
      */
     void updateLocations();
 
@@ -20,6 +20,8 @@
 Mesh::Mesh(std::string name)
 {
     m_Name = name;
+    m_HalfEdgeIndexValid = false;
+    m_BuildDepth = 0;
 }
 
 
@@ -28,29 +30,162 @@ Mesh::Mesh(std::string name)
  */
 Mesh::~Mesh()
 {
-    // supprimer les triangles
+    clear();
+}
+
+
+/**
+ * supprime tous les sommets, triangles, arêtes et demi-arêtes du maillage.
+ * Les éléments sont d'abord détachés les uns des autres, leurs destructeurs
+ * n'ont alors plus aucun chaînage à défaire : le coût est linéaire.
+ */
+void Mesh::clear()
+{
+    // détacher les demi-arêtes : plus d'opposée, d'arête ni de sommet à mettre à jour
+    for (MeshHalfEdge* halfedge: m_HalfEdgeList) {
+        halfedge->m_Mesh = nullptr;
+        halfedge->m_Opposite = nullptr;
+        halfedge->m_Edge = nullptr;
+        halfedge->m_Origin = nullptr;
+    }
+    // détacher les triangles de leurs demi-arêtes et les sommets de leur éventail
     for (MeshTriangle* triangle: m_TriangleList) {
-        triangle->setMesh(nullptr);
-        delete triangle;
+        triangle->m_Mesh = nullptr;
+        triangle->m_HalfEdge = nullptr;
     }
-    // supprimer les sommets
     for (MeshVertex* vertex: m_VertexList) {
-        vertex->setMesh(nullptr);
-        delete vertex;
+        vertex->m_Mesh = nullptr;
+        vertex->m_HalfEdge = nullptr;
+        vertex->m_Valence = 0;
+        vertex->m_MidpointOf = nullptr;
     }
-    // supprimer les arêtes qui resteraient
     for (MeshEdge* edge: m_EdgeList) {
-        edge->setMesh(nullptr);
-        delete edge;
+        edge->m_Mesh = nullptr;
+        edge->m_Midpoint = nullptr;
     }
-    // supprimer les demi-arêtes qui resteraient
+
+    // supprimer les éléments, aucun n'accède plus aux autres ni aux listes
+    for (MeshTriangle* triangle: m_TriangleList) delete triangle;
+    for (MeshHalfEdge* halfedge: m_HalfEdgeList) delete halfedge;
+    for (MeshEdge* edge: m_EdgeList) delete edge;
+    for (MeshVertex* vertex: m_VertexList) delete vertex;
+    m_TriangleList.clear();
+    m_HalfEdgeList.clear();
+    m_EdgeList.clear();
+    m_VertexList.clear();
+
+    // libérer les canaux d'attributs
+    m_VertexData.clear();
+
+    // vider l'index, il reste actif si une construction est en cours
+    m_HalfEdgeIndex.clear();
+}
+
+
+/**
+ * commence une phase de construction : jusqu'à endBuild(), les demi-arêtes qui partent
+ * des sommets de forte valence sont indexées par leurs sommets, ce qui évite de parcourir
+ * l'éventail de ces sommets à chaque nouveau triangle. Les phases peuvent être imbriquées.
+ * NB : l'index est construit à partir des demi-arêtes existantes, il vaut mieux
+ * appeler cette méthode une fois avant un grand nombre d'ajouts
+ */
+void Mesh::beginBuild()
+{
+    // seule la phase la plus externe construit l'index
+    if (m_BuildDepth++ > 0) return;
+
+    // indexer les demi-arêtes existantes
+    m_HalfEdgeIndex.clear();
     for (MeshHalfEdge* halfedge: m_HalfEdgeList) {
-        halfedge->setMesh(nullptr);
-        delete halfedge;
+        MeshVertex* origin = halfedge->getOrigin();
+        MeshVertex* target = halfedge->getTarget();
+        if (target != nullptr && origin->getValence() >= INDEX_MIN_VALENCE) {
+            m_HalfEdgeIndex.insert(origin, target, halfedge);
+        }
+    }
+    m_HalfEdgeIndexValid = true;
+}
+
+
+/**
+ * termine une phase de construction, l'index des demi-arêtes est libéré
+ * à la fin de la phase la plus externe
+ */
+void Mesh::endBuild()
+{
+    if (m_BuildDepth == 0 || --m_BuildDepth > 0) return;
+
+    // libérer la mémoire de l'index
+    m_HalfEdgeIndex.clear();
+    m_HalfEdgeIndexValid = false;
+}
+
+
+/**
+ * retourne la demi-arête allant de origin à target, par l'index si une construction
+ * est en cours et que origin a une forte valence, sinon par l'éventail de origin
+ * @param origin : sommet de départ
+ * @param target : sommet d'arrivée
+ * @return demi-arête ou nullptr si absente
+ */
+MeshHalfEdge* Mesh::findHalfEdge(MeshVertex* origin, MeshVertex* target)
+{
+    if (! m_HalfEdgeIndexValid || origin->getValence() < INDEX_MIN_VALENCE) return origin->getHalfEdgeTo(target);
+    return m_HalfEdgeIndex.find(origin, target);
+}
+
+
+/**
+ * ajoute une demi-arête à l'index, s'il existe et si son origine a une forte valence.
+ * Quand l'origine atteint cette valence, toutes ses demi-arêtes sont indexées.
+ * NB: appelée par le constructeur de MeshHalfEdge, après l'avoir chaînée à origin
+ * @param halfedge : demi-arête à indexer
+ * @param origin : son sommet de départ
+ * @param target : son sommet d'arrivée
+ */
+void Mesh::indexHalfEdge(MeshHalfEdge* halfedge, MeshVertex* origin, MeshVertex* target)
+{
+    if (! m_HalfEdgeIndexValid) return;
+
+    int valence = origin->getValence();
+    if (valence > INDEX_MIN_VALENCE) {
+        m_HalfEdgeIndex.insert(origin, target, halfedge);
+    } else if (valence == INDEX_MIN_VALENCE) {
+        // origin vient d'atteindre la valence minimale, indexer tout son éventail
+        for (MeshHalfEdge* other = origin->getHalfEdge(); other != nullptr; other = other->getSibling()) {
+            MeshVertex* other_target = (other == halfedge) ? target : other->getTarget();
+            if (other_target != nullptr) m_HalfEdgeIndex.insert(origin, other_target, other);
+        }
     }
 }
 
 
+/**
+ * enlève une demi-arête de l'index, s'il existe
+ * NB: appelée par le destructeur de MeshHalfEdge
+ * @param halfedge : demi-arête à enlever
+ * @param origin : son sommet de départ
+ * @param target : son sommet d'arrivée
+ */
+void Mesh::unindexHalfEdge(MeshHalfEdge* halfedge, MeshVertex* origin, MeshVertex* target)
+{
+    // NB : la valence de origin a pu passer sous le seuil depuis son indexation
+    if (m_HalfEdgeIndexValid) m_HalfEdgeIndex.remove(origin, target, halfedge);
+}
+
+
+/**
+ * abandonne l'index des demi-arêtes jusqu'à la fin de la construction en cours,
+ * à appeler par les opérations qui changent l'origine de nombreuses demi-arêtes
+ */
+void Mesh::invalidateHalfEdgeIndex()
+{
+    if (! m_HalfEdgeIndexValid) return;
+    m_HalfEdgeIndex.clear();
+    m_HalfEdgeIndexValid = false;
+}
+
+
 /**
  * retourne le nom du maillage
  * @return nom du maillage
@@ -148,25 +283,48 @@ void Mesh::info()
 }
 
 
+/**
+ * enlève un élément d'une liste en le remplaçant par le dernier, dont le rang
+ * m_MeshIndex est mis à jour
+ * @param list : liste concernée
+ * @param element : élément à enlever
+ */
+template<typename ELEMENT> void Mesh::removeFromList(std::vector<ELEMENT*>& list, ELEMENT* element)
+{
+    // vérifier que l'élément est bien à son rang dans cette liste
+    int index = element->m_MeshIndex;
+    if (index < 0 || index >= (int)list.size() || list[index] != element) return;
+
+    // mettre le dernier élément à sa place
+    ELEMENT* last = list.back();
+    list[index] = last;
+    last->m_MeshIndex = index;
+    list.pop_back();
+    element->m_MeshIndex = -1;
+}
+
+
 /**
  * Cette méthode ajoute le sommet fourni à la fin de la liste
  * @param vertex : sommet à rajouter
  */
 void Mesh::pushVertex(MeshVertex* vertex)
 {
+    vertex->m_MeshIndex = m_VertexList.size();
     m_VertexList.push_back(vertex);
 }
 
 
 /**
- * Cette méthode enlève le sommet fourni de la liste
+ * Cette méthode enlève le sommet fourni de la liste, en temps constant :
+ * le dernier sommet de la liste prend sa place
  * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
  * @see #delVertex
  * @param vertex : sommet à enlever
  */
 void Mesh::popVertex(MeshVertex* vertex)
 {
-    list_remove(m_VertexList, vertex);
+    removeFromList(m_VertexList, vertex);
 }
 
 
@@ -176,19 +334,20 @@ void Mesh::popVertex(MeshVertex* vertex)
  */
 void Mesh::pushTriangle(MeshTriangle* triangle)
 {
+    triangle->m_MeshIndex = m_TriangleList.size();
     m_TriangleList.push_back(triangle);
 }
 
 
 /**
- * Cette méthode enlève le triangle fourni de la liste
+ * Cette méthode enlève le triangle fourni de la liste, en temps constant
  * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
  * @see #delTriangle
  * @param triangle à enlever
  */
 void Mesh::popTriangle(MeshTriangle* triangle)
 {
-    list_remove(m_TriangleList, triangle);
+    removeFromList(m_TriangleList, triangle);
 }
 
 
@@ -198,18 +357,19 @@ void Mesh::popTriangle(MeshTriangle* triangle)
  */
 void Mesh::pushEdge(MeshEdge* edge)
 {
+    edge->m_MeshIndex = m_EdgeList.size();
     m_EdgeList.push_back(edge);
 }
 
 
 /**
- * Cette méthode enlève l'arête fournie de la liste
+ * Cette méthode enlève l'arête fournie de la liste, en temps constant
  * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
  * @param edge : arête à enlever
  */
 void Mesh::popEdge(MeshEdge* edge)
 {
-    list_remove(m_EdgeList, edge);
+    removeFromList(m_EdgeList, edge);
 }
 
 
@@ -219,18 +379,19 @@ void Mesh::popEdge(MeshEdge* edge)
  */
 void Mesh::pushHalfEdge(MeshHalfEdge* halfedge)
 {
+    halfedge->m_MeshIndex = m_HalfEdgeList.size();
     m_HalfEdgeList.push_back(halfedge);
 }
 
 
 /**
- * Cette méthode enlève la demi-arête fournie de la liste
+ * Cette méthode enlève la demi-arête fournie de la liste, en temps constant
  * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
  * @param halfedge : halfedge à enlever
  */
 void Mesh::popHalfEdge(MeshHalfEdge* halfedge)
 {
-    list_remove(m_HalfEdgeList, halfedge);
+    removeFromList(m_HalfEdgeList, halfedge);
 }
 
 
@@ -289,9 +450,15 @@ void Mesh::addPolygonConvex(std::vector<MeshVertex*> vertices)
     // créer un éventail autour du premier point fourni
     MeshVertex* pivot = vertices[0];
     int count = vertices.size();
+
+    // un grand éventail donne une forte valence au pivot, indexer ses demi-arêtes
+    // si c'est moins coûteux que de les parcourir à chaque triangle
+    bool build = (size_t)count * count > m_HalfEdgeList.size();
+    if (build) beginBuild();
     for (int i=0; i<count-2; i++) {
         addTriangle(pivot, vertices[i+1], vertices[i+2]);
     }
+    if (build) endBuild();
 }
 
 
@@ -407,14 +574,25 @@ void Mesh::computeNormals()
         triangle->computeNormal();
     }
 
-    // calculer les normales des sommets
+    // renuméroter les sommets (numéro dans les VBOs) et initialiser leurs normales
     int iv = 0;
     for (MeshVertex* vertex: m_VertexList) {
-        // renuméroter le sommet (numéro dans les VBOs)
         vertex->setNumber(iv);
         iv++;
-        // recalculer la normale de ce sommet
-        vertex->computeNormal();
+        vec3::zero(vertex->getNormal());
+    }
+
+    // cumuler la normale de chaque triangle, pondérée par sa surface, sur ses sommets
+    // NB : les triangles sont parcourus à l'envers, dans le même ordre que MeshVertex::computeNormal
+    // tant qu'aucun triangle n'a été supprimé (popTriangle déplace le dernier triangle)
+    for (auto it = m_TriangleList.rbegin(); it != m_TriangleList.rend(); ++it) {
+        accumulateOnVertices(*it, MeshVertex::ID_ATTR_NORMAL, (*it)->getNormal());
+    }
+
+    // normaliser les normales des sommets
+    for (MeshVertex* vertex: m_VertexList) {
+        vec3& normal = vertex->getNormal();
+        vec3::normalize(normal, normal);
     }
 }
 
@@ -432,9 +610,45 @@ void Mesh::computeTangents()
         triangle->computeTangent();
     }
 
-    // calculer les tangentes des sommets
+    // initialiser les tangentes des sommets
+    for (MeshVertex* vertex: m_VertexList) {
+        vec3::zero(vertex->getTangent());
+    }
+
+    // cumuler la tangente de chaque triangle, pondérée par sa surface, sur ses sommets
+    for (auto it = m_TriangleList.rbegin(); it != m_TriangleList.rend(); ++it) {
+        accumulateOnVertices(*it, MeshVertex::ID_ATTR_TANGENT, (*it)->getTangent());
+    }
+
+    // normaliser les tangentes des sommets
     for (MeshVertex* vertex: m_VertexList) {
-        // recalculer la tangente de ce sommet
-        vertex->computeTangent();
+        vec3& tangent = vertex->getTangent();
+        vec3::normalize(tangent, tangent);
+    }
+}
+
+
+/**
+ * Cette méthode ajoute un vecteur pondéré par la surface du triangle à l'attribut
+ * de ses trois sommets. Les sommets sont atteints par les demi-arêtes du triangle
+ * et non par les chaînages autour des sommets.
+ * @param triangle : triangle concerné
+ * @param idattr : attribut à cumuler, ex: MeshVertex::ID_ATTR_NORMAL
+ * @param value : vecteur à cumuler
+ */
+void Mesh::accumulateOnVertices(MeshTriangle* triangle, int idattr, vec3 value)
+{
+    // triangle créé manuellement, sans demi-arêtes
+    MeshHalfEdge* halfedge = triangle->getHalfEdge();
+    if (halfedge == nullptr) return;
+
+    // prendre en compte la surface du triangle
+    vec3::scale(value, value, triangle->getSurface());
+
+    // cumuler sur les trois sommets
+    for (int i=0; i<3; i++) {
+        vec3& sum = (vec3&) halfedge->getOrigin()->getAttribute(idattr);
+        vec3::add(sum, sum, value);
+        halfedge = halfedge->getNext();
     }
 }
@@ -24,6 +24,8 @@ class Material;
 
 #include <Material.h>
 
+#include <MeshVertexData.h>
+#include <MeshHalfEdgeIndex.h>
 #include <MeshHalfEdge.h>
 #include <MeshVertex.h>
 #include <MeshTriangle.h>
@@ -52,6 +54,19 @@ private:
     /// liste des demi-arêtes (accès direct => vector)
     std::vector<MeshHalfEdge*> m_HalfEdgeList;
 
+    /// attributs des sommets, rangés par canaux contigus
+    MeshVertexData m_VertexData;
+
+    /// index des demi-arêtes, il n'existe que pendant une construction (voir beginBuild)
+    /// et ne concerne que les sommets ayant au moins INDEX_MIN_VALENCE demi-arêtes,
+    /// en dessous, parcourir l'éventail est plus rapide qu'une recherche dans la table
+    static const int INDEX_MIN_VALENCE = 16;
+    MeshHalfEdgeIndex m_HalfEdgeIndex;
+    bool m_HalfEdgeIndexValid;
+
+    /// nombre de beginBuild() en attente de leur endBuild()
+    int m_BuildDepth;
+
 
 public:
 
@@ -63,6 +78,62 @@ public:
     /** destructeur */
     virtual ~Mesh();
 
+    /**
+     * supprime tous les sommets, triangles, arêtes et demi-arêtes du maillage.
+     * Les éléments sont d'abord détachés les uns des autres, leurs destructeurs
+     * n'ont alors plus aucun chaînage à défaire : le coût est linéaire.
+     */
+    void clear();
+
+    /**
+     * commence une phase de construction : jusqu'à endBuild(), les demi-arêtes qui partent
+     * des sommets de forte valence sont indexées par leurs sommets, ce qui évite de parcourir
+     * l'éventail de ces sommets à chaque nouveau triangle. Les phases peuvent être imbriquées.
+     * NB : l'index est construit à partir des demi-arêtes existantes, il vaut mieux
+     * appeler cette méthode une fois avant un grand nombre d'ajouts
+     */
+    void beginBuild();
+
+    /**
+     * termine une phase de construction, l'index des demi-arêtes est libéré
+     * à la fin de la phase la plus externe
+     */
+    void endBuild();
+
+    /**
+     * retourne la demi-arête allant de origin à target, par l'index si une construction
+     * est en cours et que origin a une forte valence, sinon par l'éventail de origin
+     * @param origin : sommet de départ
+     * @param target : sommet d'arrivée
+     * @return demi-arête ou nullptr si absente
+     */
+    MeshHalfEdge* findHalfEdge(MeshVertex* origin, MeshVertex* target);
+
+    /**
+     * ajoute une demi-arête à l'index, s'il existe et si son origine a une forte valence.
+     * Quand l'origine atteint cette valence, toutes ses demi-arêtes sont indexées.
+     * NB: appelée par le constructeur de MeshHalfEdge, après l'avoir chaînée à origin
+     * @param halfedge : demi-arête à indexer
+     * @param origin : son sommet de départ
+     * @param target : son sommet d'arrivée
+     */
+    void indexHalfEdge(MeshHalfEdge* halfedge, MeshVertex* origin, MeshVertex* target);
+
+    /**
+     * enlève une demi-arête de l'index, s'il existe
+     * NB: appelée par le destructeur de MeshHalfEdge
+     * @param halfedge : demi-arête à enlever
+     * @param origin : son sommet de départ
+     * @param target : son sommet d'arrivée
+     */
+    void unindexHalfEdge(MeshHalfEdge* halfedge, MeshVertex* origin, MeshVertex* target);
+
+    /**
+     * abandonne l'index des demi-arêtes jusqu'à la fin de la construction en cours,
+     * à appeler par les opérations qui changent l'origine de nombreuses demi-arêtes
+     */
+    void invalidateHalfEdgeIndex();
+
     /**
      * retourne le nom du maillage
      * @return nom du maillage
@@ -113,6 +184,16 @@ public:
     }
 
 
+    /**
+     * retourne les canaux d'attributs des sommets
+     * @return attributs de tous les sommets
+     */
+    MeshVertexData& getVertexData()
+    {
+        return m_VertexData;
+    }
+
+
     /**
      * retourne le nombre de sommets
      * @return nombre de sommets
@@ -166,7 +247,8 @@ public:
     void pushVertex(MeshVertex* vertex);
 
     /**
-     * Cette méthode enlève le sommet fourni de la liste
+     * Cette méthode enlève le sommet fourni de la liste, en temps constant :
+     * le dernier sommet de la liste prend sa place
      * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
      * @see #delVertex
      * @param vertex sommet à enlever
@@ -180,7 +262,7 @@ public:
     void pushTriangle(MeshTriangle* triangle);
 
     /**
-     * Cette méthode enlève le triangle fourni de la liste
+     * Cette méthode enlève le triangle fourni de la liste, en temps constant
      * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
      * @see #delTriangle
      * @param triangle à enlever
@@ -194,7 +276,7 @@ public:
     void pushEdge(MeshEdge* edge);
 
     /**
-     * Cette méthode enlève l'arête fournie de la liste
+     * Cette méthode enlève l'arête fournie de la liste, en temps constant
      * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
      * @param edge : arête à enlever
      */
@@ -207,7 +289,7 @@ public:
     void pushHalfEdge(MeshHalfEdge* halfedge);
 
     /**
-     * Cette méthode enlève la demi-arête fournie de la liste
+     * Cette méthode enlève la demi-arête fournie de la liste, en temps constant
      * NB: la méthode ne le supprime pas (voir son destructeur pour cela)
      * @param halfedge : halfedge à enlever
      */
@@ -292,6 +374,27 @@ public:
      */
     void computeTangents();
 
+
+private:
+
+    /**
+     * Cette méthode ajoute un vecteur pondéré par la surface du triangle à l'attribut
+     * de ses trois sommets. Les sommets sont atteints par les demi-arêtes du triangle
+     * et non par les chaînages autour des sommets.
+     * @param triangle : triangle concerné
+     * @param idattr : attribut à cumuler, ex: MeshVertex::ID_ATTR_NORMAL
+     * @param value : vecteur à cumuler
+     */
+    void accumulateOnVertices(MeshTriangle* triangle, int idattr, vec3 value);
+
+    /**
+     * enlève un élément d'une liste en le remplaçant par le dernier, dont le rang
+     * m_MeshIndex est mis à jour
+     * @param list : liste concernée
+     * @param element : élément à enlever
+     */
+    template<typename ELEMENT> void removeFromList(std::vector<ELEMENT*>& list, ELEMENT* element);
+
 };
 
 
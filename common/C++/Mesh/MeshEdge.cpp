@@ -33,6 +33,8 @@ MeshEdge::MeshEdge(Mesh* mesh, MeshVertex* vertex1, MeshVertex* vertex2)
 {
     // appartenance au maillage
     m_Mesh = mesh;
+    m_MeshIndex = -1;
+    m_Midpoint = nullptr;
     if (mesh != nullptr) m_Mesh->pushEdge(this);
 
     // classer selon les numéros de sommets
@@ -63,6 +65,26 @@ MeshEdge::~MeshEdge()
 
     // supprimer cette arête de la liste du maillage
     if (m_Mesh != nullptr) m_Mesh->popEdge(this);
+
+    // son milieu ne doit plus la désigner
+    setMidpoint(nullptr);
+}
+
+
+/**
+ * mémorise le sommet placé au milieu de l'arête, il sera partagé par ses deux triangles ;
+ * le sommet connaît l'arête afin de l'effacer s'il est supprimé
+ * @param midpoint : sommet milieu, nullptr pour oublier le précédent
+ */
+void MeshEdge::setMidpoint(MeshVertex* midpoint)
+{
+    if (m_Midpoint != nullptr) m_Midpoint->m_MidpointOf = nullptr;
+    m_Midpoint = midpoint;
+    if (m_Midpoint != nullptr) {
+        // un sommet n'est le milieu que d'une seule arête
+        if (m_Midpoint->m_MidpointOf != nullptr) m_Midpoint->m_MidpointOf->m_Midpoint = nullptr;
+        m_Midpoint->m_MidpointOf = this;
+    }
 }
 
 
@@ -100,6 +122,9 @@ std::string MeshEdge::toFullString()
  */
 bool MeshEdge::replaceVertex(MeshVertex* vertex1, MeshVertex* vertex2)
 {
+    // l'ancien milieu ne correspond plus à cette arête
+    if (m_Vertex1 == vertex1 || m_Vertex2 == vertex1) setMidpoint(nullptr);
+
     if (m_Vertex1 == vertex1) {
         if (vertex2->getNumber() < m_Vertex2->getNumber()) {
             // vertex2 (qui remplace vertex1) a le plus petit numéro
@@ -26,12 +26,19 @@ private:
     Mesh* m_Mesh;
     MeshVertex* m_Vertex1;
     MeshVertex* m_Vertex2;
+    /// rang dans la liste du maillage, pour l'en retirer en temps constant
+    int m_MeshIndex;
+    /// sommet placé au milieu de l'arête lors d'une subdivision, nullptr sinon
+    MeshVertex* m_Midpoint;
 
 #ifdef DEBUG
     static int m_DebugGenNumber;
     int m_DebugNumber;
 #endif
 
+    /// le maillage gère m_MeshIndex et détache les éléments lors de clear()
+    friend class Mesh;
+
 
 public:
 
@@ -98,6 +105,22 @@ public:
     {
         return m_Vertex2;
     }
+
+    /**
+     * retourne le sommet placé au milieu de l'arête par une subdivision
+     * @return milieu ou nullptr si l'arête n'a pas encore été coupée
+     */
+    MeshVertex* getMidpoint()
+    {
+        return m_Midpoint;
+    }
+
+    /**
+     * mémorise le sommet placé au milieu de l'arête, il sera partagé par ses deux triangles ;
+     * il est oublié si ce sommet est supprimé
+     * @param midpoint : sommet milieu, nullptr pour oublier le précédent
+     */
+    void setMidpoint(MeshVertex* midpoint);
 };
 
 #endif
@@ -33,6 +33,7 @@ MeshHalfEdge::MeshHalfEdge(Mesh* mesh, MeshVertex* origin, MeshVertex* target, M
 {
     // appartenance au maillage
     m_Mesh = mesh;
+    m_MeshIndex = -1;
     if (mesh != nullptr) m_Mesh->pushHalfEdge(this);
 
     // sommet cible de la demi-arête
@@ -43,7 +44,9 @@ MeshHalfEdge::MeshHalfEdge(Mesh* mesh, MeshVertex* origin, MeshVertex* target, M
     m_Sibling  = nullptr;
 
     // vérifier que le sommet d'origine n'a pas déjà une demi-arête allant vers target
-    if (origin->getHalfEdgeTo(target) != nullptr) {
+    // NB : pendant une construction, le maillage trouve les demi-arêtes par son index
+    MeshHalfEdge* existing = (mesh != nullptr) ? mesh->findHalfEdge(origin, target) : origin->getHalfEdgeTo(target);
+    if (existing != nullptr) {
         if (mesh == nullptr) {
             throw std::runtime_error("Already a half-edge between "+origin->toString()+" and "+target->toString());
         } else {
@@ -53,7 +56,7 @@ MeshHalfEdge::MeshHalfEdge(Mesh* mesh, MeshVertex* origin, MeshVertex* target, M
 
     // est-ce que le sommet cible contient une demi-arête qui va vers origin ?
     m_Opposite = nullptr;
-    MeshHalfEdge* other = target->getHalfEdgeTo(origin);
+    MeshHalfEdge* other = (mesh != nullptr) ? mesh->findHalfEdge(target, origin) : target->getHalfEdgeTo(origin);
     if (other != nullptr) {
         // vérifier que cette autre demi-arête n'a pas d'opposée (sinon maillage pas manifold)
         if (other->getOpposite() != nullptr) {
@@ -77,6 +80,7 @@ MeshHalfEdge::MeshHalfEdge(Mesh* mesh, MeshVertex* origin, MeshVertex* target, M
 
     // chaînage de la demi-arête autour du sommet origin
     origin->linkSibling(this);
+    if (mesh != nullptr) mesh->indexHalfEdge(this, origin, target);
 
     #ifdef DEBUG
     m_DebugGenNumber++;
@@ -98,6 +102,13 @@ MeshHalfEdge::~MeshHalfEdge()
     std::cerr << "del " << toString() << std::endl;
     #endif
 
+    // retirer cette demi-arête de l'index du maillage, sa cible est donnée par l'arête
+    // NB : la demi-arête suivante a pu être supprimée juste avant, voir ~MeshTriangle
+    if (m_Mesh != nullptr && m_Edge != nullptr) {
+        MeshVertex* target = (m_Edge->getVertex1() == m_Origin) ? m_Edge->getVertex2() : m_Edge->getVertex1();
+        m_Mesh->unindexHalfEdge(this, m_Origin, target);
+    }
+
     // si cette demi-arête a une opposée, les séparer
     if (m_Opposite != nullptr) {
         m_Opposite->m_Opposite = nullptr;
@@ -109,8 +120,8 @@ MeshHalfEdge::~MeshHalfEdge()
     m_Edge = nullptr;
     m_Next = nullptr;
 
-    // retirer cette demi-arête du chaînage de son origine
-    m_Origin->unlinkSibling(this);
+    // retirer cette demi-arête du chaînage de son origine (absente si le maillage a été vidé, voir Mesh::clear)
+    if (m_Origin != nullptr) m_Origin->unlinkSibling(this);
 
     // supprimer cette demi-arête du maillage
     if (m_Mesh != nullptr) m_Mesh->popHalfEdge(this);
@@ -225,6 +236,8 @@ void MeshHalfEdge::collapseTriangle(MeshHalfEdge* halfedge)
     // supprimer les arêtes de ces deux demi-arêtes
     if (oppN != nullptr) delete oppN->m_Edge;
     if (oppNN != nullptr) delete oppNN->m_Edge;
+    if (oppN != nullptr) halfedge->m_Next->m_Edge = nullptr;
+    if (oppNN != nullptr) halfedge->m_Next->m_Next->m_Edge = nullptr;
 
     // supprimer le triangle contenant cette demi-arête => suppression de ses 3 demi-arêtes
     delete halfedge->m_Triangle;
@@ -259,6 +272,9 @@ void MeshHalfEdge::collapse(MeshHalfEdge* halfedge)
     // vertex cible qui va être fusionné sur origin
     MeshVertex* target = halfedge->getTarget();
 
+    // les demi-arêtes autour de target vont changer de sommet, l'index du maillage n'est plus à jour
+    if (halfedge->m_Mesh != nullptr) halfedge->m_Mesh->invalidateHalfEdgeIndex();
+
     // disparition du triangle sur l'arête opposée, avec échange des demi-arêtes opposées
     if (halfedge->m_Opposite != nullptr) collapseTriangle(halfedge->m_Opposite);
 
@@ -280,6 +296,17 @@ void MeshHalfEdge::collapse(MeshHalfEdge* halfedge)
         // passer à la demi-arête sortante suivante
         other = next_other;
     }
+
+    // les arêtes refaites par collapseTriangle et celles des demi-arêtes entrantes sans opposée
+    // peuvent encore désigner target, ex: bord du maillage ou faces doubles ; elles sont toutes
+    // dans les triangles autour de origin
+    other = origin->getHalfEdge();
+    while (other != nullptr) {
+        if (other->m_Edge != nullptr) other->m_Edge->replaceVertex(target, origin);
+        MeshHalfEdge* incoming = other->m_Next->m_Next;
+        if (incoming->m_Edge != nullptr) incoming->m_Edge->replaceVertex(target, origin);
+        other = other->m_Sibling;
+    }
 }
 
 
@@ -302,6 +329,12 @@ void MeshHalfEdge::flip()
     MeshHalfEdge* oppositenext = opposite->m_Next;
     MeshHalfEdge* oppositenextnext = oppositenext->m_Next;
 
+    // this et son opposée changent de sommets, les retirer de l'index du maillage
+    if (m_Mesh != nullptr) {
+        m_Mesh->unindexHalfEdge(this, m_Origin, opposite->m_Origin);
+        m_Mesh->unindexHalfEdge(opposite, opposite->m_Origin, m_Origin);
+    }
+
     // modifier le chaînage de la demi-arête this
     m_Next = halfedgenextnext;
     halfedgenextnext->m_Next = oppositenext;
@@ -323,8 +356,13 @@ void MeshHalfEdge::flip()
     // remettre le chaînage m_Sibling sur les nouveaux sommets
     m_Origin->linkSibling(this);
     opposite->m_Origin->linkSibling(opposite);
+    if (m_Mesh != nullptr) {
+        m_Mesh->indexHalfEdge(this, m_Origin, opposite->m_Origin);
+        m_Mesh->indexHalfEdge(opposite, opposite->m_Origin, m_Origin);
+    }
 
     // refaire l'arête
     delete m_Edge;
     m_Edge = new MeshEdge(m_Mesh, m_Origin, opposite->m_Origin);
+    opposite->m_Edge = m_Edge;
 }
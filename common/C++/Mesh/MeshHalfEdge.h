@@ -28,6 +28,7 @@ private:
 
     // appartenance au maillage
     Mesh* m_Mesh;
+    int m_MeshIndex;                // rang dans la liste du maillage
 
     // relations avec les autres demi-arêtes
     MeshHalfEdge* m_Sibling;        // demi-arête suivante autour du même sommet d'origine
@@ -47,6 +48,9 @@ private:
     int m_DebugNumber;
 #endif
 
+    /// le maillage gère m_MeshIndex et détache les éléments lors de clear()
+    friend class Mesh;
+
 
 public:
 
@@ -0,0 +1,137 @@
+// Définition de la classe MeshHalfEdgeIndex
+
+#include <MeshHalfEdgeIndex.h>
+
+
+/**
+ * constructeur, la table est vide et n'occupe aucune mémoire
+ */
+MeshHalfEdgeIndex::MeshHalfEdgeIndex()
+{
+    m_Mask = 0;
+    m_Used = 0;
+}
+
+
+/**
+ * prévoit la place pour le nombre de demi-arêtes indiqué
+ * @param count : nombre de demi-arêtes attendues
+ */
+void MeshHalfEdgeIndex::reserve(size_t count)
+{
+    // la table ne doit pas être remplie à plus des 3/4
+    size_t capacity = 64;
+    while (capacity * 3 < count * 4) capacity *= 2;
+    if (capacity > m_Slots.size()) rehash(capacity);
+}
+
+
+/**
+ * retourne la demi-arête allant de origin à target
+ * @param origin : sommet de départ
+ * @param target : sommet d'arrivée
+ * @return demi-arête ou nullptr si absente
+ */
+MeshHalfEdge* MeshHalfEdgeIndex::find(MeshVertex* origin, MeshVertex* target) const
+{
+    if (m_Slots.empty()) return nullptr;
+
+    // parcourir les entrées à partir du rang de hachage jusqu'à une entrée vide
+    for (size_t i = hash(origin, target); ; i = (i+1) & m_Mask) {
+        const Slot& slot = m_Slots[i];
+        if (slot.origin == nullptr) return nullptr;
+        if (slot.origin == origin && slot.target == target) return slot.halfedge;
+    }
+}
+
+
+/**
+ * associe la demi-arête au couple (origin, target), en remplaçant celle qui y était
+ * @param origin : sommet de départ
+ * @param target : sommet d'arrivée
+ * @param halfedge : demi-arête à associer
+ */
+void MeshHalfEdgeIndex::insert(MeshVertex* origin, MeshVertex* target, MeshHalfEdge* halfedge)
+{
+    // agrandir la table si elle est trop remplie
+    if ((m_Used + 1) * 4 > m_Slots.size() * 3) rehash(m_Slots.empty() ? 64 : m_Slots.size() * 2);
+
+    for (size_t i = hash(origin, target); ; i = (i+1) & m_Mask) {
+        Slot& slot = m_Slots[i];
+        if (slot.origin == nullptr) {
+            // nouvelle entrée
+            slot.origin = origin;
+            slot.target = target;
+            slot.halfedge = halfedge;
+            m_Used++;
+            return;
+        }
+        if (slot.origin == origin && slot.target == target) {
+            // entrée existante, éventuellement effacée
+            slot.halfedge = halfedge;
+            return;
+        }
+    }
+}
+
+
+/**
+ * enlève le couple (origin, target) s'il est associé à cette demi-arête
+ * NB : l'entrée reste occupée pour ne pas couper les recherches qui passent par elle
+ * @param origin : sommet de départ
+ * @param target : sommet d'arrivée
+ * @param halfedge : demi-arête à enlever
+ */
+void MeshHalfEdgeIndex::remove(MeshVertex* origin, MeshVertex* target, MeshHalfEdge* halfedge)
+{
+    if (m_Slots.empty()) return;
+
+    for (size_t i = hash(origin, target); ; i = (i+1) & m_Mask) {
+        Slot& slot = m_Slots[i];
+        if (slot.origin == nullptr) return;
+        if (slot.origin == origin && slot.target == target) {
+            if (slot.halfedge == halfedge) slot.halfedge = nullptr;
+            return;
+        }
+    }
+}
+
+
+/**
+ * vide la table et libère sa mémoire
+ */
+void MeshHalfEdgeIndex::clear()
+{
+    std::vector<Slot>().swap(m_Slots);
+    m_Mask = 0;
+    m_Used = 0;
+}
+
+
+/**
+ * reconstruit la table avec la capacité indiquée, les entrées effacées disparaissent
+ * @param capacity : nouvelle capacité, puissance de 2
+ */
+void MeshHalfEdgeIndex::rehash(size_t capacity)
+{
+    std::vector<Slot> old;
+    old.swap(m_Slots);
+
+    // table vide
+    Slot empty = { nullptr, nullptr, nullptr };
+    m_Slots.assign(capacity, empty);
+    m_Mask = capacity - 1;
+    m_Used = 0;
+
+    // remettre les entrées encore associées à une demi-arête
+    for (const Slot& slot: old) {
+        if (slot.halfedge == nullptr) continue;
+        for (size_t i = hash(slot.origin, slot.target); ; i = (i+1) & m_Mask) {
+            if (m_Slots[i].origin == nullptr) {
+                m_Slots[i] = slot;
+                m_Used++;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef MESH_MESHHALFEDGEINDEX_H
+#define MESH_MESHHALFEDGEINDEX_H
+
+// Définition de la classe MeshHalfEdgeIndex
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// pré-déclarations
+class MeshVertex;
+class MeshHalfEdge;
+
+
+/**
+ * Cette classe associe à chaque couple (origine, cible) la demi-arête correspondante.
+ * C'est une table de hachage à adressage ouvert : les entrées sont rangées dans un seul
+ * tableau contigu, sans allocation par demi-arête, et une recherche coûte en moyenne
+ * un ou deux accès quelle que soit la valence des sommets.
+ */
+class MeshHalfEdgeIndex
+{
+public:
+
+    /**
+     * constructeur, la table est vide et n'occupe aucune mémoire
+     */
+    MeshHalfEdgeIndex();
+
+    /**
+     * prévoit la place pour le nombre de demi-arêtes indiqué
+     * @param count : nombre de demi-arêtes attendues
+     */
+    void reserve(size_t count);
+
+    /**
+     * retourne la demi-arête allant de origin à target
+     * @param origin : sommet de départ
+     * @param target : sommet d'arrivée
+     * @return demi-arête ou nullptr si absente
+     */
+    MeshHalfEdge* find(MeshVertex* origin, MeshVertex* target) const;
+
+    /**
+     * associe la demi-arête au couple (origin, target), en remplaçant celle qui y était
+     * @param origin : sommet de départ
+     * @param target : sommet d'arrivée
+     * @param halfedge : demi-arête à associer
+     */
+    void insert(MeshVertex* origin, MeshVertex* target, MeshHalfEdge* halfedge);
+
+    /**
+     * enlève le couple (origin, target) s'il est associé à cette demi-arête
+     * @param origin : sommet de départ
+     * @param target : sommet d'arrivée
+     * @param halfedge : demi-arête à enlever
+     */
+    void remove(MeshVertex* origin, MeshVertex* target, MeshHalfEdge* halfedge);
+
+    /**
+     * vide la table et libère sa mémoire
+     */
+    void clear();
+
+private:
+
+    /// une entrée de la table : vide si origin est nul, effacée si seul halfedge est nul
+    struct Slot {
+        MeshVertex* origin;
+        MeshVertex* target;
+        MeshHalfEdge* halfedge;
+    };
+
+    /**
+     * retourne le rang de départ des recherches pour ce couple
+     * @param origin : sommet de départ
+     * @param target : sommet d'arrivée
+     * @return rang dans m_Slots
+     */
+    size_t hash(MeshVertex* origin, MeshVertex* target) const
+    {
+        uint64_t h = (uint64_t)(uintptr_t)origin * 0x9E3779B97F4A7C15ULL;
+        h ^= (uint64_t)(uintptr_t)target * 0xC2B2AE3D27D4EB4FULL;
+        h ^= h >> 29;
+        return (size_t)h & m_Mask;
+    }
+
+    /**
+     * reconstruit la table avec la capacité indiquée, les entrées effacées disparaissent
+     * @param capacity : nouvelle capacité, puissance de 2
+     */
+    void rehash(size_t capacity);
+
+    /// entrées de la table, leur nombre est une puissance de 2
+    std::vector<Slot> m_Slots;
+    size_t m_Mask;
+
+    /// nombre d'entrées occupées, effacées comprises
+    size_t m_Used;
+};
+
+#endif
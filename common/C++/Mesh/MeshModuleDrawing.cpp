@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <math.h>
 
 #include <utils.h>
 #include <Mesh.h>
@@ -45,11 +46,88 @@ VBOset* MeshModuleDrawing::createVBOset(Material* material, bool interleaved)
     // créer le VBO des indices
     int size = vboset->createIndexedPrimitiveVBO(GL_TRIANGLES, indexlist);
     std::cout << m_Mesh->getName() << ": "<<size<<" indices with triangles" << std::endl;
+    printVertexStats(m_Mesh->getName(), vboset);
 
     return vboset;
 }
 
 
+/**
+ * Cette méthode crée tous les VBO pour dessiner le maillage à l'aide de triangles, dans un
+ * ordre optimisé pour le cache des sommets transformés de la carte graphique. Les sommets
+ * sont rangés dans les VBO dans l'ordre de leur première utilisation.
+ * @param material : celui qu'il faut employer pour dessiner les triangles
+ * @param interleaved : true s'il faut entrelacer les données
+ */
+VBOset* MeshModuleDrawing::createOptimizedVBOset(Material* material, bool interleaved)
+{
+    // triangles réordonnés et sommets dans l'ordre de leur première utilisation
+    std::vector<int> indexlist;
+    std::vector<MeshVertex*> fetch_order;
+    createOptimizedIndexList(indexlist, fetch_order);
+
+    // créer les VBO demandés par le matériau, les sommets sont renumérotés dans ce nouvel ordre
+    VBOset* vboset = material->createVBOset();
+    vboset->createAttributesVBO(fetch_order, interleaved);
+
+    // créer le VBO des indices
+    vboset->createIndexedPrimitiveVBO(GL_TRIANGLES, indexlist);
+    printVertexStats(m_Mesh->getName(), vboset);
+
+    return vboset;
+}
+
+
+/**
+ * Cette méthode construit les indices des triangles du maillage dans un ordre optimisé
+ * pour le cache des sommets transformés, ainsi que l'ordre dans lequel ranger les sommets
+ * dans les VBO : celui de leur première utilisation, les sommets inutilisés à la fin.
+ * Les indices retournés se rapportent à cet ordre.
+ * @param indexlist : tableau qui reçoit les indices des triangles
+ * @param fetch_order : tableau qui reçoit les sommets dans l'ordre où les ranger
+ */
+void MeshModuleDrawing::createOptimizedIndexList(std::vector<int>& indexlist, std::vector<MeshVertex*>& fetch_order)
+{
+    // numéroter provisoirement les sommets dans l'ordre du maillage
+    std::vector<MeshVertex*>& vertex_list = m_Mesh->getVertexList();
+    const int vertex_count = vertex_list.size();
+    for (int iv=0; iv<vertex_count; iv++) {
+        vertex_list[iv]->setNumber(iv);
+    }
+
+    // rassembler les indices des triangles
+    indexlist.clear();
+    indexlist.reserve(m_Mesh->getTriangleCount() * 3);
+    for (MeshTriangle* triangle: m_Mesh->getTriangleList()) {
+        for (int i=0; i<3; i++) {
+            indexlist.push_back(triangle->getVertex(i)->getNumber());
+        }
+    }
+    std::cout << m_Mesh->getName() << ": before optimization, ";
+    printCacheStats(indexlist);
+
+    // réordonner les triangles
+    optimizeVertexCache(indexlist, vertex_count);
+
+    // ranger les sommets dans l'ordre où les triangles les emploient, les inutilisés à la fin
+    std::vector<int> numbers(vertex_count, -1);
+    fetch_order.clear();
+    fetch_order.reserve(vertex_count);
+    for (int& index: indexlist) {
+        if (numbers[index] < 0) {
+            numbers[index] = fetch_order.size();
+            fetch_order.push_back(vertex_list[index]);
+        }
+        index = numbers[index];
+    }
+    for (int iv=0; iv<vertex_count; iv++) {
+        if (numbers[iv] < 0) fetch_order.push_back(vertex_list[iv]);
+    }
+    std::cout << m_Mesh->getName() << ": "<<indexlist.size()<<" indices with optimized triangles, ";
+    printCacheStats(indexlist);
+}
+
+
 /**
  * Cette méthode crée tous les VBO pour dessiner le maillage à l'aide de triangle_strips
  * @param material : celui qu'il faut employer pour dessiner les triangles du ruban
@@ -61,72 +139,354 @@ VBOset* MeshModuleDrawing::createStripVBOset(Material* material, bool interleave
     VBOset* vboset = material->createVBOset();
     vboset->createAttributesVBO(m_Mesh, interleaved);
 
-    // créer une liste de rubans
-    std::vector<TriangleStrip*> striplist;
+    // construire les rubans
+    std::vector<int> indexlist;
+    int stripcount = createStripIndexList(indexlist);
 
-    // parcourir tous les triangles du maillage
-    for (MeshTriangle* triangle: m_Mesh->getTriangleList()) {
-        // tenter d'insérer le triangle dans l'un des rubans
-        bool ok = false;
-        const int stripnumber = striplist.size();
-        for (int ir=0; ir<stripnumber; ir++) {
-            TriangleStrip* strip = striplist[ir];
-            // le triangle peut-il être mis dans ce ruban ?
-            if (strip->appendTriangle(triangle)) {
-                // voir si l'un des rubans suivants peut être concaténé au courant
-                for (int irs=ir+1; irs<stripnumber; irs++) {
-                    TriangleStrip* nextstrip = striplist[irs];
-                    if (strip->concat(nextstrip)) {
-                        // supprimer le ruban suivant
-                        list_remove(striplist, nextstrip);
-                        delete nextstrip;
-                        // ne pas continuer avec les autres rubans
-                        break;
-                    }
+    // créer le VBO des indices
+    vboset->createIndexedPrimitiveVBO(GL_TRIANGLE_STRIP, indexlist);
+
+    // message d'information
+    printStripStats(indexlist, stripcount);
+    printVertexStats(m_Mesh->getName(), vboset);
+
+    return vboset;
+}
+
+
+/**
+ * Cette méthode regroupe les triangles du maillage en rubans et retourne leurs indices,
+ * les rubans étant reliés par des triangles dégénérés. Les sommets doivent être numérotés.
+ *
+ * Les rubans sont construits en suivant les demi-arêtes opposées, en temps linéaire.
+ * Chaque ruban commence par l'un des triangles ayant le moins de voisins libres, afin
+ * de ne pas laisser de triangles isolés, et part dans celle des trois directions qui
+ * donne le plus long ruban.
+ * @param indexlist : tableau qui reçoit les numéros des sommets des rubans
+ * @return nombre de rubans construits
+ */
+int MeshModuleDrawing::createStripIndexList(std::vector<int>& indexlist)
+{
+    std::vector<MeshTriangle*>& triangles = m_Mesh->getTriangleList();
+    const int triangle_count = triangles.size();
+
+    // marques des triangles : -1 pour ceux qui sont dans un ruban, sinon numéro du dernier essai
+    std::vector<int> marks(triangle_count, 0);
+
+    // nombre de voisins libres de chaque triangle et piles des triangles selon ce nombre
+    // NB : les piles peuvent contenir des entrées périmées, elles sont ignorées en les dépilant
+    std::vector<int> free_count(triangle_count, 0);
+    std::vector<int> stacks[4];
+    for (int it=triangle_count-1; it>=0; it--) {
+        MeshHalfEdge* halfedge = triangles[it]->getHalfEdge();
+        for (int i=0; i<3; i++) {
+            if (halfedge->getOpposite() != nullptr) free_count[it]++;
+            halfedge = halfedge->getNext();
+        }
+        stacks[free_count[it]].push_back(it);
+    }
+
+    // construire les rubans
+    std::vector<MeshHalfEdge*> path;
+    std::vector<MeshHalfEdge*> best;
+    int stamp = 0;
+    int stripcount = 0;
+    while (true) {
+        // triangle libre ayant le moins de voisins libres
+        int seed = -1;
+        for (int n=0; n<4 && seed < 0; n++) {
+            while (!stacks[n].empty()) {
+                int it = stacks[n].back();
+                stacks[n].pop_back();
+                if (marks[it] >= 0 && free_count[it] == n) {
+                    seed = it;
+                    break;
                 }
-                // c'est ok, on arrête le parcours des rubans
-                ok = true;
-                break;
             }
         }
-        // si le triangle n'a pas pu être ajouté à un ruban, alors créer un autre ruban et le mettre en tête
-        if (! ok) {
-            striplist.insert(striplist.begin(), new TriangleStrip(triangle));
+        if (seed < 0) break;
+
+        // essayer de partir de chacune des trois arêtes, garder le plus long ruban
+        best.clear();
+        MeshHalfEdge* start = triangles[seed]->getHalfEdge();
+        for (int i=0; i<3; i++) {
+            if (walkStrip(start, ++stamp, marks, path) > (int)best.size()) best.swap(path);
+            start = start->getNext();
         }
-    }
 
-    // rassembler les indices des sommets des rubans, avec des codes de redémarrage entre rubans
-    std::vector<int> indexlist;
-    TriangleStrip* precstrip = nullptr;
-    for (TriangleStrip* strip: striplist) {
-        // rajouter un "primitive restart"
-        if (precstrip != nullptr) {
-            int prec = precstrip->getVertex(-1)->getNumber();
+        // relier ce ruban au précédent par des triangles dégénérés
+        MeshHalfEdge* first = best[0];
+        if (!indexlist.empty()) {
+            int prec = indexlist.back();
             if ((indexlist.size() % 2) == 1) indexlist.push_back(prec);
             indexlist.push_back(prec);
-            int svt = strip->getVertex(0)->getNumber();
-            indexlist.push_back(svt);
+            indexlist.push_back(first->getOrigin()->getNumber());
         }
-        // rajouter les sommets du ruban
-        for (MeshVertex* vertex: strip->getVertexList()) {
-            indexlist.push_back(vertex->getNumber());
+
+        // sommets du premier triangle, puis le troisième sommet de chacun des suivants
+        indexlist.push_back(first->getOrigin()->getNumber());
+        indexlist.push_back(first->getNext()->getOrigin()->getNumber());
+        for (MeshHalfEdge* halfedge: best) {
+            indexlist.push_back(halfedge->getNext()->getNext()->getOrigin()->getNumber());
+
+            // retirer le triangle des triangles libres et mettre à jour ses voisins
+            marks[halfedge->getTriangle()->getMeshIndex()] = -1;
+            for (int i=0; i<3; i++) {
+                MeshHalfEdge* opposite = halfedge->getOpposite();
+                if (opposite != nullptr) {
+                    int neighbour = opposite->getTriangle()->getMeshIndex();
+                    if (marks[neighbour] >= 0) {
+                        free_count[neighbour]--;
+                        stacks[free_count[neighbour]].push_back(neighbour);
+                    }
+                }
+                halfedge = halfedge->getNext();
+            }
         }
-        precstrip = strip;
+        stripcount++;
     }
 
-    // créer le VBO des indices
-    int size = vboset->createIndexedPrimitiveVBO(GL_TRIANGLE_STRIP, indexlist);
+    return stripcount;
+}
 
-    // message d'information
+
+/**
+ * Cette méthode parcourt le ruban qui commence par le triangle de la demi-arête, sans
+ * passer par les triangles déjà mis dans un ruban ni par ceux marqués avec stamp
+ * @param start : demi-arête du premier triangle, allant de son premier à son deuxième sommet
+ * @param stamp : marque à poser sur les triangles parcourus
+ * @param marks : marques des triangles, -1 pour ceux qui sont déjà dans un ruban
+ * @param path : reçoit la demi-arête d'entrée de chaque triangle du ruban
+ * @return nombre de triangles du ruban
+ */
+int MeshModuleDrawing::walkStrip(MeshHalfEdge* start, int stamp, std::vector<int>& marks, std::vector<MeshHalfEdge*>& path)
+{
+    path.clear();
+    MeshHalfEdge* entry = start;
+    while (true) {
+        path.push_back(entry);
+        marks[entry->getTriangle()->getMeshIndex()] = stamp;
+
+        // le triangle suivant partage l'arête formée par les deux derniers sommets du ruban :
+        // demi-arête suivant l'entrée pour les triangles de rang pair, la précédente sinon
+        MeshHalfEdge* exit = entry->getNext();
+        if ((path.size() % 2) == 0) exit = exit->getNext();
+
+        // le triangle voisin est-il libre ?
+        MeshHalfEdge* opposite = exit->getOpposite();
+        if (opposite == nullptr) break;
+        int mark = marks[opposite->getTriangle()->getMeshIndex()];
+        if (mark < 0 || mark == stamp) break;
+        entry = opposite;
+    }
+    return path.size();
+}
+
+
+/**
+ * Cette méthode affiche les statistiques d'un ensemble de rubans
+ * @param indexlist : indices des rubans
+ * @param stripcount : nombre de rubans
+ */
+void MeshModuleDrawing::printStripStats(const std::vector<int>& indexlist, int stripcount)
+{
+    int size = indexlist.size();
     int triangle_count = m_Mesh->getTriangleCount();
-    std::cout << m_Mesh->getName() << ": "<<size<<" indices with "<<striplist.size()<<" strips, instead of "<<(triangle_count*3)<<std::endl;
+    std::cout << m_Mesh->getName() << ": "<<size<<" indices with "<<stripcount<<" strips, instead of "<<(triangle_count*3);
+    if (stripcount > 0) {
+        std::cout << " ("<<(float(triangle_count)/stripcount)<<" triangles per strip, "<<(float(size)/triangle_count)<<" indices per triangle)";
+    }
+    std::cout << ", ";
+    printCacheStats(indexlist);
+}
 
-    // libérer les rubans
-    for (TriangleStrip* ruban: striplist) {
-        delete ruban;
+
+/**
+ * Cette méthode affiche la place occupée par les sommets d'un VBOset, en octets
+ * par sommet, comparée à celle qu'ils occuperaient avec des GL_FLOAT seulement
+ * @param name : nom du maillage
+ * @param vboset : VBOset dont les VBO des attributs ont été créés
+ */
+void MeshModuleDrawing::printVertexStats(std::string name, VBOset* vboset)
+{
+    int vertex_count = vboset->getVertexCount();
+    int size = vboset->getVertexSize();
+    int floatsize = vboset->getFloatVertexSize();
+    std::cout << name << ": "<<vertex_count<<" vertices, "<<size<<" bytes per vertex";
+    if (size != floatsize) std::cout << " instead of "<<floatsize;
+    std::cout << ", "<<((vertex_count*size + 1023)/1024)<<" KB"<<std::endl;
+}
+
+
+/**
+ * Cette méthode affiche l'efficacité du cache de sommets : nombre moyen de sommets
+ * transformés par triangle (ACMR) et par sommet du maillage (ATVR)
+ * @param indexlist : indices des sommets, triangles ou rubans
+ */
+void MeshModuleDrawing::printCacheStats(const std::vector<int>& indexlist)
+{
+    int misses = countCacheMisses(indexlist);
+    int triangle_count = std::max(m_Mesh->getTriangleCount(), 1);
+    int vertex_count = std::max(m_Mesh->getVertexCount(), 1);
+    std::cout << "ACMR "<<(float(misses)/triangle_count)<<", ATVR "<<(float(misses)/vertex_count)<<" (FIFO "<<CACHE_SIZE<<")"<<std::endl;
+}
+
+
+/**
+ * Cette méthode compte les sommets qu'un cache FIFO de la taille indiquée devrait
+ * transformer pour dessiner les indices dans l'ordre fourni
+ * @param indexlist : indices des sommets, triangles ou rubans
+ * @param cachesize : nombre de sommets dans le cache
+ * @return nombre de défauts de cache
+ */
+int MeshModuleDrawing::countCacheMisses(const std::vector<int>& indexlist, int cachesize)
+{
+    if (indexlist.empty()) return 0;
+
+    // rang du défaut de cache qui a fait entrer chaque sommet dans le cache, -1 si jamais
+    // NB : un sommet est encore dans le cache FIFO si moins de cachesize défauts ont suivi le sien
+    int max_index = *std::max_element(indexlist.begin(), indexlist.end());
+    std::vector<int> entries(max_index+1, -1);
+    int misses = 0;
+    for (int index: indexlist) {
+        if (entries[index] < 0 || misses - entries[index] >= cachesize) {
+            entries[index] = misses;
+            misses++;
+        }
     }
+    return misses;
+}
 
-    return vboset;
+
+/**
+ * score d'un sommet dans l'algorithme de Forsyth : il favorise les sommets présents dans
+ * le cache, d'autant plus qu'ils y sont entrés récemment, et ceux qui ont peu de triangles
+ * restants, pour ne pas les laisser isolés
+ * @param position : rang du sommet dans le cache LRU, -1 s'il n'y est pas
+ * @param valence : nombre de triangles pas encore émis qui emploient ce sommet
+ * @return score du sommet
+ */
+static float getVertexCacheScore(int position, int valence)
+{
+    // sommet qui n'est plus employé
+    if (valence <= 0) return -1.0;
+
+    float score = 0.0;
+    if (position >= 0) {
+        if (position < 3) {
+            // sommets du dernier triangle émis : score fixe, pour ne pas favoriser un sens de parcours
+            score = 0.75;
+        } else {
+            score = powf(1.0 - (position - 3) / float(MeshModuleDrawing::CACHE_SIZE - 3), 1.5);
+        }
+    }
+    return score + 2.0 * powf(valence, -0.5);
+}
+
+
+/**
+ * Cette méthode réordonne les triangles d'une liste d'indices GL_TRIANGLES pour qu'ils
+ * réutilisent au mieux le cache des sommets transformés (algorithme de Tom Forsyth,
+ * "Linear-Speed Vertex Cache Optimisation")
+ * @param indexlist : indices des triangles, modifié sur place
+ * @param vertex_count : nombre de sommets, les indices doivent être inférieurs
+ */
+void MeshModuleDrawing::optimizeVertexCache(std::vector<int>& indexlist, int vertex_count)
+{
+    const int triangle_count = indexlist.size() / 3;
+
+    // triangles restants de chaque sommet : ceux de v sont dans triangles[first[v] .. first[v]+valences[v]-1]
+    std::vector<int> valences(vertex_count, 0);
+    for (int index: indexlist) valences[index]++;
+    std::vector<int> first(vertex_count, 0);
+    for (int iv=1; iv<vertex_count; iv++) first[iv] = first[iv-1] + valences[iv-1];
+    std::vector<int> triangles(triangle_count * 3);
+    std::vector<int> fill(first);
+    for (int it=0; it<triangle_count; it++) {
+        for (int i=0; i<3; i++) {
+            triangles[fill[indexlist[it*3+i]]++] = it;
+        }
+    }
+
+    // scores des sommets et des triangles
+    std::vector<int> positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+    for (int iv=0; iv<vertex_count; iv++) {
+        vertex_scores[iv] = getVertexCacheScore(-1, valences[iv]);
+    }
+    std::vector<float> triangle_scores(triangle_count);
+    for (int it=0; it<triangle_count; it++) {
+        triangle_scores[it] = vertex_scores[indexlist[it*3+0]] + vertex_scores[indexlist[it*3+1]] + vertex_scores[indexlist[it*3+2]];
+    }
+    std::vector<bool> emitted(triangle_count, false);
+
+    // cache LRU simulé, il peut déborder de 3 sommets le temps de la mise à jour
+    std::vector<int> cache;
+    std::vector<int> newcache;
+    cache.reserve(CACHE_SIZE+3);
+    newcache.reserve(CACHE_SIZE+3);
+
+    // émettre les triangles un par un
+    std::vector<int> result;
+    result.reserve(indexlist.size());
+    int best = -1;
+    int next = 0;
+    for (int count=0; count<triangle_count; count++) {
+
+        // si aucun triangle du cache n'est disponible, prendre le suivant non émis
+        if (best < 0) {
+            while (emitted[next]) next++;
+            best = next;
+        }
+
+        // émettre le triangle et le retirer de la liste de ses sommets
+        emitted[best] = true;
+        newcache.clear();
+        for (int i=0; i<3; i++) {
+            int iv = indexlist[best*3+i];
+            result.push_back(iv);
+            newcache.push_back(iv);
+            int* begin = &triangles[first[iv]];
+            int* end = begin + valences[iv];
+            *std::find(begin, end, best) = *(end-1);
+            valences[iv]--;
+        }
+
+        // mettre ses sommets en tête du cache, suivis des anciens
+        for (int iv: cache) {
+            if (iv != newcache[0] && iv != newcache[1] && iv != newcache[2]) newcache.push_back(iv);
+        }
+
+        // mettre à jour les scores des sommets du cache, et ceux de leurs triangles
+        const int newcache_size = newcache.size();
+        for (int ic=0; ic<newcache_size; ic++) {
+            int iv = newcache[ic];
+            positions[iv] = (ic < CACHE_SIZE) ? ic : -1;
+            float score = getVertexCacheScore(positions[iv], valences[iv]);
+            float delta = score - vertex_scores[iv];
+            vertex_scores[iv] = score;
+            for (int k=0; k<valences[iv]; k++) {
+                triangle_scores[triangles[first[iv]+k]] += delta;
+            }
+        }
+        if (newcache_size > CACHE_SIZE) newcache.resize(CACHE_SIZE);
+        cache.swap(newcache);
+
+        // choisir le meilleur triangle parmi ceux des sommets du cache
+        best = -1;
+        float best_score = -1.0;
+        for (int iv: cache) {
+            for (int k=0; k<valences[iv]; k++) {
+                int it = triangles[first[iv]+k];
+                if (triangle_scores[it] > best_score) {
+                    best_score = triangle_scores[it];
+                    best = it;
+                }
+            }
+        }
+    }
+
+    indexlist.swap(result);
 }
 
 
@@ -172,8 +532,9 @@ VBOset* MeshModuleDrawing::createFacesNormalsVBOset(Material* material, float le
     // remplir les VBO avec les données demandées
     std::vector<GLfloat> data;
 
-    // sommet et coordonnées temporaires
-    MeshVertex* vertextmp = new MeshVertex(nullptr, "tmp");
+    // sommet et coordonnées temporaires, le sommet range ses attributs dans un maillage de travail
+    Mesh scratch("tmp");
+    MeshVertex* vertextmp = new MeshVertex(&scratch, "tmp");
     vec3 coords_center = vec3::create();
     vec3 coords_endpoint = vec3::create();
 
@@ -207,7 +568,6 @@ VBOset* MeshModuleDrawing::createFacesNormalsVBOset(Material* material, float le
         // ajouter les valeurs des variables attributs (VBOvar)
         vboset->appendVertexComponents(vertextmp, data);
     }
-    delete vertextmp;
 
     // créer le VBO entrelacé
     vboset->createInterleavedDataAttributesVBO(data);
@@ -233,8 +593,9 @@ VBOset* MeshModuleDrawing::createVertexNormalsVBOset(Material* material, float l
     // remplir les VBO avec les données demandées
     std::vector<GLfloat> data;
 
-    // sommet et coordonnées temporaires
-    MeshVertex* vertextmp = new MeshVertex(nullptr, "tmp");
+    // sommet et coordonnées temporaires, le sommet range ses attributs dans un maillage de travail
+    Mesh scratch("tmp");
+    MeshVertex* vertextmp = new MeshVertex(&scratch, "tmp");
     vec3 coords_endpoint = vec3::create();
 
     // traiter chaque vertex
@@ -252,7 +613,6 @@ VBOset* MeshModuleDrawing::createVertexNormalsVBOset(Material* material, float l
         // ajouter les valeurs des variables attributs (VBOvar)
         vboset->appendVertexComponents(vertextmp, data);
     }
-    delete vertextmp;
 
     // créer le VBO entrelacé
     vboset->createInterleavedDataAttributesVBO(data);
@@ -264,284 +624,3 @@ VBOset* MeshModuleDrawing::createVertexNormalsVBOset(Material* material, float l
     return vboset;
 }
 
-
-
-TriangleStrip::TriangleStrip(MeshTriangle* triangle)
-{
-    // copie de la liste des sommets du triangle
-    m_VertexList.clear();
-    m_VertexList.push_back(triangle->getVertex0());
-    m_VertexList.push_back(triangle->getVertex1());
-    m_VertexList.push_back(triangle->getVertex2());
-}
-
-
-/**
- * retourne l'un des sommets du ruban, désigné par son numéro
- * @param i = le numéro du sommet, si <0 alors par rapport à la fin du tableau
- * @return le ie sommet du ruban
- */
-MeshVertex* TriangleStrip::getVertex(int i)
-{
-    if (i < 0) {
-        return m_VertexList[m_VertexList.size()+i];
-    } else {
-        return m_VertexList[i];
-    }
-}
-
-
-/**
- * Cette méthode tente d'ajouter le triangle au ruban
- * @param triangle à rajouter
- * @return true si le triangle a pu être mis dans le ruban, false sinon
- */
-bool TriangleStrip::appendTriangle(MeshTriangle* triangle)
-{
-    // nombre de sommets du ruban
-    int vertex_number = m_VertexList.size();
-
-    // cas particulier : le ruban ne compte qu'un seul triangle
-    if (vertex_number == 3) {
-        // sommets du ruban
-        MeshVertex* v0 = m_VertexList[0];
-        MeshVertex* v1 = m_VertexList[1];
-        MeshVertex* v2 = m_VertexList[2];
-        // NB: les tests sont dans l'ordre le plus favorable si les triangles ont été créés par addNappeRectangulaire
-        // le triangle contient-il l'arête C-B ?
-        if (triangle->containsEdge(v2, v1)) {
-            // le triangle se colle à l'arête B-C du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-        // le triangle contient-il l'arête B-A ?
-        if (triangle->containsEdge(v1, v0)) {
-            // le triangle se colle à l'arête A-B du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-        // le triangle contient-il l'arête A-C ?
-        if (triangle->containsEdge(v0, v2)) {
-            // le triangle se colle à l'arête C-A du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-        // aucun des trois côtés ne convient
-        return false;
-    }
-
-    // si le nombre de sommets du ruban est pair, on peut le retourner si besoin
-    if ((vertex_number % 2) == 0) {
-        // test d'insertion en fin de ruban
-        if (triangle->containsEdge(m_VertexList[vertex_number-2], m_VertexList[vertex_number-1])) {
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-        // test d'insertion en debut de ruban
-        if (triangle->containsEdge(m_VertexList[1], m_VertexList[0])) {
-            // retourner le ruban
-            std::reverse(m_VertexList.begin(), m_VertexList.end());
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-    } else {
-        // le nombre de sommets du ruban est impair, on ne peut insérer qu'en fin
-        if (triangle->containsEdge(m_VertexList[vertex_number-1], m_VertexList[vertex_number-2])) {
-            m_VertexList.push_back(triangle->getVertex(2));
-            return true;
-        }
-    }
-
-    // aucune solution n'est satisfaisante, le triangle ne peut pas être ajouté
-    return false;
-}
-
-
-/**
- * Cette méthode tente d'ajouter un ruban de 3 sommets au ruban
- * @param other : autre ruban à rajouter
- * @return true si l'autre ruban a pu être mis dans le ruban, false sinon
- */
-bool TriangleStrip::appendStrip3(TriangleStrip* other)
-{
-    // nombre de sommets du ruban
-    int vertex_number = m_VertexList.size();
-
-    // cas particulier : le ruban ne compte qu'un seul triangle
-    if (vertex_number == 3) {
-        // sommets du ruban
-        MeshVertex* v0 = m_VertexList[0];
-        MeshVertex* v1 = m_VertexList[1];
-        MeshVertex* v2 = m_VertexList[2];
-        // NB: les tests sont dans l'ordre le plus favorable si les triangles ont été créés par addNappeRectangulaire
-        // l'autre ruban contient-il l'arête C-B ?
-        if (other->containsEdge(v2, v1)) {
-            // l'autre ruban se colle à l'arête B-C du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-        // l'autre ruban contient-il l'arête B-A ?
-        if (other->containsEdge(v1, v0)) {
-            // l'autre ruban se colle à l'arête A-B du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-        // l'autre ruban contient-il l'arête A-C ?
-        if (other->containsEdge(v0, v2)) {
-            // l'autre ruban se colle à l'arête C-A du ruban
-            m_VertexList.clear();
-            m_VertexList.push_back(v1);
-            m_VertexList.push_back(v2);
-            m_VertexList.push_back(v0);
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-        // aucun des trois côtés ne convient
-        return false;
-    }
-
-    // si le nombre de sommets du ruban est pair, on peut le retourner si besoin
-    if ((vertex_number % 2) == 0) {
-        // test d'insertion en fin de ruban
-        if (other->containsEdge(m_VertexList[vertex_number-2], m_VertexList[vertex_number-1])) {
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-        // test d'insertion en debut de ruban
-        if (other->containsEdge(m_VertexList[1], m_VertexList[0])) {
-            // retourner le ruban
-            std::reverse(m_VertexList.begin(), m_VertexList.end());
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-    } else {
-        // le nombre de sommets du ruban est impair, on ne peut insérer qu'en fin
-        if (other->containsEdge(m_VertexList[vertex_number-1], m_VertexList[vertex_number-2])) {
-            m_VertexList.push_back(other->m_VertexList[2]);
-            return true;
-        }
-    }
-
-    // aucune solution n'est satisfaisante, le triangle ne peut pas être ajouté
-    return false;
-}
-
-
-/**
- * retourne true si le ruban contient 3 sommets, dont v1 suivi de v2
- * Si true, alors au retour, v1 et v2 sont dans les deux premières places du ruban
- * @param vertex0 : premier sommet de l'arête (elle est orientée de 1 à 2)
- * @param vertex1 : second sommet
- * @return true si oui, false si l'arête n'est pas dans le triangle
- */
-bool TriangleStrip::containsEdge(MeshVertex* vertex0, MeshVertex* vertex1)
-{
-    if (m_VertexList.size() != 3) return false;
-
-    if (m_VertexList[0] == vertex0 && m_VertexList[1] == vertex1) return true;
-
-    if (m_VertexList[1] == vertex0 && m_VertexList[2] == vertex1) {
-        // mettre m_VertexList[1] en premier
-        MeshVertex* tmp = m_VertexList[1];
-        m_VertexList[1] = m_VertexList[2];
-        m_VertexList[2] = m_VertexList[0];
-        m_VertexList[0] = tmp;
-        return true;
-    }
-
-    if (m_VertexList[2] == vertex0 && m_VertexList[0] == vertex1) {
-        // mettre m_VertexList[2] en premier
-        MeshVertex* tmp = m_VertexList[1];
-        m_VertexList[1] = m_VertexList[0];
-        m_VertexList[0] = m_VertexList[2];
-        m_VertexList[2] = tmp;
-        return true;
-    }
-
-    return false;
-}
-
-
-/**
- * Cette méthode tente d'ajouter le ruban fourni au ruban this
- * @param strip : ruban à rajouter
- * @return true si le ruban a pu être concaténé à this, false sinon
- */
-bool TriangleStrip::concat(TriangleStrip* strip)
-{
-    // nombre de sommets des rubans
-    const int thisvertexnumber  = m_VertexList.size();
-    const int stripvertexnumber = strip->m_VertexList.size();
-
-    // cas particulier d'un triangle, appeler l'autre méthode
-    if (stripvertexnumber == 3) return appendStrip3(strip);
-
-    // si this a un nombre de sommets pair, alors tenter
-    if ((thisvertexnumber % 2) == 0) {
-        // il faut que la dernière arête de this = la première de ruban
-        if (m_VertexList[thisvertexnumber-2] == strip->m_VertexList[0] &&
-            m_VertexList[thisvertexnumber-1] == strip->m_VertexList[1]) {
-            m_VertexList.insert(m_VertexList.end(), strip->m_VertexList.begin()+2, strip->m_VertexList.end());
-            return true;
-        }
-        // si l'autre ruban a un nombre pair de sommets, on peut le retourner
-        if ((stripvertexnumber % 2) == 0) {
-            // tenter de mettre l'autre ruban à l'envers en fin de this
-            if (m_VertexList[thisvertexnumber-2] == strip->m_VertexList[stripvertexnumber-1] &&
-                m_VertexList[thisvertexnumber-1] == strip->m_VertexList[stripvertexnumber-2]) {
-                std::reverse(strip->m_VertexList.begin(), strip->m_VertexList.end());
-                m_VertexList.insert(m_VertexList.end(), strip->m_VertexList.begin()+2, strip->m_VertexList.end());
-                return true;
-            }
-            // tenter de metre l'autre ruban au début de this
-            if (m_VertexList[0] == strip->m_VertexList[stripvertexnumber-2] &&
-                m_VertexList[1] == strip->m_VertexList[stripvertexnumber-1]) {
-                m_VertexList.erase(m_VertexList.begin(), m_VertexList.begin()+2);
-                m_VertexList.insert(m_VertexList.begin(), strip->m_VertexList.begin(), strip->m_VertexList.end());
-                return true;
-            }
-        }
-    }
-
-    // si ruban a un nombre de sommets pair
-    if ((stripvertexnumber % 2) == 0) {
-        // tenter de mettre this à la fin de ruban
-        if (m_VertexList[0] == strip->m_VertexList[stripvertexnumber-2] &&
-            m_VertexList[1] == strip->m_VertexList[stripvertexnumber-1]) {
-            m_VertexList.erase(m_VertexList.begin(), m_VertexList.begin()+2);
-            m_VertexList.insert(m_VertexList.begin(), strip->m_VertexList.begin(), strip->m_VertexList.end());
-            return true;
-        }
-        // tenter de mettre this en début de ruban (en inversant ruban)
-        if (m_VertexList[0] == strip->m_VertexList[1] &&
-            m_VertexList[1] == strip->m_VertexList[0]) {
-            std::reverse(strip->m_VertexList.begin(), strip->m_VertexList.end());
-            m_VertexList.erase(m_VertexList.begin(), m_VertexList.begin()+2);
-            m_VertexList.insert(m_VertexList.begin(), strip->m_VertexList.begin(), strip->m_VertexList.end());
-            return true;
-        }
-    }
-
-    // aucune solution n'est satisfaisante, le ruban ne peut pas être ajouté
-    return false;
-}
@@ -25,6 +25,42 @@ public:
      */
     VBOset* createVBOset(Material* material, bool interleaved=true);
 
+    /**
+     * Cette méthode crée tous les VBO pour dessiner le maillage à l'aide de triangles, dans un
+     * ordre optimisé pour le cache des sommets transformés de la carte graphique. Les sommets
+     * sont rangés dans les VBO dans l'ordre de leur première utilisation.
+     * @param material : celui qu'il faut employer pour dessiner les triangles
+     * @param interleaved : true s'il faut entrelacer les données
+     */
+    VBOset* createOptimizedVBOset(Material* material, bool interleaved=true);
+
+    /**
+     * Cette méthode construit les indices des triangles du maillage dans un ordre optimisé
+     * pour le cache des sommets transformés, ainsi que l'ordre dans lequel ranger les sommets
+     * dans les VBO (celui de leur première utilisation). Les indices se rapportent à cet ordre.
+     * @param indexlist : tableau qui reçoit les indices des triangles
+     * @param fetch_order : tableau qui reçoit les sommets dans l'ordre où les ranger
+     */
+    void createOptimizedIndexList(std::vector<int>& indexlist, std::vector<MeshVertex*>& fetch_order);
+
+    /**
+     * Cette méthode réordonne les triangles d'une liste d'indices GL_TRIANGLES pour qu'ils
+     * réutilisent au mieux le cache des sommets transformés (algorithme de Tom Forsyth,
+     * "Linear-Speed Vertex Cache Optimisation")
+     * @param indexlist : indices des triangles, modifié sur place
+     * @param vertex_count : nombre de sommets, les indices doivent être inférieurs
+     */
+    static void optimizeVertexCache(std::vector<int>& indexlist, int vertex_count);
+
+    /**
+     * Cette méthode compte les sommets qu'un cache FIFO de la taille indiquée devrait
+     * transformer pour dessiner les indices dans l'ordre fourni
+     * @param indexlist : indices des sommets, triangles ou rubans
+     * @param cachesize : nombre de sommets dans le cache
+     * @return nombre de défauts de cache
+     */
+    static int countCacheMisses(const std::vector<int>& indexlist, int cachesize=CACHE_SIZE);
+
     /**
      * Cette méthode crée tous les VBO pour dessiner le maillage à l'aide de triangle_strips
      * @param material : celui qu'il faut employer pour dessiner les triangles du ruban
@@ -32,6 +68,14 @@ public:
      */
     VBOset* createStripVBOset(Material* material, bool interleaved=true);
 
+    /**
+     * Cette méthode regroupe les triangles du maillage en rubans et retourne leurs indices,
+     * les rubans étant reliés par des triangles dégénérés. Les sommets doivent être numérotés.
+     * @param indexlist : tableau qui reçoit les numéros des sommets des rubans
+     * @return nombre de rubans construits
+     */
+    int createStripIndexList(std::vector<int>& indexlist);
+
     /**
      * Cette méthode crée tous les VBO pour dessiner les arêtes du maillage
      * @param material : celui qu'il faut employer pour dessiner les arêtes
@@ -52,87 +96,45 @@ public:
      */
     VBOset* createVertexNormalsVBOset(Material* material, float length);
 
-};
-
-
-
-/**
- * Cette classe représente un triangle strip
- * @param triangle : le premier triangle d'un ruban
- * @remark l'ordre des sommets du triangle est important pour commencer un ruban !
- * @remark Ruban hérite de Triangle, ou inversement
- */
-class TriangleStrip
-{
-
-private:
-
-    std::vector<MeshVertex*> m_VertexList;
-
-public:
-
-    /** constructeur d'un ruban ne contenant qu'un triangle initialement */
-    TriangleStrip(MeshTriangle* triangle);
-
-    /**
-     * retourne la longueur du ruban, son nombre de sommets
-     * @return nombre de sommets du ruban
-     */
-    int size()
-    {
-        return m_VertexList.size();
-    }
-
     /**
-     * retourne la liste des sommets du ruban
-     * @return liste des sommets
+     * Cette méthode affiche les statistiques d'un ensemble de rubans
+     * @param indexlist : indices des rubans
+     * @param stripcount : nombre de rubans
      */
-     std::vector<MeshVertex*> getVertexList()
-     {
-         return m_VertexList;
-     }
+    void printStripStats(const std::vector<int>& indexlist, int stripcount);
 
     /**
-     * retourne l'un des sommets du ruban, désigné par son numéro
-     * @param i = le numéro du sommet, si <0 alors par rapport à la fin du tableau
-     * @return le ie sommet du ruban
+     * Cette méthode affiche la place occupée par les sommets d'un VBOset, en octets
+     * par sommet, comparée à celle qu'ils occuperaient avec des GL_FLOAT seulement
+     * @param name : nom du maillage
+     * @param vboset : VBOset dont les VBO des attributs ont été créés
      */
-    MeshVertex* getVertex(int i);
+    static void printVertexStats(std::string name, VBOset* vboset);
 
     /**
-     * Cette méthode tente d'ajouter le triangle au ruban
-     * @param triangle à rajouter
-     * @return true si le triangle a pu être mis dans le ruban, false sinon
+     * Cette méthode affiche l'efficacité du cache de sommets : nombre moyen de sommets
+     * transformés par triangle (ACMR) et par sommet du maillage (ATVR)
+     * @param indexlist : indices des sommets, triangles ou rubans
      */
-    bool appendTriangle(MeshTriangle* triangle);
+    void printCacheStats(const std::vector<int>& indexlist);
 
-    /**
-     * Cette méthode tente d'ajouter un ruban de 3 sommets au ruban
-     * @param autre ruban à rajouter
-     * @return true si l'autre ruban a pu être mis dans le ruban, false sinon
-     */
-    bool appendStrip3(TriangleStrip* autre);
+    /// nombre de sommets transformés gardés par le cache supposé de la carte graphique
+    static const int CACHE_SIZE = 32;
 
 private:
 
     /**
-     * retourne true si le ruban contient 3 sommets, dont s1 suivi de s2
-     * Si true, alors au retour, s1 et s2 sont dans les deux premières places du ruban
-     * @param vertex0 : premier sommet de l'arête (elle est orientée de 1 à 2)
-     * @param vertex1 : second sommet
-     * @return true si oui, false si l'arête n'est pas dans le triangle
-     */
-    bool containsEdge(MeshVertex* vertex0, MeshVertex* vertex1);
-
-public:
-
-    /**
-     * Cette méthode tente d'ajouter le ruban fourni au ruban this
-     * @param ruban à rajouter
-     * @return true si le ruban a pu être concaténé à this, false sinon
+     * Cette méthode parcourt le ruban qui commence par le triangle de la demi-arête, sans
+     * passer par les triangles déjà mis dans un ruban ni par ceux marqués avec stamp
+     * @param start : demi-arête du premier triangle, allant de son premier à son deuxième sommet
+     * @param stamp : marque à poser sur les triangles parcourus
+     * @param marks : marques des triangles, -1 pour ceux qui sont déjà dans un ruban
+     * @param path : reçoit la demi-arête d'entrée de chaque triangle du ruban
+     * @return nombre de triangles du ruban
      */
-    bool concat(TriangleStrip* ruban);
+    int walkStrip(MeshHalfEdge* start, int stamp, std::vector<int>& marks, std::vector<MeshHalfEdge*>& path);
 
 };
 
+
 #endif
@@ -7,71 +7,371 @@
 #include <stdlib.h>
 #include <math.h>
 #include <ctype.h>
+#include <thread>
+#include <atomic>
 
+#include <utils.h>
 #include <MeshModuleLoading.h>
 
 
+/**
+ * Fonctions d'analyse lexicale du fichier OBJ. Elles travaillent directement sur
+ * le contenu du fichier projeté en mémoire, entre un pointeur courant p et la fin
+ * de la ligne end, et retournent la position qui suit ce qu'elles ont lu.
+ */
+
+/**
+ * passe les espaces et tabulations
+ * @param p : position courante
+ * @param end : fin de la ligne
+ * @return position du premier caractère qui n'est pas un espace
+ */
+static inline const char* skipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+
+/**
+ * passe le mot courant
+ * @param p : position courante
+ * @param end : fin de la ligne
+ * @return position du premier espace qui suit le mot
+ */
+static inline const char* skipWord(const char* p, const char* end)
+{
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r') p++;
+    return p;
+}
+
+
+/**
+ * lit un entier signé
+ * @param p : position courante, sur le premier chiffre ou le signe
+ * @param end : fin de la ligne
+ * @param value : entier lu, 0 s'il n'y a pas de chiffres
+ * @return position qui suit l'entier
+ */
+static inline const char* parseInt(const char* p, const char* end, int& value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    int result = 0;
+    while (p < end && (unsigned)(*p - '0') < 10) {
+        result = result * 10 + (*p - '0');
+        p++;
+    }
+    value = negative ? -result : result;
+    return p;
+}
+
+
+/**
+ * lit un réel, ex: -1.25e-3, comme le ferait atof
+ * @param p : position courante
+ * @param end : fin de la ligne
+ * @param value : réel lu, 0 s'il est absent ou incorrect
+ * @return position qui suit le réel
+ */
+static inline const char* parseFloat(const char* p, const char* end, float& value)
+{
+    // puissances de 10 représentables exactement
+    static const double powers10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    p = skipSpaces(p, end);
+    const char* start = p;
+
+    // signe
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // mantisse : partie entière puis décimale, 19 chiffres significatifs au plus
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool ok = false;
+    while (p < end && (unsigned)(*p - '0') < 10) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa > 0) digits++;
+        } else {
+            exponent++;
+        }
+        ok = true;
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && (unsigned)(*p - '0') < 10) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa > 0) digits++;
+                exponent--;
+            }
+            ok = true;
+            p++;
+        }
+    }
+
+    // exposant
+    if (ok && p < end && (*p == 'e' || *p == 'E')) {
+        int e = 0;
+        p = parseInt(p+1, end, e);
+        exponent += e;
+    }
+
+    // cas non prévu (nan, inf, 0x...) : laisser faire la bibliothèque C sur une copie du mot
+    if (! ok || (p < end && *p != ' ' && *p != '\t' && *p != '\r')) {
+        const char* wordend = skipWord(start, end);
+        std::string word(start, wordend);
+        value = atof(word.c_str());
+        return wordend;
+    }
+
+    // calcul du résultat
+    double result = (double) mantissa;
+    if (exponent < 0) {
+        if (exponent >= -22) result /= powers10[-exponent]; else result *= pow(10.0, exponent);
+    } else if (exponent > 0) {
+        if (exponent <= 22) result *= powers10[exponent]; else result *= pow(10.0, exponent);
+    }
+    value = negative ? -result : result;
+    return p;
+}
+
+
+/**
+ * lit un coin de face de la forme nv, nv/nt, nv//nn ou nv/nt/nn
+ * @param p : position courante
+ * @param end : fin de la ligne
+ * @param nv : numéro des coordonnées, 0 s'il est absent
+ * @param nt : numéro des coordonnées de texture, 0 s'il est absent
+ * @param nn : numéro de la normale, 0 s'il est absente
+ * @return position qui suit le coin, nullptr s'il n'y a plus de coin sur la ligne
+ */
+static inline const char* parseCorner(const char* p, const char* end, int& nv, int& nt, int& nn)
+{
+    p = skipSpaces(p, end);
+    if (p >= end) return nullptr;
+    nv = nt = nn = 0;
+    p = parseInt(p, end, nv);
+    if (p < end && *p == '/') {
+        p++;
+        if (p < end && *p != '/') p = parseInt(p, end, nt);
+        if (p < end && *p == '/') {
+            p = parseInt(p+1, end, nn);
+        }
+    }
+    // ignorer ce qui resterait du mot
+    return skipWord(p, end);
+}
+
+
+/**
+ * compare le mot [p, wordend[ au mot-clé fourni, en minuscules
+ * @param p : début du mot
+ * @param wordend : fin du mot
+ * @param keyword : mot-clé en minuscules
+ * @return true si le mot est égal au mot-clé sans tenir compte de la casse
+ */
+static inline bool isKeyword(const char* p, const char* wordend, const char* keyword)
+{
+    while (p < wordend && *keyword != '\0') {
+        if (tolower(*p) != *keyword) return false;
+        p++;
+        keyword++;
+    }
+    return p == wordend && *keyword == '\0';
+}
+
+
+/**
+ * Cette structure contient le résultat de l'analyse d'un morceau du fichier OBJ.
+ * Les morceaux sont analysés indépendamment, éventuellement en parallèle, puis
+ * fusionnés dans l'ordre du fichier. Les faces ne sont pas encore résolues : on
+ * garde les numéros lus et le nombre de v, vt et vn vus avant elles dans le morceau,
+ * pour pouvoir traiter les numéros relatifs (négatifs) lors de la fusion.
+ */
+struct ObjChunk
+{
+    /// zone du fichier à analyser
+    const char* begin;
+    const char* end;
+
+    /// coordonnées, coordonnées de texture et normales définies dans ce morceau
+    std::vector<vec3> coordlist;
+    std::vector<vec2> texcoordlist;
+    std::vector<vec3> normallist;
+
+    /// numéros (nv,nt,nn) des coins de toutes les faces, à la suite
+    std::vector<int> corners;
+
+    /// faces et changements de matériau dans l'ordre du fichier
+    struct Record {
+        int count;          // nombre de coins de la face, -1 pour un usemtl
+        int first;          // indice du premier coin dans corners, ou du nom dans materialnames
+        int vbase;          // nombre de v vus avant cette face dans le morceau
+        int vtbase;         // nombre de vt vus avant cette face dans le morceau
+        int vnbase;         // nombre de vn vus avant cette face dans le morceau
+    };
+    std::vector<Record> records;
+
+    /// noms des matériaux cités par usemtl
+    std::vector<std::string> materialnames;
+};
+
+
+/**
+ * analyse un morceau du fichier OBJ, sans rien modifier d'autre que le morceau
+ * @param chunk : morceau à analyser, il reçoit le résultat
+ * @param scale : rapport d'agrandissement à appliquer aux coordonnées
+ */
+static void parseObjChunk(ObjChunk& chunk, float scale)
+{
+    // parcourir le morceau ligne par ligne
+    const char* p = chunk.begin;
+    const char* eof = chunk.end;
+    while (p < eof) {
+        // délimiter la ligne courante et préparer la suivante
+        const char* end = (const char*) memchr(p, '\n', eof - p);
+        if (end == nullptr) end = eof;
+        const char* line = p;
+        p = end + 1;
+
+        // extraire le premier mot de la ligne
+        line = skipSpaces(line, end);
+        const char* wordend = skipWord(line, end);
+        if (wordend == line) continue;
+
+        if (isKeyword(line, wordend, "f")) {
+            // mémoriser les numéros de tous les coins de la face
+            ObjChunk::Record record;
+            record.first = chunk.corners.size();
+            record.vbase = chunk.coordlist.size();
+            record.vtbase = chunk.texcoordlist.size();
+            record.vnbase = chunk.normallist.size();
+            int nv, nt, nn;
+            const char* q = wordend;
+            while ((q = parseCorner(q, end, nv, nt, nn)) != nullptr) {
+                chunk.corners.push_back(nv);
+                chunk.corners.push_back(nt);
+                chunk.corners.push_back(nn);
+            }
+            record.count = (chunk.corners.size() - record.first) / 3;
+            chunk.records.push_back(record);
+        } else
+        if (isKeyword(line, wordend, "v")) {
+            // coordonnées du sommet
+            float x, y, z;
+            const char* q = parseFloat(wordend, end, x);
+            q = parseFloat(q, end, y);
+            parseFloat(q, end, z);
+            chunk.coordlist.push_back(vec3::fromValues(x*scale, y*scale, z*scale));
+        } else
+        if (isKeyword(line, wordend, "vt")) {
+            // coordonnées de texture
+            float u, v;
+            const char* q = parseFloat(wordend, end, u);
+            parseFloat(q, end, v);
+            chunk.texcoordlist.push_back(vec2::fromValues(u,v));
+        } else
+        if (isKeyword(line, wordend, "vn")) {
+            // coordonnées de la normale
+            float nx, ny, nz;
+            const char* q = parseFloat(wordend, end, nx);
+            q = parseFloat(q, end, ny);
+            parseFloat(q, end, nz);
+            chunk.normallist.push_back(vec3::fromValues(nx,ny,nz));
+        } else
+        if (isKeyword(line, wordend, "usemtl")) {
+            // mémoriser le changement de matériau
+            const char* name = skipSpaces(wordend, end);
+            ObjChunk::Record record;
+            record.count = -1;
+            record.first = chunk.materialnames.size();
+            record.vbase = record.vtbase = record.vnbase = 0;
+            chunk.materialnames.push_back(std::string(name, skipWord(name, end)));
+            chunk.records.push_back(record);
+        }
+    }
+}
+
+
 /**
  * initialise un loader de fichier obj sur le maillage fourni
  * @param mesh maillage à compléter avec le fichier obj
  */
 MeshModuleLoading::MeshModuleLoading(Mesh* mesh): MeshModule(mesh)
 {
+    m_ThreadCount = 0;
+}
+
+
+/**
+ * définit le nombre de threads employés pour analyser les fichiers OBJ.
+ * Le fichier est découpé en morceaux analysés en parallèle, puis les
+ * maillages sont construits dans l'ordre du fichier.
+ * @param count : nombre de threads, 0 pour autant que de coeurs, 1 pour une analyse séquentielle
+ */
+void MeshModuleLoading::setThreadCount(int count)
+{
+    m_ThreadCount = count;
 }
 
 
 /**
  * Cette méthode recherche dans sommets celui qui possède exactement les
  * mêmes coordonnées : 3D, de texture et normale qu'indiqué
- * @param nvntnn : mot contenant les numéros nn/nt/nn
- * @param vertexlist : tableau indexé par iv de sommets au même endroit
+ * @param nv : numéro des coordonnées dans le fichier (1..N ou <0 si relatif)
+ * @param nt : numéro des coordonnées de texture, 0 si absent
+ * @param nn : numéro de la normale, 0 si absent
+ * @param vertexmap : dictionnaire des sommets déjà créés dans le maillage
  * @param coordlist : tableau de vec3 donnant les coordonnées des sommets
  * @param texcoordlist : tableau de vec2 donnant les coordonnées de texture
  * @param normallist : tableau de vec3 donnant les normales
- * @return le sommet correspondant au triplet (nv,nt,nn)
+ * @return le sommet correspondant au triplet (nv,nt,nn), nullptr si nv est incorrect
  */
 MeshVertex* MeshModuleLoading::findOrCreateVertex(
-    char* nvntnn,
-    std::map<int, std::list<MeshVertex*>> &vertexlist,
+    int nv, int nt, int nn,
+    ObjVertexMap &vertexmap,
     std::vector<vec3> &coordlist,
     std::vector<vec2> &texcoordlist,
     std::vector<vec3> &normallist)
 {
     // indices des coordonnées 3D, des coordonnées de texture et de la normale
-    int nv = 0;
-    int nt = 0;
-    int nn = 0;
-    sscanf(nvntnn, "%d", &nv);
-    sscanf(nvntnn, "%d//%d", &nv, &nn);
-    sscanf(nvntnn, "%d/%d", &nv, &nt);
-    sscanf(nvntnn, "%d/%d/%d", &nv, &nt, &nn);
     if (nv == 0) return nullptr;
-    if (nv < 0) nv = coordlist.size() + nv; else nv = nv - 1;
-    if (nt < 0) nt = texcoordlist.size() + nt; else nt = nt - 1;
-    if (nt >= texcoordlist.size()) nt = -1;
-    if (nn < 0) nn = normallist.size() + nn; else nn = nn - 1;
-    if (nn >= normallist.size()) nn = -1;
+    // NB : un numéro hors limites, même relatif, désigne des coordonnées absentes
+    if (nv < 0) nv = (int) coordlist.size() + nv; else nv = nv - 1;
+    if (nv < 0 || nv >= (int) coordlist.size()) return nullptr;
+    if (nt < 0) nt = (int) texcoordlist.size() + nt; else nt = nt - 1;
+    if (nt < 0 || nt >= (int) texcoordlist.size()) nt = -1;
+    if (nn < 0) nn = (int) normallist.size() + nn; else nn = nn - 1;
+    if (nn < 0 || nn >= (int) normallist.size()) nn = -1;
 
-    // nom du sommet courant, c'est son identifiant
-    std::stringstream ss;
-    ss << "v(" << nv << "," << nt << "," << nn << ")";
-    std::string name = ss.str();
+    // le sommet existe-t-il déjà ?
+    ObjVertexKey key = { nv, nt, nn };
+    auto found = vertexmap.insert(std::make_pair(key, (MeshVertex*) nullptr));
+    if (! found.second) return found.first->second;
 
-    // parcourir les sommets de la liste nv et voir s'il y a le même
-    std::list<MeshVertex*>& siblings = vertexlist[nv];
-    for (MeshVertex* other: siblings) {
-        // si les noms sont égaux, c'est le même sommet
-        if (name == other->getName()) return other;
-    }
-
-    // il faut créer un nouveau sommet car soit nouveau, soit un peu différent des autres
+    // il faut créer un nouveau sommet, son nom est son identifiant
+    std::string name = "v("+std::to_string(nv)+","+std::to_string(nt)+","+std::to_string(nn)+")";
     MeshVertex* vertex = m_Mesh->addVertex(name);
     vertex->setCoord(coordlist[nv]);
     if (nt >= 0) vertex->setTexCoord(texcoordlist[nt]);
     if (nn >= 0) vertex->setNormal(normallist[nn]);
 
-    // on ajoute ce sommet dans la liste de ceux qui ont le même numéro nv
-    siblings.push_front(vertex);
+    // on le mémorise pour les prochaines faces
+    found.first->second = vertex;
     return vertex;
 }
 
@@ -84,85 +384,168 @@ MeshVertex* MeshModuleLoading::findOrCreateVertex(
  */
 void MeshModuleLoading::loadObjFile(std::string objfilename, std::string materialname, float scale)
 {
-    // tableaux des sommets qu'on va extraire du fichier obj, ils sont groupés par indice nv
-    std::map<int, std::list<MeshVertex*>> vertexlist;
+    // un seul maillage, celui du module, pour le matériau demandé ("" = tous)
+    std::map<std::string, Mesh*> meshes;
+    meshes[materialname] = m_Mesh;
+    loadObjFile(objfilename, meshes, scale);
+}
+
+
+/**
+ * Charge les données du fichier OBJ indiqué en une seule lecture et répartit
+ * les triangles dans les maillages fournis, selon leur matériau (usemtl).
+ * Les faces d'un matériau absent du dictionnaire sont ignorées, sauf si le
+ * dictionnaire contient la clé "" : son maillage reçoit alors toutes ces faces.
+ * NB : le maillage du module (setMesh) n'est pas employé par cette méthode
+ * @param objfilename : nom complet du fichier à charger
+ * @param meshes : dictionnaire (nom du matériau, maillage à compléter)
+ * @param scale : rapport d'agrandissement à appliquer
+ */
+void MeshModuleLoading::loadObjFile(std::string objfilename, std::map<std::string, Mesh*>& meshes, float scale)
+{
+    // sauvegarde du maillage du module, m_Mesh désigne le maillage du matériau courant
+    Mesh* modulemesh = m_Mesh;
+
+    // sommets qu'on va extraire du fichier obj, ils sont groupés par maillage
+    std::map<Mesh*, ObjVertexMap> vertexmaps;
+
+    // maillage par défaut (clé "") : il reçoit les faces des matériaux non listés
+    auto itdefault = meshes.find("");
+    Mesh* defaultmesh = (itdefault != meshes.end()) ? itdefault->second : nullptr;
+
+    // projection du fichier en mémoire
+    Utils::MappedFile file(objfilename);
+    if (! file.isOpen()) {
+        std::cerr << "Error : \"" << objfilename << "\" cannot be loaded, check pathname and permissions." << std::endl;
+        return;
+    }
+    const char* data = file.getData();
+    const size_t size = file.getSize();
+
+    // nombre de threads et de morceaux : au moins 1 Mo par morceau, quelques morceaux par thread
+    int threadcount = (m_ThreadCount > 0) ? m_ThreadCount : std::thread::hardware_concurrency();
+    if (threadcount < 1) threadcount = 1;
+    const size_t minchunksize = 1 << 20;
+    size_t chunkcount = std::min((size_t) threadcount * 4, size / minchunksize);
+    if (chunkcount < 1 || threadcount == 1) chunkcount = 1;
+
+    // découper le fichier en morceaux, chacun se termine à une fin de ligne
+    std::vector<ObjChunk> chunks(chunkcount);
+    const char* begin = data;
+    for (size_t i=0; i<chunkcount; i++) {
+        const char* end = data + (size * (i+1)) / chunkcount;
+        if (end < begin) end = begin;
+        if (i < chunkcount-1) {
+            const char* eol = (const char*) memchr(end, '\n', data + size - end);
+            end = (eol == nullptr) ? data + size : eol + 1;
+        }
+        chunks[i].begin = begin;
+        chunks[i].end = end;
+        begin = end;
+    }
 
-    // tableau des coordonnées, des textures et des normales
+    // analyser les morceaux, en parallèle s'il y en a plusieurs
+    if (chunkcount == 1) {
+        parseObjChunk(chunks[0], scale);
+    } else {
+        std::atomic<int> nextchunk(0);
+        auto worker = [&chunks, &nextchunk, chunkcount, scale]() {
+            int i;
+            while ((i = nextchunk++) < (int) chunkcount) {
+                parseObjChunk(chunks[i], scale);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int t=1; t<threadcount && t<(int) chunkcount; t++) {
+            threads.push_back(std::thread(worker));
+        }
+        worker();
+        for (std::thread& thread: threads) thread.join();
+    }
+
+    // rassembler les coordonnées, textures et normales de tous les morceaux
     std::vector<vec3> coordlist;
     std::vector<vec2> texcoordlist;
     std::vector<vec3> normallist;
-    bool computeNormals = true;
+    std::vector<int> vbases, vtbases, vnbases;
+    for (ObjChunk& chunk: chunks) {
+        vbases.push_back(coordlist.size());
+        vtbases.push_back(texcoordlist.size());
+        vnbases.push_back(normallist.size());
+        coordlist.insert(coordlist.end(), chunk.coordlist.begin(), chunk.coordlist.end());
+        texcoordlist.insert(texcoordlist.end(), chunk.texcoordlist.begin(), chunk.texcoordlist.end());
+        normallist.insert(normallist.end(), chunk.normallist.begin(), chunk.normallist.end());
+    }
+    bool computeNormals = normallist.empty();
 
-    // matériau à prendre en compte (tous si materialname est "")
-    std::string usemtl = "";
+    // maillage recevant les faces du matériau courant, nullptr si on les ignore
+    m_Mesh = defaultmesh;
+    ObjVertexMap* vertexmap = &vertexmaps[m_Mesh];
 
-    // ouverture du fichier
-    std::ifstream inputStream;
-    inputStream.open(objfilename.c_str(), std::ifstream::in);
-    if (! inputStream.is_open()) {
-        std::cerr << "Error : \"" << objfilename << "\" cannot be loaded, check pathname and permissions." << std::endl;
-        return;
+    // indexer les demi-arêtes des maillages pendant leur construction
+    for (auto const& it: meshes) {
+        if (it.second != nullptr) it.second->beginBuild();
     }
 
-    // parcourir le fichier obj ligne par ligne
-    char* word = NULL;
-    char* saveptr_mot = NULL;
-    int line_number = 0;
-    char line[180];
-    while (inputStream.getline(line, sizeof(line))) {
-        line_number++;
-        // extraire le premier mot de la ligne
-        word = strtok_r(line," \t", &saveptr_mot);
-        if (word == NULL) continue;
-        // mettre le mot en minuscules
-        for (char* c=word; *c!='\0'; ++c) *c = tolower(*c);
-
-        if (strcmp(word,"f") == 0) {
-            // le matériau est-il celui qu'on veut ?
-            if (! materialname.empty() &&  materialname != usemtl) continue;
-            // lire les numéros du premier point
-            if (! (word = strtok_r(NULL, " \t", &saveptr_mot))) continue;
-            MeshVertex* v1 = findOrCreateVertex(word, vertexlist, coordlist, texcoordlist, normallist);
-            // lire les numéros du deuxième point
-            if (! (word = strtok_r(NULL, " \t", &saveptr_mot))) continue;
-            MeshVertex* v2 = findOrCreateVertex(word, vertexlist, coordlist, texcoordlist, normallist);
-            // lire et traiter les points suivants
-            while ((word = strtok_r(NULL, " \t", &saveptr_mot))) {
-                MeshVertex* v3 = findOrCreateVertex(word, vertexlist, coordlist, texcoordlist, normallist);
-                // ajouter un triangle v1,v2,v3
-                if (v1 != nullptr && v2 != nullptr && v3 != nullptr) {
-                    m_Mesh->addTriangle(v1,v2,v3);
+    // construire les maillages dans l'ordre du fichier
+    for (size_t i=0; i<chunkcount; i++) {
+        ObjChunk& chunk = chunks[i];
+        for (ObjChunk::Record& record: chunk.records) {
+
+            // changement de matériau : choisir le maillage qui reçoit les faces suivantes
+            if (record.count < 0) {
+                auto itmesh = meshes.find(chunk.materialnames[record.first]);
+                m_Mesh = (itmesh != meshes.end()) ? itmesh->second : defaultmesh;
+                vertexmap = &vertexmaps[m_Mesh];
+                continue;
+            }
+
+            // le matériau est-il l'un de ceux qu'on veut ?
+            if (m_Mesh == nullptr) continue;
+
+            // sommets de la face, les numéros relatifs sont rendus absolus (1..N) ; ceux qui
+            // remontent avant le début du fichier deviennent 0, c'est à dire absents, sinon
+            // findOrCreateVertex les prendrait pour des numéros relatifs à la fin des listes
+            MeshVertex* v1 = nullptr;
+            MeshVertex* v2 = nullptr;
+            for (int c=0; c<record.count; c++) {
+                const int* corner = &chunk.corners[record.first + 3*c];
+                int nv = corner[0];
+                int nt = corner[1];
+                int nn = corner[2];
+                if (nv < 0) nv = vbases[i]  + record.vbase  + nv + 1;
+                if (nt < 0) nt = vtbases[i] + record.vtbase + nt + 1;
+                if (nn < 0) nn = vnbases[i] + record.vnbase + nn + 1;
+                if (nv < 0) nv = 0;
+                if (nt < 0) nt = 0;
+                if (nn < 0) nn = 0;
+                MeshVertex* v3 = findOrCreateVertex(nv, nt, nn, *vertexmap, coordlist, texcoordlist, normallist);
+                if (c == 0) {
+                    v1 = v3;
+                } else if (c == 1) {
+                    v2 = v3;
+                } else {
+                    // ajouter un triangle v1,v2,v3
+                    if (v1 != nullptr && v2 != nullptr && v3 != nullptr) {
+                        m_Mesh->addTriangle(v1,v2,v3);
+                    }
+                    // préparer le passage au triangle suivant
+                    v2 = v3;
                 }
-                // préparer le passage au triangle suivant
-                v2 = v3;
             }
-        } else
-        if (strcmp(word,"v") == 0) {
-            // coordonnées du sommet
-            float x = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            float y = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            float z = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            vec3 coords = vec3::fromValues(x,y,z);
-            vec3::scale(coords, coords, scale);
-            coordlist.push_back(coords);
-        } else
-        if (strcmp(word,"vt") == 0) {
-            // coordonnées de texture
-            float u = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            float v = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            texcoordlist.push_back(vec2::fromValues(u,v));
-        } else
-        if (strcmp(word,"vn") == 0) {
-            // coordonnées de la normale
-            float nx = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            float ny = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            float nz = atof(strtok_r(NULL, " \t", &saveptr_mot));
-            normallist.push_back(vec3::fromValues(nx,ny,nz));
-            computeNormals = false;
-        } else
-        if (strcmp(word,"usemtl") == 0) {
-            usemtl = strtok_r(NULL, " \t", &saveptr_mot);
         }
     }
-    if (computeNormals) m_Mesh->computeNormals();
+    for (auto const& it: meshes) {
+        if (it.second != nullptr) it.second->endBuild();
+    }
+
+    // calculer les normales des maillages qui ont reçu des sommets
+    if (computeNormals) {
+        for (auto const& it: vertexmaps) {
+            if (it.first != nullptr) it.first->computeNormals();
+        }
+    }
+
+    // remettre le maillage du module
+    m_Mesh = modulemesh;
 }
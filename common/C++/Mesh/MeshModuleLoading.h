@@ -1,6 +1,8 @@
 #ifndef MESH_MESHMODULELOADING_H
 #define MESH_MESHMODULELOADING_H
 
+#include <unordered_map>
+
 #include <gl-matrix.h>
 
 #include <MeshModule.h>
@@ -19,6 +21,14 @@ public:
      */
     MeshModuleLoading(Mesh* mesh=nullptr);
 
+    /**
+     * définit le nombre de threads employés pour analyser les fichiers OBJ.
+     * Le fichier est découpé en morceaux analysés en parallèle, puis les
+     * maillages sont construits dans l'ordre du fichier.
+     * @param count : nombre de threads, 0 pour autant que de coeurs, 1 pour une analyse séquentielle
+     */
+    void setThreadCount(int count);
+
     /**
      * Charge les données du fichier OBJ indiqué et applique une homothétie aux sommets.
      * @param objfilename : nom complet du fichier à charger
@@ -27,22 +37,68 @@ public:
      */
     void loadObjFile(std::string objfilename, std::string materialname="", float scale=1.0f);
 
+    /**
+     * Charge les données du fichier OBJ indiqué en une seule lecture et répartit
+     * les triangles dans les maillages fournis, selon leur matériau (usemtl).
+     * Les faces d'un matériau absent du dictionnaire sont ignorées, sauf si le
+     * dictionnaire contient la clé "" : son maillage reçoit alors toutes ces faces.
+     * NB : le maillage du module (setMesh) n'est pas employé par cette méthode
+     * @param objfilename : nom complet du fichier à charger
+     * @param meshes : dictionnaire (nom du matériau, maillage à compléter)
+     * @param scale : rapport d'agrandissement à appliquer
+     */
+    void loadObjFile(std::string objfilename, std::map<std::string, Mesh*>& meshes, float scale=1.0f);
+
 
 protected:
 
+    /**
+     * Clé identifiant un sommet du fichier OBJ : triplet des numéros (nv,nt,nn)
+     * de ses coordonnées, de ses coordonnées de texture et de sa normale
+     */
+    struct ObjVertexKey
+    {
+        int nv, nt, nn;
+
+        bool operator==(const ObjVertexKey& other) const
+        {
+            return nv == other.nv && nt == other.nt && nn == other.nn;
+        }
+    };
+
+    /** fonction de hachage des clés ObjVertexKey */
+    struct ObjVertexKeyHash
+    {
+        size_t operator()(const ObjVertexKey& key) const
+        {
+            size_t h = (size_t) key.nv;
+            h = h * 0x9E3779B1u + (size_t) key.nt;
+            h = h * 0x9E3779B1u + (size_t) key.nn;
+            return h;
+        }
+    };
+
+    /** dictionnaire des sommets déjà créés dans un maillage, indexé par leur triplet (nv,nt,nn) */
+    typedef std::unordered_map<ObjVertexKey, MeshVertex*, ObjVertexKeyHash> ObjVertexMap;
+
+    /** nombre de threads pour analyser le fichier, 0 si autant que de coeurs */
+    int m_ThreadCount;
+
     /**
      * Cette méthode recherche dans sommets celui qui possède exactement les
      * mêmes coordonnées : 3D, de texture et normale qu'indiqué
-     * @param nvntnn : mot contenant les numéros nn/nt/nn
-     * @param vertexlist : tableau indexé par iv de sommets au même endroit
+     * @param nv : numéro des coordonnées dans le fichier (1..N ou <0 si relatif)
+     * @param nt : numéro des coordonnées de texture, 0 si absent
+     * @param nn : numéro de la normale, 0 si absent
+     * @param vertexmap : dictionnaire des sommets déjà créés dans le maillage
      * @param coordlist : tableau de vec3 donnant les coordonnées des sommets
      * @param texcoordlist : tableau de vec2 donnant les coordonnées de texture
-     * @param normallist : tableau de vec3 donnant les normallist
-     * @return le sommet correspondant au triplet (nv,nt,nn)
+     * @param normallist : tableau de vec3 donnant les normales
+     * @return le sommet correspondant au triplet (nv,nt,nn), nullptr si nv est incorrect
      */
     MeshVertex* findOrCreateVertex(
-        char* nvntnn,
-        std::map<int, std::list<MeshVertex*>> &vertexlist,
+        int nv, int nt, int nn,
+        ObjVertexMap &vertexmap,
         std::vector<vec3> &coordlist,
         std::vector<vec2> &texcoordlist,
         std::vector<vec3> &normallist);
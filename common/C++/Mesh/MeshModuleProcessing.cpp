@@ -12,6 +12,10 @@
 #include <MeshModuleProcessing.h>
 
 
+// numéro du prochain sommet milieu, toujours croissant pour que les noms restent uniques
+static int MidpointNumber = 0;
+
+
 /**
  * initialise le module sur le maillage fourni
  * @param mesh : maillage concerné
@@ -273,71 +277,71 @@ MeshTriangle* MeshModuleProcessing::extrudeTriangle(MeshTriangle* triangle, floa
 
 
 /**
- * Cette méthode subdivise le triangle en sous-triangles
- * @param triangle auquel on applique la transformation
- * @param steps : fournir un entier 1..raisonnable
- * @param smooth : déplace ou non les points midpoints vers l'intérieur ou l'extérieur
- * @return liste de triangles qui doivent remplacer celui-ci
+ * Cette méthode retourne le milieu de l'arête portée par la demi-arête, en le créant
+ * s'il n'existe pas encore. Le milieu est mémorisé dans l'arête afin que le triangle
+ * opposé le retrouve sans recherche.
+ * @param halfedge : demi-arête allant de s0 à s1
+ * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
+ * @return sommet milieu de s0 et s1
  */
-std::vector<MeshTriangle*> MeshModuleProcessing::subdivide(MeshTriangle* triangle, int steps, float smooth)
+MeshVertex* MeshModuleProcessing::getMidpoint(MeshHalfEdge* halfedge, float smooth)
 {
-    std::vector<MeshTriangle*> result;
-
-    // fin de la récursivité ?
-    if (steps <= 0) {
-        // ajouter le triangle au résultat et le retourner
-        std::vector<MeshTriangle*> triangles;
-        triangles.push_back(triangle);
-        return triangles;
+    // milieu déjà calculé par le triangle opposé ?
+    MeshEdge* edge = halfedge->getEdge();
+    MeshVertex* m01 = edge->getMidpoint();
+    if (m01 != nullptr) return m01;
+
+    // extrémités de l'arête
+    MeshVertex* s0 = halfedge->getOrigin();
+    MeshVertex* s1 = halfedge->getNext()->getOrigin();
+
+    // NB : le nom est court, un nom composé de ceux des extrémités doublerait de longueur à chaque niveau
+    m01 = new MeshVertex(m_Mesh, "m"+std::to_string(MidpointNumber++));
+    // lissage ?
+    if (smooth > 0.0) {
+        // vecteur s0s1
+        vec3 s0s1 = vec3::create();
+        vec3::subtract(s0s1, s1->getCoord(), s0->getCoord());
+        vec3::scale(s0s1, s0s1, smooth);
+        // normale, binormale et tangente en s0
+        vec3 n0 = s0->getNormal();
+        vec3 b0 = vec3::create();
+        vec3::cross(b0, s0s1, n0);
+        vec3 t0 = vec3::create();
+        vec3::cross(t0, n0, b0);
+        // normale, binormale et tangente en s1
+        vec3 n1 = s1->getNormal();
+        vec3 b1 = vec3::create();
+        vec3::cross(b1, s0s1, n1);
+        vec3 t1 = vec3::create();
+        vec3::cross(t1, n1, b1);
+        // interpolation cubique spline de Hermite
+        m01->hermite(s0, t0, s1, t1, 0.5);
+    } else {
+        // simple interpolation linéaire
+        m01->lerp(s0, s1, 0.5);
     }
-    steps -= 1;
-
-    // noter les trois sommets du triangle
-    MeshVertex* vertex_list[3] = {
-            triangle->getVertex0(),
-            triangle->getVertex1(),
-            triangle->getVertex2()
-    };
+    edge->setMidpoint(m01);
+    return m01;
+}
 
-    // sommets intermédiaires (dans l'ordre des sommets)
-    std::vector<MeshVertex*> midpoints;
 
-    // traiter chaque arête
+/**
+ * Cette méthode remplace le triangle par 4 sous-triangles
+ * @param triangle auquel on applique la transformation
+ * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
+ * @param result : liste à laquelle on ajoute les 4 triangles qui remplacent celui-ci
+ */
+void MeshModuleProcessing::subdivideTriangle(MeshTriangle* triangle, float smooth, std::vector<MeshTriangle*>& result)
+{
+    // noter les trois sommets du triangle et les milieux de ses arêtes (dans l'ordre des sommets)
+    MeshVertex* vertex_list[3];
+    MeshVertex* midpoints[3];
+    MeshHalfEdge* halfedge = triangle->getHalfEdge();
     for (int is=0; is<3; is++) {
-        // extrémités de l'arête
-        MeshVertex* s0 = triangle->getVertex(is);
-        MeshVertex* s1 = triangle->getVertex((is+1)%3);
-        // milieu entre s0 et s1
-        std::string name01 = getMidName(s0, s1);
-        MeshVertex* m01 = m_Mesh->getVertexByName(name01);
-        if (m01 == nullptr) {
-            m01 = new MeshVertex(m_Mesh, name01);
-            // lissage ?
-            if (smooth > 0.0) {
-                // vecteur s0s1
-                vec3 s0s1 = vec3::create();
-                vec3::subtract(s0s1, s1->getCoord(), s0->getCoord());
-                vec3::scale(s0s1, s0s1, smooth);
-                // normale, binormale et tangente en s0
-                vec3 n0 = s0->getNormal();
-                vec3 b0 = vec3::create();
-                vec3::cross(b0, s0s1, n0);
-                vec3 t0 = vec3::create();
-                vec3::cross(t0, n0, b0);
-                // normale, binormale et tangente en s1
-                vec3 n1 = s1->getNormal();
-                vec3 b1 = vec3::create();
-                vec3::cross(b1, s0s1, n1);
-                vec3 t1 = vec3::create();
-                vec3::cross(t1, n1, b1);
-                // interpolation cubique spline de Hermite
-                m01->hermite(s0, t0, s1, t1, 0.5);
-            } else {
-                // simple interpolation linéaire
-                m01->lerp(s0, s1, 0.5);
-            }
-        }
-        midpoints.push_back(m01);
+        vertex_list[is] = halfedge->getOrigin();
+        midpoints[is] = getMidpoint(halfedge, smooth);
+        halfedge = halfedge->getNext();
     }
 
     // supprimer le triangle
@@ -348,22 +352,33 @@ std::vector<MeshTriangle*> MeshModuleProcessing::subdivide(MeshTriangle* triangl
         MeshVertex* s0 = vertex_list[is];
         MeshVertex* m01 = midpoints[is];
         MeshVertex* m20 = midpoints[(is+2)%3];
-        MeshTriangle* triangle_tmp = new MeshTriangle(m_Mesh, s0, m01, m20);
-        std::vector<MeshTriangle*> subdiv = subdivide(triangle_tmp, steps, smooth);
-        result.insert(result.end(), subdiv.begin(), subdiv.end());
+        result.push_back(new MeshTriangle(m_Mesh, s0, m01, m20));
     }
 
     // triangle central
-    MeshTriangle* triangle_tmp = new MeshTriangle(m_Mesh, midpoints[0], midpoints[1], midpoints[2]);
-    std::vector<MeshTriangle*> subdiv = subdivide(triangle_tmp, steps, smooth);
-    result.insert(result.end(), subdiv.begin(), subdiv.end());
+    result.push_back(new MeshTriangle(m_Mesh, midpoints[0], midpoints[1], midpoints[2]));
+}
+
 
-    return result;
+/**
+ * Cette méthode subdivise le triangle en sous-triangles
+ * @param triangle auquel on applique la transformation
+ * @param steps : fournir un entier 1..raisonnable
+ * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
+ * @return liste de triangles qui doivent remplacer celui-ci
+ */
+std::vector<MeshTriangle*> MeshModuleProcessing::subdivide(MeshTriangle* triangle, int steps, float smooth)
+{
+    std::vector<MeshTriangle*> triangles;
+    triangles.push_back(triangle);
+    return subdivideAll(triangles, steps, smooth);
 }
 
 
 /**
- * Cette méthode subdivise les triangles indiqués
+ * Cette méthode subdivise les triangles indiqués, niveau par niveau : tous les
+ * triangles d'un niveau sont découpés avant de passer au suivant. Les milieux
+ * sont mémorisés dans les arêtes, ce qui rend la subdivision linéaire.
  * @param triangles : liste des triangles concernés par la subdivision
  * @param steps : fournir un entier 1..raisonnable
  * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
@@ -371,22 +386,17 @@ std::vector<MeshTriangle*> MeshModuleProcessing::subdivide(MeshTriangle* triangl
  */
 std::vector<MeshTriangle*> MeshModuleProcessing::subdivideAll(std::vector<MeshTriangle*> triangles, int steps, float smooth)
 {
-    // mémoriser les triangles qui sont subdivisés
-    std::vector<MeshTriangle*> result;
-
-    // liste des triangles dont les sommets vont être clonés
-    const int nbtriangles = triangles.size();
-    if (nbtriangles == 0) return result;
-
-    // faut-il faire quelque chose ?
-    if (steps <= 0) return triangles;
-
-    // subdiviser tous les triangles
-    for (MeshTriangle* triangle: triangles) {
-        std::vector<MeshTriangle*> subdiv = subdivide(triangle, steps, smooth);
-        result.insert(result.end(), subdiv.begin(), subdiv.end());
+    // subdiviser tous les triangles d'un niveau pour obtenir ceux du niveau suivant
+    std::vector<MeshTriangle*> next;
+    for (int step=0; step<steps; step++) {
+        next.clear();
+        next.reserve(triangles.size() * 4);
+        for (MeshTriangle* triangle: triangles) {
+            subdivideTriangle(triangle, smooth, next);
+        }
+        triangles.swap(next);
     }
-    return result;
+    return triangles;
 }
 
 
@@ -6,6 +6,8 @@
 #include <MeshModuleUtils.h>
 #include <MeshTriangle.h>
 #include <MeshVertex.h>
+#include <MeshHalfEdge.h>
+#include <MeshEdge.h>
 
 
 class MeshModuleProcessing: public MeshModuleUtils
@@ -93,6 +95,25 @@ public:
      */
     void transform(mat4 matrix);
 
+private:
+
+    /**
+     * Cette méthode retourne le milieu de l'arête portée par la demi-arête, en le créant
+     * s'il n'existe pas encore
+     * @param halfedge : demi-arête allant de s0 à s1
+     * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
+     * @return sommet milieu de s0 et s1
+     */
+    MeshVertex* getMidpoint(MeshHalfEdge* halfedge, float smooth);
+
+    /**
+     * Cette méthode remplace le triangle par 4 sous-triangles
+     * @param triangle auquel on applique la transformation
+     * @param smooth : déplace ou non les points milieux vers l'intérieur ou l'extérieur
+     * @param result : liste à laquelle on ajoute les 4 triangles qui remplacent celui-ci
+     */
+    void subdivideTriangle(MeshTriangle* triangle, float smooth, std::vector<MeshTriangle*>& result);
+
 };
 
 #endif
@@ -60,6 +60,33 @@ void MeshModuleRedux::reduxCost(float maxcost)
 }
 
 
+/**
+ * Cette méthode prépare une réduction progressive, par étapes successives
+ * de reduxTriangleCount, par exemple pour construire des niveaux de détail
+ */
+void MeshModuleRedux::reduxStart()
+{
+    // calculer les coûts de fusion de toutes les arêtes
+    computeAllEdgesCollapseCosts();
+}
+
+
+/**
+ * Cette méthode continue la réduction commencée par reduxStart, jusqu'à ce
+ * que le maillage n'ait plus que le nombre de triangles indiqué
+ * NB : les coûts ne sont pas recalculés, le tas est celui de l'étape précédente
+ * @param count : nombre de triangles à atteindre
+ * @return false si plus aucune fusion n'est possible avant d'atteindre ce nombre
+ */
+bool MeshModuleRedux::reduxTriangleCount(int count)
+{
+    while (m_Mesh->getTriangleCount() > count) {
+        if (!collapseMinimumCostEdge(1e40)) return false;
+    }
+    return true;
+}
+
+
 /**
  * calcule les coûts de fusion de tous les sommets, chacun vers l'un de ses voisins
  */
@@ -68,12 +95,15 @@ void MeshModuleRedux::computeAllEdgesCollapseCosts()
     // calculer les normales
     m_Mesh->computeNormals();
 
-    // calculer les quadriques
+    // calculer les quadriques et vider le tas
+    m_Heap.clear();
+    m_Heap.reserve(m_Mesh->getVertexCount());
     for (MeshVertex* vertex: m_Mesh->getVertexList()) {
         computeQuadric(vertex);
+        vertex->setCollapseRank(-1);
     }
 
-    // calculer les coûts de fusion
+    // calculer les coûts de fusion, ce qui remplit le tas
     for (MeshVertex* vertex: m_Mesh->getVertexList()) {
         computeEdgesCollapseCost(vertex);
     }
@@ -95,15 +125,27 @@ void MeshModuleRedux::computeEdgesCollapseCost(MeshVertex* vertex)
     for (MeshVertex* candidate: candidates) {
         // calculer le coût de fusion du sommet vers ce candidat
         float cost = computeEdgeCollapseCost(vertex, candidate);
-        // on garde le candidat ayant le plus faible coût
-        if (cost < min_cost) {
+        // on garde le candidat ayant le plus faible coût, ou le premier dont le coût est nul ;
+        // les candidats sont classés par adresse, ce qui peut changer d'une exécution à l'autre,
+        // « premier » signifie donc celui de plus petit rang dans le maillage
+        bool better;
+        if (min_target == nullptr) {
+            better = cost < min_cost;
+        } else if (cost <= 0.0 || min_cost <= 0.0) {
+            better = cost <= 0.0 && (min_cost > 0.0 || candidate->getMeshIndex() < min_target->getMeshIndex());
+        } else {
+            better = cost < min_cost || (cost == min_cost && candidate->getMeshIndex() < min_target->getMeshIndex());
+        }
+        if (better) {
             min_target = candidate;
             min_cost = cost;
-            if (min_cost <= 0.0) break;
         }
     }
     vertex->setCollapseTarget(min_target);
     vertex->setCollapseCost(min_cost);
+
+    // mettre à jour sa place dans le tas
+    heapUpdate(vertex);
 }
 
 
@@ -131,7 +173,16 @@ bool MeshModuleRedux::collapseMinimumCostEdge(float maxcost)
 {
     MeshVertex* min_vertex = findMinimumCostVertex(maxcost);
     if (min_vertex == nullptr) return false;
-    collapseVertex(min_vertex, min_vertex->getCollapseTarget());
+
+    // si la fusion est impossible (sommet isolé, bord mal orienté), ne plus proposer ce sommet,
+    // il reviendra dans le tas si l'un de ses voisins est fusionné
+    MeshVertex* target = min_vertex->getCollapseTarget();
+    if (target == nullptr || target->getHalfEdgeTo(min_vertex) == nullptr) {
+        heapRemove(min_vertex);
+        return true;
+    }
+
+    collapseVertex(min_vertex, target);
     return true;
 }
 
@@ -144,14 +195,10 @@ bool MeshModuleRedux::collapseMinimumCostEdge(float maxcost)
  */
 MeshVertex* MeshModuleRedux::findMinimumCostVertex(float maxcost)
 {
-    MeshVertex* min_vertex = nullptr;
-    float min_cost = maxcost;
-    for (MeshVertex* vertex: m_Mesh->getVertexList()) {
-        if (vertex->getCollapseCost() < min_cost) {
-            min_vertex = vertex;
-            min_cost = min_vertex->getCollapseCost();
-        }
-    }
+    // le sommet le moins cher est en tête du tas
+    if (m_Heap.empty()) return nullptr;
+    MeshVertex* min_vertex = m_Heap[0];
+    if (min_vertex->getCollapseCost() >= maxcost) return nullptr;
     return min_vertex;
 }
 
@@ -167,19 +214,35 @@ void MeshModuleRedux::collapseVertex(MeshVertex* U, MeshVertex* V)
     MeshHalfEdge* halfedge = V->getHalfEdgeTo(U);
     if (halfedge == nullptr) return;
 
+    // anciens voisins de U : ceux qu'il ne touchait que par les triangles qui vont disparaître
+    // ne seront plus voisins de V, il faut pourtant recalculer leur coût car U était peut-être leur cible
+    std::set<MeshVertex*> neighbors = U->getNeighborVertices();
+
     // écraser cette demi-arête
     MeshHalfEdge::collapse(halfedge);
 
     // comme U a été fusionné, il n'est plus dans aucun triangle
+    heapRemove(U);
+    int index = U->getMeshIndex();
     delete U;
 
+    // le dernier sommet du maillage a pris la place de U dans la liste ; son rang départage
+    // les coûts égaux dans le tas, il faut donc l'y replacer
+    if (index < m_Mesh->getVertexCount()) {
+        MeshVertex* moved = m_Mesh->getVertexList()[index];
+        if (moved->getCollapseRank() >= 0) heapUpdate(moved);
+    }
+
     // recalculer les normales des anciens et nouveaux triangles autour de V
     for (MeshTriangle* triangle: V->getTrianglesAround()) {
         triangle->computeNormal();
     }
 
     // sommets voisins anciens et nouveaux de V
-    std::set<MeshVertex*> neighbors = V->getNeighborVertices();
+    for (MeshVertex* neighbor: V->getNeighborVertices()) {
+        neighbors.insert(neighbor);
+    }
+    neighbors.erase(V);
 
     // recalculer les normales de V et ses voisins
     V->computeNormal();
@@ -230,6 +293,112 @@ void MeshModuleRedux::computeQuadric(MeshVertex* vertex)
 }
 
 
+/**
+ * compare deux sommets du tas : le moins cher à fusionner, à égalité celui de plus petit
+ * rang dans le maillage, afin que l'ordre des fusions ne dépende pas de l'ordre des mises à jour
+ * @return true si a doit être fusionné avant b
+ */
+static bool isCheaper(MeshVertex* a, MeshVertex* b)
+{
+    if (a->getCollapseCost() != b->getCollapseCost()) return a->getCollapseCost() < b->getCollapseCost();
+    return a->getMeshIndex() < b->getMeshIndex();
+}
+
+
+/**
+ * place le sommet dans le tas selon son coût de fusion, en l'y ajoutant s'il
+ * n'y est pas encore
+ * @param vertex : sommet dont le coût de fusion vient d'être calculé
+ */
+void MeshModuleRedux::heapUpdate(MeshVertex* vertex)
+{
+    int rank = vertex->getCollapseRank();
+    if (rank < 0) {
+        // ajouter le sommet à la fin du tas puis le faire remonter
+        rank = m_Heap.size();
+        m_Heap.push_back(vertex);
+        vertex->setCollapseRank(rank);
+        heapSiftUp(rank);
+    } else {
+        // son coût a pu augmenter ou diminuer
+        heapSiftUp(rank);
+        heapSiftDown(vertex->getCollapseRank());
+    }
+}
+
+
+/**
+ * enlève le sommet du tas, s'il y est
+ * @param vertex : sommet à enlever
+ */
+void MeshModuleRedux::heapRemove(MeshVertex* vertex)
+{
+    int rank = vertex->getCollapseRank();
+    if (rank < 0) return;
+    vertex->setCollapseRank(-1);
+
+    // mettre le dernier sommet du tas à sa place puis le replacer
+    MeshVertex* last = m_Heap.back();
+    m_Heap.pop_back();
+    if (last == vertex) return;
+    heapSet(rank, last);
+    heapSiftUp(rank);
+    heapSiftDown(last->getCollapseRank());
+}
+
+
+/**
+ * fait remonter le sommet de rang rank vers la racine du tas tant qu'il coûte
+ * moins que son parent
+ * @param rank : rang du sommet dans m_Heap
+ */
+void MeshModuleRedux::heapSiftUp(int rank)
+{
+    MeshVertex* vertex = m_Heap[rank];
+    while (rank > 0) {
+        int parent = (rank - 1) / 2;
+        if (! isCheaper(vertex, m_Heap[parent])) break;
+        heapSet(rank, m_Heap[parent]);
+        rank = parent;
+    }
+    heapSet(rank, vertex);
+}
+
+
+/**
+ * fait descendre le sommet de rang rank vers les feuilles du tas tant qu'il coûte
+ * plus que l'un de ses enfants
+ * @param rank : rang du sommet dans m_Heap
+ */
+void MeshModuleRedux::heapSiftDown(int rank)
+{
+    int count = m_Heap.size();
+    MeshVertex* vertex = m_Heap[rank];
+    while (true) {
+        // chercher l'enfant le moins cher
+        int child = 2 * rank + 1;
+        if (child >= count) break;
+        if (child + 1 < count && isCheaper(m_Heap[child+1], m_Heap[child])) child++;
+        if (! isCheaper(m_Heap[child], vertex)) break;
+        heapSet(rank, m_Heap[child]);
+        rank = child;
+    }
+    heapSet(rank, vertex);
+}
+
+
+/**
+ * range le sommet au rang indiqué du tas
+ * @param rank : rang dans m_Heap
+ * @param vertex : sommet à y mettre
+ */
+void MeshModuleRedux::heapSet(int rank, MeshVertex* vertex)
+{
+    m_Heap[rank] = vertex;
+    vertex->setCollapseRank(rank);
+}
+
+
 // Définition de la classe Quadric
 
 
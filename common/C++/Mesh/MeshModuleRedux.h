@@ -10,6 +10,8 @@
  * http://www1.cs.columbia.edu/~cs4162/html05s/garland97.pdf
  */
 
+#include <vector>
+
 #include <MeshModuleUtils.h>
 #include <MeshVertex.h>
 
@@ -38,6 +40,20 @@ public:
      */
     void reduxCost(float maxcost);
 
+    /**
+     * Cette méthode prépare une réduction progressive, par étapes successives
+     * de reduxTriangleCount, par exemple pour construire des niveaux de détail
+     */
+    void reduxStart();
+
+    /**
+     * Cette méthode continue la réduction commencée par reduxStart, jusqu'à ce
+     * que le maillage n'ait plus que le nombre de triangles indiqué
+     * @param count : nombre de triangles à atteindre
+     * @return false si plus aucune fusion n'est possible avant d'atteindre ce nombre
+     */
+    bool reduxTriangleCount(int count);
+
 
 protected:
 
@@ -88,6 +104,46 @@ protected:
      * @param vertex : sommet pour lequel il faut calculer la quadrique
      */
     void computeQuadric(MeshVertex* vertex);
+
+    /**
+     * place le sommet dans le tas selon son coût de fusion, en l'y ajoutant s'il
+     * n'y est pas encore
+     * @param vertex : sommet dont le coût de fusion vient d'être calculé
+     */
+    void heapUpdate(MeshVertex* vertex);
+
+    /**
+     * enlève le sommet du tas, s'il y est
+     * @param vertex : sommet à enlever
+     */
+    void heapRemove(MeshVertex* vertex);
+
+    /**
+     * fait remonter le sommet de rang rank vers la racine du tas tant qu'il coûte
+     * moins que son parent
+     * @param rank : rang du sommet dans m_Heap
+     */
+    void heapSiftUp(int rank);
+
+    /**
+     * fait descendre le sommet de rang rank vers les feuilles du tas tant qu'il coûte
+     * plus que l'un de ses enfants
+     * @param rank : rang du sommet dans m_Heap
+     */
+    void heapSiftDown(int rank);
+
+    /**
+     * range le sommet au rang indiqué du tas
+     * @param rank : rang dans m_Heap
+     * @param vertex : sommet à y mettre
+     */
+    void heapSet(int rank, MeshVertex* vertex);
+
+
+private:
+
+    /// tas binaire des sommets selon leur coût de fusion, le moins cher en tête
+    std::vector<MeshVertex*> m_Heap;
 };
 
 
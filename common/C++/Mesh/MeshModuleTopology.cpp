@@ -71,6 +71,9 @@ int MeshModuleTopology::addRectangularSurface(int nbX, int nbZ, std::string name
         }
     }
 
+    // indexer les demi-arêtes pendant la construction des triangles
+    m_Mesh->beginBuild();
+
     // créer les quads de la grille
     for (int iz=0; iz<nbZ-1; iz++) {
         for (int ix=0; ix<nbX-1; ix++) {
@@ -121,6 +124,8 @@ int MeshModuleTopology::addRectangularSurface(int nbX, int nbZ, std::string name
         m_Mesh->addQuad(v00, v01, v11, v10);
     }
 
+    m_Mesh->endBuild();
+
     // retourner le numéro du premier point
     return num0;
 }
@@ -154,6 +159,9 @@ int MeshModuleTopology::addHexagonalSurface(int nbX, int nbZ, std::string names,
         }
     }
 
+    // indexer les demi-arêtes pendant la construction des triangles
+    m_Mesh->beginBuild();
+
     // créer les triangles de la grille
     for (int iz=0; iz<nbZ-1; iz++) {
         for (int ix=0; ix<nbX-1; ix++) {
@@ -219,6 +227,8 @@ int MeshModuleTopology::addHexagonalSurface(int nbX, int nbZ, std::string names,
         m_Mesh->addTriangle(v10, v01, v11);
     }
 
+    m_Mesh->endBuild();
+
     // retourner le numéro du premier point
     return num0;
 }
@@ -259,6 +269,9 @@ int MeshModuleTopology::addRevolutionSurface(int spokes_count, int segments_coun
         }
     }
 
+    // indexer les demi-arêtes pendant la construction des triangles
+    m_Mesh->beginBuild();
+
     // rajouter des triangles afin de pouvoir créer des rubans rapidement
     for (int ir=0; ir<spokes_count; ir++) {
         // rajouter les triangles juste autour du centre
@@ -280,6 +293,8 @@ int MeshModuleTopology::addRevolutionSurface(int spokes_count, int segments_coun
         }
     }
 
+    m_Mesh->endBuild();
+
     // retourner le numéro du premier point
     return num0;
 }
@@ -11,6 +11,8 @@
 #include <MeshObject.h>
 #include <MeshModuleLoading.h>
 #include <MeshModuleDrawing.h>
+#include <MeshModuleRedux.h>
+#include <RenderQueue.h>
 
 
 /**
@@ -18,6 +20,8 @@
  */
 MeshObject::MeshObject()
 {
+    m_LODCenter = vec3::create();
+    m_LODRadius = 0.0;
 }
 
 
@@ -29,6 +33,11 @@ MeshObject::~MeshObject()
     for (auto const& it: m_VBOsets) {
         delete it.second;
     }
+    for (auto const& level: m_LODVBOsets) {
+        for (auto const& it: level) {
+            delete it.second;
+        }
+    }
     for (auto const& it: m_Meshes) {
         delete it.second;
     }
@@ -48,20 +57,86 @@ void MeshObject::transform(mat4& matrix)
 
 
 /**
- * dessine l'objet
+ * dessine l'objet, ou le met dans la file active s'il y en a une
  * @param mat4Projection matrice de projection
  * @param mat4ModelView matrice qui positionne l'objet devant la caméra
  */
 void MeshObject::onDraw(mat4& mat4Projection, mat4& mat4ModelView)
 {
+    // les dessins seront triés et faits par la file
+    RenderQueue* queue = RenderQueue::getActive();
+    if (queue != nullptr) {
+        submit(queue, mat4ModelView);
+        return;
+    }
+
+    // choisir le niveau de détail
+    int level = getLevelOfDetail(mat4Projection, mat4ModelView);
+    std::map<std::string, VBOset*>& vbosets = (level > 0) ? m_LODVBOsets[level-1] : m_VBOsets;
+
     // dessiner les maillages
-    for (auto const& it: m_VBOsets) {
+    for (auto const& it: vbosets) {
         VBOset* vboset = it.second;
         vboset->onDraw(mat4Projection, mat4ModelView);
     }
 }
 
 
+/**
+ * dépose le dessin de chaque VBOset du niveau de détail adéquat dans une file
+ * @param queue : file qui reçoit les dessins
+ * @param mat4ModelView matrice qui positionne l'objet devant la caméra
+ */
+void MeshObject::submit(RenderQueue* queue, mat4& mat4ModelView)
+{
+    // choisir le niveau de détail
+    int level = getLevelOfDetail(queue->getProjection(), mat4ModelView);
+    std::map<std::string, VBOset*>& vbosets = (level > 0) ? m_LODVBOsets[level-1] : m_VBOsets;
+
+    // un paquet par matériau
+    for (auto const& it: vbosets) {
+        queue->submit(it.second, mat4ModelView);
+    }
+}
+
+
+/**
+ * dessine plusieurs exemplaires de l'objet avec un seul appel de dessin par matériau
+ * et par niveau de détail employé. Le niveau de détail est choisi pour chaque exemplaire.
+ * @param mat4Projection matrice de projection
+ * @param mat4View matrice de vue, commune à tous les exemplaires
+ * @param transforms matrice de chaque exemplaire, appliquée avant mat4View
+ */
+void MeshObject::drawInstanced(mat4& mat4Projection, mat4& mat4View, std::vector<mat4>& transforms)
+{
+    // sans niveaux de détail, toutes les instances sont dessinées ensemble
+    if (m_LODVBOsets.empty()) {
+        for (auto const& it: m_VBOsets) {
+            it.second->onDrawInstanced(mat4Projection, mat4View, transforms);
+        }
+        return;
+    }
+
+    // répartir les instances selon leur niveau de détail
+    m_LODInstances.resize(m_LODVBOsets.size() + 1);
+    for (std::vector<mat4>& instances: m_LODInstances) instances.clear();
+    mat4 mat4ModelView = mat4::create();
+    for (mat4& transform: transforms) {
+        mat4::multiply(mat4ModelView, mat4View, transform);
+        m_LODInstances[getLevelOfDetail(mat4Projection, mat4ModelView)].push_back(transform);
+    }
+
+    // dessiner les instances de chaque niveau
+    for (unsigned int level=0; level<m_LODInstances.size(); level++) {
+        if (m_LODInstances[level].empty()) continue;
+        std::map<std::string, VBOset*>& vbosets = (level > 0) ? m_LODVBOsets[level-1] : m_VBOsets;
+        for (auto const& it: vbosets) {
+            it.second->onDrawInstanced(mat4Projection, mat4View, m_LODInstances[level]);
+        }
+    }
+}
+
+
 /**
  * définit un plan de coupe pour les fragments. Ce plan est en coordonnées caméra
  * @param active : true s'il faut compiler un shader gérant le plan de coupe
@@ -89,3 +164,135 @@ void MeshObject::setClipPlane(bool active)
         material->setClipPlane(active);
     }
 }
+
+
+/**
+ * rend les matériaux capables de dessiner des instances, voir drawInstanced
+ * @param active : true s'il faut compiler des shaders gérant les instances
+ */
+void MeshObject::setInstanced(bool active)
+{
+    for (auto const& it: m_Materials) {
+        Material* material = it.second;
+        material->setInstanced(active);
+    }
+
+    // les emplacements des variables attribute ont pu changer
+    for (auto const& it: m_VBOsets) {
+        it.second->updateLocations();
+    }
+    for (auto const& level: m_LODVBOsets) {
+        for (auto const& it: level) {
+            it.second->updateLocations();
+        }
+    }
+}
+
+
+/**
+ * crée des niveaux de détail simplifiés des maillages, en une seule réduction
+ * progressive de chacun, et construit tous leurs VBOsets. onDraw choisit ensuite
+ * le niveau d'après la taille apparente de l'objet.
+ * NB : les maillages m_Meshes sont réduits au dernier niveau par cette méthode
+ * NB : les niveaux ne sont pas enregistrés dans le cache des maillages, un MeshObjectFromObj
+ * chargé du cache relit donc son fichier OBJ et refait la réduction à chaque création
+ * @param ratios : proportions de triangles de chaque niveau, décroissantes, ex: {0.5, 0.25, 0.1}
+ * @param screensizes : hauteurs apparentes (fraction de la hauteur de l'écran) en dessous
+ * desquelles chaque niveau est employé, par défaut les mêmes valeurs que ratios
+ */
+void MeshObject::createLevelsOfDetail(std::vector<float> ratios, std::vector<float> screensizes)
+{
+    // les maillages sont nécessaires pour la réduction
+    reloadMeshes();
+    if (screensizes.size() < ratios.size()) screensizes = ratios;
+
+    // sphère englobante de tous les maillages
+    vec3 vmin = vec3::fromValues(+1e38, +1e38, +1e38);
+    vec3 vmax = vec3::fromValues(-1e38, -1e38, -1e38);
+    for (auto const& it: m_Meshes) {
+        for (MeshVertex* vertex: it.second->getVertexList()) {
+            vec3::min(vmin, vmin, vertex->getCoord());
+            vec3::max(vmax, vmax, vertex->getCoord());
+        }
+    }
+    vec3::lerp(m_LODCenter, vmin, vmax, 0.5);
+    m_LODRadius = vec3::distance(vmin, vmax) * 0.5;
+
+    // un dictionnaire de VBOsets par niveau
+    m_LODVBOsets.resize(ratios.size());
+    m_LODScreenSizes.assign(screensizes.begin(), screensizes.begin() + ratios.size());
+
+    // réduire chaque maillage progressivement, en construisant les VBOsets à chaque niveau
+    MeshModuleRedux redux;
+    for (auto const& it: m_Meshes) {
+        std::string matname = it.first;
+        Mesh* mesh = it.second;
+        auto itvboset = m_VBOsets.find(matname);
+        if (itvboset == m_VBOsets.end()) continue;
+        Material* material = itvboset->second->getMaterial();
+
+        int triangle_count = mesh->getTriangleCount();
+        redux.setMesh(mesh);
+        redux.reduxStart();
+        for (unsigned int level=0; level<ratios.size(); level++) {
+            redux.reduxTriangleCount(triangle_count * ratios[level]);
+            m_LODVBOsets[level][matname] = createLevelVBOset(mesh, material);
+        }
+    }
+}
+
+
+/**
+ * crée le VBOset d'un niveau de détail à partir du maillage réduit, avec des rubans
+ * de triangles par défaut ; les sous-classes le construisent comme leurs autres VBOsets
+ * @param mesh : maillage réduit au niveau voulu
+ * @param material : matériau du maillage
+ * @return VBOset du niveau
+ */
+VBOset* MeshObject::createLevelVBOset(Mesh* mesh, Material* material)
+{
+    MeshModuleDrawing renderer(mesh);
+    return renderer.createStripVBOset(material);
+}
+
+
+/**
+ * retourne le niveau de détail à employer pour dessiner l'objet
+ * @param mat4Projection matrice de projection
+ * @param mat4ModelView matrice qui positionne l'objet devant la caméra
+ * @return 0 pour les maillages complets, 1 pour le premier niveau simplifié, etc.
+ */
+int MeshObject::getLevelOfDetail(mat4& mat4Projection, mat4& mat4ModelView)
+{
+    if (m_LODVBOsets.empty()) return 0;
+
+    // profondeur du centre de la sphère englobante et échelle de la matrice ModelView
+    vec3 center = vec3::create();
+    vec3::transformMat4(center, m_LODCenter, mat4ModelView);
+    float scale = sqrt(mat4ModelView[0]*mat4ModelView[0] + mat4ModelView[1]*mat4ModelView[1] + mat4ModelView[2]*mat4ModelView[2]);
+
+    // hauteur apparente de la sphère, en fraction de la hauteur de l'écran
+    float size = m_LODRadius * scale * mat4Projection[5];
+    if (mat4Projection[11] != 0.0) {
+        // projection en perspective : l'objet derrière la caméra reçoit le niveau le plus simple
+        float distance = -center[2];
+        if (distance <= 0.0) return m_LODVBOsets.size();
+        size = size / distance;
+    }
+
+    // le niveau le plus simple dont la taille limite dépasse la taille apparente
+    int level = 0;
+    for (unsigned int i=0; i<m_LODScreenSizes.size(); i++) {
+        if (size < m_LODScreenSizes[i]) level = i+1;
+    }
+    return level;
+}
+
+
+/**
+ * recrée les maillages m_Meshes s'ils ne sont plus disponibles, par exemple
+ * quand les VBOsets ont été lus dans un fichier binaire. Ne fait rien par défaut.
+ */
+void MeshObject::reloadMeshes()
+{
+}
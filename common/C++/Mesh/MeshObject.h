@@ -4,6 +4,7 @@
 // Définition de la classe MeshObject
 
 #include <map>
+#include <vector>
 
 #include <Mesh.h>
 #include <VBOset.h>
@@ -23,9 +24,29 @@ public:
     /** Destructeur */
     virtual ~MeshObject();
 
-    /** dessin du maillage sur l'écran */
+    /**
+     * dessin du maillage sur l'écran ; si une RenderQueue est active,
+     * les VBOsets y sont déposés au lieu d'être dessinés
+     */
     virtual void onDraw(mat4& mat4Projection, mat4& mat4ModelView);
 
+    /**
+     * dépose le dessin de chaque VBOset du niveau de détail adéquat dans une file
+     * @param queue : file qui reçoit les dessins
+     * @param mat4ModelView matrice qui positionne l'objet devant la caméra
+     */
+    virtual void submit(RenderQueue* queue, mat4& mat4ModelView);
+
+    /**
+     * dessine plusieurs exemplaires de l'objet avec un seul appel de dessin par matériau
+     * et par niveau de détail employé, voir setInstanced ; ces dessins sont faits
+     * aussitôt, même si une RenderQueue est active
+     * @param mat4Projection matrice de projection
+     * @param mat4View matrice de vue, commune à tous les exemplaires
+     * @param transforms matrice de chaque exemplaire, appliquée avant mat4View
+     */
+    void drawInstanced(mat4& mat4Projection, mat4& mat4View, std::vector<mat4>& transforms);
+
     /** transformation de l'objet par une matrice */
     virtual void transform(mat4& matrix);
 
@@ -42,9 +63,51 @@ public:
      */
     void setClipPlane(bool active);
 
+    /**
+     * rend les matériaux capables de dessiner des instances, ce qui recompile leurs shaders
+     * et refait les VAO des VBOsets ; sinon drawInstanced dessine les exemplaires un par un
+     * @param active : true s'il faut compiler des shaders gérant les instances
+     */
+    void setInstanced(bool active);
+
+    /**
+     * crée des niveaux de détail simplifiés des maillages, en une seule réduction
+     * progressive de chacun, et construit tous leurs VBOsets. onDraw choisit ensuite
+     * le niveau d'après la taille apparente de l'objet.
+     * NB : les maillages m_Meshes sont réduits au dernier niveau par cette méthode
+     * NB : les niveaux ne sont pas enregistrés dans le cache des maillages, un MeshObjectFromObj
+     * chargé du cache relit donc son fichier OBJ et refait la réduction à chaque création
+     * @param ratios : proportions de triangles de chaque niveau, décroissantes, ex: {0.5, 0.25, 0.1}
+     * @param screensizes : hauteurs apparentes (fraction de la hauteur de l'écran) en dessous
+     * desquelles chaque niveau est employé, par défaut les mêmes valeurs que ratios
+     */
+    void createLevelsOfDetail(std::vector<float> ratios, std::vector<float> screensizes=std::vector<float>());
+
+    /**
+     * retourne le niveau de détail à employer pour dessiner l'objet
+     * @param mat4Projection matrice de projection
+     * @param mat4ModelView matrice qui positionne l'objet devant la caméra
+     * @return 0 pour les maillages complets, 1 pour le premier niveau simplifié, etc.
+     */
+    int getLevelOfDetail(mat4& mat4Projection, mat4& mat4ModelView);
+
 
 protected:
 
+    /**
+     * recrée les maillages m_Meshes s'ils ne sont plus disponibles, par exemple
+     * quand les VBOsets ont été lus dans un fichier binaire. Ne fait rien par défaut.
+     */
+    virtual void reloadMeshes();
+
+    /**
+     * crée le VBOset d'un niveau de détail à partir du maillage réduit, voir createLevelsOfDetail
+     * @param mesh : maillage réduit au niveau voulu
+     * @param material : matériau du maillage
+     * @return VBOset du niveau
+     */
+    virtual VBOset* createLevelVBOset(Mesh* mesh, Material* material);
+
     // dictionnaire des maillages (nom_matériau, maillage)
     std::map<std::string, Mesh*> m_Meshes;
 
@@ -53,6 +116,17 @@ protected:
 
     // dictionnaire des VBOsets (nom_matériau, VBOset)
     std::map<std::string, VBOset*> m_VBOsets;
+
+    // VBOsets des niveaux de détail simplifiés et tailles apparentes en dessous desquelles les employer
+    std::vector<std::map<std::string, VBOset*>> m_LODVBOsets;
+    std::vector<float> m_LODScreenSizes;
+
+    // sphère englobante des maillages, pour estimer leur taille apparente
+    vec3 m_LODCenter;
+    float m_LODRadius;
+
+    // matrices des instances de chaque niveau de détail, voir drawInstanced
+    std::vector<std::vector<mat4>> m_LODInstances;
 };
 
 #endif
@@ -4,6 +4,10 @@
 #include <GL/gl.h>
 
 #include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
 #include <math.h>
 
 #include <utils.h>
@@ -13,6 +17,42 @@
 #include <MeshModuleDrawing.h>
 
 
+// en-tête du fichier binaire des maillages déjà construits (.cooked)
+static const char COOKED_MAGIC[8] = {'O','B','J','C','O','O','K','\0'};
+static const uint32_t COOKED_VERSION = 1;
+struct CookedHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t materialcount;
+    int64_t sourcesize;
+    int64_t sourcemtime;
+    float scale;
+    uint32_t layout;
+};
+
+// en-tête de chaque bloc matériau, suivi du nom, de la signature des attributs,
+// puis alignés sur 4 octets, des données entrelacées et des indices
+struct CookedBlock
+{
+    uint32_t namelength;
+    uint32_t signaturelength;
+    uint32_t primitive;
+    uint32_t floatcount;
+    uint32_t indexcount;
+};
+
+// taille arrondie au multiple de 4 supérieur
+static inline size_t align4(size_t size)
+{
+    return (size + 3) & ~size_t(3);
+}
+
+
+// rangement des triangles, rubans par défaut
+int MeshObjectFromObj::m_Layout = MeshObjectFromObj::LAYOUT_STRIPS;
+
+
 /**
  * Crée un ensemble de maillages et de matériaux à partir de deux fichiers OBJ et MTL associés
  * @param folder : chemin d'accès aux deux fichiers obj et mtl
@@ -26,27 +66,28 @@ MeshObjectFromObj::MeshObjectFromObj(std::string folder, std::string objfilename
     m_Folder = folder;
     m_ObjFilename = objfilename;
     m_ScaleFactor = scale;
+    m_SingleMesh = false;
 
     // charger les matériaux du fichier MTL
     m_Materials = Material::loadMTL(m_Folder, mtlfilename);
 
+    // les VBOsets ont-ils déjà été construits lors d'une exécution précédente ?
+    if (loadCookedFile(m_Materials)) return;
+
     // module de chargement
     MeshModuleLoading loader;
 
-    // module de dessin
-    MeshModuleDrawing renderer;
-
-    // charger les maillages, un par matériau
+    // créer les maillages, un par matériau
     for (auto const& it: m_Materials) {
         std::string matname = it.first;
-        Material* material = it.second;
-        Mesh* mesh = new Mesh(m_ObjFilename+"@"+matname);
-        m_Meshes[matname] = mesh;
-        loader.setMesh(mesh);
-        loader.loadObjFile(m_Folder+"/"+m_ObjFilename, matname, m_ScaleFactor);
-        renderer.setMesh(mesh);
-        m_VBOsets[matname] = renderer.createStripVBOset(material, true);
+        m_Meshes[matname] = new Mesh(m_ObjFilename+"@"+matname);
     }
+
+    // charger tous les maillages en une seule lecture du fichier
+    loader.loadObjFile(m_Folder+"/"+m_ObjFilename, m_Meshes, m_ScaleFactor);
+
+    // construire les VBOsets, un par matériau, et les enregistrer
+    createCookedVBOsets(m_Materials);
 }
 
 
@@ -63,25 +104,25 @@ MeshObjectFromObj::MeshObjectFromObj(std::string folder, std::string objfilename
     m_Folder = folder;
     m_ObjFilename = objfilename;
     m_ScaleFactor = scale;
+    m_SingleMesh = false;
+
+    // les VBOsets ont-ils déjà été construits lors d'une exécution précédente ?
+    if (loadCookedFile(materials)) return;
 
     // module de chargement
     MeshModuleLoading loader;
 
-    // module de dessin
-    MeshModuleDrawing renderer;
-
-    // charger les maillages, un par matériau
+    // créer un maillage pour chaque matériau
     for (auto const& it: materials) {
         std::string matname = it.first;
-        Material* material = it.second;
-        // créer un maillage pour ce matériau
-        Mesh* mesh = new Mesh(m_ObjFilename+"@"+matname);
-        m_Meshes[matname] = mesh;
-        loader.setMesh(mesh);
-        loader.loadObjFile(m_Folder+"/"+m_ObjFilename, matname, m_ScaleFactor);
-        renderer.setMesh(mesh);
-        m_VBOsets[matname] = renderer.createStripVBOset(material, true);
+        m_Meshes[matname] = new Mesh(m_ObjFilename+"@"+matname);
     }
+
+    // charger tous les maillages en une seule lecture du fichier
+    loader.loadObjFile(m_Folder+"/"+m_ObjFilename, m_Meshes, m_ScaleFactor);
+
+    // construire les VBOsets, un par matériau, et les enregistrer
+    createCookedVBOsets(materials);
 }
 
 
@@ -98,23 +139,27 @@ MeshObjectFromObj::MeshObjectFromObj(std::string folder, std::string objfilename
     m_Folder = folder;
     m_ObjFilename = objfilename;
     m_ScaleFactor = scale;
+    m_SingleMesh = true;
 
     // nom du matériau
     std::string matname = material->getName();
+    std::map<std::string, Material*> materials;
+    materials[matname] = material;
+
+    // les VBOsets ont-ils déjà été construits lors d'une exécution précédente ?
+    if (loadCookedFile(materials)) return;
 
     // module de chargement
     MeshModuleLoading loader;
 
-    // module de dessin
-    MeshModuleDrawing renderer;
-
     // charger le maillage, il n'a qu'un seul matériau
     Mesh* mesh = new Mesh(m_ObjFilename+"@"+matname);
     m_Meshes[matname] = mesh;
     loader.setMesh(mesh);
     loader.loadObjFile(m_Folder+"/"+m_ObjFilename, "", m_ScaleFactor);
-    renderer.setMesh(mesh);
-    m_VBOsets[matname] = renderer.createStripVBOset(material, true);
+
+    // construire le VBOset et l'enregistrer
+    createCookedVBOsets(materials);
 }
 
 
@@ -124,3 +169,267 @@ MeshObjectFromObj::MeshObjectFromObj(std::string folder, std::string objfilename
 MeshObjectFromObj::~MeshObjectFromObj()
 {
 }
+
+
+/**
+ * choisit le rangement des triangles des prochains objets chargés
+ * @param layout : LAYOUT_STRIPS ou LAYOUT_TRIANGLES
+ */
+void MeshObjectFromObj::setLayout(int layout)
+{
+    m_Layout = layout;
+}
+
+
+/**
+ * relit le fichier OBJ si les maillages ne sont plus disponibles, c'est le
+ * cas quand les VBOsets ont été créés à partir du fichier binaire
+ */
+void MeshObjectFromObj::reloadMeshes()
+{
+    if (! m_Meshes.empty()) return;
+
+    // un maillage par VBOset, ou un seul recevant toutes les faces
+    std::map<std::string, Mesh*> meshes;
+    for (auto const& it: m_VBOsets) {
+        std::string matname = it.first;
+        m_Meshes[matname] = new Mesh(m_ObjFilename+"@"+matname);
+        meshes[m_SingleMesh ? "" : matname] = m_Meshes[matname];
+    }
+
+    // charger tous les maillages en une seule lecture du fichier
+    MeshModuleLoading loader;
+    loader.loadObjFile(m_Folder+"/"+m_ObjFilename, meshes, m_ScaleFactor);
+}
+
+
+/**
+ * crée le VBOset d'un niveau de détail avec le même rangement que les autres :
+ * rubans de triangles ou triangles optimisés pour le cache des sommets, voir setLayout
+ * @param mesh : maillage réduit au niveau voulu
+ * @param material : matériau du maillage
+ * @return VBOset du niveau
+ */
+VBOset* MeshObjectFromObj::createLevelVBOset(Mesh* mesh, Material* material)
+{
+    MeshModuleDrawing renderer(mesh);
+    if (m_Layout == LAYOUT_TRIANGLES) {
+        return renderer.createOptimizedVBOset(material);
+    } else {
+        return renderer.createStripVBOset(material);
+    }
+}
+
+
+/**
+ * retourne le nom du fichier binaire qui contient les VBO déjà construits ;
+ * il est placé dans le cache de l'utilisateur car le dossier des données peut être
+ * partagé ou en lecture seule. Son nom contient une empreinte du chemin absolu du
+ * fichier OBJ, de l'échelle et des matériaux, pour que des emplois différents
+ * d'un même fichier OBJ ne se remplacent pas l'un l'autre, ni ses différents rangements.
+ * @param materials : collection de (nom, matériau) à appliquer au maillage
+ * @return nom complet du fichier .cooked, "" s'il n'y a pas de cache
+ */
+std::string MeshObjectFromObj::getCookedFilename(std::map<std::string, Material*>& materials)
+{
+    std::string folder = Utils::getMeshCacheFolder();
+    if (folder.empty()) return "";
+
+    // identité de ce chargement
+    std::string key = Utils::getAbsolutePath(m_Folder+"/"+m_ObjFilename) + "|" + std::to_string(m_ScaleFactor) + "|" + std::to_string(m_Layout);
+    for (auto const& it: materials) key += "|" + it.first;
+
+    // empreinte FNV-1a 64 bits de cette identité
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c: key) hash = (hash ^ c) * 1099511628211ULL;
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+
+    return folder+"/"+m_ObjFilename+"-"+hex+".cooked";
+}
+
+
+/**
+ * crée les VBOsets des matériaux à partir du fichier binaire s'il existe et
+ * qu'il correspond encore au fichier OBJ (taille, date, échelle et matériaux)
+ * @param materials : collection de (nom, matériau) à appliquer au maillage
+ * @return true si les VBOsets ont pu être créés, false s'il faut relire le fichier OBJ
+ */
+bool MeshObjectFromObj::loadCookedFile(std::map<std::string, Material*>& materials)
+{
+    // caractéristiques du fichier OBJ
+    long long sourcesize, sourcemtime;
+    if (! Utils::getFileStamp(m_Folder+"/"+m_ObjFilename, sourcesize, sourcemtime)) return false;
+
+    // projeter le fichier binaire en mémoire
+    std::string cookedfilename = getCookedFilename(materials);
+    if (cookedfilename.empty()) return false;
+    Utils::MappedFile file(cookedfilename);
+    if (! file.isOpen()) return false;
+    const char* data = file.getData();
+    const size_t size = file.getSize();
+
+    // vérifier l'en-tête
+    if (size < sizeof(CookedHeader)) return false;
+    const CookedHeader* header = (const CookedHeader*) data;
+    if (memcmp(header->magic, COOKED_MAGIC, sizeof(COOKED_MAGIC)) != 0) return false;
+    if (header->version != COOKED_VERSION) return false;
+    if (header->sourcesize != sourcesize || header->sourcemtime != sourcemtime) return false;
+    if (header->scale != m_ScaleFactor) return false;
+    if (header->layout != uint32_t(m_Layout)) return false;
+    if (header->materialcount != materials.size()) return false;
+
+    // parcourir les blocs et vérifier qu'ils correspondent aux matériaux avant de créer le moindre VBO
+    struct Block {
+        Material* material;
+        uint32_t primitive;
+        const GLfloat* floats;
+        uint32_t floatcount;
+        const GLuint* indices;
+        uint32_t indexcount;
+    };
+    std::map<std::string, Block> blocks;
+    size_t offset = sizeof(CookedHeader);
+    for (uint32_t im=0; im<header->materialcount; im++) {
+        // en-tête du bloc
+        if (offset + sizeof(CookedBlock) > size) return false;
+        const CookedBlock* cooked = (const CookedBlock*) (data + offset);
+        offset += sizeof(CookedBlock);
+
+        // nom du matériau et signature de ses attributs
+        if (offset + cooked->namelength + cooked->signaturelength > size) return false;
+        std::string matname(data + offset, cooked->namelength);
+        offset += cooked->namelength;
+        std::string signature(data + offset, cooked->signaturelength);
+        offset = align4(offset + cooked->signaturelength);
+
+        // données entrelacées et indices
+        const size_t floatsize = size_t(cooked->floatcount) * sizeof(GLfloat);
+        const size_t indexsize = size_t(cooked->indexcount) * sizeof(GLuint);
+        if (offset + floatsize + indexsize > size) return false;
+        Block block;
+        block.primitive = cooked->primitive;
+        block.floats = (const GLfloat*) (data + offset);
+        block.floatcount = cooked->floatcount;
+        block.indices = (const GLuint*) (data + offset + floatsize);
+        block.indexcount = cooked->indexcount;
+        offset += floatsize + indexsize;
+
+        // le matériau doit exister et demander les mêmes attributs
+        auto it = materials.find(matname);
+        if (it == materials.end()) return false;
+        block.material = it->second;
+        VBOset* vboset = block.material->createVBOset();
+        bool same = vboset->getAttributesSignature() == signature;
+        delete vboset;
+        if (! same) return false;
+        blocks[matname] = block;
+    }
+    if (blocks.size() != materials.size()) return false;
+
+    // créer les VBOsets directement à partir des données projetées
+    for (auto const& it: blocks) {
+        const Block& block = it.second;
+        VBOset* vboset = block.material->createVBOset();
+        vboset->createInterleavedDataAttributesVBO(block.floats, block.floatcount);
+        vboset->createIndexedPrimitiveVBO(block.primitive, block.indices, block.indexcount);
+        m_VBOsets[it.first] = vboset;
+        MeshModuleDrawing::printVertexStats(it.first, vboset);
+    }
+    std::cout << m_ObjFilename << ": " << blocks.size() << " material(s) loaded from " << cookedfilename << std::endl;
+    return true;
+}
+
+
+/**
+ * crée les VBOsets des matériaux à partir des maillages m_Meshes et enregistre
+ * leurs données dans le fichier binaire pour les prochains chargements
+ * @param materials : collection de (nom, matériau) à appliquer au maillage
+ */
+void MeshObjectFromObj::createCookedVBOsets(std::map<std::string, Material*>& materials)
+{
+    // module de dessin
+    MeshModuleDrawing renderer;
+
+    // fichier temporaire, renommé seulement s'il est complet ; sans cache ou si le
+    // fichier ne peut pas être créé, les VBOsets sont quand même construits
+    std::string cookedfilename = getCookedFilename(materials);
+    std::string tmpfilename = cookedfilename+".tmp";
+    std::ofstream file;
+    if (! cookedfilename.empty() && Utils::makeFolders(Utils::getMeshCacheFolder())) {
+        file.open(tmpfilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+
+    // en-tête, avec les caractéristiques du fichier OBJ
+    CookedHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COOKED_MAGIC, sizeof(COOKED_MAGIC));
+    header.version = COOKED_VERSION;
+    header.materialcount = materials.size();
+    long long sourcesize = 0, sourcemtime = 0;
+    bool ok = Utils::getFileStamp(m_Folder+"/"+m_ObjFilename, sourcesize, sourcemtime);
+    header.sourcesize = sourcesize;
+    header.sourcemtime = sourcemtime;
+    header.scale = m_ScaleFactor;
+    header.layout = m_Layout;
+    if (file.is_open()) file.write((const char*) &header, sizeof(header));
+
+    // construire les VBOsets, un par matériau
+    for (auto const& it: materials) {
+        std::string matname = it.first;
+        Material* material = it.second;
+        Mesh* mesh = m_Meshes[matname];
+
+        // attributs entrelacés des sommets et indices des rubans ou des triangles
+        VBOset* vboset = material->createVBOset();
+        std::vector<GLfloat> data;
+        std::vector<int> indexlist;
+        GLenum primitive;
+        renderer.setMesh(mesh);
+        if (m_Layout == LAYOUT_TRIANGLES) {
+            std::vector<MeshVertex*> fetch_order;
+            renderer.createOptimizedIndexList(indexlist, fetch_order);
+            vboset->collectInterleavedAttributes(fetch_order, data);
+            primitive = GL_TRIANGLES;
+        } else {
+            vboset->collectInterleavedAttributes(mesh, data);
+            int stripcount = renderer.createStripIndexList(indexlist);
+            renderer.printStripStats(indexlist, stripcount);
+            primitive = GL_TRIANGLE_STRIP;
+        }
+
+        // créer les VBO
+        vboset->createInterleavedDataAttributesVBO(data);
+        vboset->createIndexedPrimitiveVBO(primitive, indexlist);
+        m_VBOsets[matname] = vboset;
+        MeshModuleDrawing::printVertexStats(matname, vboset);
+
+        // enregistrer le bloc de ce matériau
+        if (! file.is_open()) continue;
+        std::string signature = vboset->getAttributesSignature();
+        CookedBlock block;
+        block.namelength = matname.size();
+        block.signaturelength = signature.size();
+        block.primitive = primitive;
+        block.floatcount = data.size();
+        block.indexcount = indexlist.size();
+        file.write((const char*) &block, sizeof(block));
+        file.write(matname.data(), matname.size());
+        file.write(signature.data(), signature.size());
+        const char padding[4] = {0, 0, 0, 0};
+        const size_t textsize = matname.size() + signature.size();
+        file.write(padding, align4(textsize) - textsize);
+        file.write((const char*) data.data(), data.size()*sizeof(GLfloat));
+        file.write((const char*) indexlist.data(), indexlist.size()*sizeof(int));
+    }
+
+    // remplacer l'ancien fichier binaire par le nouveau, les échecs sont silencieux
+    if (! file.is_open()) return;
+    ok = ok && file.good();
+    file.close();
+    if (ok) {
+        remove(cookedfilename.c_str());
+        ok = rename(tmpfilename.c_str(), cookedfilename.c_str()) == 0;
+    }
+    if (! ok) remove(tmpfilename.c_str());
+}
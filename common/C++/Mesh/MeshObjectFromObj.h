@@ -15,6 +15,10 @@ class MeshObjectFromObj: public MeshObject
 {
 public:
 
+    /// rangement des triangles dans les VBO, voir setLayout
+    static const int LAYOUT_STRIPS = 0;
+    static const int LAYOUT_TRIANGLES = 1;
+
     /**
      * Crée un ensemble de maillages et de matériaux à partir de deux fichiers OBJ et MTL associés
      * @param folder chemin d'accès aux deux fichiers obj et mtl
@@ -45,12 +49,64 @@ public:
     /** Destructeur */
     virtual ~MeshObjectFromObj();
 
+    /**
+     * choisit le rangement des triangles des prochains objets chargés :
+     * - LAYOUT_STRIPS (par défaut) : rubans de triangles, voir MeshModuleDrawing::createStripIndexList
+     * - LAYOUT_TRIANGLES : triangles et sommets réordonnés pour le cache des sommets transformés,
+     *   voir MeshModuleDrawing::createOptimizedIndexList
+     * @param layout : LAYOUT_STRIPS ou LAYOUT_TRIANGLES
+     */
+    static void setLayout(int layout);
+
 
 protected:
 
+    /**
+     * retourne le nom du fichier binaire qui contient les VBO déjà construits,
+     * il est placé dans le dossier du cache de l'utilisateur, voir Utils::setMeshCacheFolder
+     * @param materials : collection de (nom, matériau) à appliquer au maillage
+     * @return nom complet du fichier .cooked, "" s'il n'y a pas de cache
+     */
+    std::string getCookedFilename(std::map<std::string, Material*>& materials);
+
+    /**
+     * crée les VBOsets des matériaux à partir du fichier binaire s'il existe et
+     * qu'il correspond encore au fichier OBJ (taille, date, échelle et matériaux)
+     * @param materials : collection de (nom, matériau) à appliquer au maillage
+     * @return true si les VBOsets ont pu être créés, false s'il faut relire le fichier OBJ
+     */
+    bool loadCookedFile(std::map<std::string, Material*>& materials);
+
+    /**
+     * crée les VBOsets des matériaux à partir des maillages m_Meshes et enregistre
+     * leurs données dans le fichier binaire pour les prochains chargements
+     * @param materials : collection de (nom, matériau) à appliquer au maillage
+     */
+    void createCookedVBOsets(std::map<std::string, Material*>& materials);
+
+    /**
+     * relit le fichier OBJ si les maillages ne sont plus disponibles, c'est le
+     * cas quand les VBOsets ont été créés à partir du fichier binaire
+     */
+    virtual void reloadMeshes();
+
+    /**
+     * crée le VBOset d'un niveau de détail avec le même rangement que les autres, voir setLayout
+     * @param mesh : maillage réduit au niveau voulu
+     * @param material : matériau du maillage
+     * @return VBOset du niveau
+     */
+    virtual VBOset* createLevelVBOset(Mesh* mesh, Material* material);
+
     std::string m_Folder;
     std::string m_ObjFilename;
     float m_ScaleFactor;
+
+    // true si toutes les faces vont dans le même maillage, quel que soit leur matériau
+    bool m_SingleMesh;
+
+    /// rangement des triangles des objets chargés
+    static int m_Layout;
 };
 
 #endif
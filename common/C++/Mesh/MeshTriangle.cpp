@@ -30,6 +30,7 @@ MeshTriangle::MeshTriangle(Mesh* mesh, MeshVertex* v1, MeshVertex* v2, MeshVerte
 {
     // appartenance au maillage
     m_Mesh = mesh;
+    m_MeshIndex = -1;
     if (mesh != nullptr) m_Mesh->pushTriangle(this);
 
     // créer trois demi-arêtes sauf si les sommets sont nuls
@@ -68,6 +69,7 @@ MeshTriangle::MeshTriangle(Mesh* mesh)
 {
     // appartenance au maillage
     m_Mesh = mesh;
+    m_MeshIndex = -1;
     if (mesh != nullptr) m_Mesh->pushTriangle(this);
 
     // pas de demi-arête (création manuelle)
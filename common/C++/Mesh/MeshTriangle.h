@@ -62,6 +62,8 @@ private:
     /// maillage d'appartenance du triangle
     Mesh* m_Mesh;
     MeshHalfEdge* m_HalfEdge;
+    /// rang dans la liste du maillage, pour l'en retirer en temps constant
+    int m_MeshIndex;
 
     // attributs de triangle
     vec3 m_Normal;
@@ -77,6 +79,9 @@ private:
     int m_DebugNumero;
 #endif
 
+    /// le maillage gère m_MeshIndex et détache les éléments lors de clear()
+    friend class Mesh;
+
 
 public:
 
@@ -125,6 +130,15 @@ public:
      */
     void setMesh(Mesh* mesh);
 
+    /**
+     * retourne le rang du triangle dans la liste du maillage
+     * @return rang 0..NT-1, ou -1 si le triangle n'est pas dans un maillage
+     */
+    int getMeshIndex()
+    {
+        return m_MeshIndex;
+    }
+
     /**
      * retourne les sommets du triangle sous forme d'un itérable
      * @return itérable sur les trois sommets du triangle
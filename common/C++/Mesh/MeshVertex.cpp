@@ -29,36 +29,36 @@ int MeshVertex::m_DebugGenNumber = 0;
  */
 MeshVertex::MeshVertex(Mesh* mesh, std::string name)
 {
+    // les attributs sont rangés dans le maillage, il est indispensable
+    if (mesh == nullptr) {
+        throw std::invalid_argument("MeshVertex: mesh is null");
+    }
+
     // appartenance au maillage
     m_Mesh = mesh;
-    if (mesh != nullptr) {
-        m_Mesh->pushVertex(this);
+    m_MeshIndex = -1;
+    m_MidpointOf = nullptr;
+    m_Mesh->pushVertex(this);
 
-        // numéro du vertex dans les VBO
-        m_Number = m_Mesh->getVertexCount();
-    }
+    // numéro du vertex dans les VBO
+    m_Number = m_Mesh->getVertexCount();
 
     // nom du sommet
     m_Name = name;
 
-    // attributs du sommet, voir setCoord(), setColor(), setNormal()...
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_VERTEX
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_COLOR
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_NORMAL
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_TANGENT
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_TEXCOORD
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_VERTEX1
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_NORMAL1
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_IDBONES
-    m_Attributes.push_back(vec4::create());      // ID_ATTR_WEIGHTS
+    // attributs du sommet (tous nuls), voir setCoord(), setColor(), setNormal()...
+    m_Data = &m_Mesh->getVertexData();
+    m_Slot = m_Data->allocSlot();
 
     // demi-arête
     m_HalfEdge = nullptr;
+    m_Valence = 0;
 
     // divers
     m_Quadric = nullptr;
     m_CollapseTarget = nullptr;
     m_CollapseCost = 1e38;
+    m_CollapseRank = -1;
 
     #ifdef DEBUG
     m_DebugGenNumber++;
@@ -79,6 +79,12 @@ MeshVertex::~MeshVertex()
     if (m_Mesh != nullptr) m_Mesh->popVertex(this);
     m_Mesh = nullptr;
 
+    // l'arête dont il était le milieu ne doit plus le désigner
+    if (m_MidpointOf != nullptr) m_MidpointOf->setMidpoint(nullptr);
+
+    // libérer sa place dans les canaux d'attributs
+    m_Data->freeSlot(m_Slot);
+
     // supprimer la quadrique si elle existe
     if (m_Quadric != nullptr) delete m_Quadric;
 
@@ -127,6 +133,7 @@ void MeshVertex::linkSibling(MeshHalfEdge* halfedge)
     // mettre la demi-arête en tête de la liste
     halfedge->setSibling(m_HalfEdge);
     m_HalfEdge = halfedge;
+    m_Valence++;
 }
 
 
@@ -141,6 +148,7 @@ void MeshVertex::unlinkSibling(MeshHalfEdge* halfedge)
     if (m_HalfEdge == halfedge) {
         // this doit maintenant désigner la demi-arête suivante dans sa liste
         m_HalfEdge = m_HalfEdge->getSibling();
+        m_Valence--;
         // si m_HalfEdge==nullptr, alors le sommet this devient libre (supprimable)
     } else {
         // le sommet désigne une autre demi-arête, il faut parcourir le chaînage
@@ -148,6 +156,7 @@ void MeshVertex::unlinkSibling(MeshHalfEdge* halfedge)
         while (other != nullptr) {
             if (other->getSibling() == halfedge) {
                 other->setSibling(halfedge->getSibling());
+                m_Valence--;
                 break;
             }
             other = other->getSibling();
@@ -348,7 +357,7 @@ void MeshVertex::setNumber(int number)
  */
 MeshVertex* MeshVertex::setCoord(vec3 xyz)
 {
-    vec3::copy((vec3&)m_Attributes[ID_ATTR_VERTEX], xyz);
+    vec3::copy(getCoord(), xyz);
     return this;
 }
 
@@ -367,7 +376,7 @@ MeshVertex* MeshVertex::setCoord(vec3 xyz)
  */
 MeshVertex* MeshVertex::setColor(vec4 rgba)
 {
-    vec4::copy(m_Attributes[ID_ATTR_COLOR], rgba);
+    vec4::copy(getColor(), rgba);
     return this;
 }
 /**
@@ -377,8 +386,9 @@ MeshVertex* MeshVertex::setColor(vec4 rgba)
  */
 MeshVertex* MeshVertex::setColor(vec3 rgb)
 {
-    vec3::copy((vec3&)m_Attributes[ID_ATTR_COLOR], rgb);
-    m_Attributes[ID_ATTR_COLOR][3] = 1.0;
+    vec4& color = getColor();
+    vec3::copy((vec3&)color, rgb);
+    color[3] = 1.0;
     return this;
 }
 
@@ -397,7 +407,7 @@ MeshVertex* MeshVertex::setColor(vec3 rgb)
  */
 MeshVertex* MeshVertex::setNormal(vec3 normal)
 {
-    vec3::copy((vec3&)m_Attributes[ID_ATTR_NORMAL], normal);
+    vec3::copy(getNormal(), normal);
     return this;
 }
 
@@ -423,7 +433,7 @@ MeshVertex* MeshVertex::setNormal(vec3 normal)
  */
 MeshVertex* MeshVertex::setTexCoord(vec2 uv)
 {
-    vec2::copy((vec2&)m_Attributes[ID_ATTR_TEXCOORD], uv);
+    vec2::copy(getTexCoord(), uv);
     return this;
 }
 
@@ -451,17 +461,17 @@ MeshVertex* MeshVertex::setTexCoord(vec2 uv)
  */
 MeshVertex* MeshVertex::setAttribute(int idattr, vec4 value)
 {
-    vec4::copy(m_Attributes[idattr], value);
+    vec4::copy(getAttribute(idattr), value);
     return this;
 }
 MeshVertex* MeshVertex::setAttribute(int idattr, vec3 value)
 {
-    vec3::copy((vec3&)m_Attributes[idattr], value);
+    vec3::copy((vec3&)getAttribute(idattr), value);
     return this;
 }
 MeshVertex* MeshVertex::setAttribute(int idattr, vec2 value)
 {
-    vec2::copy((vec2&)m_Attributes[idattr], value);
+    vec2::copy((vec2&)getAttribute(idattr), value);
     return this;
 }
 
@@ -473,7 +483,8 @@ MeshVertex* MeshVertex::setAttribute(int idattr, vec2 value)
 void MeshVertex::computeNormal()
 {
     // calculer la moyenne des normales des triangles contenant ce sommet
-    vec3::zero((vec3&)m_Attributes[ID_ATTR_NORMAL]);
+    vec3& sum = getNormal();
+    vec3::zero(sum);
     MeshHalfEdge* halfedge = m_HalfEdge;
     while (halfedge != nullptr) {
         MeshTriangle* triangle = halfedge->getTriangle();
@@ -482,12 +493,12 @@ void MeshVertex::computeNormal()
         // prendre en compte la surface du triangle
         vec3::scale(normal, normal, triangle->getSurface());
         // cumuler les normales pondérées
-        vec3::add((vec3&)m_Attributes[ID_ATTR_NORMAL], (vec3&)m_Attributes[ID_ATTR_NORMAL], normal);
+        vec3::add(sum, sum, normal);
         // passer à la demi-arête suivante autour de ce sommet
         halfedge = halfedge->getSibling();
     }
     // normaliser le résultat
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_NORMAL], (vec3&)m_Attributes[ID_ATTR_NORMAL]);
+    vec3::normalize(sum, sum);
 }
 
 
@@ -498,7 +509,8 @@ void MeshVertex::computeNormal()
 void MeshVertex::computeTangent()
 {
     // calculer la moyenne des tangentes des triangles contenant ce sommet
-    vec3::zero((vec3&)m_Attributes[ID_ATTR_TANGENT]);
+    vec3& sum = getTangent();
+    vec3::zero(sum);
     MeshHalfEdge* halfedge = m_HalfEdge;
     while (halfedge != nullptr) {
         MeshTriangle* triangle = halfedge->getTriangle();
@@ -507,12 +519,12 @@ void MeshVertex::computeTangent()
         // prendre en compte la surface du triangle
         vec3::scale(tangent, tangent, triangle->getSurface());
         // cumuler les tangentes pondérées
-        vec3::add((vec3&)m_Attributes[ID_ATTR_TANGENT], (vec3&)m_Attributes[ID_ATTR_TANGENT], tangent);
+        vec3::add(sum, sum, tangent);
         // passer à la demi-arête suivante autour de ce sommet
         halfedge = halfedge->getSibling();
     }
     // normaliser le résultat
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_TANGENT], (vec3&)m_Attributes[ID_ATTR_TANGENT]);
+    vec3::normalize(sum, sum);
 }
 
 
@@ -554,6 +566,25 @@ void MeshVertex::setCollapseCost(float cost)
 }
 
 
+/**
+ * retourne le rang de ce sommet dans le tas des fusions, -1 s'il n'y est pas
+ * @see MeshModuleRedux
+ * @return rang
+ */
+//int MeshVertex::getCollapseRank();
+
+
+/**
+ * modifie le rang de ce sommet dans le tas des fusions
+ * @see MeshModuleRedux
+ * @param rank : rang à affecter, -1 s'il n'y est pas
+ */
+void MeshVertex::setCollapseRank(int rank)
+{
+    m_CollapseRank = rank;
+}
+
+
 /**
  * retourne la quadrique permettant de calculer le coût d'une réduction
  * @see MeshModuleRedux
@@ -581,9 +612,9 @@ void MeshVertex::setQuadric(Quadric* quadric)
 MeshVertex* MeshVertex::clone(std::string suffix)
 {
     MeshVertex* copie = new MeshVertex(m_Mesh, this->m_Name+suffix);
-    // recopier les attributs du vertex
-    for (int i=0; i<m_Attributes.size(); i++) {
-        vec4::copy(copie->m_Attributes[i], m_Attributes[i]);
+    // recopier les attributs employés par le vertex
+    for (int i=0; i<MeshVertexData::ATTR_COUNT; i++) {
+        if (m_Data->hasChannel(i)) vec4::copy(copie->getAttribute(i), readAttribute(i));
     }
     return copie;
 }
@@ -599,13 +630,12 @@ MeshVertex* MeshVertex::clone(std::string suffix)
 void MeshVertex::lerp(const MeshVertex* v0, const MeshVertex* v1, const float k)
 {
     // interpoler les attributs
-    for (int i=0; i<m_Attributes.size(); i++) {
-        vec4::lerp(m_Attributes[i], v0->m_Attributes[i], v1->m_Attributes[i], k);
+    for (int i=0; i<MeshVertexData::ATTR_COUNT; i++) {
+        if (! isAttributeUsed(i, v0, v1)) continue;
+        vec4::lerp(getAttribute(i), v0->readAttribute(i), v1->readAttribute(i), k);
     }
     // normaliser les vecteurs
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_NORMAL],  (vec3&)m_Attributes[ID_ATTR_NORMAL]);
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_TANGENT], (vec3&)m_Attributes[ID_ATTR_TANGENT]);
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_NORMAL1], (vec3&)m_Attributes[ID_ATTR_NORMAL1]);
+    normalizeDirections();
 }
 
 
@@ -621,16 +651,43 @@ void MeshVertex::lerp(const MeshVertex* v0, const MeshVertex* v1, const float k)
 void MeshVertex::hermite(const MeshVertex* v0, const vec3& t0, const MeshVertex* v1, const vec3& t1, const float k)
 {
     // interpoler les coordonnées par hermite
-    vec3::hermite((vec3&)m_Attributes[ID_ATTR_VERTEX],
-        (vec3&)v0->m_Attributes[ID_ATTR_VERTEX], t0,
-        (vec3&)v1->m_Attributes[ID_ATTR_VERTEX], t1,
+    vec3::hermite(getCoord(),
+        (const vec3&)v0->readAttribute(ID_ATTR_VERTEX), t0,
+        (const vec3&)v1->readAttribute(ID_ATTR_VERTEX), t1,
         k);
     // interpoler linéairement les autres attributs (il faudrait leurs dérivées)
-    for (int i=1; i<m_Attributes.size(); i++) {
-        vec4::lerp(m_Attributes[i], v0->m_Attributes[i], v1->m_Attributes[i], k);
+    for (int i=1; i<MeshVertexData::ATTR_COUNT; i++) {
+        if (! isAttributeUsed(i, v0, v1)) continue;
+        vec4::lerp(getAttribute(i), v0->readAttribute(i), v1->readAttribute(i), k);
     }
     // normaliser les vecteurs
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_NORMAL], (vec3&)m_Attributes[ID_ATTR_NORMAL]);
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_TANGENT], (vec3&)m_Attributes[ID_ATTR_TANGENT]);
-    vec3::normalize((vec3&)m_Attributes[ID_ATTR_NORMAL1], (vec3&)m_Attributes[ID_ATTR_NORMAL1]);
+    normalizeDirections();
+}
+
+
+/**
+ * indique si l'attribut est employé par this ou par l'un des deux sommets fournis,
+ * les attributs qui ne le sont pas restent nuls et n'ont pas besoin d'être interpolés
+ * @param idattr : numéro de l'attribut
+ * @param v0 : premier vertex
+ * @param v1 : second vertex
+ * @return true si l'un des trois maillages possède ce canal
+ */
+bool MeshVertex::isAttributeUsed(int idattr, const MeshVertex* v0, const MeshVertex* v1)
+{
+    return m_Data->hasChannel(idattr) || v0->m_Data->hasChannel(idattr) || v1->m_Data->hasChannel(idattr);
+}
+
+
+/**
+ * normalise les attributs qui sont des directions : normales et tangente
+ */
+void MeshVertex::normalizeDirections()
+{
+    const int directions[] = { ID_ATTR_NORMAL, ID_ATTR_TANGENT, ID_ATTR_NORMAL1 };
+    for (int idattr: directions) {
+        if (! m_Data->hasChannel(idattr)) continue;
+        vec3& direction = (vec3&)getAttribute(idattr);
+        vec3::normalize(direction, direction);
+    }
 }
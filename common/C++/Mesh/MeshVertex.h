@@ -13,6 +13,7 @@
 
 
 #include <Mesh.h>
+#include <MeshVertexData.h>
 
 // pour le module MeshModuleRedux
 class Quadric;
@@ -34,17 +35,24 @@ private:
     /// numéro du sommet
     int m_Number;
 
-    // attributs du sommet, voir setCoord(),  setColor(), etc.
-    std::vector<vec4> m_Attributes;
+    // attributs du sommet, rangés dans les canaux du maillage, voir setCoord(), setColor(), etc.
+    MeshVertexData* m_Data;
+    int m_Slot;
 
     /// maillage d'appartenance de ce sommet
     Mesh* m_Mesh;
     MeshHalfEdge* m_HalfEdge;       // demi-arête sortant de ce sommet
+    int m_Valence;                  // nombre de demi-arêtes sortant de ce sommet
+    /// rang dans la liste du maillage, pour l'en retirer en temps constant
+    int m_MeshIndex;
+    /// arête dont ce sommet est le milieu mémorisé, voir MeshEdge::setMidpoint
+    MeshEdge* m_MidpointOf;
 
     /* pour le module MeshModuleRedux */
 
     MeshVertex* m_CollapseTarget;
     float m_CollapseCost;
+    int m_CollapseRank;
     Quadric* m_Quadric;
 
 
@@ -53,6 +61,11 @@ private:
     int m_DebugNumber;
 #endif
 
+    /// le maillage gère m_MeshIndex et détache les éléments lors de clear()
+    friend class Mesh;
+    /// l'arête gère m_MidpointOf
+    friend class MeshEdge;
+
 
 public:
 
@@ -96,6 +109,15 @@ public:
         return m_HalfEdge;
     }
 
+    /**
+     * retourne le nombre de demi-arêtes sortant de this
+     * @return longueur du chaînage m_Sibling
+     */
+    int getValence()
+    {
+        return m_Valence;
+    }
+
     /**
      * cette méthode rajoute la demi-arête dans le chaînage m_Sibling (demi-arêtes autour de this)
      * @see #unlinkSibling qui fait l'inverse
@@ -193,6 +215,15 @@ public:
         return m_Number;
     }
 
+    /**
+     * retourne le rang du sommet dans la liste du maillage
+     * @return rang 0..NV-1, ou -1 si le sommet n'est pas dans un maillage
+     */
+    int getMeshIndex()
+    {
+        return m_MeshIndex;
+    }
+
     /**
      * définit les coordonnées du sommet
      * @param xyz coordonnées
@@ -206,7 +237,7 @@ public:
      */
     vec3& getCoord()
     {
-        return (vec3&)m_Attributes[ID_ATTR_VERTEX];
+        return (vec3&)m_Data->getAttribute(m_Slot, ID_ATTR_VERTEX);
     }
 
     /**
@@ -230,7 +261,7 @@ public:
      */
     vec4& getColor()
     {
-        return m_Attributes[ID_ATTR_COLOR];
+        return m_Data->getAttribute(m_Slot, ID_ATTR_COLOR);
     }
 
     /**
@@ -246,7 +277,7 @@ public:
      */
     vec3& getNormal()
     {
-        return (vec3&)m_Attributes[ID_ATTR_NORMAL];
+        return (vec3&)m_Data->getAttribute(m_Slot, ID_ATTR_NORMAL);
     }
 
     /**
@@ -255,7 +286,7 @@ public:
      */
     vec3& getTangent()
     {
-        return (vec3&)m_Attributes[ID_ATTR_TANGENT];
+        return (vec3&)m_Data->getAttribute(m_Slot, ID_ATTR_TANGENT);
     }
 
 
@@ -272,7 +303,7 @@ public:
      */
     vec2& getTexCoord()
     {
-        return (vec2&)m_Attributes[ID_ATTR_TEXCOORD];
+        return (vec2&)m_Data->getAttribute(m_Slot, ID_ATTR_TEXCOORD);
     }
 
 
@@ -297,7 +328,27 @@ public:
      */
     vec4& getAttribute(int idattr)
     {
-        return m_Attributes[idattr];
+        return m_Data->getAttribute(m_Slot, idattr);
+    }
+
+    /**
+     * retourne l'attribut dont on fournit l'identifiant, sans allouer son canal
+     * dans le maillage s'il n'a encore jamais été employé
+     * @param idattr : numéro de l'attribut, ex: MeshVertex::ID_ATTR_VERTEX
+     * @return vec4 contenant l'attribut, nul si le canal n'existe pas
+     */
+    const vec4& readAttribute(int idattr) const
+    {
+        return m_Data->readAttribute(m_Slot, idattr);
+    }
+
+    /**
+     * retourne la place du sommet dans les canaux d'attributs du maillage
+     * @return numéro de la place
+     */
+    int getSlot()
+    {
+        return m_Slot;
     }
 
     /**
@@ -356,6 +407,23 @@ public:
      */
     void setCollapseCost(float cost);
 
+    /**
+     * retourne le rang de ce sommet dans le tas des fusions, -1 s'il n'y est pas
+     * @see MeshModuleRedux
+     * @return rang
+     */
+    int getCollapseRank()
+    {
+        return m_CollapseRank;
+    }
+
+    /**
+     * modifie le rang de ce sommet dans le tas des fusions
+     * @see MeshModuleRedux
+     * @param rank : rang à affecter, -1 s'il n'y est pas
+     */
+    void setCollapseRank(int rank);
+
     /**
      * retourne la quadrique permettant de calculer le coût d'une réduction
      * @see MeshModuleRedux
@@ -400,6 +468,23 @@ public:
      */
     void hermite(const MeshVertex* v0, const vec3& t0, const MeshVertex* v1, const vec3& t1, const float k);
 
+private:
+
+    /**
+     * indique si l'attribut est employé par this ou par l'un des deux sommets fournis,
+     * les attributs qui ne le sont pas restent nuls et n'ont pas besoin d'être interpolés
+     * @param idattr : numéro de l'attribut
+     * @param v0 : premier vertex
+     * @param v1 : second vertex
+     * @return true si l'un des trois maillages possède ce canal
+     */
+    bool isAttributeUsed(int idattr, const MeshVertex* v0, const MeshVertex* v1);
+
+    /**
+     * normalise les attributs qui sont des directions : normales et tangente
+     */
+    void normalizeDirections();
+
 };
 
 
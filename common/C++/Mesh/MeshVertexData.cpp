@@ -0,0 +1,85 @@
+// Définition de la classe MeshVertexData
+
+#include <MeshVertexData.h>
+
+
+/**
+ * constructeur, aucun canal n'est alloué
+ */
+MeshVertexData::MeshVertexData()
+{
+    m_SlotCount = 0;
+    m_Zero = vec4::create();
+}
+
+
+/**
+ * réserve une place pour un nouveau sommet, ses attributs sont nuls
+ * @return numéro de la place
+ */
+int MeshVertexData::allocSlot()
+{
+    // réutiliser une place libérée
+    if (! m_FreeSlots.empty()) {
+        int slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+        return slot;
+    }
+
+    // agrandir les canaux alloués
+    for (int idattr=0; idattr<ATTR_COUNT; idattr++) {
+        if (! m_Channels[idattr].empty()) m_Channels[idattr].push_back(m_Zero);
+    }
+    return m_SlotCount++;
+}
+
+
+/**
+ * libère la place d'un sommet, elle sera réutilisée par un prochain sommet
+ * @param slot : numéro de la place
+ */
+void MeshVertexData::freeSlot(int slot)
+{
+    // remettre les attributs à zéro pour le prochain sommet
+    for (int idattr=0; idattr<ATTR_COUNT; idattr++) {
+        if (! m_Channels[idattr].empty()) m_Channels[idattr][slot] = m_Zero;
+    }
+    m_FreeSlots.push_back(slot);
+}
+
+
+/**
+ * alloue un canal, tous les sommets existants ont un attribut nul
+ * @param idattr : numéro de l'attribut
+ */
+void MeshVertexData::allocChannel(int idattr)
+{
+    m_Channels[idattr].resize(m_SlotCount, m_Zero);
+}
+
+
+/**
+ * retourne le nombre d'octets occupés par les canaux alloués
+ * @return taille mémoire des attributs
+ */
+size_t MeshVertexData::getMemorySize()
+{
+    size_t size = m_FreeSlots.capacity() * sizeof(int);
+    for (int idattr=0; idattr<ATTR_COUNT; idattr++) {
+        size += m_Channels[idattr].capacity() * sizeof(vec4);
+    }
+    return size;
+}
+
+
+/**
+ * libère tous les canaux et toutes les places
+ */
+void MeshVertexData::clear()
+{
+    for (int idattr=0; idattr<ATTR_COUNT; idattr++) {
+        std::vector<vec4>().swap(m_Channels[idattr]);
+    }
+    std::vector<int>().swap(m_FreeSlots);
+    m_SlotCount = 0;
+}
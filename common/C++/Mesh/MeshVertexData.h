@@ -0,0 +1,127 @@
+#ifndef MESH_MESHVERTEXDATA_H
+#define MESH_MESHVERTEXDATA_H
+
+// Définition de la classe MeshVertexData
+
+#include <vector>
+
+#include <gl-matrix.h>
+
+
+/**
+ * Cette classe range les attributs des sommets d'un maillage par canaux : un tableau
+ * contigu par attribut (coordonnées, couleurs, normales...) et non plus un tableau par
+ * sommet. Chaque sommet y occupe une place (slot) repérée par son numéro.
+ * Un canal n'est alloué qu'à sa première utilisation, un maillage sans couleurs ni
+ * tangentes ne paie donc que les coordonnées, normales et coordonnées de texture.
+ * NB : les références retournées par getAttribute sont invalidées par allocSlot
+ */
+class MeshVertexData
+{
+public:
+
+    /// nombre de canaux, voir MeshVertex::ID_ATTR_VERTEX...
+    static const int ATTR_COUNT = 9;
+
+    /**
+     * constructeur, aucun canal n'est alloué
+     */
+    MeshVertexData();
+
+    /**
+     * réserve une place pour un nouveau sommet, ses attributs sont nuls
+     * @return numéro de la place
+     */
+    int allocSlot();
+
+    /**
+     * libère la place d'un sommet, elle sera réutilisée par un prochain sommet
+     * @param slot : numéro de la place
+     */
+    void freeSlot(int slot);
+
+    /**
+     * retourne le nombre de places, libres ou non
+     * @return nombre de places
+     */
+    int getSlotCount()
+    {
+        return m_SlotCount;
+    }
+
+    /**
+     * indique si le canal est alloué, c'est à dire si un sommet a employé cet attribut
+     * @param idattr : numéro de l'attribut, ex: MeshVertex::ID_ATTR_COLOR
+     * @return true si le canal existe
+     */
+    bool hasChannel(int idattr) const
+    {
+        return ! m_Channels[idattr].empty();
+    }
+
+    /**
+     * retourne le tableau contigu d'un canal, en l'allouant si besoin
+     * @param idattr : numéro de l'attribut, ex: MeshVertex::ID_ATTR_NORMAL
+     * @return adresse du premier vec4 du canal, il y en a getSlotCount()
+     */
+    vec4* getChannel(int idattr)
+    {
+        if (m_Channels[idattr].empty()) allocChannel(idattr);
+        return m_Channels[idattr].data();
+    }
+
+    /**
+     * retourne l'attribut d'un sommet, en allouant le canal si besoin
+     * @param slot : numéro de la place du sommet
+     * @param idattr : numéro de l'attribut, ex: MeshVertex::ID_ATTR_VERTEX
+     * @return référence sur l'attribut
+     */
+    vec4& getAttribute(int slot, int idattr)
+    {
+        if (m_Channels[idattr].empty()) allocChannel(idattr);
+        return m_Channels[idattr][slot];
+    }
+
+    /**
+     * retourne l'attribut d'un sommet sans allouer le canal
+     * @param slot : numéro de la place du sommet
+     * @param idattr : numéro de l'attribut, ex: MeshVertex::ID_ATTR_VERTEX
+     * @return attribut, ou vec4 nul si le canal n'existe pas
+     */
+    const vec4& readAttribute(int slot, int idattr) const
+    {
+        if (m_Channels[idattr].empty()) return m_Zero;
+        return m_Channels[idattr][slot];
+    }
+
+    /**
+     * retourne le nombre d'octets occupés par les canaux alloués
+     * @return taille mémoire des attributs
+     */
+    size_t getMemorySize();
+
+    /**
+     * libère tous les canaux et toutes les places
+     */
+    void clear();
+
+private:
+
+    /**
+     * alloue un canal, tous les sommets existants ont un attribut nul
+     * @param idattr : numéro de l'attribut
+     */
+    void allocChannel(int idattr);
+
+    /// canaux des attributs, vides tant qu'ils ne sont pas employés
+    std::vector<vec4> m_Channels[ATTR_COUNT];
+
+    /// nombre de places et places libérées
+    int m_SlotCount;
+    std::vector<int> m_FreeSlots;
+
+    /// valeur retournée pour un canal absent
+    vec4 m_Zero;
+};
+
+#endif
@@ -10,6 +10,9 @@
 #include <utils.h>
 
 #include <AxesXYZ.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -94,16 +97,13 @@ std::string AxesXYZ::getFragmentShader()
         srcFragmentShader << "uniform vec4 ClipPlane;\n";
     }
     srcFragmentShader << "in vec3 frgColor;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
     if (m_ClipPlaneOn) {
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
     }
-    srcFragmentShader << "    glFragData[0] = vec4(frgColor, "<<m_Alpha<<");\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(1.0, 1.0, 1.0, 0.0);\n";
+    srcFragmentShader << "    writeGBuffer(vec4(frgColor, "<<m_Alpha<<"), vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(1.0, 1.0, 1.0, 0.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
@@ -142,8 +142,9 @@ void AxesXYZ::compileShader()
  */
 void AxesXYZ::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir les matrices P et MV
     mat4::glUniformMatrix(m_MatPloc, mat4Projection);
@@ -167,12 +168,12 @@ void AxesXYZ::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
     // dessiner les lignes
     glLineWidth(m_Width);
     glDrawArrays(GL_LINES, 0, 6);
+    PROFILE_DRAW(GL_LINES, 6);
 
-    // désactiver les buffers et le shader
+    // désactiver les buffers
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_VertexLoc);
     glDisableVertexAttribArray(m_ColorLoc);
-    glUseProgram(0);
 }
 
 
@@ -0,0 +1,204 @@
+// Définition de la classe FrameStats
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <chrono>
+
+#include <FrameStats.h>
+
+
+bool FrameStats::m_Enabled = false;
+bool FrameStats::m_GpuTimers = false;
+std::vector<GLuint> FrameStats::m_Queries;
+std::vector<int> FrameStats::m_QueryStages;
+int FrameStats::m_Depth = 0;
+double FrameStats::m_CpuTimes[FrameStats::STAGES_COUNT];
+double FrameStats::m_GpuTimes[FrameStats::STAGES_COUNT];
+double FrameStats::m_FrameStart = 0.0;
+double FrameStats::m_FrameTime = 0.0;
+long FrameStats::m_Frames = 0;
+
+
+/**
+ * retourne l'instant présent en secondes, pour mesurer des durées
+ */
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ * démarre la mesure d'une étape, si les mesures sont actives et qu'elle n'est
+ * pas à l'intérieur d'une autre étape
+ * @param stage : l'une des constantes STAGE_*
+ */
+FrameStats::Stage::Stage(int stage)
+{
+    m_Stage = -1;
+    m_Counted = m_Enabled;
+    if (!m_Enabled) return;
+    if (m_Depth++ > 0) return;
+    m_Stage = stage;
+
+    // lancer une timer query GPU, en prendre une nouvelle si toutes sont utilisées
+    if (m_GpuTimers) {
+        if (m_QueryStages.size() == m_Queries.size()) {
+            GLuint query;
+            glGenQueries(1, &query);
+            m_Queries.push_back(query);
+        }
+        glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_QueryStages.size()]);
+        m_QueryStages.push_back(stage);
+    }
+    m_Start = now();
+}
+
+
+/**
+ * termine la mesure de l'étape
+ */
+FrameStats::Stage::~Stage()
+{
+    if (!m_Counted) return;
+    m_Depth--;
+    if (m_Stage < 0) return;
+    m_CpuTimes[m_Stage] += now() - m_Start;
+    if (m_GpuTimers) glEndQuery(GL_TIME_ELAPSED);
+}
+
+
+/**
+ * active ou désactive les mesures
+ * @param enabled : true pour mesurer
+ */
+void FrameStats::setEnabled(bool enabled)
+{
+    if (enabled && !m_Enabled) {
+        // GL_TIME_ELAPSED fait partie d'OpenGL 3.3
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        glGetError();
+        m_GpuTimers = major > 3 || (major == 3 && minor >= 3);
+        reset();
+    }
+    if (!enabled && !m_Queries.empty()) {
+        glDeleteQueries(m_Queries.size(), &m_Queries[0]);
+        m_Queries.clear();
+        m_QueryStages.clear();
+    }
+    m_Enabled = enabled;
+    m_Depth = 0;
+}
+
+
+/**
+ * indique si les temps GPU sont mesurés
+ * @return true si GL_TIME_ELAPSED est disponible
+ */
+bool FrameStats::hasGpuTimers()
+{
+    return m_GpuTimers;
+}
+
+
+/**
+ * remet à zéro tous les cumuls
+ */
+void FrameStats::reset()
+{
+    for (int stage=0; stage<STAGES_COUNT; stage++) {
+        m_CpuTimes[stage] = 0.0;
+        m_GpuTimes[stage] = 0.0;
+    }
+    m_FrameTime = 0.0;
+    m_Frames = 0;
+}
+
+
+/**
+ * signale le début d'une image
+ */
+void FrameStats::beginFrame()
+{
+    if (!m_Enabled) return;
+    m_QueryStages.clear();
+    m_FrameStart = now();
+}
+
+
+/**
+ * signale la fin d'une image : attend les résultats des timer queries
+ * et les ajoute aux cumuls des étapes
+ */
+void FrameStats::endFrame()
+{
+    if (!m_Enabled) return;
+    m_FrameTime += now() - m_FrameStart;
+    m_Frames++;
+
+    for (unsigned int i=0; i<m_QueryStages.size(); i++) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(m_Queries[i], GL_QUERY_RESULT, &elapsed);
+        m_GpuTimes[m_QueryStages[i]] += elapsed * 1e-9;
+    }
+    m_QueryStages.clear();
+}
+
+
+/**
+ * retourne le nom d'une étape
+ * @param stage : l'une des constantes STAGE_*
+ * @return nom de la méthode de SceneBase correspondante
+ */
+std::string FrameStats::getStageName(int stage)
+{
+    switch (stage) {
+    case STAGE_PREPARE_LIGHTS:   return "prepareLights";
+    case STAGE_DEFERRED_SHADING: return "drawDeferredShading";
+    case STAGE_LIGHTINGS:        return "addLightings";
+    }
+    return "";
+}
+
+
+/**
+ * retourne le temps CPU cumulé d'une étape depuis reset()
+ * @param stage : l'une des constantes STAGE_*
+ * @return temps en secondes
+ */
+double FrameStats::getCpuTime(int stage)
+{
+    return m_CpuTimes[stage];
+}
+
+
+/**
+ * retourne le temps GPU cumulé d'une étape depuis reset()
+ * @param stage : l'une des constantes STAGE_*
+ * @return temps en secondes
+ */
+double FrameStats::getGpuTime(int stage)
+{
+    return m_GpuTimes[stage];
+}
+
+
+/**
+ * retourne le temps CPU cumulé des images entières depuis reset()
+ * @return temps en secondes
+ */
+double FrameStats::getFrameTime()
+{
+    return m_FrameTime;
+}
+
+
+/** retourne le nombre d'images depuis reset() */
+long FrameStats::getFramesCount()
+{
+    return m_Frames;
+}
+
@@ -0,0 +1,145 @@
+#ifndef MISC_FRAMESTATS_H
+#define MISC_FRAMESTATS_H
+
+// Définition de la classe FrameStats
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <string>
+#include <vector>
+
+
+/**
+ * Cette classe mesure le coût du dessin des images : temps CPU et GPU des étapes
+ * de SceneBase (préparation des lampes, dessin différé, éclairements). Les mesures
+ * ne sont faites qu'après setEnabled(true), sinon chaque point de mesure ne coûte
+ * qu'un test. Les compteurs (glDraw*, triangles...) sont ceux de la classe Profiler.
+ *
+ * Les images sont délimitées par beginFrame() et endFrame(), cette dernière attend
+ * les résultats des timer queries GPU, elle ne convient donc qu'à un banc d'essai.
+ */
+class FrameStats
+{
+public:
+
+    /// étapes mesurées du dessin d'une image
+    static const int STAGE_PREPARE_LIGHTS = 0;
+    static const int STAGE_DEFERRED_SHADING = 1;
+    static const int STAGE_LIGHTINGS = 2;
+    static const int STAGES_COUNT = 3;
+
+
+    /**
+     * mesure d'une étape entre la construction et la destruction de cet objet ;
+     * seules les étapes les plus externes sont mesurées quand elles s'imbriquent
+     */
+    class Stage
+    {
+    public:
+
+        /**
+         * démarre la mesure d'une étape
+         * @param stage : l'une des constantes STAGE_*
+         */
+        Stage(int stage);
+
+        /** termine la mesure de l'étape */
+        ~Stage();
+
+    private:
+
+        /// étape mesurée, -1 si elle n'est pas mesurée
+        int m_Stage;
+
+        /// true si cet objet compte dans la profondeur d'imbrication
+        bool m_Counted;
+
+        /// instant de début en secondes
+        double m_Start;
+    };
+
+
+    /**
+     * active ou désactive les mesures, l'activation doit avoir lieu avec un contexte OpenGL
+     * @param enabled : true pour mesurer
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * indique si les mesures sont actives
+     * @return true si elles le sont
+     */
+    static bool isEnabled()
+    {
+        return m_Enabled;
+    }
+
+    /**
+     * indique si les temps GPU sont mesurés, c'est à dire si GL_TIME_ELAPSED est disponible
+     * @return true si c'est le cas
+     */
+    static bool hasGpuTimers();
+
+    /** remet à zéro tous les cumuls */
+    static void reset();
+
+    /** signale le début d'une image */
+    static void beginFrame();
+
+    /** signale la fin d'une image, attend les timer queries et ajoute les temps aux cumuls */
+    static void endFrame();
+
+    /**
+     * retourne le nom d'une étape, pour les affichages
+     * @param stage : l'une des constantes STAGE_*
+     * @return nom de la méthode de SceneBase correspondante
+     */
+    static std::string getStageName(int stage);
+
+    /**
+     * retourne le temps CPU cumulé d'une étape depuis reset()
+     * @param stage : l'une des constantes STAGE_*
+     * @return temps en secondes
+     */
+    static double getCpuTime(int stage);
+
+    /**
+     * retourne le temps GPU cumulé d'une étape depuis reset()
+     * @param stage : l'une des constantes STAGE_*
+     * @return temps en secondes, 0 si hasGpuTimers() est faux
+     */
+    static double getGpuTime(int stage);
+
+    /**
+     * retourne le temps CPU cumulé des images entières depuis reset()
+     * @return temps en secondes entre beginFrame et endFrame, attente GPU exclue
+     */
+    static double getFrameTime();
+
+    /** retourne le nombre d'images depuis reset() */
+    static long getFramesCount();
+
+
+private:
+
+    /// mesures actives
+    static bool m_Enabled;
+
+    /// timer queries GPU disponibles, identifiants et étapes de celles lancées dans l'image
+    static bool m_GpuTimers;
+    static std::vector<GLuint> m_Queries;
+    static std::vector<int> m_QueryStages;
+
+    /// profondeur d'imbrication des étapes
+    static int m_Depth;
+
+    /// cumuls
+    static double m_CpuTimes[STAGES_COUNT];
+    static double m_GpuTimes[STAGES_COUNT];
+    static double m_FrameStart;
+    static double m_FrameTime;
+    static long m_Frames;
+};
+
+#endif
@@ -0,0 +1,396 @@
+// Définition de la classe GLState
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <GLState.h>
+#include <Profiler.h>
+
+
+GLuint GLState::m_Program = GLState::UNKNOWN;
+GLuint GLState::m_VertexArray = GLState::UNKNOWN;
+GLint GLState::m_ActiveTexture = -1;
+GLuint GLState::m_Textures2D[GLState::TEXTURE_UNITS];
+GLuint GLState::m_TexturesCube[GLState::TEXTURE_UNITS];
+std::map<GLuint, std::map<GLint, GLint>> GLState::m_Samplers;
+GLuint GLState::m_DrawFramebuffer = GLState::UNKNOWN;
+GLuint GLState::m_ReadFramebuffer = GLState::UNKNOWN;
+GLint GLState::m_Viewport[4] = { 0, 0, -1, -1 };
+GLint GLState::m_Scissor[4] = { 0, 0, -1, -1 };
+int GLState::m_Blend = -1;
+int GLState::m_ScissorTest = -1;
+GLenum GLState::m_BlendFunc[4] = { GL_NONE, GL_NONE, GL_NONE, GL_NONE };
+GLenum GLState::m_DepthFunc = GL_NONE;
+GLenum GLState::m_CullFace = GL_NONE;
+
+
+/**
+ * oublie tout l'état mémorisé
+ */
+void GLState::invalidate()
+{
+    m_Program = UNKNOWN;
+    m_VertexArray = UNKNOWN;
+    m_ActiveTexture = -1;
+    for (int unit=0; unit<TEXTURE_UNITS; unit++) {
+        m_Textures2D[unit] = UNKNOWN;
+        m_TexturesCube[unit] = UNKNOWN;
+    }
+    m_Samplers.clear();
+    m_DrawFramebuffer = UNKNOWN;
+    m_ReadFramebuffer = UNKNOWN;
+    m_Viewport[2] = -1;
+    m_Scissor[2] = -1;
+    m_Blend = -1;
+    m_ScissorTest = -1;
+    for (int i=0; i<4; i++) m_BlendFunc[i] = GL_NONE;
+    m_DepthFunc = GL_NONE;
+    m_CullFace = GL_NONE;
+}
+
+
+/**
+ * active un shader s'il ne l'est pas déjà
+ * @param program : identifiant du shader, 0 pour aucun
+ */
+void GLState::useProgram(GLuint program)
+{
+    if (program == m_Program) return;
+    glUseProgram(program);
+    m_Program = program;
+    if (program != 0) PROFILE_COUNT(PROGRAM_SWITCHES, 1);
+}
+
+
+/**
+ * active un VAO s'il ne l'est pas déjà
+ * @param vao : identifiant du VAO, 0 pour aucun
+ */
+void GLState::bindVertexArray(GLuint vao)
+{
+    if (vao == m_VertexArray) return;
+    glBindVertexArray(vao);
+    m_VertexArray = vao;
+}
+
+
+/**
+ * choisit l'unité de texture concernée par bindTexture
+ * @param unit : unité de texture, ex: GL_TEXTURE0
+ */
+void GLState::activeTexture(GLenum unit)
+{
+    GLint index = unit - GL_TEXTURE0;
+    if (index == m_ActiveTexture) return;
+    glActiveTexture(unit);
+    m_ActiveTexture = index;
+}
+
+
+/**
+ * lie une texture à l'unité active si elle ne l'est pas déjà
+ * @param target : GL_TEXTURE_2D ou GL_TEXTURE_CUBE_MAP, les autres ne sont pas mémorisés
+ * @param texture : identifiant de la texture, 0 pour aucune
+ */
+void GLState::bindTexture(GLenum target, GLuint texture)
+{
+    // texture mémorisée pour l'unité active, si elle est connue
+    GLuint* bound = nullptr;
+    if (m_ActiveTexture >= 0 && m_ActiveTexture < TEXTURE_UNITS) {
+        if (target == GL_TEXTURE_2D)       bound = &m_Textures2D[m_ActiveTexture];
+        if (target == GL_TEXTURE_CUBE_MAP) bound = &m_TexturesCube[m_ActiveTexture];
+    }
+    if (bound != nullptr && *bound == texture) return;
+
+    glBindTexture(target, texture);
+    if (bound != nullptr) *bound = texture;
+    if (texture != 0) PROFILE_COUNT(TEXTURE_BINDS, 1);
+}
+
+
+/**
+ * fournit une unité de texture à une variable sampler du shader actif, si elle
+ * ne l'a pas déjà ; la valeur d'une variable uniform reste dans le shader
+ * @param loc : emplacement de la variable, rien n'est fait s'il est négatif
+ * @param unit : unité de texture, ex: GL_TEXTURE0
+ */
+void GLState::uniformSampler(GLint loc, GLenum unit)
+{
+    if (loc < 0) return;
+    GLint index = unit - GL_TEXTURE0;
+    if (m_Program != UNKNOWN) {
+        std::map<GLint, GLint>& samplers = m_Samplers[m_Program];
+        std::map<GLint, GLint>::iterator it = samplers.find(loc);
+        if (it != samplers.end() && it->second == index) return;
+        samplers[loc] = index;
+    }
+    glUniform1i(loc, index);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+}
+
+
+/**
+ * active un FBO s'il ne l'est pas déjà
+ * @param target : GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER ou GL_READ_FRAMEBUFFER
+ * @param fbo : identifiant du FBO, 0 pour l'écran
+ */
+void GLState::bindFramebuffer(GLenum target, GLuint fbo)
+{
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+    if ((!draw || fbo == m_DrawFramebuffer) && (!read || fbo == m_ReadFramebuffer)) return;
+    glBindFramebuffer(target, fbo);
+    if (draw) m_DrawFramebuffer = fbo;
+    if (read) m_ReadFramebuffer = fbo;
+    PROFILE_COUNT(FBO_SWITCHES, 1);
+}
+
+
+/**
+ * retourne le FBO actif pour les dessins, il n'est lu qu'une fois
+ * @return identifiant du FBO, 0 pour l'écran
+ */
+GLuint GLState::getFramebuffer()
+{
+    if (m_DrawFramebuffer == UNKNOWN) {
+        GLint fbo = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &fbo);
+        m_DrawFramebuffer = fbo;
+    }
+    return m_DrawFramebuffer;
+}
+
+
+/**
+ * définit le viewport s'il change
+ */
+void GLState::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (x == m_Viewport[0] && y == m_Viewport[1] && width == m_Viewport[2] && height == m_Viewport[3]) return;
+    glViewport(x, y, width, height);
+    m_Viewport[0] = x;
+    m_Viewport[1] = y;
+    m_Viewport[2] = width;
+    m_Viewport[3] = height;
+}
+
+
+/**
+ * retourne le viewport, il n'est lu qu'une fois
+ * @param viewport : tableau recevant x, y, largeur et hauteur
+ */
+void GLState::getViewport(GLint viewport[4])
+{
+    if (m_Viewport[2] < 0) glGetIntegerv(GL_VIEWPORT, m_Viewport);
+    for (int i=0; i<4; i++) viewport[i] = m_Viewport[i];
+}
+
+
+/**
+ * définit le rectangle du scissor test s'il change
+ */
+void GLState::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (x == m_Scissor[0] && y == m_Scissor[1] && width == m_Scissor[2] && height == m_Scissor[3]) return;
+    glScissor(x, y, width, height);
+    m_Scissor[0] = x;
+    m_Scissor[1] = y;
+    m_Scissor[2] = width;
+    m_Scissor[3] = height;
+}
+
+
+/**
+ * retourne le rectangle du scissor test, il n'est lu qu'une fois
+ * @param box : tableau recevant x, y, largeur et hauteur
+ */
+void GLState::getScissor(GLint box[4])
+{
+    if (m_Scissor[2] < 0) glGetIntegerv(GL_SCISSOR_BOX, m_Scissor);
+    for (int i=0; i<4; i++) box[i] = m_Scissor[i];
+}
+
+
+/**
+ * retourne la variable qui mémorise un mode
+ * @param cap : mode concerné
+ * @return pointeur sur la variable ou nullptr si ce mode n'est pas mémorisé
+ */
+int* GLState::getCap(GLenum cap)
+{
+    switch (cap) {
+    case GL_BLEND:        return &m_Blend;
+    case GL_SCISSOR_TEST: return &m_ScissorTest;
+    }
+    return nullptr;
+}
+
+
+/**
+ * active un mode s'il ne l'est pas déjà
+ * @param cap : mode à activer
+ */
+void GLState::enable(GLenum cap)
+{
+    int* state = getCap(cap);
+    if (state != nullptr && *state == 1) return;
+    glEnable(cap);
+    if (state != nullptr) *state = 1;
+}
+
+
+/**
+ * désactive un mode s'il ne l'est pas déjà
+ * @param cap : mode à désactiver
+ */
+void GLState::disable(GLenum cap)
+{
+    int* state = getCap(cap);
+    if (state != nullptr && *state == 0) return;
+    glDisable(cap);
+    if (state != nullptr) *state = 0;
+}
+
+
+/**
+ * indique si un mode est actif, un mode mémorisé n'est lu qu'une fois
+ * @param cap : mode concerné
+ * @return true s'il est actif
+ */
+bool GLState::isEnabled(GLenum cap)
+{
+    int* state = getCap(cap);
+    if (state == nullptr) return glIsEnabled(cap);
+    if (*state < 0) *state = glIsEnabled(cap) ? 1 : 0;
+    return *state == 1;
+}
+
+
+/**
+ * définit le calcul du blending s'il change
+ */
+void GLState::blendFunc(GLenum sfactor, GLenum dfactor)
+{
+    blendFuncSeparate(sfactor, dfactor, sfactor, dfactor);
+}
+
+
+/**
+ * définit le calcul du blending séparément pour le canal alpha, s'il change
+ */
+void GLState::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+    if (srcRGB == m_BlendFunc[0] && dstRGB == m_BlendFunc[1] && srcAlpha == m_BlendFunc[2] && dstAlpha == m_BlendFunc[3]) return;
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    m_BlendFunc[0] = srcRGB;
+    m_BlendFunc[1] = dstRGB;
+    m_BlendFunc[2] = srcAlpha;
+    m_BlendFunc[3] = dstAlpha;
+}
+
+
+/**
+ * définit la comparaison du depth test si elle change
+ * @param func : ex: GL_LESS
+ */
+void GLState::depthFunc(GLenum func)
+{
+    if (func == m_DepthFunc) return;
+    glDepthFunc(func);
+    m_DepthFunc = func;
+}
+
+
+/**
+ * retourne la comparaison du depth test, elle n'est lue qu'une fois
+ * @return ex: GL_LESS
+ */
+GLenum GLState::getDepthFunc()
+{
+    if (m_DepthFunc == GL_NONE) {
+        GLint func = GL_LESS;
+        glGetIntegerv(GL_DEPTH_FUNC, &func);
+        m_DepthFunc = func;
+    }
+    return m_DepthFunc;
+}
+
+
+/**
+ * définit les faces éliminées si elles changent
+ * @param mode : GL_FRONT, GL_BACK ou GL_FRONT_AND_BACK
+ */
+void GLState::cullFace(GLenum mode)
+{
+    if (mode == m_CullFace) return;
+    glCullFace(mode);
+    m_CullFace = mode;
+}
+
+
+/**
+ * retourne les faces éliminées, elles ne sont lues qu'une fois
+ * @return GL_FRONT, GL_BACK ou GL_FRONT_AND_BACK
+ */
+GLenum GLState::getCullFace()
+{
+    if (m_CullFace == GL_NONE) {
+        GLint mode = GL_BACK;
+        glGetIntegerv(GL_CULL_FACE_MODE, &mode);
+        m_CullFace = mode;
+    }
+    return m_CullFace;
+}
+
+
+/**
+ * supprime un shader et oublie les valeurs de ses variables sampler ;
+ * un shader actif ne disparaît qu'à l'activation d'un autre
+ * @param program : identifiant du shader
+ */
+void GLState::deleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+    m_Samplers.erase(program);
+}
+
+
+/**
+ * supprime des VAO, ceux qui étaient actifs sont remplacés par 0
+ */
+void GLState::deleteVertexArrays(GLsizei n, const GLuint* vaos)
+{
+    glDeleteVertexArrays(n, vaos);
+    for (int i=0; i<n; i++) {
+        // un VAO jamais créé (identifiant -1) ne doit pas passer pour l'état inconnu
+        if (vaos[i] == m_VertexArray && vaos[i] != UNKNOWN) m_VertexArray = 0;
+    }
+}
+
+
+/**
+ * supprime des textures, celles qui étaient liées sont remplacées par 0
+ */
+void GLState::deleteTextures(GLsizei n, const GLuint* textures)
+{
+    glDeleteTextures(n, textures);
+    for (int i=0; i<n; i++) {
+        for (int unit=0; unit<TEXTURE_UNITS; unit++) {
+            if (textures[i] == m_Textures2D[unit])   m_Textures2D[unit] = 0;
+            if (textures[i] == m_TexturesCube[unit]) m_TexturesCube[unit] = 0;
+        }
+    }
+}
+
+
+/**
+ * supprime des FBO, ceux qui étaient actifs sont remplacés par 0 (l'écran)
+ */
+void GLState::deleteFramebuffers(GLsizei n, const GLuint* fbos)
+{
+    glDeleteFramebuffers(n, fbos);
+    for (int i=0; i<n; i++) {
+        if (fbos[i] == m_DrawFramebuffer) m_DrawFramebuffer = 0;
+        if (fbos[i] == m_ReadFramebuffer) m_ReadFramebuffer = 0;
+    }
+}
@@ -0,0 +1,227 @@
+#ifndef MISC_GLSTATE_H
+#define MISC_GLSTATE_H
+
+// Définition de la classe GLState
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <map>
+
+
+/**
+ * Cette classe mémorise l'état d'OpenGL (shader actif, VAO, textures de chaque unité,
+ * FBO, viewport, scissor, blending, depth test et faces éliminées) afin d'éviter les
+ * changements redondants et les lectures glGet* qui obligent le pilote à se synchroniser.
+ * Chaque méthode fait le même travail que la fonction OpenGL de même nom, mais n'appelle
+ * celle-ci que si l'état change réellement.
+ *
+ * NB : le cache n'est juste que si tous ces changements d'état passent par cette classe.
+ * Le code qui les fait directement avec OpenGL doit appeler invalidate() ensuite.
+ * En contrepartie, les méthodes disable() des matériaux, des VBOset et des traitements
+ * ne remettent plus le shader ni le VAO à zéro : il faut toujours activer ceux qu'on
+ * emploie, en particulier bindVertexArray(0) avant de définir des glVertexAttribPointer
+ * ou de lier un VBO d'indices sans VAO.
+ */
+class GLState
+{
+public:
+
+    /// nombre d'unités de texture mémorisées
+    static const int TEXTURE_UNITS = 32;
+
+
+    /**
+     * active un shader, voir glUseProgram
+     * @param program : identifiant du shader, 0 pour aucun
+     */
+    static void useProgram(GLuint program);
+
+    /**
+     * active un VAO, voir glBindVertexArray
+     * @param vao : identifiant du VAO, 0 pour aucun
+     */
+    static void bindVertexArray(GLuint vao);
+
+    /**
+     * choisit l'unité de texture concernée par bindTexture, voir glActiveTexture
+     * @param unit : unité de texture, ex: GL_TEXTURE0
+     */
+    static void activeTexture(GLenum unit);
+
+    /**
+     * lie une texture à l'unité active, voir glBindTexture
+     * @param target : GL_TEXTURE_2D ou GL_TEXTURE_CUBE_MAP, les autres ne sont pas mémorisés
+     * @param texture : identifiant de la texture, 0 pour aucune
+     */
+    static void bindTexture(GLenum target, GLuint texture);
+
+    /**
+     * fournit une unité de texture à une variable uniform sampler* du shader actif,
+     * voir glUniform1i ; la valeur est mémorisée pour chaque shader
+     * @param loc : emplacement de la variable, rien n'est fait s'il est négatif
+     * @param unit : unité de texture, ex: GL_TEXTURE0
+     */
+    static void uniformSampler(GLint loc, GLenum unit);
+
+    /**
+     * active un FBO, voir glBindFramebuffer
+     * @param target : GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER ou GL_READ_FRAMEBUFFER
+     * @param fbo : identifiant du FBO, 0 pour l'écran
+     */
+    static void bindFramebuffer(GLenum target, GLuint fbo);
+
+    /**
+     * retourne le FBO actif pour les dessins, voir GL_DRAW_FRAMEBUFFER_BINDING
+     * @return identifiant du FBO, 0 pour l'écran
+     */
+    static GLuint getFramebuffer();
+
+    /**
+     * définit le viewport, voir glViewport
+     */
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /**
+     * retourne le viewport, voir GL_VIEWPORT
+     * @param viewport : tableau recevant x, y, largeur et hauteur
+     */
+    static void getViewport(GLint viewport[4]);
+
+    /**
+     * définit le rectangle du scissor test, voir glScissor
+     */
+    static void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /**
+     * retourne le rectangle du scissor test, voir GL_SCISSOR_BOX
+     * @param box : tableau recevant x, y, largeur et hauteur
+     */
+    static void getScissor(GLint box[4]);
+
+    /**
+     * active un mode, voir glEnable ; seuls GL_BLEND et GL_SCISSOR_TEST
+     * sont mémorisés, les autres sont simplement transmis
+     * @param cap : mode à activer
+     */
+    static void enable(GLenum cap);
+
+    /**
+     * désactive un mode, voir glDisable
+     * @param cap : mode à désactiver
+     */
+    static void disable(GLenum cap);
+
+    /**
+     * indique si un mode est actif, voir glIsEnabled
+     * @param cap : mode concerné
+     * @return true s'il est actif
+     */
+    static bool isEnabled(GLenum cap);
+
+    /**
+     * définit le calcul du blending, voir glBlendFunc
+     */
+    static void blendFunc(GLenum sfactor, GLenum dfactor);
+
+    /**
+     * définit le calcul du blending séparément pour le canal alpha, voir glBlendFuncSeparate
+     */
+    static void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+    /**
+     * définit la comparaison du depth test, voir glDepthFunc
+     * @param func : ex: GL_LESS
+     */
+    static void depthFunc(GLenum func);
+
+    /**
+     * retourne la comparaison du depth test, voir GL_DEPTH_FUNC
+     * @return ex: GL_LESS
+     */
+    static GLenum getDepthFunc();
+
+    /**
+     * définit les faces éliminées quand GL_CULL_FACE est actif, voir glCullFace
+     * @param mode : GL_FRONT, GL_BACK ou GL_FRONT_AND_BACK
+     */
+    static void cullFace(GLenum mode);
+
+    /**
+     * retourne les faces éliminées, voir GL_CULL_FACE_MODE
+     * @return GL_FRONT, GL_BACK ou GL_FRONT_AND_BACK
+     */
+    static GLenum getCullFace();
+
+    /**
+     * supprime un shader et l'oublie, voir glDeleteProgram
+     * @param program : identifiant du shader
+     */
+    static void deleteProgram(GLuint program);
+
+    /**
+     * supprime des VAO et les oublie, voir glDeleteVertexArrays
+     */
+    static void deleteVertexArrays(GLsizei n, const GLuint* vaos);
+
+    /**
+     * supprime des textures et les oublie, voir glDeleteTextures
+     */
+    static void deleteTextures(GLsizei n, const GLuint* textures);
+
+    /**
+     * supprime des FBO et les oublie, voir glDeleteFramebuffers
+     */
+    static void deleteFramebuffers(GLsizei n, const GLuint* fbos);
+
+    /**
+     * oublie tout l'état mémorisé, à appeler après des changements faits directement
+     * avec OpenGL ou lors d'un changement de contexte ; l'état sera relu ou redéfini
+     * lors des appels suivants
+     */
+    static void invalidate();
+
+
+private:
+
+    /// valeur d'un identifiant inconnu
+    static const GLuint UNKNOWN = ~0u;
+
+    /// shader et VAO actifs
+    static GLuint m_Program;
+    static GLuint m_VertexArray;
+
+    /// unité de texture active (0 pour GL_TEXTURE0) et textures 2D et cube de chaque unité
+    static GLint m_ActiveTexture;
+    static GLuint m_Textures2D[TEXTURE_UNITS];
+    static GLuint m_TexturesCube[TEXTURE_UNITS];
+
+    /// unités fournies aux variables sampler, par shader et emplacement
+    static std::map<GLuint, std::map<GLint, GLint>> m_Samplers;
+
+    /// FBO actifs pour le dessin et la lecture
+    static GLuint m_DrawFramebuffer;
+    static GLuint m_ReadFramebuffer;
+
+    /// viewport et scissor, largeur négative si inconnus
+    static GLint m_Viewport[4];
+    static GLint m_Scissor[4];
+
+    /// modes : 0 désactivé, 1 activé, -1 inconnu
+    static int m_Blend;
+    static int m_ScissorTest;
+
+    /// facteurs du blending (RGB et alpha), comparaison du depth test et faces éliminées, GL_NONE si inconnus
+    static GLenum m_BlendFunc[4];
+    static GLenum m_DepthFunc;
+    static GLenum m_CullFace;
+
+    /**
+     * retourne la variable qui mémorise un mode
+     * @param cap : mode concerné
+     * @return pointeur sur la variable ou nullptr si ce mode n'est pas mémorisé
+     */
+    static int* getCap(GLenum cap);
+};
+
+#endif
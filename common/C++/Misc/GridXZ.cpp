@@ -9,6 +9,9 @@
 #include <utils.h>
 
 #include <GridXZ.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
     /**
@@ -114,7 +117,7 @@ std::string GridXZ::getFragmentShader()
     srcFragmentShader << "#version 300 es\n";
     srcFragmentShader << "precision mediump float;\n";
     srcFragmentShader << "in vec4 frgPosition;\n";
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     if (m_ClipPlaneOn) {
         srcFragmentShader << "uniform vec4 ClipPlane;\n";
     }
@@ -124,10 +127,7 @@ std::string GridXZ::getFragmentShader()
     if (m_ClipPlaneOn) {
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
     }
-    srcFragmentShader << "    glFragData[0] = vec4(frgColor, "<<m_Alpha<<");\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(1.0, 1.0, 1.0, 0.0);\n";
+    srcFragmentShader << "    writeGBuffer(vec4(frgColor, "<<m_Alpha<<"), vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(1.0, 1.0, 1.0, 0.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
@@ -166,8 +166,9 @@ void GridXZ::compileShader()
  */
 void GridXZ::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir les matrices P et MV
     mat4::glUniformMatrix(m_MatPloc, mat4Projection);
@@ -191,12 +192,12 @@ void GridXZ::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
     // dessiner les lignes
     glLineWidth(m_Width);
     glDrawArrays(GL_LINES, 0, m_VertexCount);
+    PROFILE_DRAW(GL_LINES, m_VertexCount);
 
-    // désactiver les buffers et le shader
+    // désactiver les buffers
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_VertexLoc);
     glDisableVertexAttribArray(m_ColorLoc);
-    glUseProgram(0);
 }
 
 
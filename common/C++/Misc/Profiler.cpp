@@ -0,0 +1,327 @@
+// Définition de la classe Profiler
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <chrono>
+#include <fstream>
+#include <stdio.h>
+
+#include <Profiler.h>
+
+
+bool Profiler::m_Enabled = false;
+bool Profiler::m_GpuTimers = false;
+std::vector<GLuint> Profiler::m_Queries;
+int Profiler::m_QueryNext = 0;
+int Profiler::m_QueriesPending = 0;
+double Profiler::m_CpuOrigin = 0.0;
+GLint64 Profiler::m_GpuOrigin = 0;
+std::vector<Profiler::ZoneRecord> Profiler::m_Zones;
+unsigned int Profiler::m_ZonesCollected = 0;
+int Profiler::m_FrameZone = -1;
+long Profiler::m_Counters[Profiler::COUNTERS_COUNT];
+long Profiler::m_Totals[Profiler::COUNTERS_COUNT];
+std::vector<Profiler::FrameRecord> Profiler::m_Frames;
+
+
+/**
+ * retourne l'instant présent en microsecondes depuis setEnabled
+ */
+double Profiler::now()
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (seconds - m_CpuOrigin) * 1e6;
+}
+
+
+/**
+ * active ou désactive les mesures
+ * @param enabled : true pour mesurer
+ */
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !m_Enabled) {
+        // GL_TIMESTAMP fait partie d'OpenGL 3.3
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        glGetError();
+        m_GpuTimers = major > 3 || (major == 3 && minor >= 3);
+        if (m_GpuTimers) {
+            m_Queries.resize(QUERIES_COUNT);
+            glGenQueries(QUERIES_COUNT, &m_Queries[0]);
+        }
+        m_Enabled = true;
+        reset();
+    }
+    if (!enabled && m_Enabled) {
+        // les requêtes en cours sont perdues
+        if (!m_Queries.empty()) {
+            glDeleteQueries(m_Queries.size(), &m_Queries[0]);
+            m_Queries.clear();
+        }
+        m_QueriesPending = 0;
+        m_ZonesCollected = m_Zones.size();
+        m_FrameZone = -1;
+        m_Enabled = false;
+    }
+}
+
+
+/**
+ * indique si les temps GPU sont mesurés
+ * @return true si GL_TIMESTAMP est disponible
+ */
+bool Profiler::hasGpuTimers()
+{
+    return m_GpuTimers;
+}
+
+
+/**
+ * oublie les zones et remet à zéro les compteurs ; les requêtes GPU
+ * en cours sont terminées afin de pouvoir réemployer tout l'anneau
+ */
+void Profiler::reset()
+{
+    if (m_Enabled) {
+        collect(true);
+        m_CpuOrigin = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (m_GpuTimers) glGetInteger64v(GL_TIMESTAMP, &m_GpuOrigin);
+    }
+    m_Zones.clear();
+    m_ZonesCollected = 0;
+    m_QueryNext = 0;
+    m_QueriesPending = 0;
+    m_FrameZone = -1;
+    for (int counter=0; counter<COUNTERS_COUNT; counter++) {
+        m_Counters[counter] = 0;
+        m_Totals[counter] = 0;
+    }
+    m_Frames.clear();
+}
+
+
+/**
+ * démarre la mesure d'une zone
+ * @param name : nom de la zone
+ * @return numéro de la zone, -1 si elle n'est pas mesurée
+ */
+int Profiler::begin(const char* name)
+{
+    if (m_Zones.size() >= (unsigned int) MAX_ZONES) return -1;
+
+    ZoneRecord zone;
+    zone.name = name;
+    zone.cpuEnd = -1.0;
+    zone.gpuBegin = -1.0;
+    zone.gpuEnd = -1.0;
+
+    // prendre deux requêtes dans l'anneau s'il en reste, sinon la zone n'a pas de temps GPU
+    zone.query = -1;
+    if (m_GpuTimers && m_QueriesPending + 2 <= QUERIES_COUNT) {
+        zone.query = m_QueryNext;
+        m_QueryNext = (m_QueryNext + 2) % QUERIES_COUNT;
+        m_QueriesPending += 2;
+        glQueryCounter(m_Queries[zone.query], GL_TIMESTAMP);
+    }
+    zone.cpuBegin = now();
+
+    m_Zones.push_back(zone);
+    return m_Zones.size() - 1;
+}
+
+
+/**
+ * termine la mesure d'une zone
+ * @param zone : numéro retourné par begin
+ */
+void Profiler::end(int zone)
+{
+    // les mesures ont pu être désactivées ou remises à zéro pendant la zone
+    if (!m_Enabled || zone >= (int) m_Zones.size()) return;
+
+    ZoneRecord& record = m_Zones[zone];
+    record.cpuEnd = now();
+    if (record.query >= 0) glQueryCounter(m_Queries[record.query + 1], GL_TIMESTAMP);
+}
+
+
+/**
+ * lit les résultats des requêtes GPU dans l'ordre où elles ont été lancées,
+ * c'est aussi l'ordre dans lequel le GPU les termine
+ * @param wait : true pour attendre celles qui ne sont pas terminées
+ */
+void Profiler::collect(bool wait)
+{
+    while (m_ZonesCollected < m_Zones.size()) {
+        ZoneRecord& record = m_Zones[m_ZonesCollected];
+
+        // une zone encore ouverte retient toutes les suivantes
+        if (record.cpuEnd < 0.0) return;
+
+        if (record.query >= 0) {
+            GLuint begin = m_Queries[record.query];
+            GLuint end = m_Queries[record.query + 1];
+            if (!wait) {
+                GLint available = GL_FALSE;
+                glGetQueryObjectiv(end, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available) return;
+            }
+            GLuint64 timestamp = 0;
+            glGetQueryObjectui64v(begin, GL_QUERY_RESULT, &timestamp);
+            record.gpuBegin = (GLint64(timestamp) - m_GpuOrigin) * 1e-3;
+            glGetQueryObjectui64v(end, GL_QUERY_RESULT, &timestamp);
+            record.gpuEnd = (GLint64(timestamp) - m_GpuOrigin) * 1e-3;
+            m_QueriesPending -= 2;
+        }
+        m_ZonesCollected++;
+    }
+}
+
+
+/**
+ * signale le début d'une image
+ */
+void Profiler::beginFrame()
+{
+    if (!m_Enabled) return;
+    m_FrameZone = begin("frame");
+}
+
+
+/**
+ * signale la fin d'une image : ajoute ses compteurs aux cumuls
+ * et lit les requêtes GPU terminées, sans les attendre
+ */
+void Profiler::endFrame()
+{
+    if (!m_Enabled) return;
+
+    FrameRecord frame;
+    frame.begin = m_FrameZone >= 0 ? m_Zones[m_FrameZone].cpuBegin : now();
+    for (int counter=0; counter<COUNTERS_COUNT; counter++) {
+        frame.counters[counter] = m_Counters[counter];
+        m_Totals[counter] += m_Counters[counter];
+        m_Counters[counter] = 0;
+    }
+    m_Frames.push_back(frame);
+
+    if (m_FrameZone >= 0) end(m_FrameZone);
+    m_FrameZone = -1;
+    collect(false);
+}
+
+
+/**
+ * retourne le nom d'un compteur
+ * @param counter : l'une des constantes DRAW_CALLS...UNIFORM_UPLOADS
+ * @return nom du compteur
+ */
+std::string Profiler::getCounterName(int counter)
+{
+    switch (counter) {
+    case DRAW_CALLS:       return "draw_calls";
+    case TRIANGLES:        return "triangles";
+    case PROGRAM_SWITCHES: return "program_switches";
+    case TEXTURE_BINDS:    return "texture_binds";
+    case FBO_SWITCHES:     return "fbo_switches";
+    case UNIFORM_UPLOADS:  return "uniform_uploads";
+    }
+    return "";
+}
+
+
+/**
+ * retourne le cumul d'un compteur sur les images terminées depuis reset()
+ * @param counter : l'une des constantes DRAW_CALLS...UNIFORM_UPLOADS
+ * @return valeur du compteur
+ */
+long Profiler::getCounter(int counter)
+{
+    return m_Totals[counter];
+}
+
+
+/** retourne le nombre d'images terminées depuis reset() */
+long Profiler::getFramesCount()
+{
+    return m_Frames.size();
+}
+
+
+/** retourne le nombre de zones enregistrées depuis reset() */
+int Profiler::getZonesCount()
+{
+    return m_Zones.size();
+}
+
+
+/**
+ * écrit une chaîne au format JSON, sans les caractères de contrôle
+ * @param file : fichier à compléter
+ * @param text : chaîne à écrire entre guillemets
+ */
+static void writeString(std::ofstream& file, const char* text)
+{
+    file << '"';
+    for (const char* c=text; *c!='\0'; c++) {
+        if (*c == '"' || *c == '\\') file << '\\';
+        if (*c >= 0 && *c < ' ') continue;
+        file << *c;
+    }
+    file << '"';
+}
+
+
+/**
+ * enregistre les zones et les compteurs au format Chrome trace-event JSON :
+ * les zones CPU sont sur le fil 1, les zones GPU sur le fil 2 et les compteurs
+ * de chaque image sont des événements "C" datés du début de l'image
+ * @param filename : nom du fichier à écrire
+ * @return false si le fichier n'a pas pu être écrit
+ */
+bool Profiler::exportTrace(std::string filename)
+{
+    if (m_Enabled) collect(true);
+
+    std::ofstream file;
+    file.open(filename, std::ios::out | std::ios::trunc);
+    if (! file.is_open()) {
+        perror(filename.c_str());
+        return false;
+    }
+    file.precision(3);
+    file << std::fixed;
+
+    // noms des fils
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    // zones terminées
+    for (ZoneRecord& zone: m_Zones) {
+        if (zone.cpuEnd < 0.0) continue;
+        file << ",\n{\"name\":";
+        writeString(file, zone.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << zone.cpuBegin << ",\"dur\":" << zone.cpuEnd - zone.cpuBegin << "}";
+        if (zone.gpuEnd < 0.0) continue;
+        file << ",\n{\"name\":";
+        writeString(file, zone.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":" << zone.gpuBegin << ",\"dur\":" << zone.gpuEnd - zone.gpuBegin << "}";
+    }
+
+    // compteurs des images
+    for (FrameRecord& frame: m_Frames) {
+        file << ",\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":" << frame.begin << ",\"args\":{";
+        for (int counter=0; counter<COUNTERS_COUNT; counter++) {
+            file << (counter > 0 ? "," : "") << '"' << getCounterName(counter) << "\":" << frame.counters[counter];
+        }
+        file << "}}";
+    }
+    file << "\n]}\n";
+
+    file.close();
+    return !file.fail();
+}
@@ -0,0 +1,265 @@
+#ifndef MISC_PROFILER_H
+#define MISC_PROFILER_H
+
+// Définition de la classe Profiler et des macros PROFILE_*
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <string>
+#include <vector>
+
+
+/**
+ * Points de mesure à placer dans les chemins critiques du dessin. Ils ne sont compilés
+ * que si PROFILING est défini (make CXXFLAGS+=-DPROFILING), sinon ils ne coûtent rien.
+ *  - PROFILE_ZONE(nom) : mesure le bloc englobant, jusqu'à sa fin
+ *  - PROFILE_COUNT(compteur, n) : ajoute n à l'un des compteurs, ex: PROFILE_COUNT(TEXTURE_BINDS, 1)
+ *  - PROFILE_DRAW(mode, count) : comptabilise un glDraw* et ses triangles
+ *  - PROFILE_DRAW_INSTANCED(mode, count, instances) : idem pour un glDraw*Instanced
+ */
+#ifdef PROFILING
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_ZONE(name) Profiler::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_COUNT(counter, n) Profiler::count(Profiler::counter, n)
+#define PROFILE_DRAW(mode, count) Profiler::countDraw(mode, count)
+#define PROFILE_DRAW_INSTANCED(mode, count, instances) Profiler::countDraw(mode, count, instances)
+#else
+// instructions vides, utilisables comme corps d'un if sans avertissement
+#define PROFILE_ZONE(name) do {} while (0)
+#define PROFILE_COUNT(counter, n) do {} while (0)
+#define PROFILE_DRAW(mode, count) do {} while (0)
+#define PROFILE_DRAW_INSTANCED(mode, count, instances) do {} while (0)
+#endif
+
+
+/**
+ * Cette classe instrumente le dessin des images : zones imbriquées mesurées en temps
+ * CPU et GPU, et compteurs par image (glDraw*, triangles, changements de shader, de
+ * texture et de FBO, envois de variables uniform). Les mesures ne sont faites qu'après
+ * setEnabled(true), sinon chaque point de mesure ne coûte qu'un test.
+ *
+ * Les temps GPU sont pris par une paire de GL_TIMESTAMP par zone, ce qui permet de
+ * les imbriquer. Les requêtes forment un anneau dont les résultats sont lus lorsqu'ils
+ * sont disponibles, quelques images plus tard : le CPU n'attend jamais le GPU. Quand
+ * l'anneau est plein, les zones suivantes n'ont pas de temps GPU.
+ *
+ * Les zones et les compteurs de chaque image sont exportés au format Chrome trace-event,
+ * à ouvrir avec chrome://tracing ou https://ui.perfetto.dev
+ */
+class Profiler
+{
+public:
+
+    /// compteurs par image
+    static const int DRAW_CALLS = 0;
+    static const int TRIANGLES = 1;
+    static const int PROGRAM_SWITCHES = 2;
+    static const int TEXTURE_BINDS = 3;
+    static const int FBO_SWITCHES = 4;
+    static const int UNIFORM_UPLOADS = 5;
+    static const int COUNTERS_COUNT = 6;
+
+    /// nombre de requêtes GL_TIMESTAMP de l'anneau, deux par zone
+    static const int QUERIES_COUNT = 4096;
+
+    /// nombre maximal de zones conservées pour la trace
+    static const int MAX_ZONES = 500000;
+
+
+    /**
+     * zone mesurée entre la construction et la destruction de cet objet,
+     * employer la macro PROFILE_ZONE plutôt que cette classe directement
+     */
+    class Zone
+    {
+    public:
+
+        /**
+         * démarre la mesure d'une zone
+         * @param name : nom de la zone, ce doit être une chaîne constante
+         */
+        Zone(const char* name)
+        {
+            m_Zone = m_Enabled ? begin(name) : -1;
+        }
+
+        /** termine la mesure de la zone */
+        ~Zone()
+        {
+            if (m_Zone >= 0) end(m_Zone);
+        }
+
+    private:
+
+        /// numéro de la zone dans la trace, -1 si elle n'est pas mesurée
+        int m_Zone;
+    };
+
+
+    /**
+     * active ou désactive les mesures, l'activation doit avoir lieu avec un contexte OpenGL
+     * @param enabled : true pour mesurer
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * indique si les mesures sont actives
+     * @return true si elles le sont
+     */
+    static bool isEnabled()
+    {
+        return m_Enabled;
+    }
+
+    /**
+     * indique si les temps GPU sont mesurés, c'est à dire si GL_TIMESTAMP est disponible
+     * @return true si c'est le cas
+     */
+    static bool hasGpuTimers();
+
+    /** oublie les zones et remet à zéro les compteurs */
+    static void reset();
+
+    /** signale le début d'une image, elle devient une zone de la trace */
+    static void beginFrame();
+
+    /** signale la fin d'une image : ajoute ses compteurs aux cumuls et lit les requêtes GPU terminées */
+    static void endFrame();
+
+    /**
+     * ajoute une valeur à un compteur de l'image courante
+     * @param counter : l'une des constantes DRAW_CALLS...UNIFORM_UPLOADS
+     * @param n : valeur à ajouter
+     */
+    static void count(int counter, long n)
+    {
+        if (m_Enabled) m_Counters[counter] += n;
+    }
+
+    /**
+     * comptabilise un appel à glDrawArrays ou glDrawElements, ou à leurs variantes instanciées
+     * @param mode : type de primitives dessinées
+     * @param count : nombre de sommets ou d'indices
+     * @param instances : nombre d'instances dessinées par cet appel
+     */
+    static void countDraw(GLenum mode, GLsizei count, GLsizei instances=1)
+    {
+        if (!m_Enabled) return;
+        m_Counters[DRAW_CALLS]++;
+        switch (mode) {
+        case GL_TRIANGLES:
+            m_Counters[TRIANGLES] += long(count / 3) * instances;
+            break;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            if (count > 2) m_Counters[TRIANGLES] += long(count - 2) * instances;
+            break;
+        }
+    }
+
+    /**
+     * retourne le nom d'un compteur, pour les affichages
+     * @param counter : l'une des constantes DRAW_CALLS...UNIFORM_UPLOADS
+     * @return nom du compteur, ex: "draw_calls"
+     */
+    static std::string getCounterName(int counter);
+
+    /**
+     * retourne le cumul d'un compteur sur les images terminées depuis reset()
+     * @param counter : l'une des constantes DRAW_CALLS...UNIFORM_UPLOADS
+     * @return valeur du compteur
+     */
+    static long getCounter(int counter);
+
+    /** retourne le nombre d'images terminées depuis reset() */
+    static long getFramesCount();
+
+    /** retourne le nombre de zones enregistrées depuis reset() */
+    static int getZonesCount();
+
+    /**
+     * enregistre les zones et les compteurs au format Chrome trace-event JSON,
+     * cette méthode attend les requêtes GPU encore en cours
+     * @param filename : nom du fichier à écrire
+     * @return false si le fichier n'a pas pu être écrit
+     */
+    static bool exportTrace(std::string filename);
+
+
+private:
+
+    /// mesures d'une zone, les temps sont en microsecondes depuis setEnabled, négatifs si inconnus
+    struct ZoneRecord
+    {
+        const char* name;
+        double cpuBegin;
+        double cpuEnd;
+        double gpuBegin;
+        double gpuEnd;
+        /// première des deux requêtes de la zone dans l'anneau, -1 si aucune
+        int query;
+    };
+
+    /// compteurs d'une image terminée
+    struct FrameRecord
+    {
+        double begin;
+        long counters[COUNTERS_COUNT];
+    };
+
+    /**
+     * démarre la mesure d'une zone
+     * @param name : nom de la zone
+     * @return numéro de la zone, -1 si elle n'est pas mesurée
+     */
+    static int begin(const char* name);
+
+    /**
+     * termine la mesure d'une zone
+     * @param zone : numéro retourné par begin
+     */
+    static void end(int zone);
+
+    /**
+     * lit les résultats des requêtes GPU dans l'ordre où elles ont été lancées
+     * @param wait : true pour attendre celles qui ne sont pas terminées
+     */
+    static void collect(bool wait);
+
+    /**
+     * retourne l'instant présent en microsecondes depuis setEnabled
+     */
+    static double now();
+
+
+private:
+
+    /// mesures actives
+    static bool m_Enabled;
+
+    /// anneau des requêtes GPU : identifiants, prochaine à employer, nombre en attente de résultat
+    static bool m_GpuTimers;
+    static std::vector<GLuint> m_Queries;
+    static int m_QueryNext;
+    static int m_QueriesPending;
+
+    /// origines des temps CPU (secondes) et GPU (nanosecondes)
+    static double m_CpuOrigin;
+    static GLint64 m_GpuOrigin;
+
+    /// zones enregistrées et première dont les temps GPU ne sont pas encore lus
+    static std::vector<ZoneRecord> m_Zones;
+    static unsigned int m_ZonesCollected;
+
+    /// zone de l'image en cours, -1 si aucune
+    static int m_FrameZone;
+
+    /// compteurs de l'image en cours, cumuls et compteurs des images terminées
+    static long m_Counters[COUNTERS_COUNT];
+    static long m_Totals[COUNTERS_COUNT];
+    static std::vector<FrameRecord> m_Frames;
+};
+
+#endif
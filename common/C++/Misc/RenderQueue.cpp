@@ -0,0 +1,178 @@
+// Définition de la classe RenderQueue
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <algorithm>
+#include <string.h>
+
+#include <utils.h>
+#include <RenderQueue.h>
+#include <Profiler.h>
+
+
+RenderQueue* RenderQueue::m_Active = nullptr;
+
+
+/**
+ * constructeur
+ */
+RenderQueue::RenderQueue()
+{
+    m_Mat4Projection = mat4::create();
+    m_Previous = nullptr;
+}
+
+
+/**
+ * ouvre la file : elle est vidée et devient la file active jusqu'à flush()
+ * @param mat4Projection : matrice de projection de tous les dessins
+ */
+void RenderQueue::begin(mat4& mat4Projection)
+{
+    mat4::copy(m_Mat4Projection, mat4Projection);
+    m_Packets.clear();
+    m_Order.clear();
+
+    // les files peuvent s'imbriquer, ex: dessin d'un reflet pendant celui de la scène
+    m_Previous = m_Active;
+    m_Active = this;
+}
+
+
+/**
+ * ajoute le dessin d'un VBOset
+ * @param vboset : VBOset à dessiner avec son matériau
+ * @param mat4ModelView : matrice qui positionne le VBOset devant la caméra
+ */
+void RenderQueue::submit(VBOset* vboset, mat4& mat4ModelView)
+{
+    Packet packet;
+    packet.vboset = vboset;
+    packet.drawable = nullptr;
+    packet.modelview = mat4ModelView;
+    m_Packets.push_back(packet);
+
+    SortEntry entry;
+    entry.key = makeKey(vboset->getMaterial(), mat4ModelView);
+    entry.index = m_Packets.size() - 1;
+    m_Order.push_back(entry);
+}
+
+
+/**
+ * ajoute le dessin d'un objet qui ne sait pas se décomposer en VBOsets
+ * @param drawable : objet à dessiner
+ * @param mat4ModelView : matrice qui positionne l'objet devant la caméra
+ */
+void RenderQueue::submit(Drawable* drawable, mat4& mat4ModelView)
+{
+    Packet packet;
+    packet.vboset = nullptr;
+    packet.drawable = drawable;
+    packet.modelview = mat4ModelView;
+    m_Packets.push_back(packet);
+
+    SortEntry entry;
+    entry.key = makeKey(nullptr, mat4ModelView);
+    entry.index = m_Packets.size() - 1;
+    m_Order.push_back(entry);
+}
+
+
+/**
+ * construit la clé de tri d'un paquet :
+ * - opaque : bit 63 à 0, shader sur 16 bits, texture sur 16 bits, distance sur 31 bits
+ * - transparent : bit 63 à 1, distance inversée sur 31 bits
+ * Une distance positive a la même relation d'ordre que les bits de son float.
+ * @param material : matériau du paquet ou nullptr pour un objet quelconque
+ * @param mat4ModelView : matrice ModelView du paquet, donne sa distance à l'oeil
+ * @return clé de tri
+ */
+uint64_t RenderQueue::makeKey(Material* material, mat4& mat4ModelView)
+{
+    // distance de l'origine de l'objet à l'oeil, qui regarde vers -Z
+    float distance = -mat4ModelView[14];
+    if (!(distance > 0.0)) distance = 0.0;
+    uint32_t depth;
+    memcpy(&depth, &distance, sizeof(depth));
+
+    // les objets quelconques sont dessinés en premier parmi les opaques
+    if (material == nullptr) return depth;
+
+    if (material->isTransparent()) {
+        return (uint64_t(1) << 63) | (0x7FFFFFFFu - depth);
+    }
+    uint64_t program = material->getShaderId() & 0xFFFF;
+    uint64_t texture = material->getTextureId() & 0xFFFF;
+    return (program << 47) | (texture << 31) | depth;
+}
+
+
+/**
+ * compare deux paquets selon leur clé, puis selon leur ordre d'arrivée
+ */
+bool RenderQueue::SortEntry::operator<(const SortEntry& other) const
+{
+    if (key != other.key) return key < other.key;
+    return index < other.index;
+}
+
+
+/**
+ * trie puis dessine tous les paquets reçus depuis begin() et ferme la file
+ */
+void RenderQueue::flush()
+{
+    PROFILE_ZONE("RenderQueue::flush");
+
+    // fermer la file avant de dessiner, pour que les objets dessinent vraiment
+    m_Active = m_Previous;
+    m_Previous = nullptr;
+
+    // classer les paquets
+    std::sort(m_Order.begin(), m_Order.end());
+
+    // dessiner les paquets dans cet ordre
+    bool active = false;
+    for (unsigned int i=0; i<m_Order.size(); i++) {
+        Packet& packet = m_Packets[m_Order[i].index];
+        if (packet.vboset != nullptr) {
+            // laisser le matériau actif si le paquet suivant l'emploie aussi, il n'aura
+            // alors qu'à changer la matrice ModelView au lieu de tout réactiver
+            bool release = true;
+            if (i+1 < m_Order.size()) {
+                VBOset* next = m_Packets[m_Order[i+1].index].vboset;
+                release = (next == nullptr || next->getMaterial() != packet.vboset->getMaterial());
+            }
+            packet.vboset->onDraw(m_Mat4Projection, packet.modelview, release, !active);
+            active = !release;
+        } else {
+            packet.drawable->onDraw(m_Mat4Projection, packet.modelview);
+            active = false;
+        }
+    }
+
+    m_Packets.clear();
+    m_Order.clear();
+}
+
+
+/**
+ * retourne la matrice de projection fournie à begin()
+ * @return matrice de projection
+ */
+mat4& RenderQueue::getProjection()
+{
+    return m_Mat4Projection;
+}
+
+
+/**
+ * retourne la file ouverte par begin()
+ * @return file active ou nullptr si les dessins doivent être faits aussitôt
+ */
+RenderQueue* RenderQueue::getActive()
+{
+    return m_Active;
+}
@@ -0,0 +1,112 @@
+#ifndef MISC_RENDERQUEUE_H
+#define MISC_RENDERQUEUE_H
+
+// Définition de la classe RenderQueue
+
+#include <vector>
+#include <stdint.h>
+
+#include <gl-matrix.h>
+#include <VBOset.h>
+#include <SceneElement.h>
+
+
+/**
+ * Cette classe reçoit les dessins d'une passe au lieu de les faire aussitôt, puis les
+ * trie et les dessine tous dans flush(). Chaque dessin (paquet) est classé par une clé
+ * de 64 bits : d'abord les objets opaques regroupés par shader, puis par texture, puis
+ * du plus proche au plus loin, ensuite les objets transparents du plus loin au plus proche.
+ * Les dessins consécutifs d'un même matériau ne le désactivent ni ne le réactivent
+ * entre eux, seule la matrice ModelView change.
+ *
+ * SceneBase n'emploie une file que si la scène le demande, voir SceneBase::setRenderQueue.
+ * Entre begin() et flush(), MeshObject::onDraw et SceneElement::onDraw déposent leurs
+ * dessins dans la file active au lieu de dessiner. NB : l'état des matériaux est lu au
+ * moment de flush(), il ne faut donc pas le modifier entre deux dessins d'un même matériau.
+ */
+class RenderQueue
+{
+public:
+
+    /** constructeur */
+    RenderQueue();
+
+    /**
+     * ouvre la file : elle est vidée et devient la file active jusqu'à flush()
+     * @param mat4Projection : matrice de projection de tous les dessins
+     */
+    void begin(mat4& mat4Projection);
+
+    /**
+     * ajoute le dessin d'un VBOset
+     * @param vboset : VBOset à dessiner avec son matériau
+     * @param mat4ModelView : matrice qui positionne le VBOset devant la caméra
+     */
+    void submit(VBOset* vboset, mat4& mat4ModelView);
+
+    /**
+     * ajoute le dessin d'un objet qui ne sait pas se décomposer en VBOsets ;
+     * sa méthode onDraw sera appelée par flush() parmi les objets opaques
+     * @param drawable : objet à dessiner
+     * @param mat4ModelView : matrice qui positionne l'objet devant la caméra
+     */
+    void submit(Drawable* drawable, mat4& mat4ModelView);
+
+    /**
+     * trie puis dessine tous les paquets reçus depuis begin() et ferme la file,
+     * la file qui était active avant begin() le redevient
+     */
+    void flush();
+
+    /**
+     * retourne la matrice de projection fournie à begin()
+     * @return matrice de projection
+     */
+    mat4& getProjection();
+
+    /**
+     * retourne la file ouverte par begin(), dans laquelle les objets doivent déposer leurs dessins
+     * @return file active ou nullptr si les dessins doivent être faits aussitôt
+     */
+    static RenderQueue* getActive();
+
+
+private:
+
+    /// un dessin en attente : VBOset ou bien objet, et sa matrice ModelView
+    struct Packet {
+        VBOset* vboset;
+        Drawable* drawable;
+        mat4 modelview;
+    };
+
+    /// clé de tri d'un paquet et numéro du paquet, qui départage les clés égales
+    struct SortEntry {
+        uint64_t key;
+        unsigned int index;
+        bool operator<(const SortEntry& other) const;
+    };
+
+    /**
+     * construit la clé de tri d'un paquet
+     * @param material : matériau du paquet ou nullptr pour un objet quelconque
+     * @param mat4ModelView : matrice ModelView du paquet, donne sa distance à l'oeil
+     * @return clé de tri
+     */
+    static uint64_t makeKey(Material* material, mat4& mat4ModelView);
+
+    /// matrice de projection de la passe
+    mat4 m_Mat4Projection;
+
+    /// paquets reçus et leur ordre de dessin, conservés d'une image à l'autre pour éviter les allocations
+    std::vector<Packet> m_Packets;
+    std::vector<SortEntry> m_Order;
+
+    /// file qui était active avant begin()
+    RenderQueue* m_Previous;
+
+    /// file active
+    static RenderQueue* m_Active;
+};
+
+#endif
@@ -8,6 +8,8 @@
 
 #include <utils.h>
 #include <SceneBase.h>
+#include <FrameStats.h>
+#include <GLState.h>
 
 
 
@@ -28,6 +30,14 @@ SceneBase::SceneBase(bool deferredShading)
     m_DeferredShading = deferredShading;
     m_GBuffer = nullptr;     // sera initialisé dans onSurfaceChanged
 
+    // lampes regroupées, la passe est créée au premier besoin
+    m_ClusteredLighting = true;
+    m_ClusteredLights = nullptr;
+
+    // dessins dans l'ordre de onDraw, la file de tri est créée au premier besoin
+    m_QueuedDrawing = false;
+    m_RenderQueue = nullptr;
+
     // matrice de projection et de transformation
     m_Mat4Projection = mat4::create();
     m_Mat4ModelView = mat4::create();
@@ -38,6 +48,8 @@ SceneBase::SceneBase(bool deferredShading)
 SceneBase::~SceneBase()
 {
     if (m_GBuffer != nullptr) delete m_GBuffer;
+    if (m_ClusteredLights != nullptr) delete m_ClusteredLights;
+    if (m_RenderQueue != nullptr) delete m_RenderQueue;
 }
 
 
@@ -56,12 +68,13 @@ void SceneBase::updateInfos()
 void SceneBase::onSurfaceChanged(int width, int height, int scale)
 {
     // met en place le viewport
-    glViewport(0, 0, width, height);
+    GLState::viewport(0, 0, width, height);
 
     // créer un FBO pour dessiner hors écran avec plusieurs buffers pour stocker toutes les informations nécessaires
     if (m_GBuffer != nullptr) delete m_GBuffer;
     if (m_DeferredShading) {
-        m_GBuffer = new FrameBufferObject(width*scale, height*scale, GL_TEXTURE_2D, GL_TEXTURE_2D, 3);
+        // NB : son organisation, flottante ou compacte, est choisie par GBuffer::setLayout
+        m_GBuffer = new GBuffer(width*scale, height*scale);
     } else {
         m_GBuffer = nullptr;
     }
@@ -171,6 +184,7 @@ void SceneBase::makeShadowMaps(mat4& mat4View)
  */
 void SceneBase::prepareLights(mat4& mat4View)
 {
+    FrameStats::Stage stage(FrameStats::STAGE_PREPARE_LIGHTS);
     transformLights(mat4View);
     makeShadowMaps(mat4View);
 }
@@ -183,14 +197,27 @@ void SceneBase::prepareLights(mat4& mat4View)
  */
 void SceneBase::drawDeferredShading(mat4& mat4Projection, mat4& mat4ModelView)
 {
+    FrameStats::Stage stage(FrameStats::STAGE_DEFERRED_SHADING);
+
     // rediriger les dessins vers le FBO
     if (m_GBuffer != nullptr) m_GBuffer->enable();
 
+    // les lampes ont besoin de la projection pour retrouver les positions d'un g-buffer compact
+    GBuffer* gbuffer = dynamic_cast<GBuffer*>(m_GBuffer);
+    if (gbuffer != nullptr) gbuffer->setProjection(mat4Projection);
+
     // effacer l'écran
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // dessiner les objets de la scène
-    onDraw(mat4Projection, mat4ModelView);
+    // dessiner les objets de la scène, triés par la file si elle est active
+    if (m_QueuedDrawing) {
+        if (m_RenderQueue == nullptr) m_RenderQueue = new RenderQueue();
+        m_RenderQueue->begin(mat4Projection);
+        onDraw(mat4Projection, mat4ModelView);
+        m_RenderQueue->flush();
+    } else {
+        onDraw(mat4Projection, mat4ModelView);
+    }
 
     // revenir au dessin sur l'écran
     if (m_GBuffer != nullptr) m_GBuffer->disable();
@@ -209,6 +236,7 @@ void SceneBase::drawDeferredShading(mat4& mat4Projection, mat4& mat4ModelView)
 void SceneBase::addLighting(Light* light, bool is_first)
 {
     if (!m_DeferredShading || m_GBuffer == nullptr) return;
+    FrameStats::Stage stage(FrameStats::STAGE_LIGHTINGS);
 
     if (is_first) {
 
@@ -218,28 +246,63 @@ void SceneBase::addLighting(Light* light, bool is_first)
     } else {
 
         // passer en mode blending, en tenant compte du canal alpha des éclairements ajoutés
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_SRC_ALPHA);
+        GLState::enable(GL_BLEND);
+        GLState::blendFunc(GL_SRC_ALPHA, GL_SRC_ALPHA);
 
         // rajouter l'éclairement de la lampe
         light->process(m_GBuffer);
 
         // revenir en mode normal
-        glDisable(GL_BLEND);
+        GLState::disable(GL_BLEND);
     }
 }
 
 
+/**
+ * active ou désactive l'éclairement en une seule passe des OmniLight de portée limitée
+ * @param enabled : true pour regrouper les lampes
+ */
+void SceneBase::setClusteredLighting(bool enabled)
+{
+    m_ClusteredLighting = enabled;
+}
+
+
+/**
+ * active ou désactive le tri des dessins de onDraw
+ * @param enabled : true pour trier les dessins
+ */
+void SceneBase::setRenderQueue(bool enabled)
+{
+    m_QueuedDrawing = enabled;
+}
+
+
 /**
  * rajoute les éclairements de toutes les lampes
+ * NB : les OmniLight de portée limitée sont éclairées ensemble en une seule passe
+ * si le g-buffer est un GBuffer, les autres lampes ont chacune leur passe
  */
 void SceneBase::addLightings()
 {
+    FrameStats::Stage stage(FrameStats::STAGE_LIGHTINGS);
     if (m_DeferredShading && m_GBuffer != nullptr) {
         bool is_first = true;
+        bool clustering = m_ClusteredLighting && dynamic_cast<GBuffer*>(m_GBuffer) != nullptr;
+        std::vector<OmniLight*> clustered;
         for (Light* light: m_Lights) {
-            addLighting(light, is_first);
-            is_first = false;
+            OmniLight* omni = dynamic_cast<OmniLight*>(light);
+            if (clustering && omni != nullptr && omni->isClusterable()) {
+                clustered.push_back(omni);
+            } else {
+                addLighting(light, is_first);
+                is_first = false;
+            }
+        }
+        if (!clustered.empty()) {
+            if (m_ClusteredLights == nullptr) m_ClusteredLights = new ClusteredLights();
+            m_ClusteredLights->setLights(clustered);
+            addLighting(m_ClusteredLights, is_first);
         }
     }
 }
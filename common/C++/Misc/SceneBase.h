@@ -11,8 +11,11 @@ class Scene;
 #include <gl-matrix.h>
 #include <utils.h>
 #include <FrameBufferObject.h>
+#include <GBuffer.h>
 #include <ShadowMap.h>
 #include <Light.h>
+#include <ClusteredLights.h>
+#include <RenderQueue.h>
 
 
 class SceneBase
@@ -30,6 +33,14 @@ protected:
     bool m_DeferredShading;
     FrameBufferObject* m_GBuffer;
 
+    // éclairement en une seule passe des lampes de portée limitée
+    bool m_ClusteredLighting;
+    ClusteredLights* m_ClusteredLights;
+
+    // file qui trie les dessins des objets par shader et par texture
+    bool m_QueuedDrawing;
+    RenderQueue* m_RenderQueue;
+
 
 
 public:
@@ -90,6 +101,22 @@ public:
      */
     virtual void onDrawFrame();
 
+    /**
+     * active ou désactive l'éclairement en une seule passe des OmniLight de portée
+     * limitée (voir ClusteredLights), actif par défaut ; sinon chaque lampe dessine
+     * sa propre passe sur tout l'écran
+     * @param enabled : true pour regrouper les lampes
+     */
+    void setClusteredLighting(bool enabled);
+
+    /**
+     * active ou désactive le tri des dessins de onDraw (voir RenderQueue), inactif par
+     * défaut : les objets sont dessinés dans l'ordre où onDraw les demande, ce qui est
+     * nécessaire si elle modifie l'état d'OpenGL ou des matériaux entre eux
+     * @param enabled : true pour trier les dessins
+     */
+    void setRenderQueue(bool enabled);
+
 protected:
 
     /** affiche les informations sur la caméra **/
@@ -10,6 +10,8 @@
 
 #include <utils.h>
 #include <SceneElement.h>
+#include <RenderQueue.h>
+#include <Profiler.h>
 
 
 void Drawable::transform(mat4& mat4View)
@@ -22,6 +24,12 @@ void Drawable::onDraw(mat4& mat4Projection, mat4& mat4View)
     // ne fait rien
 }
 
+void Drawable::submit(RenderQueue* queue, mat4& mat4View)
+{
+    // l'objet sera dessiné tel quel lors du vidage de la file
+    queue->submit(this, mat4View);
+}
+
 
 /**
  * Constructeur d'un élément 3d
@@ -172,13 +180,16 @@ void SceneElement::transform(mat4& mat4ModelView, SceneElement* exclude)
 
 
 /**
- * dessine l'élément ainsi que tous ses enfants et ancêtres, sauf ceux qui ont déjà été dessinés
+ * dessine l'élément ainsi que tous ses enfants et ancêtres, sauf ceux qui ont déjà été dessinés ;
+ * si une RenderQueue est active, les objets y déposent leurs dessins
  * @param mat4Projection : matrice de projection
  * @param mat4ModelView : matrice qui positionne l'objet devant la caméra
  * @param exclude : s'il est non null, alors ne pas le dessiner
  */
 void SceneElement::onDraw(mat4& mat4Projection, mat4& mat4ModelView, SceneElement* exclude)
 {
+    PROFILE_ZONE("SceneElement::onDraw");
+
     // s'il faut remonter, alors dessiner le parent dans la transformation inverse
     if (m_Parent != nullptr && m_Parent != exclude) {
         // transformation inverse de this pour dessiner l'élément parent
@@ -188,9 +199,14 @@ void SceneElement::onDraw(mat4& mat4Projection, mat4& mat4ModelView, SceneElemen
         m_Parent->onDraw(mat4Projection, m_ModelViewTmp, this);
     }
 
-    // dessiner l'objet géré par cet élément
+    // dessiner l'objet géré par cet élément, ou le mettre dans la file active
     if (m_Object != nullptr) {
-        m_Object->onDraw(mat4Projection, mat4ModelView);
+        RenderQueue* queue = RenderQueue::getActive();
+        if (queue != nullptr) {
+            m_Object->submit(queue, mat4ModelView);
+        } else {
+            m_Object->onDraw(mat4Projection, mat4ModelView);
+        }
     }
 
     // dessiner les éléments enfants, sauf celui qui est désigné par exclude
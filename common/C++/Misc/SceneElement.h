@@ -11,6 +11,8 @@
 #include <Mesh.h>
 #include <Material.h>
 
+class RenderQueue;
+
 /**
  * C'est une classe abstraite indiquant qu'un objet doit avoir une
  * méthode de transformation par une matrice et une méthode de dessin
@@ -29,6 +31,14 @@ public:
      */
     virtual void onDraw(mat4& mat4Projection, mat4& mat4View);
 
+    /**
+     * dépose le dessin de l'objet dans une file, voir RenderQueue ; par défaut
+     * l'objet entier y est mis et son onDraw sera appelée lors du vidage de la file
+     * @param queue : file qui reçoit le dessin
+     * @param mat4ModelView : matrice de vue
+     */
+    virtual void submit(RenderQueue* queue, mat4& mat4ModelView);
+
     /** destructeur */
     virtual ~Drawable() {};
 };
@@ -114,7 +124,8 @@ public:
     void transform(mat4& mat4ModelView, SceneElement* exclude=nullptr);
 
     /**
-     * dessine l'élément ainsi que tous ses enfants et ancêtres, sauf ceux qui ont déjà été dessinés
+     * dessine l'élément ainsi que tous ses enfants et ancêtres, sauf ceux qui ont déjà été dessinés ;
+     * si une RenderQueue est active, les objets y déposent leurs dessins
      * @param mat4Projection : matrice de projection
      * @param mat4ModelView : matrice qui positionne l'objet devant la caméra
      * @param exclude : s'il est non null, alors ne pas le dessiner
@@ -10,6 +10,9 @@
 #include <utils.h>
 
 #include <Star.h>
+#include <GBuffer.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -100,16 +103,13 @@ std::string Star::getFragmentShader()
     if (m_ClipPlaneOn) {
         srcFragmentShader << "uniform vec4 ClipPlane;\n";
     }
-    srcFragmentShader << "out vec4 glFragData[4];\n";
+    srcFragmentShader << GBuffer::getEncoderShader();
     srcFragmentShader << "void main()\n";
     srcFragmentShader << "{\n";
     if (m_ClipPlaneOn) {
         srcFragmentShader << "    if (dot(frgPosition, ClipPlane) < 0.0) discard;\n";
     }
-    srcFragmentShader << "    glFragData[0] = vec4(1.0, 1.0, 0.0, "<<m_Alpha<<");\n";
-    srcFragmentShader << "    glFragData[1] = vec4(0.0);\n";
-    srcFragmentShader << "    glFragData[2] = vec4(frgPosition.xyz, 1.0);\n";
-    srcFragmentShader << "    glFragData[3] = vec4(1.0, 1.0, 1.0, 0.0);\n";
+    srcFragmentShader << "    writeGBuffer(vec4(1.0, 1.0, 0.0, "<<m_Alpha<<"), vec4(0.0), vec4(frgPosition.xyz, 1.0), vec4(1.0, 1.0, 1.0, 0.0));\n";
     srcFragmentShader << "}";
     return srcFragmentShader.str();
 }
@@ -155,8 +155,9 @@ Star::~Star()
  */
 void Star::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir les matrices P et MV
     mat4::glUniformMatrix(m_MatPloc, mat4Projection);
@@ -175,11 +176,11 @@ void Star::onDraw(mat4 mat4Projection, mat4 mat4ModelView)
     // dessiner les lignes
     glLineWidth(m_Width);
     glDrawArrays(GL_LINES, 0, m_DebugLineCount);
+    PROFILE_DRAW(GL_LINES, m_DebugLineCount);
 
-    // désactiver les buffers et le shader
+    // désactiver les buffers
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDisableVertexAttribArray(m_VertexLoc);
-    glUseProgram(0);
 }
 
 
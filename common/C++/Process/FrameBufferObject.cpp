@@ -11,6 +11,8 @@
 #include <math.h>
 
 #include <FrameBufferObject.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 FrameBufferObject::FrameBufferObject()
 {
@@ -47,13 +49,10 @@ FrameBufferObject::FrameBufferObject(int width, int height, GLenum color, GLenum
 
     // variables d'instance
     init(width, height);
-    std::vector<GLenum> drawBuffers;
-
-    const GLfloat borderColor[] = {1.0,1.0,1.0,0.0};
 
     // créer le FBO
     glGenFramebuffers(1, &m_FBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 
     // identifiant du buffer courant
     GLuint bufferId = 0;
@@ -63,20 +62,7 @@ FrameBufferObject::FrameBufferObject(int width, int height, GLenum color, GLenum
 
     case GL_TEXTURE_2D:
         // créer une texture 2D pour recevoir les dessins faits via le FBO
-        glGenTextures(1, &bufferId);
-        glBindTexture(GL_TEXTURE_2D, bufferId);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F,  width, height, 0, GL_RGBA, GL_FLOAT, 0);
-
-        // configurer la texture
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
-
-        // attacher la texture au FBO
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bufferId, 0);
-        m_ColorBufferIds.push_back(bufferId);
-        m_DrawBufferNames.push_back(GL_COLOR_ATTACHMENT0);
+        addColorTexture(GL_COLOR_ATTACHMENT0, GL_RGBA32F, GL_RGBA, GL_FLOAT, filtering);
         break;
 
     case GL_RENDERBUFFER:
@@ -103,23 +89,7 @@ FrameBufferObject::FrameBufferObject(int width, int height, GLenum color, GLenum
 
     case GL_TEXTURE_2D:
         // lui ajouter un depth buffer de type texture
-        glGenTextures(1, &m_DepthBufferId);
-        glBindTexture(GL_TEXTURE_2D, m_DepthBufferId);
-        //glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 0);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, 0);
-
-        // configurer la texture
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
-        //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
-
-        // couleur du bord
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-        // attacher le depth buffer au FBO
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthBufferId, 0);
+        addDepthTexture(GL_DEPTH_COMPONENT, filtering);
         break;
 
     case GL_RENDERBUFFER:
@@ -145,20 +115,7 @@ FrameBufferObject::FrameBufferObject(int width, int height, GLenum color, GLenum
     for (int i=0; i<colorsnb; i++) {
 
         // créer une texture 2D pour recevoir les dessins (voir glFragData dans les shaders)
-        glGenTextures(1, &bufferId);
-        glBindTexture(GL_TEXTURE_2D, bufferId);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, 0);
-
-        // configurer la texture
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
-
-        // attacher la texture au FBO
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1+i, GL_TEXTURE_2D, bufferId, 0);
-        m_ColorBufferIds.push_back(bufferId);
-        m_DrawBufferNames.push_back(GL_COLOR_ATTACHMENT1+i);
+        addColorTexture(GL_COLOR_ATTACHMENT1+i, GL_RGBA32F, GL_RGBA, GL_FLOAT, filtering);
     }
 
     // indiquer quels sont les buffers utilisés pour le dessin (glFragData valides)
@@ -168,9 +125,70 @@ FrameBufferObject::FrameBufferObject(int width, int height, GLenum color, GLenum
     checkStatus();
 
     // désactiver le FBO pour l'instant
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+
+/**
+ * crée une texture 2D de la taille du FBO et l'attache en tant que color buffer
+ * NB : le FBO doit être actif (glBindFramebuffer)
+ * @param attachment : GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1...
+ * @param internalformat : format des texels, par exemple GL_RGBA32F, GL_RGBA8 ou GL_RG16F
+ * @param format : composantes des texels, par exemple GL_RGBA ou GL_RG
+ * @param type : type des composantes, par exemple GL_FLOAT ou GL_UNSIGNED_BYTE
+ * @param filtering : filtrage de la texture, GL_NEAREST ou GL_LINEAR
+ */
+void FrameBufferObject::addColorTexture(GLenum attachment, GLint internalformat, GLenum format, GLenum type, GLenum filtering)
+{
+    // créer une texture 2D pour recevoir les dessins faits via le FBO
+    GLuint bufferId = 0;
+    glGenTextures(1, &bufferId);
+    GLState::bindTexture(GL_TEXTURE_2D, bufferId);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_Width, m_Height, 0, format, type, 0);
+
+    // configurer la texture
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
+
+    // attacher la texture au FBO
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, bufferId, 0);
+    m_ColorBufferIds.push_back(bufferId);
+    m_DrawBufferNames.push_back(attachment);
+}
+
+
+/**
+ * crée une texture 2D de la taille du FBO et l'attache en tant que depth buffer
+ * NB : le FBO doit être actif (glBindFramebuffer)
+ * @param internalformat : format des texels, par exemple GL_DEPTH_COMPONENT ou GL_DEPTH_COMPONENT24
+ * @param filtering : filtrage de la texture, GL_NEAREST ou GL_LINEAR
+ */
+void FrameBufferObject::addDepthTexture(GLint internalformat, GLenum filtering)
+{
+    const GLfloat borderColor[] = {1.0,1.0,1.0,0.0};
+
+    // lui ajouter un depth buffer de type texture
+    glGenTextures(1, &m_DepthBufferId);
+    GLState::bindTexture(GL_TEXTURE_2D, m_DepthBufferId);
+    //glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_Width, m_Height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, 0);
+
+    // configurer la texture
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering);
+    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+    // couleur du bord
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+    // attacher le depth buffer au FBO
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthBufferId, 0);
 }
 
 
@@ -227,20 +245,20 @@ void FrameBufferObject::checkStatus()
 FrameBufferObject::~FrameBufferObject()
 {
     // déterminer quels sont les types des attachements
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
     GLint color = GL_NONE;
     glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &color);
     GLint depth = GL_NONE;
     glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &depth);
 
     // supprimer le FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glDeleteFramebuffers(1, &m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::deleteFramebuffers(1, &m_FBO);
 
     // libérer le color buffer s'il y en a un
     switch (color) {
     case GL_TEXTURE:
-        glDeleteTextures(1, &m_ColorBufferIds[0]);
+        GLState::deleteTextures(1, &m_ColorBufferIds[0]);
         break;
     case GL_RENDERBUFFER:
         glDeleteRenderbuffers(1, &m_ColorBufferIds[0]);
@@ -250,7 +268,7 @@ FrameBufferObject::~FrameBufferObject()
     // libérer le depth buffer s'il y en a un
     switch (depth) {
     case GL_TEXTURE:
-        glDeleteTextures(1, &m_DepthBufferId);
+        GLState::deleteTextures(1, &m_DepthBufferId);
         break;
     case GL_RENDERBUFFER:
         glDeleteRenderbuffers(1, &m_DepthBufferId);
@@ -259,7 +277,7 @@ FrameBufferObject::~FrameBufferObject()
 
     // libérer les autres buffers s'il y en a
     for (int i=1; i<m_ColorBufferIds.size(); i++) {
-        glDeleteTextures(1, &m_ColorBufferIds[i]);
+        GLState::deleteTextures(1, &m_ColorBufferIds[i]);
     }
 }
 
@@ -269,17 +287,19 @@ FrameBufferObject::~FrameBufferObject()
  */
 void FrameBufferObject::enable()
 {
+    PROFILE_ZONE("FrameBufferObject::enable");
+
     // sauver le viewport
-    glGetIntegerv(GL_VIEWPORT, m_Viewport);
+    GLState::getViewport(m_Viewport);
 
     // redéfinir le viewport pour correspondre au FBO
-    glViewport(0, 0, m_Width, m_Height);
+    GLState::viewport(0, 0, m_Width, m_Height);
 
     // enregistrer le précédent FBO actif
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_PrecFBO);
+    m_PrecFBO = GLState::getFramebuffer();
 
     // activer le FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 }
 
 
@@ -289,10 +309,10 @@ void FrameBufferObject::enable()
 void FrameBufferObject::disable()
 {
     // désactiver le FBO, remettre le précédent en place
-    glBindFramebuffer(GL_FRAMEBUFFER, m_PrecFBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_PrecFBO);
 
     // remettre le viewport à ce qu'il était avant
-    glViewport(m_Viewport[0], m_Viewport[1], m_Viewport[2], m_Viewport[3]);
+    GLState::viewport(m_Viewport[0], m_Viewport[1], m_Viewport[2], m_Viewport[3]);
 }
 
 
@@ -351,12 +371,12 @@ void FrameBufferObject::setTextureUnit(GLint unit, GLint locSampler, GLuint buff
         throw std::invalid_argument("FrameBufferObject::setTextureUnit: first parameter, unit is not GL_TEXTURE0 ... GL_TEXTURE7");
     }
     /*****DEBUG*****/
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
     if (locSampler < 0 || bufferId <= 0) {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D, bufferId);
-        glUniform1i(locSampler, unit-GL_TEXTURE0);
+        GLState::bindTexture(GL_TEXTURE_2D, bufferId);
+        GLState::uniformSampler(locSampler, unit);
     }
 }
 
@@ -379,24 +399,24 @@ void FrameBufferObject::swapColorBuffers(int num1, FrameBufferObject* otherFBO,
     GLuint bufferId2 = otherFBO->m_ColorBufferIds[num2];
 
     // enregistrer le précédent FBO actif
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_PrecFBO);
+    m_PrecFBO = GLState::getFramebuffer();
 
     // activer le FBO this
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 
     // changer la texture attachée
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+num1, GL_TEXTURE_2D, bufferId2, 0);
     m_ColorBufferIds[num1] = bufferId2;
 
     // activer l'autre FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, otherFBO->m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, otherFBO->m_FBO);
 
     // changer la texture attachée
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+num2, GL_TEXTURE_2D, bufferId1, 0);
     otherFBO->m_ColorBufferIds[num2] = bufferId1;
 
     // remettre le précédent FBO en place
-    glBindFramebuffer(GL_FRAMEBUFFER, m_PrecFBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_PrecFBO);
 }
 
 
@@ -559,8 +579,9 @@ void FrameBufferObject::onDrawRGB(GLenum attachment)
     // désactiver le test du depth buffer
     glDisable(GL_DEPTH_TEST);
 
-    // activer le shader
-    glUseProgram(m_ShaderRGBId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderRGBId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glEnableVertexAttribArray(m_VertexRGBLoc);
@@ -577,6 +598,7 @@ void FrameBufferObject::onDrawRGB(GLenum attachment)
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver la texture
     setTextureUnit(GL_TEXTURE0);
@@ -586,8 +608,6 @@ void FrameBufferObject::onDrawRGB(GLenum attachment)
     glDisableVertexAttribArray(m_VertexRGBLoc);
     glDisableVertexAttribArray(m_TexCoordRGBLoc);
 
-    // désactiver le shader
-    glUseProgram(0);
 
     // réactiver le test du depth buffer
     glEnable(GL_DEPTH_TEST);
@@ -603,8 +623,9 @@ void FrameBufferObject::onDrawAlpha(GLenum attachment)
     // désactiver le test du depth buffer
     glDisable(GL_DEPTH_TEST);
 
-    // activer le shader
-    glUseProgram(m_ShaderAlphaId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderAlphaId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glEnableVertexAttribArray(m_VertexAlphaLoc);
@@ -621,6 +642,7 @@ void FrameBufferObject::onDrawAlpha(GLenum attachment)
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver la texture
     setTextureUnit(GL_TEXTURE0);
@@ -630,8 +652,6 @@ void FrameBufferObject::onDrawAlpha(GLenum attachment)
     glDisableVertexAttribArray(m_VertexAlphaLoc);
     glDisableVertexAttribArray(m_TexCoordAlphaLoc);
 
-    // désactiver le shader
-    glUseProgram(0);
 
     // réactiver le test du depth buffer
     glEnable(GL_DEPTH_TEST);
@@ -646,8 +666,9 @@ void FrameBufferObject::onDrawDepth()
     // désactiver le test du depth buffer
     glDisable(GL_DEPTH_TEST);
 
-    // activer le shader
-    glUseProgram(m_ShaderDepthId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderDepthId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glEnableVertexAttribArray(m_VertexDepthLoc);
@@ -664,6 +685,7 @@ void FrameBufferObject::onDrawDepth()
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver la texture
     setTextureUnit(GL_TEXTURE0);
@@ -673,8 +695,6 @@ void FrameBufferObject::onDrawDepth()
     glDisableVertexAttribArray(m_VertexDepthLoc);
     glDisableVertexAttribArray(m_TexCoordDepthLoc);
 
-    // désactiver le shader
-    glUseProgram(0);
 
     // réactiver le test du depth buffer
     glEnable(GL_DEPTH_TEST);
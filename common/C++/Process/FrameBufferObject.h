@@ -121,6 +121,23 @@ protected:
     /** initialise les variables membres */
     virtual void init(int width, int height);
 
+    /**
+     * crée une texture 2D de la taille du FBO et l'attache en tant que color buffer
+     * @param attachment : GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1...
+     * @param internalformat : format des texels, par exemple GL_RGBA32F, GL_RGBA8 ou GL_RG16F
+     * @param format : composantes des texels, par exemple GL_RGBA ou GL_RG
+     * @param type : type des composantes, par exemple GL_FLOAT ou GL_UNSIGNED_BYTE
+     * @param filtering : filtrage de la texture, GL_NEAREST ou GL_LINEAR
+     */
+    void addColorTexture(GLenum attachment, GLint internalformat, GLenum format, GLenum type, GLenum filtering);
+
+    /**
+     * crée une texture 2D de la taille du FBO et l'attache en tant que depth buffer
+     * @param internalformat : format des texels, par exemple GL_DEPTH_COMPONENT ou GL_DEPTH_COMPONENT24
+     * @param filtering : filtrage de la texture, GL_NEAREST ou GL_LINEAR
+     */
+    void addDepthTexture(GLint internalformat, GLenum filtering);
+
     /**
      * vérifie l'état du FBO
      */
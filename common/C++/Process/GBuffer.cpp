@@ -0,0 +1,280 @@
+// Définition de la classe GBuffer
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <utils.h>
+#include <GBuffer.h>
+#include <GLState.h>
+
+
+// organisation des g-buffers et des shaders créés par la suite
+int GBuffer::m_CurrentLayout = GBuffer::LAYOUT_FLOAT;
+
+
+/**
+ * constructeur de la classe GBuffer
+ * @param width : largeur du FBO (nombre de pixels)
+ * @param height : hauteur du FBO
+ * @param layout : organisation des buffers, LAYOUT_FLOAT ou LAYOUT_COMPACT
+ */
+GBuffer::GBuffer(int width, int height, int layout):
+    FrameBufferObject()
+{
+    // variables d'instance
+    init(width, height);
+    m_Layout = layout;
+    m_Mat4Projection = mat4::create();
+    m_Mat4InvProjection = mat4::create();
+
+    // créer le FBO
+    glGenFramebuffers(1, &m_FBO);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+
+    switch (layout) {
+
+    case LAYOUT_FLOAT:
+        // mêmes buffers que FrameBufferObject(width, height, GL_TEXTURE_2D, GL_TEXTURE_2D, 3)
+        for (int i=0; i<4; i++) {
+            addColorTexture(GL_COLOR_ATTACHMENT0+i, GL_RGBA32F, GL_RGBA, GL_FLOAT, GL_LINEAR);
+        }
+        addDepthTexture(GL_DEPTH_COMPONENT, GL_LINEAR);
+        break;
+
+    case LAYOUT_COMPACT:
+        // les couleurs peuvent être interpolées, mais pas la normale ni la profondeur
+        addColorTexture(GL_COLOR_ATTACHMENT0+COMPACT_DIFFUSE,  GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, GL_LINEAR);
+        addColorTexture(GL_COLOR_ATTACHMENT0+COMPACT_SPECULAR, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, GL_LINEAR);
+        addColorTexture(GL_COLOR_ATTACHMENT0+COMPACT_NORMAL,   GL_RG16F, GL_RG,   GL_FLOAT,         GL_NEAREST);
+        addDepthTexture(GL_DEPTH_COMPONENT24, GL_NEAREST);
+        break;
+
+    default:
+        throw std::invalid_argument("GBuffer: layout is not among LAYOUT_FLOAT, LAYOUT_COMPACT");
+    }
+
+    // indiquer quels sont les buffers utilisés pour le dessin (glFragData valides)
+    glDrawBuffers(m_DrawBufferNames.size(), &m_DrawBufferNames[0]);
+
+    // vérifier l'état des lieux
+    checkStatus();
+
+    // désactiver le FBO pour l'instant
+    GLState::bindTexture(GL_TEXTURE_2D, 0);
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+
+/**
+ * supprime ce g-buffer, les buffers sont libérés par la superclasse
+ */
+GBuffer::~GBuffer()
+{
+}
+
+
+/**
+ * retourne l'organisation des buffers de ce g-buffer
+ * @return LAYOUT_FLOAT ou LAYOUT_COMPACT
+ */
+int GBuffer::getBufferLayout()
+{
+    return m_Layout;
+}
+
+
+/**
+ * retourne le nombre d'octets occupés par un pixel de ce g-buffer, tous buffers confondus
+ * @return nombre d'octets par pixel
+ */
+int GBuffer::getBytesPerPixel()
+{
+    if (m_Layout == LAYOUT_COMPACT) {
+        // RGBA8 + RGBA8 + RG16F + DEPTH24 (stocké sur 32 bits)
+        return 4 + 4 + 4 + 4;
+    }
+    // 4 RGBA32F + DEPTH
+    return 4*16 + 4;
+}
+
+
+/**
+ * mémorise la matrice de projection avec laquelle la scène est dessinée dans ce g-buffer
+ * @param mat4Projection : matrice de projection
+ */
+void GBuffer::setProjection(const mat4& mat4Projection)
+{
+    mat4::copy(m_Mat4Projection, mat4Projection);
+    mat4::invert(m_Mat4InvProjection, mat4Projection);
+}
+
+
+/**
+ * retourne la matrice de projection fournie à setProjection
+ * @return matrice de projection
+ */
+mat4& GBuffer::getProjection()
+{
+    return m_Mat4Projection;
+}
+
+
+/**
+ * retourne l'inverse de la matrice de projection fournie à setProjection
+ * @return inverse de la matrice de projection
+ */
+mat4& GBuffer::getInverseProjection()
+{
+    return m_Mat4InvProjection;
+}
+
+
+/**
+ * choisit l'organisation des g-buffers créés par la suite, ainsi que celle
+ * qu'attendent les shaders des matériaux et des lampes compilés par la suite
+ * @param layout : LAYOUT_FLOAT ou LAYOUT_COMPACT
+ */
+void GBuffer::setLayout(int layout)
+{
+    if (layout != LAYOUT_FLOAT && layout != LAYOUT_COMPACT) {
+        throw std::invalid_argument("GBuffer::setLayout: layout is not among LAYOUT_FLOAT, LAYOUT_COMPACT");
+    }
+    m_CurrentLayout = layout;
+}
+
+
+/**
+ * retourne l'organisation courante des g-buffers
+ * @return LAYOUT_FLOAT ou LAYOUT_COMPACT
+ */
+int GBuffer::getLayout()
+{
+    return m_CurrentLayout;
+}
+
+
+/**
+ * retourne les sorties GLSL d'un fragment shader qui dessine dans le g-buffer
+ * et la fonction writeGBuffer(vec4 Kd, vec4 KsNs, vec4 position, vec4 normal)
+ * @return source GLSL à insérer avant la fonction main
+ */
+std::string GBuffer::getEncoderShader()
+{
+    std::ostringstream srcFragmentShader;
+    if (m_CurrentLayout == LAYOUT_COMPACT) {
+        srcFragmentShader << "out vec4 glFragData[3];\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "// remplit le g-buffer compact, la position est donnée par la profondeur\n";
+        srcFragmentShader << "void writeGBuffer(vec4 Kd, vec4 KsNs, vec4 position, vec4 normal)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    glFragData[0] = Kd;\n";
+        srcFragmentShader << "    // Ns entre 0 et 1023, codé de manière logarithmique sur 8 bits\n";
+        srcFragmentShader << "    glFragData[1] = vec4(KsNs.rgb, log2(max(KsNs.a, 0.0) + 1.0) / 10.0);\n";
+        srcFragmentShader << "    if (normal.w != 0.0) {\n";
+        srcFragmentShader << "        // éclairement diffus uniquement, valeur hors de l'octaèdre\n";
+        srcFragmentShader << "        glFragData[2] = vec4(2.0, 0.0, 0.0, 0.0);\n";
+        srcFragmentShader << "    } else {\n";
+        srcFragmentShader << "        // projection de la normale sur un octaèdre, puis dépliage de sa moitié arrière\n";
+        srcFragmentShader << "        vec3 N = normal.xyz / max(abs(normal.x) + abs(normal.y) + abs(normal.z), 1e-6);\n";
+        srcFragmentShader << "        vec2 e = N.xy;\n";
+        srcFragmentShader << "        if (N.z < 0.0) {\n";
+        srcFragmentShader << "            e = (1.0 - abs(N.yx)) * vec2(N.x >= 0.0 ? 1.0 : -1.0, N.y >= 0.0 ? 1.0 : -1.0);\n";
+        srcFragmentShader << "        }\n";
+        srcFragmentShader << "        glFragData[2] = vec4(e, 0.0, 0.0);\n";
+        srcFragmentShader << "    }\n";
+        srcFragmentShader << "}\n";
+    } else {
+        srcFragmentShader << "out vec4 glFragData[4];\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "// remplit le g-buffer\n";
+        srcFragmentShader << "void writeGBuffer(vec4 Kd, vec4 KsNs, vec4 position, vec4 normal)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    glFragData[0] = Kd;\n";
+        srcFragmentShader << "    glFragData[1] = KsNs;\n";
+        srcFragmentShader << "    glFragData[2] = position;\n";
+        srcFragmentShader << "    glFragData[3] = normal;\n";
+        srcFragmentShader << "}\n";
+    }
+    return srcFragmentShader.str();
+}
+
+
+/**
+ * retourne les textures GLSL du g-buffer et les fonctions readDiffuse,
+ * readSpecular, readPosition et readNormal qui les décodent
+ * @return source GLSL à insérer avant la fonction main
+ */
+std::string GBuffer::getDecoderShader()
+{
+    std::ostringstream srcFragmentShader;
+    if (m_CurrentLayout == LAYOUT_COMPACT) {
+        srcFragmentShader << "uniform sampler2D MapDiffuse;\n";
+        srcFragmentShader << "uniform sampler2D MapSpecular;\n";
+        srcFragmentShader << "uniform sampler2D MapNormale;\n";
+        srcFragmentShader << "uniform highp sampler2D MapDepth;\n";
+        srcFragmentShader << "uniform highp mat4 mat4InvProjection;\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readDiffuse(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    return texture(MapDiffuse, texcoord);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readSpecular(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    vec4 Ks = texture(MapSpecular, texcoord);\n";
+        srcFragmentShader << "    return vec4(Ks.rgb, exp2(Ks.a * 10.0) - 1.0);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "highp vec4 readPosition(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    // la profondeur vaut 1.0 là où rien n'a été dessiné\n";
+        srcFragmentShader << "    highp float depth = texture(MapDepth, texcoord).r;\n";
+        srcFragmentShader << "    if (depth >= 1.0) return vec4(0.0);\n";
+        srcFragmentShader << "    // coordonnées normalisées du fragment, ramenées dans le repère caméra\n";
+        srcFragmentShader << "    highp vec4 position = mat4InvProjection * vec4(vec3(texcoord, depth) * 2.0 - 1.0, 1.0);\n";
+        srcFragmentShader << "    return vec4(position.xyz / position.w, 1.0);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readNormal(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    vec2 e = texture(MapNormale, texcoord).xy;\n";
+        srcFragmentShader << "    if (e.x > 1.5) return vec4(0.0, 0.0, 0.0, 1.0);\n";
+        srcFragmentShader << "    // repli de la moitié arrière de l'octaèdre\n";
+        srcFragmentShader << "    vec3 N = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n";
+        srcFragmentShader << "    float t = max(-N.z, 0.0);\n";
+        srcFragmentShader << "    N.xy += vec2(N.x >= 0.0 ? -t : t, N.y >= 0.0 ? -t : t);\n";
+        srcFragmentShader << "    return vec4(normalize(N), 0.0);\n";
+        srcFragmentShader << "}\n";
+    } else {
+        srcFragmentShader << "uniform sampler2D MapDiffuse;\n";
+        srcFragmentShader << "uniform sampler2D MapSpecular;\n";
+        srcFragmentShader << "uniform sampler2D MapPosition;\n";
+        srcFragmentShader << "uniform sampler2D MapNormale;\n";
+        srcFragmentShader << "uniform sampler2D MapDepth;\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readDiffuse(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    return texture(MapDiffuse, texcoord);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readSpecular(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    return texture(MapSpecular, texcoord);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readPosition(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    return texture(MapPosition, texcoord);\n";
+        srcFragmentShader << "}\n";
+        srcFragmentShader << "\n";
+        srcFragmentShader << "vec4 readNormal(vec2 texcoord)\n";
+        srcFragmentShader << "{\n";
+        srcFragmentShader << "    return texture(MapNormale, texcoord);\n";
+        srcFragmentShader << "}\n";
+    }
+    return srcFragmentShader.str();
+}
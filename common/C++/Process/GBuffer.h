@@ -0,0 +1,130 @@
+#ifndef PROCESS_GBUFFER_H
+#define PROCESS_GBUFFER_H
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <string>
+
+#include <gl-matrix.h>
+#include <utils.h>
+#include <FrameBufferObject.h>
+
+
+/**
+ * C'est un FBO particulier, destiné au dessin différé (deferred shading). Il contient
+ * les informations de la scène à éclairer : couleur diffuse, couleur spéculaire et Ns,
+ * position et normale des fragments.
+ *
+ * Deux organisations sont possibles, choisies par GBuffer::setLayout avant de créer
+ * les matériaux, les lampes et les scènes :
+ * - LAYOUT_FLOAT : 4 color buffers GL_RGBA32F (diffuse, spéculaire+Ns, position, normale)
+ *   et un depth buffer, soit 68 octets par pixel
+ * - LAYOUT_COMPACT : diffuse GL_RGBA8, spéculaire GL_RGBA8 avec Ns codé dans le canal alpha,
+ *   normale GL_RG16F codée en octaèdre et un depth buffer GL_DEPTH_COMPONENT24, soit
+ *   16 octets par pixel ; la position est recalculée à partir de la profondeur.
+ *
+ * Les shaders des matériaux écrivent dans le g-buffer avec la fonction GLSL writeGBuffer
+ * fournie par getEncoderShader() et ceux des lampes lisent les informations avec les
+ * fonctions readDiffuse, readSpecular, readPosition et readNormal de getDecoderShader().
+ */
+class GBuffer: public FrameBufferObject
+{
+public:
+
+    /**
+     * constructeur de la classe GBuffer
+     * @param width : largeur du FBO (nombre de pixels)
+     * @param height : hauteur du FBO
+     * @param layout : organisation des buffers, LAYOUT_FLOAT ou LAYOUT_COMPACT
+     */
+    GBuffer(int width, int height, int layout=getLayout());
+
+    /** destructeur */
+    virtual ~GBuffer();
+
+    /**
+     * retourne l'organisation des buffers de ce g-buffer
+     * @return LAYOUT_FLOAT ou LAYOUT_COMPACT
+     */
+    int getBufferLayout();
+
+    /**
+     * retourne le nombre d'octets occupés par un pixel de ce g-buffer, tous buffers confondus
+     * @return nombre d'octets par pixel
+     */
+    int getBytesPerPixel();
+
+    /**
+     * mémorise la matrice de projection avec laquelle la scène est dessinée dans ce g-buffer,
+     * elle sert à retrouver la position des fragments à partir de leur profondeur
+     * @param mat4Projection : matrice de projection
+     */
+    void setProjection(const mat4& mat4Projection);
+
+    /**
+     * retourne la matrice de projection fournie à setProjection
+     * @return matrice de projection
+     */
+    mat4& getProjection();
+
+    /**
+     * retourne l'inverse de la matrice de projection fournie à setProjection
+     * @return inverse de la matrice de projection
+     */
+    mat4& getInverseProjection();
+
+    /**
+     * choisit l'organisation des g-buffers créés par la suite, ainsi que celle
+     * qu'attendent les shaders des matériaux et des lampes compilés par la suite
+     * @param layout : LAYOUT_FLOAT ou LAYOUT_COMPACT
+     */
+    static void setLayout(int layout);
+
+    /**
+     * retourne l'organisation courante des g-buffers
+     * @return LAYOUT_FLOAT ou LAYOUT_COMPACT
+     */
+    static int getLayout();
+
+    /**
+     * retourne les déclarations GLSL des sorties d'un fragment shader qui dessine dans le
+     * g-buffer, et la fonction writeGBuffer(vec4 Kd, vec4 KsNs, vec4 position, vec4 normal)
+     * qui les remplit ; normal.w != 0 indique un fragment éclairé en diffus uniquement
+     * @return source GLSL à insérer avant la fonction main
+     */
+    static std::string getEncoderShader();
+
+    /**
+     * retourne les déclarations GLSL des textures du g-buffer et les fonctions readDiffuse,
+     * readSpecular, readPosition et readNormal qui les décodent pour une coordonnée de texture ;
+     * elles retournent les mêmes valeurs que celles fournies à writeGBuffer, sauf la position
+     * dont w vaut 1.0 si un fragment a été dessiné, 0.0 sinon
+     * @return source GLSL à insérer avant la fonction main
+     */
+    static std::string getDecoderShader();
+
+    /// organisations possibles des buffers
+    static const int LAYOUT_FLOAT = 0;
+    static const int LAYOUT_COMPACT = 1;
+
+    /// numéros des color buffers dans l'organisation compacte
+    static const int COMPACT_DIFFUSE = 0;
+    static const int COMPACT_SPECULAR = 1;
+    static const int COMPACT_NORMAL = 2;
+
+protected:
+
+    /// organisation des buffers de ce g-buffer
+    int m_Layout;
+
+    /// matrice de projection de la scène et son inverse
+    mat4 m_Mat4Projection;
+    mat4 m_Mat4InvProjection;
+
+    /// organisation des g-buffers et des shaders créés par la suite
+    static int m_CurrentLayout;
+};
+
+
+#endif
@@ -12,6 +12,8 @@
 #include <utils.h>
 
 #include <GaussianBlur.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -211,8 +213,9 @@ void GaussianBlur::process(FrameBufferObject* fbo, float radius)
     // désactiver le test du depth buffer
     glDisable(GL_DEPTH_TEST);
 
-    // activer le shader horizontal
-    glUseProgram(m_HorizShaderId);
+    // activer le shader horizontal, les VBO sont liés sans VAO
+    GLState::useProgram(m_HorizShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glEnableVertexAttribArray(m_HorizVertexLoc);
@@ -229,9 +232,11 @@ void GaussianBlur::process(FrameBufferObject* fbo, float radius)
 
     // fournir les paramètres du flou
     glUniform1f(m_HorizTexelSizeLoc, radius/fbo->getWidth());
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver les textures
     setTextureUnit(GL_TEXTURE0);
@@ -246,8 +251,9 @@ void GaussianBlur::process(FrameBufferObject* fbo, float radius)
 
     // Deuxième phase : flouter verticalement le précédent FBO
 
-    // activer le shader vertical
-    glUseProgram(m_VertiShaderId);
+    // activer le shader vertical, les VBO sont liés sans VAO
+    GLState::useProgram(m_VertiShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le buffer contenant les coordonnées
     glEnableVertexAttribArray(m_VertiVertexLoc);
@@ -264,9 +270,11 @@ void GaussianBlur::process(FrameBufferObject* fbo, float radius)
 
     // fournir les paramètres du flou
     glUniform1f(m_VertiTexelSizeLoc, radius/fbo->getHeight());
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver les textures
     setTextureUnit(GL_TEXTURE0);
@@ -276,8 +284,6 @@ void GaussianBlur::process(FrameBufferObject* fbo, float radius)
     glDisableVertexAttribArray(m_VertiVertexLoc);
     glDisableVertexAttribArray(m_VertiTexCoordLoc);
 
-    // désactiver le shader
-    glUseProgram(0);
 
     // réactiver le test du depth buffer
     glEnable(GL_DEPTH_TEST);
@@ -10,6 +10,7 @@
 #include <utils.h>
 
 #include <LuminosityContrast.h>
+#include <Profiler.h>
 
 
 /**
@@ -98,10 +99,13 @@ void LuminosityContrast::process(FrameBufferObject* fbo, float luminosity, float
 
     // fournir les paramètres du shader
     glUniform1f(m_LuminosityLoc, luminosity);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
     glUniform1f(m_ContrastLoc, contrast);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver les textures
     setTextureUnit(GL_TEXTURE0);
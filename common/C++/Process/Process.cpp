@@ -9,6 +9,8 @@
 #include <utils.h>
 
 #include <Process.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 // VBO pour dessiner un rectangle occupant tout l'écran
@@ -119,8 +121,11 @@ void Process::findUniformLocations()
  */
 void Process::startProcess()
 {
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    PROFILE_ZONE("Process::startProcess");
+
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // activer et lier le VBO contenant les coordonnées
     glEnableVertexAttribArray(m_VertexLoc);
@@ -144,8 +149,6 @@ void Process::endProcess()
     glDisableVertexAttribArray(m_VertexLoc);
     glDisableVertexAttribArray(m_TexCoordLoc);
 
-    // désactiver le shader
-    glUseProgram(0);
 }
 
 
@@ -163,11 +166,11 @@ void Process::setTextureUnit(GLint unit, GLint locSampler, GLuint bufferId)
         throw std::invalid_argument("Process::setTextureUnit: first parameter, unit is not GL_TEXTURE0 ... GL_TEXTURE7");
     }
     /*****DEBUG*****/
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
     if (locSampler < 0 || bufferId <= 0) {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D, bufferId);
-        glUniform1i(locSampler, unit-GL_TEXTURE0);
+        GLState::bindTexture(GL_TEXTURE_2D, bufferId);
+        GLState::uniformSampler(locSampler, unit);
     }
 }
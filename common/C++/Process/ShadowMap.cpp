@@ -12,6 +12,8 @@
 #include <math.h>
 
 #include <ShadowMap.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 
 /**
@@ -56,14 +58,16 @@ void ShadowMap::setAcneReduction(bool offsetfill, GLenum cullface)
  */
 void ShadowMap::enable()
 {
+    PROFILE_ZONE("ShadowMap::enable");
+
     // activer le FBO
     FrameBufferObject::enable();
 
     // (optionnel) éliminer les faces avant, afin d'éviter l'acné de surface
-    glGetIntegerv(GL_CULL_FACE_MODE, &m_CullFacePrec);
+    m_CullFacePrec = GLState::getCullFace();
     if (m_CullFace != GL_NONE) {
         glEnable(GL_CULL_FACE);
-        glCullFace(m_CullFace);
+        GLState::cullFace(m_CullFace);
     }
 
     // (optionnel) décalage de polygones, afin d'éviter l'acné de surface
@@ -86,7 +90,7 @@ void ShadowMap::disable()
     FrameBufferObject::disable();
 
     // remettre les modes tels qu'ils étaient avant
-    glCullFace(m_CullFacePrec);
+    GLState::cullFace(m_CullFacePrec);
 
     // annuler le décalage
     glPolygonOffset(0.0, 0.0);
@@ -109,12 +113,12 @@ void ShadowMap::setTextureUnit(GLint unit, GLint locSampler)
     /*****DEBUG*****/
 
     // activer la shadow map en tant que texture
-    glActiveTexture(unit);
+    GLState::activeTexture(unit);
     if (locSampler < 0) {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::bindTexture(GL_TEXTURE_2D, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D, m_DepthBufferId);
-        glUniform1i(locSampler, unit-GL_TEXTURE0);
+        GLState::bindTexture(GL_TEXTURE_2D, m_DepthBufferId);
+        GLState::uniformSampler(locSampler, unit);
     }
 }
 
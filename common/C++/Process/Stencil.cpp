@@ -4,6 +4,8 @@
 #include <utils.h>
 
 #include <Stencil.h>
+#include <Profiler.h>
+#include <GLState.h>
 
 /**
  * Cette classe statique fournir des méthodes pour travailler avec les stencils.
@@ -132,7 +134,7 @@ void Stencil::use(int seuil)
     glDepthMask(GL_TRUE);                                  // réactiver l'écriture sur le depth buffer
 
     // repasser en mode normal, avec le stencil actif pour dessiner
-    glDepthFunc(GL_LESS);                                  // test normal du depth buffer
+    GLState::depthFunc(GL_LESS);                                  // test normal du depth buffer
     glDepthRange(0.0, 1.0);                                // plage complète
     glStencilFunc(GL_LEQUAL, seuil, 0xFF);                 // On testera si le stencil est au moins égal au seuil
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
@@ -149,7 +151,7 @@ void Stencil::disable()
     glStencilMask(0x00);                                   // ne pas modifier le stencil
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);       // réactiver le dessin sur l'écran
     glDepthMask(GL_TRUE);                                  // réactiver l'écriture sur le depth buffer
-    glDepthFunc(GL_LESS);                                  // test normal du depth buffer
+    GLState::depthFunc(GL_LESS);                                  // test normal du depth buffer
 }
 
 
@@ -162,18 +164,20 @@ void Stencil::clearScreen(int seuil)
 {
     // configurer le stencil
     glDepthRange(1.0, 1.0);                                // on va mettre des 1 partout dans le depth buffer
-    glDepthFunc(GL_ALWAYS);                                // forcer la modification partout
+    GLState::depthFunc(GL_ALWAYS);                                // forcer la modification partout
     glStencilFunc(GL_EQUAL, seuil, 0xFF);                  // accepter tous les fragments dans ce stencil
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);                // fonctions pour affecter le contenu du stencil
     glStencilMask(0xFF);                                   // modifier le stencil
 
-    // activer le shader
-    glUseProgram(m_ShaderId);
+    // activer le shader, les VBO sont liés sans VAO
+    GLState::useProgram(m_ShaderId);
+    GLState::bindVertexArray(0);
 
     // fournir la couleur d'effacement de l'écran
     GLfloat color[4];
     glGetFloatv(GL_COLOR_CLEAR_VALUE, color);
     glUniform4fv(m_ColorLoc, 1, color);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // activer et lier le buffer contenant les coordonnées
     glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferId);
@@ -182,11 +186,10 @@ void Stencil::clearScreen(int seuil)
 
     // dessiner un quad qui remplit tout l'écran
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver le buffer
     glDisableVertexAttribArray(m_VertexLoc);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // désactiver le shader
-    glUseProgram(0);
 }
@@ -9,6 +9,7 @@
 #include <utils.h>
 
 #include <Threshold.h>
+#include <Profiler.h>
 
 
 /**
@@ -91,9 +92,11 @@ void Threshold::process(FrameBufferObject* fbo, float threshold)
 
     // fournir les paramètres du shader
     glUniform1f(m_ThresholdLoc, threshold);
+    PROFILE_COUNT(UNIFORM_UPLOADS, 1);
 
     // dessiner un quadrilatère avec les quatre vertices
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    PROFILE_DRAW(GL_TRIANGLE_FAN, 4);
 
     // désactiver les textures
     setTextureUnit(GL_TEXTURE0);
@@ -29,6 +29,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #include <math.h>
 
 #include <gl-matrix.h>
+#include <Profiler.h>
 
 const mat2 mat2::null;
 
@@ -53,7 +54,7 @@ mat2 mat2::create()
  * @param a matrix to clone
  * @returns {mat2} a new 2x2 matrix
  */
-mat2 mat2::clone(const mat2 a)
+mat2 mat2::clone(const mat2& a)
 {
     mat2 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -70,7 +71,7 @@ mat2 mat2::clone(const mat2 a)
  * @param a the source matrix
  * @returns {mat2} out
  */
-mat2 mat2::copy(mat2& out, const mat2 a)
+mat2 mat2::copy(mat2& out, const mat2& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -140,7 +141,7 @@ mat2 mat2::set(mat2& out, const GLfloat m00, const GLfloat m01, const GLfloat m1
  * @param a the source matrix
  * @returns {mat2} out
  */
-mat2 mat2::transpose(mat2& out, const mat2 a)
+mat2 mat2::transpose(mat2& out, const mat2& a)
 {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     if (out == a) {
@@ -164,7 +165,7 @@ mat2 mat2::transpose(mat2& out, const mat2 a)
  * @param a the source matrix
  * @returns {mat2} out
  */
-mat2 mat2::invert(mat2& out, const mat2 a)
+mat2 mat2::invert(mat2& out, const mat2& a)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3],
 
@@ -191,7 +192,7 @@ mat2 mat2::invert(mat2& out, const mat2 a)
  * @param a the source matrix
  * @returns {mat2} out
  */
-mat2 mat2::adjoint(mat2& out, const mat2 a)
+mat2 mat2::adjoint(mat2& out, const mat2& a)
 {
     // Caching this value is nessecary if out == a
     GLfloat a0 = a.m_Cells[0];
@@ -209,7 +210,7 @@ mat2 mat2::adjoint(mat2& out, const mat2 a)
  * @param a the source matrix
  * @returns {Number} determinant of a
  */
-GLfloat mat2::determinant(const mat2 a)
+GLfloat mat2::determinant(const mat2& a)
 {
     return a.m_Cells[0] * a.m_Cells[3] - a.m_Cells[2] * a.m_Cells[1];
 };
@@ -222,7 +223,7 @@ GLfloat mat2::determinant(const mat2 a)
  * @param b the second operand
  * @returns {mat2} out
  */
-mat2 mat2::multiply(mat2& out, const mat2 a, const mat2 b)
+mat2 mat2::multiply(mat2& out, const mat2& a, const mat2& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3];
@@ -241,7 +242,7 @@ mat2 mat2::multiply(mat2& out, const mat2 a, const mat2 b)
  * @param rad the angle to rotate the matrix by
  * @returns {mat2} out
  */
-mat2 mat2::rotate(mat2& out, const mat2 a, const GLfloat rad)
+mat2 mat2::rotate(mat2& out, const mat2& a, const GLfloat rad)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3],
     s = sin(rad),
@@ -261,7 +262,7 @@ mat2 mat2::rotate(mat2& out, const mat2 a, const GLfloat rad)
  * @param v the vec2 to scale the matrix by
  * @returns {mat2} out
  **/
-mat2 mat2::scale(mat2& out, const mat2 a, const vec2 v)
+mat2 mat2::scale(mat2& out, const mat2& a, const vec2& v)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3],
     v0 = v.m_Cells[0], v1 = v.m_Cells[1];
@@ -305,7 +306,7 @@ mat2 mat2::fromRotation(mat2& out, const GLfloat rad)
  * @param v Scaling vector
  * @returns {mat2} out
  */
-mat2 mat2::fromScaling(mat2& out, const vec2 v)
+mat2 mat2::fromScaling(mat2& out, const vec2& v)
 {
     out.m_Cells[0] = v.m_Cells[0];
     out.m_Cells[1] = 0;
@@ -320,7 +321,7 @@ mat2 mat2::fromScaling(mat2& out, const vec2 v)
  * @param a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-GLfloat mat2::frob(const mat2 a)
+GLfloat mat2::frob(const mat2& a)
 {
     return(sqrt(pow(a.m_Cells[0], 2) + pow(a.m_Cells[1], 2) + pow(a.m_Cells[2], 2) + pow(a.m_Cells[3], 2)));
 };
@@ -333,7 +334,7 @@ GLfloat mat2::frob(const mat2 a)
  * @param b the second operand
  * @returns {mat2} out
  */
-mat2 mat2::add(mat2& out, const mat2 a, const mat2 b)
+mat2 mat2::add(mat2& out, const mat2& a, const mat2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -350,7 +351,7 @@ mat2 mat2::add(mat2& out, const mat2 a, const mat2 b)
  * @param b the second operand
  * @returns {mat2} out
  */
-mat2 mat2::subtract(mat2& out, const mat2 a, const mat2 b)
+mat2 mat2::subtract(mat2& out, const mat2& a, const mat2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -366,7 +367,7 @@ mat2 mat2::subtract(mat2& out, const mat2 a, const mat2 b)
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat2::exactEquals(const mat2 a, const mat2 b)
+bool mat2::exactEquals(const mat2& a, const mat2& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2] && a.m_Cells[3] == b.m_Cells[3];
 };
@@ -378,7 +379,7 @@ bool mat2::exactEquals(const mat2 a, const mat2 b)
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat2::equals(const mat2 a, const mat2 b)
+bool mat2::equals(const mat2& a, const mat2& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3];
@@ -396,7 +397,7 @@ bool mat2::equals(const mat2 a, const mat2 b)
  * @param b amount to scale the matrix's elements by
  * @returns {mat2} out
  */
-mat2 mat2::multiplyScalar(mat2& out, const mat2 a, const GLfloat b)
+mat2 mat2::multiplyScalar(mat2& out, const mat2& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -414,7 +415,7 @@ mat2 mat2::multiplyScalar(mat2& out, const mat2 a, const GLfloat b)
  * @param scale the amount to scale b's elements by before adding
  * @returns {mat2} out
  */
-mat2 mat2::multiplyScalarAndAdd(mat2& out, const mat2 a, const mat2 b, const GLfloat scale)
+mat2 mat2::multiplyScalarAndAdd(mat2& out, const mat2& a, const mat2& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -458,9 +459,12 @@ mat2 mat2::zero(mat2& out)
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void mat2::glUniformMatrix(const GLint loc, const mat2 a)
+void mat2::glUniformMatrix(const GLint loc, const mat2& a)
 {
-    if (loc >= 0) glUniformMatrix2fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniformMatrix2fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const mat2d mat2d::null;
@@ -488,7 +492,7 @@ mat2d mat2d::create()
  * @param a matrix to clone
  * @returns {mat2d} a new 2x3 matrix
  */
-mat2d mat2d::clone(const mat2d a)
+mat2d mat2d::clone(const mat2d& a)
 {
     mat2d out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -507,7 +511,7 @@ mat2d mat2d::clone(const mat2d a)
  * @param a the source matrix
  * @returns {mat2d} out
  */
-mat2d mat2d::copy(mat2d& out, const mat2d a)
+mat2d mat2d::copy(mat2d& out, const mat2d& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -588,7 +592,7 @@ mat2d mat2d::set(mat2d& out, const GLfloat a, const GLfloat b, const GLfloat c,
  * @param a the source matrix
  * @returns {mat2d} out
  */
-mat2d mat2d::invert(mat2d& out, const mat2d a)
+mat2d mat2d::invert(mat2d& out, const mat2d& a)
 {
     GLfloat aa = a.m_Cells[0], ab = a.m_Cells[1], ac = a.m_Cells[2], ad = a.m_Cells[3],
     atx = a.m_Cells[4], aty = a.m_Cells[5];
@@ -614,7 +618,7 @@ mat2d mat2d::invert(mat2d& out, const mat2d a)
  * @param a the source matrix
  * @returns {Number} determinant of a
  */
-GLfloat mat2d::determinant(const mat2d a)
+GLfloat mat2d::determinant(const mat2d& a)
 {
     return a.m_Cells[0] * a.m_Cells[3] - a.m_Cells[1] * a.m_Cells[2];
 };
@@ -627,7 +631,7 @@ GLfloat mat2d::determinant(const mat2d a)
  * @param b the second operand
  * @returns {mat2d} out
  */
-mat2d mat2d::multiply(mat2d& out, const mat2d a, const mat2d b)
+mat2d mat2d::multiply(mat2d& out, const mat2d& a, const mat2d& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5],
     b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3], b4 = b.m_Cells[4], b5 = b.m_Cells[5];
@@ -648,7 +652,7 @@ mat2d mat2d::multiply(mat2d& out, const mat2d a, const mat2d b)
  * @param rad the angle to rotate the matrix by
  * @returns {mat2d} out
  */
-mat2d mat2d::rotate(mat2d& out, const mat2d a, const GLfloat rad)
+mat2d mat2d::rotate(mat2d& out, const mat2d& a, const GLfloat rad)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5],
     s = sin(rad),
@@ -670,7 +674,7 @@ mat2d mat2d::rotate(mat2d& out, const mat2d a, const GLfloat rad)
  * @param v the vec2 to scale the matrix by
  * @returns {mat2d} out
  **/
-mat2d mat2d::scale(mat2d& out, const mat2d a, const vec2 v)
+mat2d mat2d::scale(mat2d& out, const mat2d& a, const vec2& v)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5],
     v0 = v.m_Cells[0], v1 = v.m_Cells[1];
@@ -691,7 +695,7 @@ mat2d mat2d::scale(mat2d& out, const mat2d a, const vec2 v)
  * @param v the vec2 to translate the matrix by
  * @returns {mat2d} out
  **/
-mat2d mat2d::translate(mat2d& out, const mat2d a, const vec2 v)
+mat2d mat2d::translate(mat2d& out, const mat2d& a, const vec2& v)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5],
     v0 = v.m_Cells[0], v1 = v.m_Cells[1];
@@ -738,7 +742,7 @@ mat2d mat2d::fromRotation(mat2d& out, const GLfloat rad)
  * @param v Scaling vector
  * @returns {mat2d} out
  */
-mat2d mat2d::fromScaling(mat2d& out, const vec2 v)
+mat2d mat2d::fromScaling(mat2d& out, const vec2& v)
 {
     out.m_Cells[0] = v.m_Cells[0];
     out.m_Cells[1] = 0;
@@ -760,7 +764,7 @@ mat2d mat2d::fromScaling(mat2d& out, const vec2 v)
  * @param v Translation vector
  * @returns {mat2d} out
  */
-mat2d mat2d::fromTranslation(mat2d& out, const vec2 v)
+mat2d mat2d::fromTranslation(mat2d& out, const vec2& v)
 {
     out.m_Cells[0] = 1;
     out.m_Cells[1] = 0;
@@ -777,7 +781,7 @@ mat2d mat2d::fromTranslation(mat2d& out, const vec2 v)
  * @param a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-GLfloat mat2d::frob(const mat2d a)
+GLfloat mat2d::frob(const mat2d& a)
 {
     return(sqrt(pow(a.m_Cells[0], 2) + pow(a.m_Cells[1], 2) + pow(a.m_Cells[2], 2) + pow(a.m_Cells[3], 2) + pow(a.m_Cells[4], 2) + pow(a.m_Cells[5], 2) + 1));
 };
@@ -790,7 +794,7 @@ GLfloat mat2d::frob(const mat2d a)
  * @param b the second operand
  * @returns {mat2d} out
  */
-mat2d mat2d::add(mat2d& out, const mat2d a, const mat2d b)
+mat2d mat2d::add(mat2d& out, const mat2d& a, const mat2d& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -809,7 +813,7 @@ mat2d mat2d::add(mat2d& out, const mat2d a, const mat2d b)
  * @param b the second operand
  * @returns {mat2d} out
  */
-mat2d mat2d::subtract(mat2d& out, const mat2d a, const mat2d b)
+mat2d mat2d::subtract(mat2d& out, const mat2d& a, const mat2d& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -828,7 +832,7 @@ mat2d mat2d::subtract(mat2d& out, const mat2d a, const mat2d b)
  * @param b amount to scale the matrix's elements by
  * @returns {mat2d} out
  */
-mat2d mat2d::multiplyScalar(mat2d& out, const mat2d a, const GLfloat b)
+mat2d mat2d::multiplyScalar(mat2d& out, const mat2d& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -848,7 +852,7 @@ mat2d mat2d::multiplyScalar(mat2d& out, const mat2d a, const GLfloat b)
  * @param scale the amount to scale b's elements by before adding
  * @returns {mat2d} out
  */
-mat2d mat2d::multiplyScalarAndAdd(mat2d& out, const mat2d a, const mat2d b, const GLfloat scale)
+mat2d mat2d::multiplyScalarAndAdd(mat2d& out, const mat2d& a, const mat2d& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -866,7 +870,7 @@ mat2d mat2d::multiplyScalarAndAdd(mat2d& out, const mat2d a, const mat2d b, cons
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat2d::exactEquals(const mat2d a, const mat2d b)
+bool mat2d::exactEquals(const mat2d& a, const mat2d& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2] && a.m_Cells[3] == b.m_Cells[3] && a.m_Cells[4] == b.m_Cells[4] && a.m_Cells[5] == b.m_Cells[5];
 };
@@ -878,7 +882,7 @@ bool mat2d::exactEquals(const mat2d a, const mat2d b)
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat2d::equals(const mat2d a, const mat2d b)
+bool mat2d::equals(const mat2d& a, const mat2d& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3], b4 = b.m_Cells[4], b5 = b.m_Cells[5];
@@ -950,7 +954,7 @@ mat3 mat3::create()
  * @param a   the source 4x4 matrix
  * @returns {mat3} out
  */
-mat3 mat3::fromMat4(mat3& out, const mat4 a)
+mat3 mat3::fromMat4(mat3& out, const mat4& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -970,7 +974,7 @@ mat3 mat3::fromMat4(mat3& out, const mat4 a)
  * @param a matrix to clone
  * @returns {mat3} a new 3x3 matrix
  */
-mat3 mat3::clone(const mat3 a)
+mat3 mat3::clone(const mat3& a)
 {
     mat3 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -992,7 +996,7 @@ mat3 mat3::clone(const mat3 a)
  * @param a the source matrix
  * @returns {mat3} out
  */
-mat3 mat3::copy(mat3& out, const mat3 a)
+mat3 mat3::copy(mat3& out, const mat3& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -1091,7 +1095,7 @@ mat3 mat3::identity(mat3& out)
  * @param a the source matrix
  * @returns {mat3} out
  */
-mat3 mat3::transpose(mat3& out, const mat3 a)
+mat3 mat3::transpose(mat3& out, const mat3& a)
 {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     if (out == a) {
@@ -1124,7 +1128,7 @@ mat3 mat3::transpose(mat3& out, const mat3 a)
  * @param a the source matrix
  * @returns {mat3} out
  */
-mat3 mat3::invert(mat3& out, const mat3 a)
+mat3 mat3::invert(mat3& out, const mat3& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1161,7 +1165,7 @@ mat3 mat3::invert(mat3& out, const mat3 a)
  * @param a the source matrix
  * @returns {mat3} out
  */
-mat3 mat3::adjoint(mat3& out, const mat3 a)
+mat3 mat3::adjoint(mat3& out, const mat3& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1185,7 +1189,7 @@ mat3 mat3::adjoint(mat3& out, const mat3 a)
  * @param a the source matrix
  * @returns {Number} determinant of a
  */
-GLfloat mat3::determinant(const mat3 a)
+GLfloat mat3::determinant(const mat3& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1202,7 +1206,7 @@ GLfloat mat3::determinant(const mat3 a)
  * @param b the second operand
  * @returns {mat3} out
  */
-mat3 mat3::multiply(mat3& out, const mat3 a, const mat3 b)
+mat3 mat3::multiply(mat3& out, const mat3& a, const mat3& b)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1234,7 +1238,7 @@ mat3 mat3::multiply(mat3& out, const mat3 a, const mat3 b)
  * @param v vector to translate by
  * @returns {mat3} out
  */
-mat3 mat3::translate(mat3& out, const mat3 a, const vec2 v)
+mat3 mat3::translate(mat3& out, const mat3& a, const vec2& v)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1263,7 +1267,7 @@ mat3 mat3::translate(mat3& out, const mat3 a, const vec2 v)
  * @param rad the angle to rotate the matrix by
  * @returns {mat3} out
  */
-mat3 mat3::rotate(mat3& out, const mat3 a, const GLfloat rad)
+mat3 mat3::rotate(mat3& out, const mat3& a, const GLfloat rad)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2],
     a10 = a.m_Cells[3], a11 = a.m_Cells[4], a12 = a.m_Cells[5],
@@ -1294,7 +1298,7 @@ mat3 mat3::rotate(mat3& out, const mat3 a, const GLfloat rad)
  * @param v the vec2 to scale the matrix by
  * @returns {mat3} out
  **/
-mat3 mat3::scale(mat3& out, const mat3 a, const vec2 v)
+mat3 mat3::scale(mat3& out, const mat3& a, const vec2& v)
 {
     GLfloat x = v.m_Cells[0], y = v.m_Cells[1];
 
@@ -1323,7 +1327,7 @@ mat3 mat3::scale(mat3& out, const mat3 a, const vec2 v)
  * @param v Translation vector
  * @returns {mat3} out
  */
-mat3 mat3::fromTranslation(mat3& out, const vec2 v)
+mat3 mat3::fromTranslation(mat3& out, const vec2& v)
 {
     out.m_Cells[0] = 1;
     out.m_Cells[1] = 0;
@@ -1377,7 +1381,7 @@ mat3 mat3::fromRotation(mat3& out, const GLfloat rad)
  * @param v Scaling vector
  * @returns {mat3} out
  */
-mat3 mat3::fromScaling(mat3& out, const vec2 v)
+mat3 mat3::fromScaling(mat3& out, const vec2& v)
 {
     out.m_Cells[0] = v.m_Cells[0];
     out.m_Cells[1] = 0;
@@ -1400,7 +1404,7 @@ mat3 mat3::fromScaling(mat3& out, const vec2 v)
  * @param a the matrix to copy
  * @returns {mat3} out
  **/
-mat3 mat3::fromMat2d(mat3& out, const mat2d a)
+mat3 mat3::fromMat2d(mat3& out, const mat2d& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -1424,7 +1428,7 @@ mat3 mat3::fromMat2d(mat3& out, const mat2d a)
 *
 * @returns {mat3} out
 */
-mat3 mat3::fromQuat(mat3& out, const quat q)
+mat3 mat3::fromQuat(mat3& out, const quat& q)
 {
     GLfloat x = q.m_Cells[0], y = q.m_Cells[1], z = q.m_Cells[2], w = q.m_Cells[3],
     x2 = x + x,
@@ -1464,7 +1468,7 @@ mat3 mat3::fromQuat(mat3& out, const quat q)
 *
 * @returns {mat3} out
 */
-mat3 mat3::normalFromMat4(mat3& out, const mat4 a)
+mat3 mat3::normalFromMat4(mat3& out, const mat4& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
     a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
@@ -1513,7 +1517,7 @@ mat3 mat3::normalFromMat4(mat3& out, const mat4 a)
  * @param a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-GLfloat mat3::frob(const mat3 a)
+GLfloat mat3::frob(const mat3& a)
 {
     return(sqrt(pow(a.m_Cells[0], 2) + pow(a.m_Cells[1], 2) + pow(a.m_Cells[2], 2) + pow(a.m_Cells[3], 2) + pow(a.m_Cells[4], 2) + pow(a.m_Cells[5], 2) + pow(a.m_Cells[6], 2) + pow(a.m_Cells[7], 2) + pow(a.m_Cells[8], 2)));
 };
@@ -1526,7 +1530,7 @@ GLfloat mat3::frob(const mat3 a)
  * @param b the second operand
  * @returns {mat3} out
  */
-mat3 mat3::add(mat3& out, const mat3 a, const mat3 b)
+mat3 mat3::add(mat3& out, const mat3& a, const mat3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -1548,7 +1552,7 @@ mat3 mat3::add(mat3& out, const mat3 a, const mat3 b)
  * @param b the second operand
  * @returns {mat3} out
  */
-mat3 mat3::subtract(mat3& out, const mat3 a, const mat3 b)
+mat3 mat3::subtract(mat3& out, const mat3& a, const mat3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -1570,7 +1574,7 @@ mat3 mat3::subtract(mat3& out, const mat3 a, const mat3 b)
  * @param b amount to scale the matrix's elements by
  * @returns {mat3} out
  */
-mat3 mat3::multiplyScalar(mat3& out, const mat3 a, const GLfloat b)
+mat3 mat3::multiplyScalar(mat3& out, const mat3& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -1593,7 +1597,7 @@ mat3 mat3::multiplyScalar(mat3& out, const mat3 a, const GLfloat b)
  * @param scale the amount to scale b's elements by before adding
  * @returns {mat3} out
  */
-mat3 mat3::multiplyScalarAndAdd(mat3& out, const mat3 a, const mat3 b, const GLfloat scale)
+mat3 mat3::multiplyScalarAndAdd(mat3& out, const mat3& a, const mat3& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -1614,7 +1618,7 @@ mat3 mat3::multiplyScalarAndAdd(mat3& out, const mat3 a, const mat3 b, const GLf
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat3::exactEquals(const mat3 a, const mat3 b)
+bool mat3::exactEquals(const mat3& a, const mat3& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2] &&
     a.m_Cells[3] == b.m_Cells[3] && a.m_Cells[4] == b.m_Cells[4] && a.m_Cells[5] == b.m_Cells[5] &&
@@ -1628,7 +1632,7 @@ bool mat3::exactEquals(const mat3 a, const mat3 b)
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat3::equals(const mat3 a, const mat3 b)
+bool mat3::equals(const mat3& a, const mat3& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3], a4 = a.m_Cells[4], a5 = a.m_Cells[5], a6 = a.m_Cells[6], a7 = a.m_Cells[7], a8 = a.m_Cells[8];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3], b4 = b.m_Cells[4], b5 = b.m_Cells[5], b6 = b.m_Cells[6], b7 = b.m_Cells[7], b8 = b.m_Cells[8];
@@ -1684,9 +1688,12 @@ mat3 mat3::zero(mat3& out)
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void mat3::glUniformMatrix(const GLint loc, const mat3 a)
+void mat3::glUniformMatrix(const GLint loc, const mat3& a)
 {
-    if (loc >= 0) glUniformMatrix3fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniformMatrix3fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const mat4 mat4::null;
@@ -1724,7 +1731,7 @@ mat4 mat4::create()
  * @param a matrix to clone
  * @returns {mat4} a new 4x4 matrix
  */
-mat4 mat4::clone(const mat4 a)
+mat4 mat4::clone(const mat4& a)
 {
     mat4 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -1753,7 +1760,7 @@ mat4 mat4::clone(const mat4 a)
  * @param a the source matrix
  * @returns {mat4} out
  */
-mat4 mat4::copy(mat4& out, const mat4 a)
+mat4 mat4::copy(mat4& out, const mat4& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -1895,7 +1902,7 @@ mat4 mat4::identity(mat4& out)
  * @param a the source matrix
  * @returns {mat4} out
  */
-mat4 mat4::transpose(mat4& out, const mat4 a)
+mat4 mat4::transpose(mat4& out, const mat4& a)
 {
     // If we are transposing ourselves we can skip a few steps but have to cache some values
     if (out == a) {
@@ -1944,53 +1951,6 @@ mat4 mat4::transpose(mat4& out, const mat4 a)
  * @param a the source matrix
  * @returns {mat4} out
  */
-mat4 mat4::invert(mat4& out, const mat4 a)
-{
-    GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
-    a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
-    a20 = a.m_Cells[8], a21 = a.m_Cells[9], a22 = a.m_Cells[10], a23 = a.m_Cells[11],
-    a30 = a.m_Cells[12], a31 = a.m_Cells[13], a32 = a.m_Cells[14], a33 = a.m_Cells[15],
-
-    b00 = a00 * a11 - a01 * a10,
-    b01 = a00 * a12 - a02 * a10,
-    b02 = a00 * a13 - a03 * a10,
-    b03 = a01 * a12 - a02 * a11,
-    b04 = a01 * a13 - a03 * a11,
-    b05 = a02 * a13 - a03 * a12,
-    b06 = a20 * a31 - a21 * a30,
-    b07 = a20 * a32 - a22 * a30,
-    b08 = a20 * a33 - a23 * a30,
-    b09 = a21 * a32 - a22 * a31,
-    b10 = a21 * a33 - a23 * a31,
-    b11 = a22 * a33 - a23 * a32,
-
-    // Calculate the determinant
-    det = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
-
-    if (!det) {
-        return null;
-    }
-    det = 1.0 / det;
-
-    out.m_Cells[0] = (a11 * b11 - a12 * b10 + a13 * b09) * det;
-    out.m_Cells[1] = (a02 * b10 - a01 * b11 - a03 * b09) * det;
-    out.m_Cells[2] = (a31 * b05 - a32 * b04 + a33 * b03) * det;
-    out.m_Cells[3] = (a22 * b04 - a21 * b05 - a23 * b03) * det;
-    out.m_Cells[4] = (a12 * b08 - a10 * b11 - a13 * b07) * det;
-    out.m_Cells[5] = (a00 * b11 - a02 * b08 + a03 * b07) * det;
-    out.m_Cells[6] = (a32 * b02 - a30 * b05 - a33 * b01) * det;
-    out.m_Cells[7] = (a20 * b05 - a22 * b02 + a23 * b01) * det;
-    out.m_Cells[8] = (a10 * b10 - a11 * b08 + a13 * b06) * det;
-    out.m_Cells[9] = (a01 * b08 - a00 * b10 - a03 * b06) * det;
-    out.m_Cells[10] = (a30 * b04 - a31 * b02 + a33 * b00) * det;
-    out.m_Cells[11] = (a21 * b02 - a20 * b04 - a23 * b00) * det;
-    out.m_Cells[12] = (a11 * b07 - a10 * b09 - a12 * b06) * det;
-    out.m_Cells[13] = (a00 * b09 - a01 * b07 + a02 * b06) * det;
-    out.m_Cells[14] = (a31 * b01 - a30 * b03 - a32 * b00) * det;
-    out.m_Cells[15] = (a20 * b03 - a21 * b01 + a22 * b00) * det;
-
-    return out;
-};
 
 /**
  * Calculates the adjugate of a mat4 not using SIMD
@@ -1999,7 +1959,7 @@ mat4 mat4::invert(mat4& out, const mat4 a)
  * @param a the source matrix
  * @returns {mat4} out
  */
-mat4 mat4::adjoint(mat4& out, const mat4 a)
+mat4 mat4::adjoint(mat4& out, const mat4& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
     a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
@@ -2031,7 +1991,7 @@ mat4 mat4::adjoint(mat4& out, const mat4 a)
  * @param a the source matrix
  * @returns {Number} determinant of a
  */
-GLfloat mat4::determinant(const mat4 a)
+GLfloat mat4::determinant(const mat4& a)
 {
     GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
     a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
@@ -2063,39 +2023,6 @@ GLfloat mat4::determinant(const mat4 a)
  * @param b the second operand
  * @returns {mat4} out
  */
-mat4 mat4::multiply(mat4& out, const mat4 a, const mat4 b)
-{
-    GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
-    a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
-    a20 = a.m_Cells[8], a21 = a.m_Cells[9], a22 = a.m_Cells[10], a23 = a.m_Cells[11],
-    a30 = a.m_Cells[12], a31 = a.m_Cells[13], a32 = a.m_Cells[14], a33 = a.m_Cells[15];
-
-    // Cache only the current line of the second matrix
-    GLfloat b0  = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3];
-    out.m_Cells[0] = b0*a00 + b1*a10 + b2*a20 + b3*a30;
-    out.m_Cells[1] = b0*a01 + b1*a11 + b2*a21 + b3*a31;
-    out.m_Cells[2] = b0*a02 + b1*a12 + b2*a22 + b3*a32;
-    out.m_Cells[3] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
-
-    b0 = b.m_Cells[4]; b1 = b.m_Cells[5]; b2 = b.m_Cells[6]; b3 = b.m_Cells[7];
-    out.m_Cells[4] = b0*a00 + b1*a10 + b2*a20 + b3*a30;
-    out.m_Cells[5] = b0*a01 + b1*a11 + b2*a21 + b3*a31;
-    out.m_Cells[6] = b0*a02 + b1*a12 + b2*a22 + b3*a32;
-    out.m_Cells[7] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
-
-    b0 = b.m_Cells[8]; b1 = b.m_Cells[9]; b2 = b.m_Cells[10]; b3 = b.m_Cells[11];
-    out.m_Cells[8] = b0*a00 + b1*a10 + b2*a20 + b3*a30;
-    out.m_Cells[9] = b0*a01 + b1*a11 + b2*a21 + b3*a31;
-    out.m_Cells[10] = b0*a02 + b1*a12 + b2*a22 + b3*a32;
-    out.m_Cells[11] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
-
-    b0 = b.m_Cells[12]; b1 = b.m_Cells[13]; b2 = b.m_Cells[14]; b3 = b.m_Cells[15];
-    out.m_Cells[12] = b0*a00 + b1*a10 + b2*a20 + b3*a30;
-    out.m_Cells[13] = b0*a01 + b1*a11 + b2*a21 + b3*a31;
-    out.m_Cells[14] = b0*a02 + b1*a12 + b2*a22 + b3*a32;
-    out.m_Cells[15] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
-    return out;
-};
 
 /**
  * Translate a mat4 by the given vector not using SIMD
@@ -2105,7 +2032,7 @@ mat4 mat4::multiply(mat4& out, const mat4 a, const mat4 b)
  * @param v vector to translate by
  * @returns {mat4} out
  */
-mat4 mat4::translate(mat4& out, const mat4 a, const vec3 v)
+mat4 mat4::translate(mat4& out, const mat4& a, const vec3& v)
 {
     GLfloat x = v.m_Cells[0], y = v.m_Cells[1], z = v.m_Cells[2],
     a00, a01, a02, a03,
@@ -2143,7 +2070,7 @@ mat4 mat4::translate(mat4& out, const mat4 a, const vec3 v)
  * @param v the vec3 to scale the matrix by
  * @returns {mat4} out
  **/
-mat4 mat4::scale(mat4& out, const mat4 a, const vec3 v)
+mat4 mat4::scale(mat4& out, const mat4& a, const vec3& v)
 {
     GLfloat x = v.m_Cells[0], y = v.m_Cells[1], z = v.m_Cells[2];
 
@@ -2175,7 +2102,7 @@ mat4 mat4::scale(mat4& out, const mat4 a, const vec3 v)
  * @param axis the axis to rotate around
  * @returns {mat4} out
  */
-mat4 mat4::rotate(mat4& out, const mat4 a, const GLfloat rad, const vec3 axis)
+mat4 mat4::rotate(mat4& out, const mat4& a, const GLfloat rad, const vec3& axis)
 {
     GLfloat x = axis.m_Cells[0], y = axis.m_Cells[1], z = axis.m_Cells[2],
     len = sqrt(x * x + y * y + z * z),
@@ -2238,7 +2165,7 @@ if (fabs(len) < GLMAT_EPSILON) { return null; }
  * @param rad the angle to rotate the matrix by
  * @returns {mat4} out
  */
-mat4 mat4::rotateX(mat4& out, const mat4 a, const GLfloat rad)
+mat4 mat4::rotateX(mat4& out, const mat4& a, const GLfloat rad)
 {
     GLfloat s = sin(rad),
     c = cos(rad),
@@ -2282,7 +2209,7 @@ mat4 mat4::rotateX(mat4& out, const mat4 a, const GLfloat rad)
  * @param rad the angle to rotate the matrix by
  * @returns {mat4} out
  */
-mat4 mat4::rotateY(mat4& out, const mat4 a, const GLfloat rad)
+mat4 mat4::rotateY(mat4& out, const mat4& a, const GLfloat rad)
 {
     GLfloat s = sin(rad),
     c = cos(rad),
@@ -2326,7 +2253,7 @@ mat4 mat4::rotateY(mat4& out, const mat4 a, const GLfloat rad)
  * @param rad the angle to rotate the matrix by
  * @returns {mat4} out
  */
-mat4 mat4::rotateZ(mat4& out, const mat4 a, const GLfloat rad)
+mat4 mat4::rotateZ(mat4& out, const mat4& a, const GLfloat rad)
 {
     GLfloat s = sin(rad),
     c = cos(rad),
@@ -2373,7 +2300,7 @@ mat4 mat4::rotateZ(mat4& out, const mat4 a, const GLfloat rad)
  * @param v Translation vector
  * @returns {mat4} out
  */
-mat4 mat4::fromTranslation(mat4& out, const vec3 v)
+mat4 mat4::fromTranslation(mat4& out, const vec3& v)
 {
     out.m_Cells[0] = 1;
     out.m_Cells[1] = 0;
@@ -2405,7 +2332,7 @@ mat4 mat4::fromTranslation(mat4& out, const vec3 v)
  * @param v Scaling vector
  * @returns {mat4} out
  */
-mat4 mat4::fromScaling(mat4& out, const vec3 v)
+mat4 mat4::fromScaling(mat4& out, const vec3& v)
 {
     out.m_Cells[0] = v.m_Cells[0];
     out.m_Cells[1] = 0;
@@ -2438,7 +2365,7 @@ mat4 mat4::fromScaling(mat4& out, const vec3 v)
  * @param axis the axis to rotate around
  * @returns {mat4} out
  */
-mat4 mat4::fromRotation(mat4& out, const GLfloat rad, const vec3 axis)
+mat4 mat4::fromRotation(mat4& out, const GLfloat rad, const vec3& axis)
 {
     GLfloat x = axis.m_Cells[0], y = axis.m_Cells[1], z = axis.m_Cells[2],
     len = sqrt(x * x + y * y + z * z),
@@ -2598,7 +2525,7 @@ mat4 mat4::fromZRotation(mat4& out, const GLfloat rad)
  * @param v Translation vector
  * @returns {mat4} out
  */
-mat4 mat4::fromRotationTranslation(mat4& out, const quat q, const vec3 v)
+mat4 mat4::fromRotationTranslation(mat4& out, const quat& q, const vec3& v)
 {
     // Quaternion math
     GLfloat x = q.m_Cells[0], y = q.m_Cells[1], z = q.m_Cells[2], w = q.m_Cells[3],
@@ -2645,7 +2572,7 @@ mat4 mat4::fromRotationTranslation(mat4& out, const quat q, const vec3 v)
  * @param  {mat4} mat Matrix to be decomposed (input)
  * @returns {vec3} out
  */
-vec3 mat4::getTranslation(vec3& out, const mat4 mat)
+vec3 mat4::getTranslation(vec3& out, const mat4& mat)
 {
     out.m_Cells[0] = mat.m_Cells[12];
     out.m_Cells[1] = mat.m_Cells[13];
@@ -2663,7 +2590,7 @@ vec3 mat4::getTranslation(vec3& out, const mat4 mat)
  * @param mat Matrix to be decomposed (input)
  * @returns {quat} out
  */
-quat mat4::getRotation(quat& out, const mat4 mat)
+quat mat4::getRotation(quat& out, const mat4& mat)
 {
     // Algorithm taken from http://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/index.htm
     GLfloat trace = mat.m_Cells[0] + mat.m_Cells[5] + mat.m_Cells[10];
@@ -2715,7 +2642,7 @@ quat mat4::getRotation(quat& out, const mat4 mat)
  * @param s Scaling vector
  * @returns {mat4} out
  */
-mat4 mat4::fromRotationTranslationScale(mat4& out, const quat q, const vec3 v, const vec3 s)
+mat4 mat4::fromRotationTranslationScale(mat4& out, const quat& q, const vec3& v, const vec3& s)
 {
     // Quaternion math
     GLfloat x = q.m_Cells[0], y = q.m_Cells[1], z = q.m_Cells[2], w = q.m_Cells[3],
@@ -2776,7 +2703,7 @@ mat4 mat4::fromRotationTranslationScale(mat4& out, const quat q, const vec3 v, c
  * @param o The origin vector around which to scale and rotate
  * @returns {mat4} out
  */
-mat4 mat4::fromRotationTranslationScaleOrigin(mat4& out, const quat q, const vec3 v, const vec3 s, const vec3 o)
+mat4 mat4::fromRotationTranslationScaleOrigin(mat4& out, const quat& q, const vec3& v, const vec3& s, const vec3& o)
 {
     // Quaternion math
     GLfloat x = q.m_Cells[0], y = q.m_Cells[1], z = q.m_Cells[2], w = q.m_Cells[3],
@@ -2830,7 +2757,7 @@ mat4 mat4::fromRotationTranslationScaleOrigin(mat4& out, const quat q, const vec
  *
  * @returns {mat4} out
  */
-mat4 mat4::fromQuat(mat4& out, const quat q)
+mat4 mat4::fromQuat(mat4& out, const quat& q)
 {
     GLfloat x = q.m_Cells[0], y = q.m_Cells[1], z = q.m_Cells[2], w = q.m_Cells[3],
     x2 = x + x,
@@ -2984,7 +2911,7 @@ mat4 mat4::ortho(mat4& out, const GLfloat left, const GLfloat right, const GLflo
  * @param up vec3 pointing up
  * @returns {mat4} out
  */
-mat4 mat4::lookAt(mat4& out, const vec3 eye, const vec3 center, const vec3 up)
+mat4 mat4::lookAt(mat4& out, const vec3& eye, const vec3& center, const vec3& up)
 {
     GLfloat x0, x1, x2, y0, y1, y2, z0, z1, z2, len,
     eyex = eye.m_Cells[0],
@@ -3069,7 +2996,7 @@ mat4 mat4::lookAt(mat4& out, const vec3 eye, const vec3 center, const vec3 up)
  * @param a the matrix to calculate Frobenius norm of
  * @returns {Number} Frobenius norm
  */
-GLfloat mat4::frob(const mat4 a)
+GLfloat mat4::frob(const mat4& a)
 {
     return(sqrt(pow(a.m_Cells[0], 2) + pow(a.m_Cells[1], 2) + pow(a.m_Cells[2], 2) + pow(a.m_Cells[3], 2) + pow(a.m_Cells[4], 2) + pow(a.m_Cells[5], 2) + pow(a.m_Cells[6], 2) + pow(a.m_Cells[7], 2) + pow(a.m_Cells[8], 2) + pow(a.m_Cells[9], 2) + pow(a.m_Cells[10], 2) + pow(a.m_Cells[11], 2) + pow(a.m_Cells[12], 2) + pow(a.m_Cells[13], 2) + pow(a.m_Cells[14], 2) + pow(a.m_Cells[15], 2) ));
 };
@@ -3082,7 +3009,7 @@ GLfloat mat4::frob(const mat4 a)
  * @param b the second operand
  * @returns {mat4} out
  */
-mat4 mat4::add(mat4& out, const mat4 a, const mat4 b)
+mat4 mat4::add(mat4& out, const mat4& a, const mat4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -3111,7 +3038,7 @@ mat4 mat4::add(mat4& out, const mat4 a, const mat4 b)
  * @param b the second operand
  * @returns {mat4} out
  */
-mat4 mat4::subtract(mat4& out, const mat4 a, const mat4 b)
+mat4 mat4::subtract(mat4& out, const mat4& a, const mat4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -3140,7 +3067,7 @@ mat4 mat4::subtract(mat4& out, const mat4 a, const mat4 b)
  * @param b amount to scale the matrix's elements by
  * @returns {mat4} out
  */
-mat4 mat4::multiplyScalar(mat4& out, const mat4 a, const GLfloat b)
+mat4 mat4::multiplyScalar(mat4& out, const mat4& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -3170,7 +3097,7 @@ mat4 mat4::multiplyScalar(mat4& out, const mat4 a, const GLfloat b)
  * @param scale the amount to scale b's elements by before adding
  * @returns {mat4} out
  */
-mat4 mat4::multiplyScalarAndAdd(mat4& out, const mat4 a, const mat4 b, const GLfloat scale)
+mat4 mat4::multiplyScalarAndAdd(mat4& out, const mat4& a, const mat4& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -3198,7 +3125,7 @@ mat4 mat4::multiplyScalarAndAdd(mat4& out, const mat4 a, const mat4 b, const GLf
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat4::exactEquals(const mat4 a, const mat4 b)
+bool mat4::exactEquals(const mat4& a, const mat4& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2] && a.m_Cells[3] == b.m_Cells[3] &&
     a.m_Cells[4] == b.m_Cells[4] && a.m_Cells[5] == b.m_Cells[5] && a.m_Cells[6] == b.m_Cells[6] && a.m_Cells[7] == b.m_Cells[7] &&
@@ -3213,7 +3140,7 @@ bool mat4::exactEquals(const mat4 a, const mat4 b)
  * @param b The second matrix.
  * @returns {Boolean} True if the matrices are equal, false otherwise.
  */
-bool mat4::equals(const mat4 a, const mat4 b)
+bool mat4::equals(const mat4& a, const mat4& b)
 {
     GLfloat a0  = a.m_Cells[0],  a1  = a.m_Cells[1],  a2  = a.m_Cells[2],  a3  = a.m_Cells[3],
     a4  = a.m_Cells[4],  a5  = a.m_Cells[5],  a6  = a.m_Cells[6],  a7  = a.m_Cells[7],
@@ -3292,9 +3219,12 @@ mat4 mat4::zero(mat4& out)
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void mat4::glUniformMatrix(const GLint loc, const mat4 a)
+void mat4::glUniformMatrix(const GLint loc, const mat4& a)
 {
-    if (loc >= 0) glUniformMatrix4fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniformMatrix4fv(loc, 1, GL_FALSE, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const vec2 vec2::null;
@@ -3318,7 +3248,7 @@ vec2 vec2::create()
  * @param a vector to clone
  * @returns {vec2} a new 2D vector
  */
-vec2 vec2::clone(const vec2 a)
+vec2 vec2::clone(const vec2& a)
 {
     vec2 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -3348,7 +3278,7 @@ vec2 vec2::fromValues(const GLfloat x, const GLfloat y)
  * @param a the source vector
  * @returns {vec2} out
  */
-vec2 vec2::copy(vec2& out, const vec2 a)
+vec2 vec2::copy(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -3378,7 +3308,7 @@ vec2 vec2::set(vec2& out, const GLfloat x, const GLfloat y)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::add(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::add(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -3393,7 +3323,7 @@ vec2 vec2::add(vec2& out, const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::subtract(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::subtract(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -3408,7 +3338,7 @@ vec2 vec2::subtract(vec2& out, const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::multiply(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::multiply(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] * b.m_Cells[1];
@@ -3423,7 +3353,7 @@ vec2 vec2::multiply(vec2& out, const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::divide(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::divide(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = a.m_Cells[0] / b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] / b.m_Cells[1];
@@ -3437,7 +3367,7 @@ vec2 vec2::divide(vec2& out, const vec2 a, const vec2 b)
  * @param a vector to ceil
  * @returns {vec2} out
  */
-vec2 vec2::ceil(vec2& out, const vec2 a)
+vec2 vec2::ceil(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = ceilf(a.m_Cells[0]);
     out.m_Cells[1] = ceilf(a.m_Cells[1]);
@@ -3451,7 +3381,7 @@ vec2 vec2::ceil(vec2& out, const vec2 a)
  * @param a vector to floor
  * @returns {vec2} out
  */
-vec2 vec2::floor(vec2& out, const vec2 a)
+vec2 vec2::floor(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = floorf(a.m_Cells[0]);
     out.m_Cells[1] = floorf(a.m_Cells[1]);
@@ -3466,7 +3396,7 @@ vec2 vec2::floor(vec2& out, const vec2 a)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::min(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::min(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = fmin(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmin(a.m_Cells[1], b.m_Cells[1]);
@@ -3481,7 +3411,7 @@ vec2 vec2::min(vec2& out, const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {vec2} out
  */
-vec2 vec2::max(vec2& out, const vec2 a, const vec2 b)
+vec2 vec2::max(vec2& out, const vec2& a, const vec2& b)
 {
     out.m_Cells[0] = fmax(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmax(a.m_Cells[1], b.m_Cells[1]);
@@ -3495,7 +3425,7 @@ vec2 vec2::max(vec2& out, const vec2 a, const vec2 b)
  * @param a vector to round
  * @returns {vec2} out
  */
-vec2 vec2::round(vec2& out, const vec2 a)
+vec2 vec2::round(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = roundf(a.m_Cells[0]);
     out.m_Cells[1] = roundf(a.m_Cells[1]);
@@ -3510,7 +3440,7 @@ vec2 vec2::round(vec2& out, const vec2 a)
  * @param b amount to scale the vector by
  * @returns {vec2} out
  */
-vec2 vec2::scale(vec2& out, const vec2 a, const GLfloat b)
+vec2 vec2::scale(vec2& out, const vec2& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -3526,7 +3456,7 @@ vec2 vec2::scale(vec2& out, const vec2 a, const GLfloat b)
  * @param scale the amount to scale b by before adding
  * @returns {vec2} out
  */
-vec2 vec2::scaleAndAdd(vec2& out, const vec2 a, const vec2 b, const GLfloat scale)
+vec2 vec2::scaleAndAdd(vec2& out, const vec2& a, const vec2& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -3540,7 +3470,7 @@ vec2 vec2::scaleAndAdd(vec2& out, const vec2 a, const vec2 b, const GLfloat scal
  * @param b the second operand
  * @returns {Number} distance between a and b
  */
-GLfloat vec2::distance(const vec2 a, const vec2 b)
+GLfloat vec2::distance(const vec2& a, const vec2& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1];
@@ -3554,7 +3484,7 @@ GLfloat vec2::distance(const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {Number} squared distance between a and b
  */
-GLfloat vec2::squaredDistance(const vec2 a, const vec2 b)
+GLfloat vec2::squaredDistance(const vec2& a, const vec2& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1];
@@ -3567,7 +3497,7 @@ GLfloat vec2::squaredDistance(const vec2 a, const vec2 b)
  * @param a vector to calculate length of
  * @returns {Number} length of a
  */
-GLfloat vec2::length(const vec2 a)
+GLfloat vec2::length(const vec2& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3580,7 +3510,7 @@ GLfloat vec2::length(const vec2 a)
  * @param a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-GLfloat vec2::squaredLength(const vec2 a)
+GLfloat vec2::squaredLength(const vec2& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3594,7 +3524,7 @@ GLfloat vec2::squaredLength(const vec2 a)
  * @param a vector to negate
  * @returns {vec2} out
  */
-vec2 vec2::negate(vec2& out, const vec2 a)
+vec2 vec2::negate(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = -a.m_Cells[0];
     out.m_Cells[1] = -a.m_Cells[1];
@@ -3608,7 +3538,7 @@ vec2 vec2::negate(vec2& out, const vec2 a)
  * @param a vector to invert
  * @returns {vec2} out
  */
-vec2 vec2::inverse(vec2& out, const vec2 a)
+vec2 vec2::inverse(vec2& out, const vec2& a)
 {
     out.m_Cells[0] = 1.0 / a.m_Cells[0];
     out.m_Cells[1] = 1.0 / a.m_Cells[1];
@@ -3622,7 +3552,7 @@ vec2 vec2::inverse(vec2& out, const vec2 a)
  * @param a vector to normalize
  * @returns {vec2} out
  */
-vec2 vec2::normalize(vec2& out, const vec2 a)
+vec2 vec2::normalize(vec2& out, const vec2& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3643,7 +3573,7 @@ vec2 vec2::normalize(vec2& out, const vec2 a)
  * @param b the second operand
  * @returns {Number} dot product of a and b
  */
-GLfloat vec2::dot(const vec2 a, const vec2 b)
+GLfloat vec2::dot(const vec2& a, const vec2& b)
 {
     return a.m_Cells[0] * b.m_Cells[0] + a.m_Cells[1] * b.m_Cells[1];
 };
@@ -3657,7 +3587,7 @@ GLfloat vec2::dot(const vec2 a, const vec2 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec2::cross(vec3& out, const vec2 a, const vec2 b)
+vec3 vec2::cross(vec3& out, const vec2& a, const vec2& b)
 {
     GLfloat z = a.m_Cells[0] * b.m_Cells[1] - a.m_Cells[1] * b.m_Cells[0];
     out.m_Cells[0] = out.m_Cells[1] = 0;
@@ -3674,7 +3604,7 @@ vec3 vec2::cross(vec3& out, const vec2 a, const vec2 b)
  * @param t interpolation amount between the two inputs
  * @returns {vec2} out
  */
-vec2 vec2::lerp(vec2& out, const vec2 a, const vec2 b, const GLfloat t)
+vec2 vec2::lerp(vec2& out, const vec2& a, const vec2& b, const GLfloat t)
 {
     GLfloat ax = a.m_Cells[0],
     ay = a.m_Cells[1];
@@ -3706,7 +3636,7 @@ vec2 vec2::random(vec2& out, const GLfloat scale)
  * @param m matrix to transform with
  * @returns {vec2} out
  */
-vec2 vec2::transformMat2(vec2& out, const vec2 a, const mat2 m)
+vec2 vec2::transformMat2(vec2& out, const vec2& a, const mat2& m)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3723,7 +3653,7 @@ vec2 vec2::transformMat2(vec2& out, const vec2 a, const mat2 m)
  * @param m matrix to transform with
  * @returns {vec2} out
  */
-vec2 vec2::transformMat2d(vec2& out, const vec2 a, const mat2d m)
+vec2 vec2::transformMat2d(vec2& out, const vec2& a, const mat2d& m)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3741,7 +3671,7 @@ vec2 vec2::transformMat2d(vec2& out, const vec2 a, const mat2d m)
  * @param m matrix to transform with
  * @returns {vec2} out
  */
-vec2 vec2::transformMat3(vec2& out, const vec2 a, const mat3 m)
+vec2 vec2::transformMat3(vec2& out, const vec2& a, const mat3& m)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3760,7 +3690,7 @@ vec2 vec2::transformMat3(vec2& out, const vec2 a, const mat3 m)
  * @param m matrix to transform with
  * @returns {vec2} out
  */
-vec2 vec2::transformMat4(vec2& out, const vec2 a, const mat4 m)
+vec2 vec2::transformMat4(vec2& out, const vec2& a, const mat4& m)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1];
@@ -3776,7 +3706,7 @@ vec2 vec2::transformMat4(vec2& out, const vec2 a, const mat4 m)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec2::exactEquals(const vec2 a, const vec2 b)
+bool vec2::exactEquals(const vec2& a, const vec2& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1];
 };
@@ -3788,7 +3718,7 @@ bool vec2::exactEquals(const vec2 a, const vec2 b)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec2::equals(const vec2 a, const vec2 b)
+bool vec2::equals(const vec2& a, const vec2& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1];
@@ -3828,7 +3758,7 @@ vec2 vec2::zero(vec2& out)
  * @param a
  * @returns {vec2} a new vector
  */
-vec2 vec2::fromVec(const vec2 a)
+vec2 vec2::fromVec(const vec2& a)
 {
     vec2 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -3841,7 +3771,7 @@ vec2 vec2::fromVec(const vec2 a)
  * @param a
  * @returns {vec2} a new vector
  */
-vec2 vec2::fromVec(const vec3 a)
+vec2 vec2::fromVec(const vec3& a)
 {
     vec2 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -3854,7 +3784,7 @@ vec2 vec2::fromVec(const vec3 a)
  * @param a
  * @returns {vec2} a new vector
  */
-vec2 vec2::fromVec(const vec4 a)
+vec2 vec2::fromVec(const vec4& a)
 {
     vec2 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -3871,18 +3801,20 @@ vec2 vec2::fromVec(const vec4 a)
  * @param k coefficient entre 0 et 1
  * @returns {vec2} out
  */
-vec2 vec2::hermite(vec2& out, const vec2 p0, const vec2 t0, const vec2 p1, const vec2 t1, const GLfloat k)
+vec2 vec2::hermite(vec2& out, const vec2& p0, const vec2& t0, const vec2& p1, const vec2& t1, const GLfloat k)
 {
     GLfloat h00 = ((2*k) - 3)*k*k + 1;
     GLfloat h10 = ((k - 2)*k + 1)*k;
     GLfloat h01 = (3 - 2*k)*k*k;
     GLfloat h11 = (k - 1)*k*k;
 
-    vec2::zero(out);
-    vec2::scaleAndAdd(out, out, p0, h00);
-    vec2::scaleAndAdd(out, out, t0, h10);
-    vec2::scaleAndAdd(out, out, p1, h01);
-    vec2::scaleAndAdd(out, out, t1, h11);
+    // accumulate in a local vector, out may be one of the operands
+    vec2 result = vec2::create();
+    vec2::scaleAndAdd(result, result, p0, h00);
+    vec2::scaleAndAdd(result, result, t0, h10);
+    vec2::scaleAndAdd(result, result, p1, h01);
+    vec2::scaleAndAdd(result, result, t1, h11);
+    out = result;
 
     return out;
 };
@@ -3897,7 +3829,7 @@ vec2 vec2::hermite(vec2& out, const vec2 p0, const vec2 t0, const vec2 p1, const
  * @param t interpolation amount between the two inputs
  * @returns {vec2} out
  */
-vec2 vec2::bezier(vec2& out, const vec2 a, const vec2 b, const vec2 c, const vec2 d, const GLfloat t)
+vec2 vec2::bezier(vec2& out, const vec2& a, const vec2& b, const vec2& c, const vec2& d, const GLfloat t)
 {
     GLfloat inverseFactor = 1 - t,
     inverseFactorTimesTwo = inverseFactor * inverseFactor,
@@ -3907,11 +3839,13 @@ vec2 vec2::bezier(vec2& out, const vec2 a, const vec2 b, const vec2 c, const vec
     factor3 = 3 * factorTimes2 * inverseFactor,
     factor4 = factorTimes2 * t;
 
-    vec2::zero(out);
-    vec2::scaleAndAdd(out, out, a, factor1);
-    vec2::scaleAndAdd(out, out, b, factor2);
-    vec2::scaleAndAdd(out, out, c, factor3);
-    vec2::scaleAndAdd(out, out, d, factor4);
+    // accumulate in a local vector, out may be one of the operands
+    vec2 result = vec2::create();
+    vec2::scaleAndAdd(result, result, a, factor1);
+    vec2::scaleAndAdd(result, result, b, factor2);
+    vec2::scaleAndAdd(result, result, c, factor3);
+    vec2::scaleAndAdd(result, result, d, factor4);
+    out = result;
 
     return out;
 };
@@ -3922,9 +3856,12 @@ vec2 vec2::bezier(vec2& out, const vec2 a, const vec2 b, const vec2 c, const vec
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void vec2::glUniform(const GLint loc, const vec2 a)
+void vec2::glUniform(const GLint loc, const vec2& a)
 {
-    if (loc >= 0) glUniform2fv(loc, 1, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniform2fv(loc, 1, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 /**
  * calls glUniform2fv for the vector array a
@@ -3935,7 +3872,10 @@ void vec2::glUniform(const GLint loc, const vec2 a)
  */
 void vec2::glUniform(const GLint loc, const std::vector<vec2>& a)
 {
-    if (loc >= 0) glUniform2fv(loc, a.size(), (const GLfloat*)a.data());
+    if (loc >= 0) {
+        glUniform2fv(loc, a.size(), (const GLfloat*)a.data());
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const vec3 vec3::null;
@@ -3960,7 +3900,7 @@ vec3 vec3::create()
  * @param a vector to clone
  * @returns {vec3} a new 3D vector
  */
-vec3 vec3::clone(const vec3 a)
+vec3 vec3::clone(const vec3& a)
 {
     vec3 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -3993,7 +3933,7 @@ vec3 vec3::fromValues(const GLfloat x, const GLfloat y, const GLfloat z)
  * @param a the source vector
  * @returns {vec3} out
  */
-vec3 vec3::copy(vec3& out, const vec3 a)
+vec3 vec3::copy(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -4026,7 +3966,7 @@ vec3 vec3::set(vec3& out, const GLfloat x, const GLfloat y, const GLfloat z)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::add(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::add(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -4042,7 +3982,7 @@ vec3 vec3::add(vec3& out, const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::subtract(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::subtract(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -4058,7 +3998,7 @@ vec3 vec3::subtract(vec3& out, const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::multiply(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::multiply(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] * b.m_Cells[1];
@@ -4074,7 +4014,7 @@ vec3 vec3::multiply(vec3& out, const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::divide(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::divide(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = a.m_Cells[0] / b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] / b.m_Cells[1];
@@ -4089,7 +4029,7 @@ vec3 vec3::divide(vec3& out, const vec3 a, const vec3 b)
  * @param a vector to ceil
  * @returns {vec3} out
  */
-vec3 vec3::ceil(vec3& out, const vec3 a)
+vec3 vec3::ceil(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = ceilf(a.m_Cells[0]);
     out.m_Cells[1] = ceilf(a.m_Cells[1]);
@@ -4104,7 +4044,7 @@ vec3 vec3::ceil(vec3& out, const vec3 a)
  * @param a vector to floor
  * @returns {vec3} out
  */
-vec3 vec3::floor(vec3& out, const vec3 a)
+vec3 vec3::floor(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = floorf(a.m_Cells[0]);
     out.m_Cells[1] = floorf(a.m_Cells[1]);
@@ -4120,7 +4060,7 @@ vec3 vec3::floor(vec3& out, const vec3 a)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::min(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::min(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = fmin(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmin(a.m_Cells[1], b.m_Cells[1]);
@@ -4136,7 +4076,7 @@ vec3 vec3::min(vec3& out, const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::max(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::max(vec3& out, const vec3& a, const vec3& b)
 {
     out.m_Cells[0] = fmax(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmax(a.m_Cells[1], b.m_Cells[1]);
@@ -4151,7 +4091,7 @@ vec3 vec3::max(vec3& out, const vec3 a, const vec3 b)
  * @param a vector to round
  * @returns {vec3} out
  */
-vec3 vec3::round(vec3& out, const vec3 a)
+vec3 vec3::round(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = roundf(a.m_Cells[0]);
     out.m_Cells[1] = roundf(a.m_Cells[1]);
@@ -4167,7 +4107,7 @@ vec3 vec3::round(vec3& out, const vec3 a)
  * @param b amount to scale the vector by
  * @returns {vec3} out
  */
-vec3 vec3::scale(vec3& out, const vec3 a, const GLfloat b)
+vec3 vec3::scale(vec3& out, const vec3& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -4184,7 +4124,7 @@ vec3 vec3::scale(vec3& out, const vec3 a, const GLfloat b)
  * @param scale the amount to scale b by before adding
  * @returns {vec3} out
  */
-vec3 vec3::scaleAndAdd(vec3& out, const vec3 a, const vec3 b, const GLfloat scale)
+vec3 vec3::scaleAndAdd(vec3& out, const vec3& a, const vec3& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -4199,7 +4139,7 @@ vec3 vec3::scaleAndAdd(vec3& out, const vec3 a, const vec3 b, const GLfloat scal
  * @param b the second operand
  * @returns {Number} distance between a and b
  */
-GLfloat vec3::distance(const vec3 a, const vec3 b)
+GLfloat vec3::distance(const vec3& a, const vec3& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1],
@@ -4214,7 +4154,7 @@ GLfloat vec3::distance(const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {Number} squared distance between a and b
  */
-GLfloat vec3::squaredDistance(const vec3 a, const vec3 b)
+GLfloat vec3::squaredDistance(const vec3& a, const vec3& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1],
@@ -4228,7 +4168,7 @@ GLfloat vec3::squaredDistance(const vec3 a, const vec3 b)
  * @param a vector to calculate length of
  * @returns {Number} length of a
  */
-GLfloat vec3::length(const vec3 a)
+GLfloat vec3::length(const vec3& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1],
@@ -4242,7 +4182,7 @@ GLfloat vec3::length(const vec3 a)
  * @param a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-GLfloat vec3::squaredLength(const vec3 a)
+GLfloat vec3::squaredLength(const vec3& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1],
@@ -4257,7 +4197,7 @@ GLfloat vec3::squaredLength(const vec3 a)
  * @param a vector to negate
  * @returns {vec3} out
  */
-vec3 vec3::negate(vec3& out, const vec3 a)
+vec3 vec3::negate(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = -a.m_Cells[0];
     out.m_Cells[1] = -a.m_Cells[1];
@@ -4272,7 +4212,7 @@ vec3 vec3::negate(vec3& out, const vec3 a)
  * @param a vector to invert
  * @returns {vec3} out
  */
-vec3 vec3::inverse(vec3& out, const vec3 a)
+vec3 vec3::inverse(vec3& out, const vec3& a)
 {
     out.m_Cells[0] = 1.0 / a.m_Cells[0];
     out.m_Cells[1] = 1.0 / a.m_Cells[1];
@@ -4287,21 +4227,6 @@ vec3 vec3::inverse(vec3& out, const vec3 a)
  * @param a vector to normalize
  * @returns {vec3} out
  */
-vec3 vec3::normalize(vec3& out, const vec3 a)
-{
-    GLfloat x = a.m_Cells[0],
-    y = a.m_Cells[1],
-    z = a.m_Cells[2];
-    GLfloat len = x*x + y*y + z*z;
-    if (len > 0) {
-        //TODO: evaluate use of glm_invsqrt here?
-        len = 1 / sqrt(len);
-        out.m_Cells[0] = a.m_Cells[0] * len;
-        out.m_Cells[1] = a.m_Cells[1] * len;
-        out.m_Cells[2] = a.m_Cells[2] * len;
-    }
-    return out;
-};
 
 /**
  * Calculates the dot product of two vec3's
@@ -4310,7 +4235,7 @@ vec3 vec3::normalize(vec3& out, const vec3 a)
  * @param b the second operand
  * @returns {Number} dot product of a and b
  */
-GLfloat vec3::dot(const vec3 a, const vec3 b)
+GLfloat vec3::dot(const vec3& a, const vec3& b)
 {
     return a.m_Cells[0] * b.m_Cells[0] + a.m_Cells[1] * b.m_Cells[1] + a.m_Cells[2] * b.m_Cells[2];
 };
@@ -4323,7 +4248,7 @@ GLfloat vec3::dot(const vec3 a, const vec3 b)
  * @param b the second operand
  * @returns {vec3} out
  */
-vec3 vec3::cross(vec3& out, const vec3 a, const vec3 b)
+vec3 vec3::cross(vec3& out, const vec3& a, const vec3& b)
 {
     GLfloat ax = a.m_Cells[0], ay = a.m_Cells[1], az = a.m_Cells[2],
     bx = b.m_Cells[0], by = b.m_Cells[1], bz = b.m_Cells[2];
@@ -4343,7 +4268,7 @@ vec3 vec3::cross(vec3& out, const vec3 a, const vec3 b)
  * @param t interpolation amount between the two inputs
  * @returns {vec3} out
  */
-vec3 vec3::lerp(vec3& out, const vec3 a, const vec3 b, const GLfloat t)
+vec3 vec3::lerp(vec3& out, const vec3& a, const vec3& b, const GLfloat t)
 {
     GLfloat ax = a.m_Cells[0],
     ay = a.m_Cells[1],
@@ -4383,16 +4308,6 @@ vec3 vec3::random(vec3& out, const GLfloat scale)
  * @param m matrix to transform with
  * @returns {vec3} out
  */
-vec3 vec3::transformMat4(vec3& out, const vec3 a, const mat4 m)
-{
-    GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2],
-    w = m.m_Cells[3] * x + m.m_Cells[7] * y + m.m_Cells[11] * z + m.m_Cells[15];
-    w = w || 1.0;
-    out.m_Cells[0] = (m.m_Cells[0] * x + m.m_Cells[4] * y + m.m_Cells[8] * z + m.m_Cells[12]) / w;
-    out.m_Cells[1] = (m.m_Cells[1] * x + m.m_Cells[5] * y + m.m_Cells[9] * z + m.m_Cells[13]) / w;
-    out.m_Cells[2] = (m.m_Cells[2] * x + m.m_Cells[6] * y + m.m_Cells[10] * z + m.m_Cells[14]) / w;
-    return out;
-};
 
 /**
  * Transforms the vec3 with a mat3.
@@ -4402,7 +4317,7 @@ vec3 vec3::transformMat4(vec3& out, const vec3 a, const mat4 m)
  * @param m the 3x3 matrix to transform with
  * @returns {vec3} out
  */
-vec3 vec3::transformMat3(vec3& out, const vec3 a, const mat4 m)
+vec3 vec3::transformMat3(vec3& out, const vec3& a, const mat4& m)
 {
     GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2];
     out.m_Cells[0] = x * m.m_Cells[0] + y * m.m_Cells[3] + z * m.m_Cells[6];
@@ -4419,7 +4334,7 @@ vec3 vec3::transformMat3(vec3& out, const vec3 a, const mat4 m)
  * @param q quaternion to transform with
  * @returns {vec3} out
  */
-vec3 vec3::transformQuat(vec3& out, const vec3 a, const quat q)
+vec3 vec3::transformQuat(vec3& out, const vec3& a, const quat& q)
 {
     // benchmarks: http://jsperf.com/quaternion-transform-vec3-implementations
 
@@ -4447,7 +4362,7 @@ vec3 vec3::transformQuat(vec3& out, const vec3 a, const quat q)
  * @param c The angle of rotation
  * @returns {vec3} out
  */
-vec3 vec3::rotateX(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
+vec3 vec3::rotateX(vec3& out, const vec3& a, const vec3& b, const GLfloat c)
 {
     vec3 p, r;
     //Translate point to the origin
@@ -4476,7 +4391,7 @@ vec3 vec3::rotateX(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
  * @param c The angle of rotation
  * @returns {vec3} out
  */
-vec3 vec3::rotateY(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
+vec3 vec3::rotateY(vec3& out, const vec3& a, const vec3& b, const GLfloat c)
 {
     vec3 p, r;
     //Translate point to the origin
@@ -4505,7 +4420,7 @@ vec3 vec3::rotateY(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
  * @param c The angle of rotation
  * @returns {vec3} out
  */
-vec3 vec3::rotateZ(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
+vec3 vec3::rotateZ(vec3& out, const vec3& a, const vec3& b, const GLfloat c)
 {
     vec3 p, r;
     //Translate point to the origin
@@ -4532,7 +4447,7 @@ vec3 vec3::rotateZ(vec3& out, const vec3 a, const vec3 b, const GLfloat c)
  * @param b The second operand
  * @returns {Number} The angle in radians
  */
-GLfloat vec3::angle(const vec3 a, const vec3 b)
+GLfloat vec3::angle(const vec3& a, const vec3& b)
 {
 
     vec3 tempA = vec3::fromValues(a.m_Cells[0], a.m_Cells[1], a.m_Cells[2]);
@@ -4557,7 +4472,7 @@ GLfloat vec3::angle(const vec3 a, const vec3 b)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec3::exactEquals(const vec3 a, const vec3 b)
+bool vec3::exactEquals(const vec3& a, const vec3& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2];
 };
@@ -4569,7 +4484,7 @@ bool vec3::exactEquals(const vec3 a, const vec3 b)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec3::equals(const vec3 a, const vec3 b)
+bool vec3::equals(const vec3& a, const vec3& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2];
@@ -4611,7 +4526,7 @@ vec3 vec3::zero(vec3& out)
  * @param a
  * @returns {vec3} a new vector
  */
-vec3 vec3::fromVec(const vec2 a)
+vec3 vec3::fromVec(const vec2& a)
 {
     vec3 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -4624,7 +4539,7 @@ vec3 vec3::fromVec(const vec2 a)
  * @param a
  * @returns {vec3} a new vector
  */
-vec3 vec3::fromVec(const vec3 a)
+vec3 vec3::fromVec(const vec3& a)
 {
     vec3 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -4638,7 +4553,7 @@ vec3 vec3::fromVec(const vec3 a)
  * @param a
  * @returns {vec3} a new vector
  */
-vec3 vec3::fromVec(const vec4 a)
+vec3 vec3::fromVec(const vec4& a)
 {
     vec3 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -4656,18 +4571,20 @@ vec3 vec3::fromVec(const vec4 a)
  * @param k coefficient entre 0 et 1
  * @returns {vec3} out
  */
-vec3 vec3::hermite(vec3& out, const vec3 p0, const vec3 t0, const vec3 p1, const vec3 t1, const GLfloat k)
+vec3 vec3::hermite(vec3& out, const vec3& p0, const vec3& t0, const vec3& p1, const vec3& t1, const GLfloat k)
 {
     GLfloat h00 = ((2*k) - 3)*k*k + 1;
     GLfloat h10 = ((k - 2)*k + 1)*k;
     GLfloat h01 = (3 - 2*k)*k*k;
     GLfloat h11 = (k - 1)*k*k;
 
-    vec3::zero(out);
-    vec3::scaleAndAdd(out, out, p0, h00);
-    vec3::scaleAndAdd(out, out, t0, h10);
-    vec3::scaleAndAdd(out, out, p1, h01);
-    vec3::scaleAndAdd(out, out, t1, h11);
+    // accumulate in a local vector, out may be one of the operands
+    vec3 result = vec3::create();
+    vec3::scaleAndAdd(result, result, p0, h00);
+    vec3::scaleAndAdd(result, result, t0, h10);
+    vec3::scaleAndAdd(result, result, p1, h01);
+    vec3::scaleAndAdd(result, result, t1, h11);
+    out = result;
 
     return out;
 };
@@ -4682,7 +4599,7 @@ vec3 vec3::hermite(vec3& out, const vec3 p0, const vec3 t0, const vec3 p1, const
  * @param t interpolation amount between the two inputs
  * @returns {vec3} out
  */
-vec3 vec3::bezier(vec3& out, const vec3 a, const vec3 b, const vec3 c, const vec3 d, const GLfloat t)
+vec3 vec3::bezier(vec3& out, const vec3& a, const vec3& b, const vec3& c, const vec3& d, const GLfloat t)
 {
     GLfloat inverseFactor = 1 - t,
     inverseFactorTimesTwo = inverseFactor * inverseFactor,
@@ -4692,11 +4609,13 @@ vec3 vec3::bezier(vec3& out, const vec3 a, const vec3 b, const vec3 c, const vec
     factor3 = 3 * factorTimes2 * inverseFactor,
     factor4 = factorTimes2 * t;
 
-    vec3::zero(out);
-    vec3::scaleAndAdd(out, out, a, factor1);
-    vec3::scaleAndAdd(out, out, b, factor2);
-    vec3::scaleAndAdd(out, out, c, factor3);
-    vec3::scaleAndAdd(out, out, d, factor4);
+    // accumulate in a local vector, out may be one of the operands
+    vec3 result = vec3::create();
+    vec3::scaleAndAdd(result, result, a, factor1);
+    vec3::scaleAndAdd(result, result, b, factor2);
+    vec3::scaleAndAdd(result, result, c, factor3);
+    vec3::scaleAndAdd(result, result, d, factor4);
+    out = result;
 
     return out;
 };
@@ -4707,9 +4626,12 @@ vec3 vec3::bezier(vec3& out, const vec3 a, const vec3 b, const vec3 c, const vec
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void vec3::glUniform(const GLint loc, const vec3 a)
+void vec3::glUniform(const GLint loc, const vec3& a)
 {
-    if (loc >= 0) glUniform3fv(loc, 1, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniform3fv(loc, 1, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 /**
  * calls glUniform3fv for the vector array a
@@ -4720,7 +4642,10 @@ void vec3::glUniform(const GLint loc, const vec3 a)
  */
 void vec3::glUniform(const GLint loc, const std::vector<vec3>& a)
 {
-    if (loc >= 0) glUniform3fv(loc, a.size(), (const GLfloat*)a.data());
+    if (loc >= 0) {
+        glUniform3fv(loc, a.size(), (const GLfloat*)a.data());
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const vec4 vec4::null;
@@ -4746,7 +4671,7 @@ vec4 vec4::create()
  * @param a vector to clone
  * @returns {vec4} a new 4D vector
  */
-vec4 vec4::clone(const vec4 a)
+vec4 vec4::clone(const vec4& a)
 {
     vec4 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -4782,7 +4707,7 @@ vec4 vec4::fromValues(const GLfloat x, const GLfloat y, const GLfloat z, const G
  * @param a the source vector
  * @returns {vec4} out
  */
-vec4 vec4::copy(vec4& out, const vec4 a)
+vec4 vec4::copy(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = a.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1];
@@ -4818,7 +4743,7 @@ vec4 vec4::set(vec4& out, const GLfloat x, const GLfloat y, const GLfloat z, con
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::add(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::add(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] + b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] + b.m_Cells[1];
@@ -4835,7 +4760,7 @@ vec4 vec4::add(vec4& out, const vec4 a, const vec4 b)
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::subtract(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::subtract(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] - b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] - b.m_Cells[1];
@@ -4852,7 +4777,7 @@ vec4 vec4::subtract(vec4& out, const vec4 a, const vec4 b)
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::multiply(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::multiply(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] * b.m_Cells[1];
@@ -4869,7 +4794,7 @@ vec4 vec4::multiply(vec4& out, const vec4 a, const vec4 b)
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::divide(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::divide(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = a.m_Cells[0] / b.m_Cells[0];
     out.m_Cells[1] = a.m_Cells[1] / b.m_Cells[1];
@@ -4885,7 +4810,7 @@ vec4 vec4::divide(vec4& out, const vec4 a, const vec4 b)
  * @param a vector to ceil
  * @returns {vec4} out
  */
-vec4 vec4::ceil(vec4& out, const vec4 a)
+vec4 vec4::ceil(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = ceilf(a.m_Cells[0]);
     out.m_Cells[1] = ceilf(a.m_Cells[1]);
@@ -4901,7 +4826,7 @@ vec4 vec4::ceil(vec4& out, const vec4 a)
  * @param a vector to floor
  * @returns {vec4} out
  */
-vec4 vec4::floor(vec4& out, const vec4 a)
+vec4 vec4::floor(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = floorf(a.m_Cells[0]);
     out.m_Cells[1] = floorf(a.m_Cells[1]);
@@ -4918,7 +4843,7 @@ vec4 vec4::floor(vec4& out, const vec4 a)
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::min(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::min(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = fmin(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmin(a.m_Cells[1], b.m_Cells[1]);
@@ -4935,7 +4860,7 @@ vec4 vec4::min(vec4& out, const vec4 a, const vec4 b)
  * @param b the second operand
  * @returns {vec4} out
  */
-vec4 vec4::max(vec4& out, const vec4 a, const vec4 b)
+vec4 vec4::max(vec4& out, const vec4& a, const vec4& b)
 {
     out.m_Cells[0] = fmax(a.m_Cells[0], b.m_Cells[0]);
     out.m_Cells[1] = fmax(a.m_Cells[1], b.m_Cells[1]);
@@ -4951,7 +4876,7 @@ vec4 vec4::max(vec4& out, const vec4 a, const vec4 b)
  * @param a vector to round
  * @returns {vec4} out
  */
-vec4 vec4::round(vec4& out, const vec4 a)
+vec4 vec4::round(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = roundf(a.m_Cells[0]);
     out.m_Cells[1] = roundf(a.m_Cells[1]);
@@ -4968,7 +4893,7 @@ vec4 vec4::round(vec4& out, const vec4 a)
  * @param b amount to scale the vector by
  * @returns {vec4} out
  */
-vec4 vec4::scale(vec4& out, const vec4 a, const GLfloat b)
+vec4 vec4::scale(vec4& out, const vec4& a, const GLfloat b)
 {
     out.m_Cells[0] = a.m_Cells[0] * b;
     out.m_Cells[1] = a.m_Cells[1] * b;
@@ -4986,7 +4911,7 @@ vec4 vec4::scale(vec4& out, const vec4 a, const GLfloat b)
  * @param scale the amount to scale b by before adding
  * @returns {vec4} out
  */
-vec4 vec4::scaleAndAdd(vec4& out, const vec4 a, const vec4 b, const GLfloat scale)
+vec4 vec4::scaleAndAdd(vec4& out, const vec4& a, const vec4& b, const GLfloat scale)
 {
     out.m_Cells[0] = a.m_Cells[0] + (b.m_Cells[0] * scale);
     out.m_Cells[1] = a.m_Cells[1] + (b.m_Cells[1] * scale);
@@ -5002,7 +4927,7 @@ vec4 vec4::scaleAndAdd(vec4& out, const vec4 a, const vec4 b, const GLfloat scal
  * @param b the second operand
  * @returns {Number} distance between a and b
  */
-GLfloat vec4::distance(const vec4 a, const vec4 b)
+GLfloat vec4::distance(const vec4& a, const vec4& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1],
@@ -5018,7 +4943,7 @@ GLfloat vec4::distance(const vec4 a, const vec4 b)
  * @param b the second operand
  * @returns {Number} squared distance between a and b
  */
-GLfloat vec4::squaredDistance(const vec4 a, const vec4 b)
+GLfloat vec4::squaredDistance(const vec4& a, const vec4& b)
 {
     GLfloat x = b.m_Cells[0] - a.m_Cells[0],
     y = b.m_Cells[1] - a.m_Cells[1],
@@ -5033,7 +4958,7 @@ GLfloat vec4::squaredDistance(const vec4 a, const vec4 b)
  * @param a vector to calculate length of
  * @returns {Number} length of a
  */
-GLfloat vec4::length(const vec4 a)
+GLfloat vec4::length(const vec4& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1],
@@ -5048,7 +4973,7 @@ GLfloat vec4::length(const vec4 a)
  * @param a vector to calculate squared length of
  * @returns {Number} squared length of a
  */
-GLfloat vec4::squaredLength(const vec4 a)
+GLfloat vec4::squaredLength(const vec4& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1],
@@ -5064,7 +4989,7 @@ GLfloat vec4::squaredLength(const vec4 a)
  * @param a vector to negate
  * @returns {vec4} out
  */
-vec4 vec4::negate(vec4& out, const vec4 a)
+vec4 vec4::negate(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = -a.m_Cells[0];
     out.m_Cells[1] = -a.m_Cells[1];
@@ -5080,7 +5005,7 @@ vec4 vec4::negate(vec4& out, const vec4 a)
  * @param a vector to invert
  * @returns {vec4} out
  */
-vec4 vec4::inverse(vec4& out, const vec4 a)
+vec4 vec4::inverse(vec4& out, const vec4& a)
 {
     out.m_Cells[0] = 1.0 / a.m_Cells[0];
     out.m_Cells[1] = 1.0 / a.m_Cells[1];
@@ -5096,7 +5021,7 @@ vec4 vec4::inverse(vec4& out, const vec4 a)
  * @param a vector to normalize
  * @returns {vec4} out
  */
-vec4 vec4::normalize(vec4& out, const vec4 a)
+vec4 vec4::normalize(vec4& out, const vec4& a)
 {
     GLfloat x = a.m_Cells[0],
     y = a.m_Cells[1],
@@ -5120,7 +5045,7 @@ vec4 vec4::normalize(vec4& out, const vec4 a)
  * @param b the second operand
  * @returns {Number} dot product of a and b
  */
-GLfloat vec4::dot(const vec4 a, const vec4 b)
+GLfloat vec4::dot(const vec4& a, const vec4& b)
 {
     return a.m_Cells[0] * b.m_Cells[0] + a.m_Cells[1] * b.m_Cells[1] + a.m_Cells[2] * b.m_Cells[2] + a.m_Cells[3] * b.m_Cells[3];
 };
@@ -5134,7 +5059,7 @@ GLfloat vec4::dot(const vec4 a, const vec4 b)
  * @param t interpolation amount between the two inputs
  * @returns {vec4} out
  */
-vec4 vec4::lerp(vec4& out, const vec4 a, const vec4 b, const GLfloat t)
+vec4 vec4::lerp(vec4& out, const vec4& a, const vec4& b, const GLfloat t)
 {
     GLfloat ax = a.m_Cells[0],
     ay = a.m_Cells[1],
@@ -5175,15 +5100,6 @@ vec4 vec4::random(vec4& out, const GLfloat scale)
  * @param m matrix to transform with
  * @returns {vec4} out
  */
-vec4 vec4::transformMat4(vec4& out, const vec4 a, const mat4 m)
-{
-    GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2], w = a.m_Cells[3];
-    out.m_Cells[0] = m.m_Cells[0] * x + m.m_Cells[4] * y + m.m_Cells[8] * z + m.m_Cells[12] * w;
-    out.m_Cells[1] = m.m_Cells[1] * x + m.m_Cells[5] * y + m.m_Cells[9] * z + m.m_Cells[13] * w;
-    out.m_Cells[2] = m.m_Cells[2] * x + m.m_Cells[6] * y + m.m_Cells[10] * z + m.m_Cells[14] * w;
-    out.m_Cells[3] = m.m_Cells[3] * x + m.m_Cells[7] * y + m.m_Cells[11] * z + m.m_Cells[15] * w;
-    return out;
-};
 
 /**
  * Transforms the vec4 with a quat
@@ -5193,7 +5109,7 @@ vec4 vec4::transformMat4(vec4& out, const vec4 a, const mat4 m)
  * @param q quaternion to transform with
  * @returns {vec4} out
  */
-vec4 vec4::transformQuat(vec4& out, const vec4 a, const quat q)
+vec4 vec4::transformQuat(vec4& out, const vec4& a, const quat& q)
 {
     GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2],
     qx = q.m_Cells[0], qy = q.m_Cells[1], qz = q.m_Cells[2], qw = q.m_Cells[3],
@@ -5219,7 +5135,7 @@ vec4 vec4::transformQuat(vec4& out, const vec4 a, const quat q)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec4::exactEquals(const vec4 a, const vec4 b)
+bool vec4::exactEquals(const vec4& a, const vec4& b)
 {
     return a.m_Cells[0] == b.m_Cells[0] && a.m_Cells[1] == b.m_Cells[1] && a.m_Cells[2] == b.m_Cells[2] && a.m_Cells[3] == b.m_Cells[3];
 };
@@ -5231,7 +5147,7 @@ bool vec4::exactEquals(const vec4 a, const vec4 b)
  * @param b The second vector.
  * @returns {Boolean} True if the vectors are equal, false otherwise.
  */
-bool vec4::equals(const vec4 a, const vec4 b)
+bool vec4::equals(const vec4& a, const vec4& b)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3];
     GLfloat b0 = b.m_Cells[0], b1 = b.m_Cells[1], b2 = b.m_Cells[2], b3 = b.m_Cells[3];
@@ -5275,7 +5191,7 @@ vec4 vec4::zero(vec4& out)
  * @param a
  * @returns {vec4} a new vector
  */
-vec4 vec4::fromVec(const vec2 a)
+vec4 vec4::fromVec(const vec2& a)
 {
     vec4 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -5288,7 +5204,7 @@ vec4 vec4::fromVec(const vec2 a)
  * @param a
  * @returns {vec4} a new vector
  */
-vec4 vec4::fromVec(const vec3 a)
+vec4 vec4::fromVec(const vec3& a)
 {
     vec4 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -5302,7 +5218,7 @@ vec4 vec4::fromVec(const vec3 a)
  * @param a
  * @returns {vec4} a new vector
  */
-vec4 vec4::fromVec(const vec4 a)
+vec4 vec4::fromVec(const vec4& a)
 {
     vec4 out;
     out.m_Cells[0] = a.m_Cells[0];
@@ -5321,18 +5237,20 @@ vec4 vec4::fromVec(const vec4 a)
  * @param k coefficient entre 0 et 1
  * @returns {vec4} out
  */
-vec4 vec4::hermite(vec4& out, const vec4 p0, const vec4 t0, const vec4 p1, const vec4 t1, const GLfloat k)
+vec4 vec4::hermite(vec4& out, const vec4& p0, const vec4& t0, const vec4& p1, const vec4& t1, const GLfloat k)
 {
     GLfloat h00 = ((2*k) - 3)*k*k + 1;
     GLfloat h10 = ((k - 2)*k + 1)*k;
     GLfloat h01 = (3 - 2*k)*k*k;
     GLfloat h11 = (k - 1)*k*k;
 
-    vec4::zero(out);
-    vec4::scaleAndAdd(out, out, p0, h00);
-    vec4::scaleAndAdd(out, out, t0, h10);
-    vec4::scaleAndAdd(out, out, p1, h01);
-    vec4::scaleAndAdd(out, out, t1, h11);
+    // accumulate in a local vector, out may be one of the operands
+    vec4 result = vec4::create();
+    vec4::scaleAndAdd(result, result, p0, h00);
+    vec4::scaleAndAdd(result, result, t0, h10);
+    vec4::scaleAndAdd(result, result, p1, h01);
+    vec4::scaleAndAdd(result, result, t1, h11);
+    out = result;
 
     return out;
 };
@@ -5347,7 +5265,7 @@ vec4 vec4::hermite(vec4& out, const vec4 p0, const vec4 t0, const vec4 p1, const
  * @param t interpolation amount between the two inputs
  * @returns {vec4} out
  */
-vec4 vec4::bezier(vec4& out, const vec4 a, const vec4 b, const vec4 c, const vec4 d, const GLfloat t)
+vec4 vec4::bezier(vec4& out, const vec4& a, const vec4& b, const vec4& c, const vec4& d, const GLfloat t)
 {
     GLfloat inverseFactor = 1 - t,
     inverseFactorTimesTwo = inverseFactor * inverseFactor,
@@ -5357,11 +5275,13 @@ vec4 vec4::bezier(vec4& out, const vec4 a, const vec4 b, const vec4 c, const vec
     factor3 = 3 * factorTimes2 * inverseFactor,
     factor4 = factorTimes2 * t;
 
-    vec4::zero(out);
-    vec4::scaleAndAdd(out, out, a, factor1);
-    vec4::scaleAndAdd(out, out, b, factor2);
-    vec4::scaleAndAdd(out, out, c, factor3);
-    vec4::scaleAndAdd(out, out, d, factor4);
+    // accumulate in a local vector, out may be one of the operands
+    vec4 result = vec4::create();
+    vec4::scaleAndAdd(result, result, a, factor1);
+    vec4::scaleAndAdd(result, result, b, factor2);
+    vec4::scaleAndAdd(result, result, c, factor3);
+    vec4::scaleAndAdd(result, result, d, factor4);
+    out = result;
 
     return out;
 };
@@ -5372,9 +5292,12 @@ vec4 vec4::bezier(vec4& out, const vec4 a, const vec4 b, const vec4 c, const vec
  * @param a the vector to send to OpenGL shader
  * @returns {void}
  */
-void vec4::glUniform(const GLint loc, const vec4 a)
+void vec4::glUniform(const GLint loc, const vec4& a)
 {
-    if (loc >= 0) glUniform4fv(loc, 1, (const GLfloat*)&a);
+    if (loc >= 0) {
+        glUniform4fv(loc, 1, (const GLfloat*)&a);
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 /**
  * calls glUniform4fv for the vector array a
@@ -5385,7 +5308,10 @@ void vec4::glUniform(const GLint loc, const vec4 a)
  */
 void vec4::glUniform(const GLint loc, const std::vector<vec4>& a)
 {
-    if (loc >= 0) glUniform4fv(loc, a.size(), (const GLfloat*)a.data());
+    if (loc >= 0) {
+        glUniform4fv(loc, a.size(), (const GLfloat*)a.data());
+        PROFILE_COUNT(UNIFORM_UPLOADS, 1);
+    }
 };
 
 const quat quat::null;
@@ -5429,7 +5355,7 @@ quat quat::identity(quat& out)
  * @param rad the angle in radians
  * @returns {quat} out
  **/
-quat quat::setAxisAngle(quat& out, const vec3 axis, const GLfloat rad)
+quat quat::setAxisAngle(quat& out, const vec3& axis, const GLfloat rad)
 {
     GLfloat angle = rad * 0.5;
     GLfloat s = sin(angle);
@@ -5453,7 +5379,7 @@ quat quat::setAxisAngle(quat& out, const vec3 axis, const GLfloat rad)
  * @param  {quat} q     Quaternion to be decomposed
  * @returns {Number}     Angle, in radians, of the rotation
  */
-GLfloat quat::getAxisAngle(vec3& out_axis, const quat q)
+GLfloat quat::getAxisAngle(vec3& out_axis, const quat& q)
 {
     GLfloat rad = acos(q.m_Cells[3]) * 2.0;
     GLfloat s = sin(rad / 2.0);
@@ -5478,7 +5404,7 @@ GLfloat quat::getAxisAngle(vec3& out_axis, const quat q)
  * @param b the second operand
  * @returns {quat} out
  */
-quat quat::multiply(quat& out, const quat a, const quat b)
+quat quat::multiply(quat& out, const quat& a, const quat& b)
 {
     GLfloat ax = a.m_Cells[0], ay = a.m_Cells[1], az = a.m_Cells[2], aw = a.m_Cells[3],
     bx = b.m_Cells[0], by = b.m_Cells[1], bz = b.m_Cells[2], bw = b.m_Cells[3];
@@ -5498,7 +5424,7 @@ quat quat::multiply(quat& out, const quat a, const quat b)
  * @param rad angle (in radians) to rotate
  * @returns {quat} out
  */
-quat quat::rotateX(quat& out, const quat a, const GLfloat rad)
+quat quat::rotateX(quat& out, const quat& a, const GLfloat rad)
 {
     GLfloat angle = rad * 0.5;
 
@@ -5520,7 +5446,7 @@ quat quat::rotateX(quat& out, const quat a, const GLfloat rad)
  * @param rad angle (in radians) to rotate
  * @returns {quat} out
  */
-quat quat::rotateY(quat& out, const quat a, const GLfloat rad)
+quat quat::rotateY(quat& out, const quat& a, const GLfloat rad)
 {
     GLfloat angle = rad * 0.5;
 
@@ -5542,7 +5468,7 @@ quat quat::rotateY(quat& out, const quat a, const GLfloat rad)
  * @param rad angle (in radians) to rotate
  * @returns {quat} out
  */
-quat quat::rotateZ(quat& out, const quat a, const GLfloat rad)
+quat quat::rotateZ(quat& out, const quat& a, const GLfloat rad)
 {
     GLfloat angle = rad * 0.5;
 
@@ -5565,7 +5491,7 @@ quat quat::rotateZ(quat& out, const quat a, const GLfloat rad)
  * @param a quat to calculate W component of
  * @returns {quat} out
  */
-quat quat::calculateW(quat& out, const quat a)
+quat quat::calculateW(quat& out, const quat& a)
 {
     GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2];
 
@@ -5585,7 +5511,7 @@ quat quat::calculateW(quat& out, const quat a)
  * @param t interpolation amount between the two inputs
  * @returns {quat} out
  */
-quat quat::slerp(quat& out, const quat a, const quat b, const GLfloat t)
+quat quat::slerp(quat& out, const quat& a, const quat& b, const GLfloat t)
 {
     // benchmarks:
     //    http://jsperf.com/quaternion-slerp-implementations
@@ -5634,7 +5560,7 @@ quat quat::slerp(quat& out, const quat a, const quat b, const GLfloat t)
  * @param a quat to calculate inverse of
  * @returns {quat} out
  */
-quat quat::invert(quat& out, const quat a)
+quat quat::invert(quat& out, const quat& a)
 {
     GLfloat a0 = a.m_Cells[0], a1 = a.m_Cells[1], a2 = a.m_Cells[2], a3 = a.m_Cells[3],
     dot = a0*a0 + a1*a1 + a2*a2 + a3*a3,
@@ -5657,7 +5583,7 @@ quat quat::invert(quat& out, const quat a)
  * @param a quat to calculate conjugate of
  * @returns {quat} out
  */
-quat quat::conjugate(quat& out, const quat a)
+quat quat::conjugate(quat& out, const quat& a)
 {
     out.m_Cells[0] = -a.m_Cells[0];
     out.m_Cells[1] = -a.m_Cells[1];
@@ -5677,7 +5603,7 @@ quat quat::conjugate(quat& out, const quat a)
  * @returns {quat} out
  * @function
  */
-quat quat::fromMat3(quat& out, const mat3 m)
+quat quat::fromMat3(quat& out, const mat3& m)
 {
     // Algorithm in Ken Shoemake"s article in 1987 SIGGRAPH course notes
     // article "Quaternion Calculus and Fast Animation".
@@ -5752,7 +5678,7 @@ quat quat::zero(quat& out)
  * @param b the destination vector
  * @returns {quat} out
  */
-quat quat::rotationTo(quat& out, const vec3 a, const vec3 b)
+quat quat::rotationTo(quat& out, const vec3& a, const vec3& b)
 {
     vec3 tmpvec3 = vec3::create();
     vec3 xUnitVec3 = vec3::fromValues(1,0,0);
@@ -5793,7 +5719,7 @@ quat quat::rotationTo(quat& out, const vec3 a, const vec3 b)
  * @param up    the vector representing the local "up" direction
  * @returns {quat} out
  */
-quat quat::setAxes(quat& out, const vec3 view, const vec3 right, const vec3 up)
+quat quat::setAxes(quat& out, const vec3& view, const vec3& right, const vec3& up)
 {
     mat3 matr = mat3::create();
 
@@ -5823,7 +5749,7 @@ quat quat::setAxes(quat& out, const vec3 view, const vec3 right, const vec3 up)
  * @param t interpolation amount
  * @returns {quat} out
  */
-quat quat::sqlerp(quat& out, const quat a, const quat b, const quat c, const quat d, const GLfloat t)
+quat quat::sqlerp(quat& out, const quat& a, const quat& b, const quat& c, const quat& d, const GLfloat t)
 {
     quat temp1 = quat::create();
     quat temp2 = quat::create();
@@ -5841,7 +5767,7 @@ quat quat::sqlerp(quat& out, const quat a, const quat b, const quat c, const qua
  * @param a quaternion to normalize
  * @returns {quat} out
  */
-quat quat::normalize(quat& out, const quat a)
+quat quat::normalize(quat& out, const quat& a)
 {
     GLfloat x = a.m_Cells[0],
         y = a.m_Cells[1],
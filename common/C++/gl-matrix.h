@@ -29,6 +29,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
 #include <string>
 #include <vector>
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 class vec2;
 class vec3;
@@ -116,7 +119,7 @@ public:
      * @param a matrix to clone
      * @returns {mat2} a new 2x2 matrix
      */
-    static mat2 clone(const mat2 a);
+    static mat2 clone(const mat2& a);
     /**
      * Copy the values from one mat2 to another
      *
@@ -124,7 +127,7 @@ public:
      * @param a the source matrix
      * @returns {mat2} out
      */
-    static mat2 copy(mat2& out, const mat2 a);
+    static mat2 copy(mat2& out, const mat2& a);
     /**
      * Set a mat2 to the identity matrix
      *
@@ -160,7 +163,7 @@ public:
      * @param a the source matrix
      * @returns {mat2} out
      */
-    static mat2 transpose(mat2& out, const mat2 a);
+    static mat2 transpose(mat2& out, const mat2& a);
     /**
      * Inverts a mat2
      *
@@ -168,7 +171,7 @@ public:
      * @param a the source matrix
      * @returns {mat2} out
      */
-    static mat2 invert(mat2& out, const mat2 a);
+    static mat2 invert(mat2& out, const mat2& a);
     /**
      * Calculates the adjugate of a mat2
      *
@@ -176,14 +179,14 @@ public:
      * @param a the source matrix
      * @returns {mat2} out
      */
-    static mat2 adjoint(mat2& out, const mat2 a);
+    static mat2 adjoint(mat2& out, const mat2& a);
     /**
      * Calculates the determinant of a mat2
      *
      * @param a the source matrix
      * @returns {Number} determinant of a
      */
-    static GLfloat determinant(const mat2 a);
+    static GLfloat determinant(const mat2& a);
     /**
      * Multiplies two mat2's
      *
@@ -192,7 +195,7 @@ public:
      * @param b the second operand
      * @returns {mat2} out
      */
-    static mat2 multiply(mat2& out, const mat2 a, const mat2 b);
+    static mat2 multiply(mat2& out, const mat2& a, const mat2& b);
     /**
      * Rotates a mat2 by the given angle
      *
@@ -201,7 +204,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat2} out
      */
-    static mat2 rotate(mat2& out, const mat2 a, const GLfloat rad);
+    static mat2 rotate(mat2& out, const mat2& a, const GLfloat rad);
     /**
      * Scales the mat2 by the dimensions in the given vec2
      *
@@ -210,7 +213,7 @@ public:
      * @param v the vec2 to scale the matrix by
      * @returns {mat2} out
      **/
-    static mat2 scale(mat2& out, const mat2 a, const vec2 v);
+    static mat2 scale(mat2& out, const mat2& a, const vec2& v);
     /**
      * Creates a matrix from a given angle
      * This is equivalent to (but much faster than):
@@ -234,14 +237,14 @@ public:
      * @param v Scaling vector
      * @returns {mat2} out
      */
-    static mat2 fromScaling(mat2& out, const vec2 v);
+    static mat2 fromScaling(mat2& out, const vec2& v);
     /**
      * Returns Frobenius norm of a mat2
      *
      * @param a the matrix to calculate Frobenius norm of
      * @returns {Number} Frobenius norm
      */
-    static GLfloat frob(const mat2 a);
+    static GLfloat frob(const mat2& a);
     /**
      * Adds two mat2's
      *
@@ -250,7 +253,7 @@ public:
      * @param b the second operand
      * @returns {mat2} out
      */
-    static mat2 add(mat2& out, const mat2 a, const mat2 b);
+    static mat2 add(mat2& out, const mat2& a, const mat2& b);
     /**
      * Subtracts matrix b from matrix a
      *
@@ -259,7 +262,7 @@ public:
      * @param b the second operand
      * @returns {mat2} out
      */
-    static mat2 subtract(mat2& out, const mat2 a, const mat2 b);
+    static mat2 subtract(mat2& out, const mat2& a, const mat2& b);
     /**
      * Returns whether or not the matrices have exactly the same elements in the same position (when compared with ===)
      *
@@ -267,7 +270,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool exactEquals(const mat2 a, const mat2 b);
+    static bool exactEquals(const mat2& a, const mat2& b);
     /**
      * Returns whether or not the matrices have approximately the same elements in the same position.
      *
@@ -275,7 +278,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool equals(const mat2 a, const mat2 b);
+    static bool equals(const mat2& a, const mat2& b);
     /**
      * Multiply each element of the matrix by a scalar.
      *
@@ -284,7 +287,7 @@ public:
      * @param b amount to scale the matrix's elements by
      * @returns {mat2} out
      */
-    static mat2 multiplyScalar(mat2& out, const mat2 a, const GLfloat b);
+    static mat2 multiplyScalar(mat2& out, const mat2& a, const GLfloat b);
     /**
      * Adds two mat2's after multiplying each element of the second operand by a scalar value.
      *
@@ -294,7 +297,7 @@ public:
      * @param scale the amount to scale b's elements by before adding
      * @returns {mat2} out
      */
-    static mat2 multiplyScalarAndAdd(mat2& out, const mat2 a, const mat2 b, const GLfloat scale);
+    static mat2 multiplyScalarAndAdd(mat2& out, const mat2& a, const mat2& b, const GLfloat scale);
     /**
      * Returns a string representation of a mat2
      *
@@ -316,7 +319,7 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniformMatrix(const GLint loc, const mat2 a);
+    static void glUniformMatrix(const GLint loc, const mat2& a);
 };
 /**
  * @class 2x3 Matrix
@@ -414,7 +417,7 @@ public:
      * @param a matrix to clone
      * @returns {mat2d} a new 2x3 matrix
      */
-    static mat2d clone(const mat2d a);
+    static mat2d clone(const mat2d& a);
     /**
      * Copy the values from one mat2d to another
      *
@@ -422,7 +425,7 @@ public:
      * @param a the source matrix
      * @returns {mat2d} out
      */
-    static mat2d copy(mat2d& out, const mat2d a);
+    static mat2d copy(mat2d& out, const mat2d& a);
     /**
      * Set a mat2d to the identity matrix
      *
@@ -462,14 +465,14 @@ public:
      * @param a the source matrix
      * @returns {mat2d} out
      */
-    static mat2d invert(mat2d& out, const mat2d a);
+    static mat2d invert(mat2d& out, const mat2d& a);
     /**
      * Calculates the determinant of a mat2d
      *
      * @param a the source matrix
      * @returns {Number} determinant of a
      */
-    static GLfloat determinant(const mat2d a);
+    static GLfloat determinant(const mat2d& a);
     /**
      * Multiplies two mat2d's
      *
@@ -478,7 +481,7 @@ public:
      * @param b the second operand
      * @returns {mat2d} out
      */
-    static mat2d multiply(mat2d& out, const mat2d a, const mat2d b);
+    static mat2d multiply(mat2d& out, const mat2d& a, const mat2d& b);
     /**
      * Rotates a mat2d by the given angle
      *
@@ -487,7 +490,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat2d} out
      */
-    static mat2d rotate(mat2d& out, const mat2d a, const GLfloat rad);
+    static mat2d rotate(mat2d& out, const mat2d& a, const GLfloat rad);
     /**
      * Scales the mat2d by the dimensions in the given vec2
      *
@@ -496,7 +499,7 @@ public:
      * @param v the vec2 to scale the matrix by
      * @returns {mat2d} out
      **/
-    static mat2d scale(mat2d& out, const mat2d a, const vec2 v);
+    static mat2d scale(mat2d& out, const mat2d& a, const vec2& v);
     /**
      * Translates the mat2d by the dimensions in the given vec2
      *
@@ -505,7 +508,7 @@ public:
      * @param v the vec2 to translate the matrix by
      * @returns {mat2d} out
      **/
-    static mat2d translate(mat2d& out, const mat2d a, const vec2 v);
+    static mat2d translate(mat2d& out, const mat2d& a, const vec2& v);
     /**
      * Creates a matrix from a given angle
      * This is equivalent to (but much faster than):
@@ -529,7 +532,7 @@ public:
      * @param v Scaling vector
      * @returns {mat2d} out
      */
-    static mat2d fromScaling(mat2d& out, const vec2 v);
+    static mat2d fromScaling(mat2d& out, const vec2& v);
     /**
      * Creates a matrix from a vector translation
      * This is equivalent to (but much faster than):
@@ -541,14 +544,14 @@ public:
      * @param v Translation vector
      * @returns {mat2d} out
      */
-    static mat2d fromTranslation(mat2d& out, const vec2 v);
+    static mat2d fromTranslation(mat2d& out, const vec2& v);
     /**
      * Returns Frobenius norm of a mat2d
      *
      * @param a the matrix to calculate Frobenius norm of
      * @returns {Number} Frobenius norm
      */
-    static GLfloat frob(const mat2d a);
+    static GLfloat frob(const mat2d& a);
     /**
      * Adds two mat2d's
      *
@@ -557,7 +560,7 @@ public:
      * @param b the second operand
      * @returns {mat2d} out
      */
-    static mat2d add(mat2d& out, const mat2d a, const mat2d b);
+    static mat2d add(mat2d& out, const mat2d& a, const mat2d& b);
     /**
      * Subtracts matrix b from matrix a
      *
@@ -566,7 +569,7 @@ public:
      * @param b the second operand
      * @returns {mat2d} out
      */
-    static mat2d subtract(mat2d& out, const mat2d a, const mat2d b);
+    static mat2d subtract(mat2d& out, const mat2d& a, const mat2d& b);
     /**
      * Multiply each element of the matrix by a scalar.
      *
@@ -575,7 +578,7 @@ public:
      * @param b amount to scale the matrix's elements by
      * @returns {mat2d} out
      */
-    static mat2d multiplyScalar(mat2d& out, const mat2d a, const GLfloat b);
+    static mat2d multiplyScalar(mat2d& out, const mat2d& a, const GLfloat b);
     /**
      * Adds two mat2d's after multiplying each element of the second operand by a scalar value.
      *
@@ -585,7 +588,7 @@ public:
      * @param scale the amount to scale b's elements by before adding
      * @returns {mat2d} out
      */
-    static mat2d multiplyScalarAndAdd(mat2d& out, const mat2d a, const mat2d b, const GLfloat scale);
+    static mat2d multiplyScalarAndAdd(mat2d& out, const mat2d& a, const mat2d& b, const GLfloat scale);
     /**
      * Returns whether or not the matrices have exactly the same elements in the same position (when compared with ===)
      *
@@ -593,7 +596,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool exactEquals(const mat2d a, const mat2d b);
+    static bool exactEquals(const mat2d& a, const mat2d& b);
     /**
      * Returns whether or not the matrices have approximately the same elements in the same position.
      *
@@ -601,7 +604,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool equals(const mat2d a, const mat2d b);
+    static bool equals(const mat2d& a, const mat2d& b);
     /**
      * Returns a string representation of a mat2d
      *
@@ -709,14 +712,14 @@ public:
      * @param a   the source 4x4 matrix
      * @returns {mat3} out
      */
-    static mat3 fromMat4(mat3& out, const mat4 a);
+    static mat3 fromMat4(mat3& out, const mat4& a);
     /**
      * Creates a new mat3 initialized with values from an existing matrix
      *
      * @param a matrix to clone
      * @returns {mat3} a new 3x3 matrix
      */
-    static mat3 clone(const mat3 a);
+    static mat3 clone(const mat3& a);
     /**
      * Copy the values from one mat3 to another
      *
@@ -724,7 +727,7 @@ public:
      * @param a the source matrix
      * @returns {mat3} out
      */
-    static mat3 copy(mat3& out, const mat3 a);
+    static mat3 copy(mat3& out, const mat3& a);
     /**
      * Create a new mat3 with the given values
      *
@@ -770,7 +773,7 @@ public:
      * @param a the source matrix
      * @returns {mat3} out
      */
-    static mat3 transpose(mat3& out, const mat3 a);
+    static mat3 transpose(mat3& out, const mat3& a);
     /**
      * Inverts a mat3
      *
@@ -778,7 +781,7 @@ public:
      * @param a the source matrix
      * @returns {mat3} out
      */
-    static mat3 invert(mat3& out, const mat3 a);
+    static mat3 invert(mat3& out, const mat3& a);
     /**
      * Calculates the adjugate of a mat3
      *
@@ -786,14 +789,14 @@ public:
      * @param a the source matrix
      * @returns {mat3} out
      */
-    static mat3 adjoint(mat3& out, const mat3 a);
+    static mat3 adjoint(mat3& out, const mat3& a);
     /**
      * Calculates the determinant of a mat3
      *
      * @param a the source matrix
      * @returns {Number} determinant of a
      */
-    static GLfloat determinant(const mat3 a);
+    static GLfloat determinant(const mat3& a);
     /**
      * Multiplies two mat3's
      *
@@ -802,7 +805,7 @@ public:
      * @param b the second operand
      * @returns {mat3} out
      */
-    static mat3 multiply(mat3& out, const mat3 a, const mat3 b);
+    static mat3 multiply(mat3& out, const mat3& a, const mat3& b);
     /**
      * Translate a mat3 by the given vector
      *
@@ -811,7 +814,7 @@ public:
      * @param v vector to translate by
      * @returns {mat3} out
      */
-    static mat3 translate(mat3& out, const mat3 a, const vec2 v);
+    static mat3 translate(mat3& out, const mat3& a, const vec2& v);
     /**
      * Rotates a mat3 by the given angle
      *
@@ -820,7 +823,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat3} out
      */
-    static mat3 rotate(mat3& out, const mat3 a, const GLfloat rad);
+    static mat3 rotate(mat3& out, const mat3& a, const GLfloat rad);
     /**
      * Scales the mat3 by the dimensions in the given vec2
      *
@@ -829,7 +832,7 @@ public:
      * @param v the vec2 to scale the matrix by
      * @returns {mat3} out
      **/
-    static mat3 scale(mat3& out, const mat3 a, const vec2 v);
+    static mat3 scale(mat3& out, const mat3& a, const vec2& v);
     /**
      * Creates a matrix from a vector translation
      * This is equivalent to (but much faster than):
@@ -841,7 +844,7 @@ public:
      * @param v Translation vector
      * @returns {mat3} out
      */
-    static mat3 fromTranslation(mat3& out, const vec2 v);
+    static mat3 fromTranslation(mat3& out, const vec2& v);
     /**
      * Creates a matrix from a given angle
      * This is equivalent to (but much faster than):
@@ -865,7 +868,7 @@ public:
      * @param v Scaling vector
      * @returns {mat3} out
      */
-    static mat3 fromScaling(mat3& out, const vec2 v);
+    static mat3 fromScaling(mat3& out, const vec2& v);
     /**
      * Copies the values from a mat2d into a mat3
      *
@@ -873,7 +876,7 @@ public:
      * @param a the matrix to copy
      * @returns {mat3} out
      **/
-    static mat3 fromMat2d(mat3& out, const mat2d a);
+    static mat3 fromMat2d(mat3& out, const mat2d& a);
     /**
     * Calculates a 3x3 matrix from the given quaternion
     *
@@ -882,7 +885,7 @@ public:
     *
     * @returns {mat3} out
     */
-    static mat3 fromQuat(mat3& out, const quat q);
+    static mat3 fromQuat(mat3& out, const quat& q);
     /**
     * Calculates a 3x3 normal matrix (transpose inverse) from the 4x4 matrix
     *
@@ -891,14 +894,14 @@ public:
     *
     * @returns {mat3} out
     */
-    static mat3 normalFromMat4(mat3& out, const mat4 a);
+    static mat3 normalFromMat4(mat3& out, const mat4& a);
     /**
      * Returns Frobenius norm of a mat3
      *
      * @param a the matrix to calculate Frobenius norm of
      * @returns {Number} Frobenius norm
      */
-    static GLfloat frob(const mat3 a);
+    static GLfloat frob(const mat3& a);
     /**
      * Adds two mat3's
      *
@@ -907,7 +910,7 @@ public:
      * @param b the second operand
      * @returns {mat3} out
      */
-    static mat3 add(mat3& out, const mat3 a, const mat3 b);
+    static mat3 add(mat3& out, const mat3& a, const mat3& b);
     /**
      * Subtracts matrix b from matrix a
      *
@@ -916,7 +919,7 @@ public:
      * @param b the second operand
      * @returns {mat3} out
      */
-    static mat3 subtract(mat3& out, const mat3 a, const mat3 b);
+    static mat3 subtract(mat3& out, const mat3& a, const mat3& b);
     /**
      * Multiply each element of the matrix by a scalar.
      *
@@ -925,7 +928,7 @@ public:
      * @param b amount to scale the matrix's elements by
      * @returns {mat3} out
      */
-    static mat3 multiplyScalar(mat3& out, const mat3 a, const GLfloat b);
+    static mat3 multiplyScalar(mat3& out, const mat3& a, const GLfloat b);
     /**
      * Adds two mat3's after multiplying each element of the second operand by a scalar value.
      *
@@ -935,7 +938,7 @@ public:
      * @param scale the amount to scale b's elements by before adding
      * @returns {mat3} out
      */
-    static mat3 multiplyScalarAndAdd(mat3& out, const mat3 a, const mat3 b, const GLfloat scale);
+    static mat3 multiplyScalarAndAdd(mat3& out, const mat3& a, const mat3& b, const GLfloat scale);
     /**
      * Returns whether or not the matrices have exactly the same elements in the same position (when compared with ===)
      *
@@ -943,7 +946,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool exactEquals(const mat3 a, const mat3 b);
+    static bool exactEquals(const mat3& a, const mat3& b);
     /**
      * Returns whether or not the matrices have approximately the same elements in the same position.
      *
@@ -951,7 +954,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool equals(const mat3 a, const mat3 b);
+    static bool equals(const mat3& a, const mat3& b);
     /**
      * Returns a string representation of a mat3
      *
@@ -973,13 +976,13 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniformMatrix(const GLint loc, const mat3 a);
+    static void glUniformMatrix(const GLint loc, const mat3& a);
 };
 /**
  * @class 4x4 Matrix
  * @name mat4
  */
-class mat4 {
+class alignas(16) mat4 {
 
 private:
 
@@ -1087,7 +1090,7 @@ public:
      * @param a matrix to clone
      * @returns {mat4} a new 4x4 matrix
      */
-    static mat4 clone(const mat4 a);
+    static mat4 clone(const mat4& a);
     /**
      * Copy the values from one mat4 to another
      *
@@ -1095,7 +1098,7 @@ public:
      * @param a the source matrix
      * @returns {mat4} out
      */
-    static mat4 copy(mat4& out, const mat4 a);
+    static mat4 copy(mat4& out, const mat4& a);
     /**
      * Create a new mat4 with the given values
      *
@@ -1155,7 +1158,7 @@ public:
      * @param a the source matrix
      * @returns {mat4} out
      */
-    static mat4 transpose(mat4& out, const mat4 a);
+    static mat4 transpose(mat4& out, const mat4& a);
     /**
      * Inverts a mat4 not using SIMD
      *
@@ -1163,7 +1166,7 @@ public:
      * @param a the source matrix
      * @returns {mat4} out
      */
-    static mat4 invert(mat4& out, const mat4 a);
+    static mat4 invert(mat4& out, const mat4& a);
     /**
      * Calculates the adjugate of a mat4 not using SIMD
      *
@@ -1171,14 +1174,14 @@ public:
      * @param a the source matrix
      * @returns {mat4} out
      */
-    static mat4 adjoint(mat4& out, const mat4 a);
+    static mat4 adjoint(mat4& out, const mat4& a);
     /**
      * Calculates the determinant of a mat4
      *
      * @param a the source matrix
      * @returns {Number} determinant of a
      */
-    static GLfloat determinant(const mat4 a);
+    static GLfloat determinant(const mat4& a);
     /**
      * Multiplies two mat4's explicitly not using SIMD
      *
@@ -1187,7 +1190,7 @@ public:
      * @param b the second operand
      * @returns {mat4} out
      */
-    static mat4 multiply(mat4& out, const mat4 a, const mat4 b);
+    static mat4 multiply(mat4& out, const mat4& a, const mat4& b);
     /**
      * Translate a mat4 by the given vector not using SIMD
      *
@@ -1196,7 +1199,7 @@ public:
      * @param v vector to translate by
      * @returns {mat4} out
      */
-    static mat4 translate(mat4& out, const mat4 a, const vec3 v);
+    static mat4 translate(mat4& out, const mat4& a, const vec3& v);
     /**
      * Scales the mat4 by the dimensions in the given vec3 not using vectorization
      *
@@ -1205,7 +1208,7 @@ public:
      * @param v the vec3 to scale the matrix by
      * @returns {mat4} out
      **/
-    static mat4 scale(mat4& out, const mat4 a, const vec3 v);
+    static mat4 scale(mat4& out, const mat4& a, const vec3& v);
     /**
      * Rotates a mat4 by the given angle around the given axis
      *
@@ -1215,7 +1218,7 @@ public:
      * @param axis the axis to rotate around
      * @returns {mat4} out
      */
-    static mat4 rotate(mat4& out, const mat4 a, const GLfloat rad, const vec3 axis);
+    static mat4 rotate(mat4& out, const mat4& a, const GLfloat rad, const vec3& axis);
     /**
      * Rotates a matrix by the given angle around the X axis not using SIMD
      *
@@ -1224,7 +1227,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat4} out
      */
-    static mat4 rotateX(mat4& out, const mat4 a, const GLfloat rad);
+    static mat4 rotateX(mat4& out, const mat4& a, const GLfloat rad);
     /**
      * Rotates a matrix by the given angle around the Y axis not using SIMD
      *
@@ -1233,7 +1236,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat4} out
      */
-    static mat4 rotateY(mat4& out, const mat4 a, const GLfloat rad);
+    static mat4 rotateY(mat4& out, const mat4& a, const GLfloat rad);
     /**
      * Rotates a matrix by the given angle around the Z axis not using SIMD
      *
@@ -1242,7 +1245,7 @@ public:
      * @param rad the angle to rotate the matrix by
      * @returns {mat4} out
      */
-    static mat4 rotateZ(mat4& out, const mat4 a, const GLfloat rad);
+    static mat4 rotateZ(mat4& out, const mat4& a, const GLfloat rad);
     /**
      * Creates a matrix from a vector translation
      * This is equivalent to (but much faster than):
@@ -1254,7 +1257,7 @@ public:
      * @param v Translation vector
      * @returns {mat4} out
      */
-    static mat4 fromTranslation(mat4& out, const vec3 v);
+    static mat4 fromTranslation(mat4& out, const vec3& v);
     /**
      * Creates a matrix from a vector scaling
      * This is equivalent to (but much faster than):
@@ -1266,7 +1269,7 @@ public:
      * @param v Scaling vector
      * @returns {mat4} out
      */
-    static mat4 fromScaling(mat4& out, const vec3 v);
+    static mat4 fromScaling(mat4& out, const vec3& v);
     /**
      * Creates a matrix from a given angle around a given axis
      * This is equivalent to (but much faster than):
@@ -1279,7 +1282,7 @@ public:
      * @param axis the axis to rotate around
      * @returns {mat4} out
      */
-    static mat4 fromRotation(mat4& out, const GLfloat rad, const vec3 axis);
+    static mat4 fromRotation(mat4& out, const GLfloat rad, const vec3& axis);
     /**
      * Creates a matrix from the given angle around the X axis
      * This is equivalent to (but much faster than):
@@ -1331,7 +1334,7 @@ public:
      * @param v Translation vector
      * @returns {mat4} out
      */
-    static mat4 fromRotationTranslation(mat4& out, const quat q, const vec3 v);
+    static mat4 fromRotationTranslation(mat4& out, const quat& q, const vec3& v);
     /**
      * Returns the translation vector component of a transformation
      *  matrix. If a matrix is built with fromRotationTranslation,
@@ -1341,7 +1344,7 @@ public:
      * @param  {mat4} mat Matrix to be decomposed (input)
      * @returns {vec3} out
      */
-    static vec3 getTranslation(vec3& out, const mat4 mat);
+    static vec3 getTranslation(vec3& out, const mat4& mat);
     /**
      * Returns a quaternion representing the rotational component
      *  of a transformation matrix. If a matrix is built with
@@ -1351,7 +1354,7 @@ public:
      * @param mat Matrix to be decomposed (input)
      * @returns {quat} out
      */
-    static quat getRotation(quat& out, const mat4 mat);
+    static quat getRotation(quat& out, const mat4& mat);
     /**
      * Creates a matrix from a quaternion rotation, vector translation and vector scale
      * This is equivalent to (but much faster than):
@@ -1369,7 +1372,7 @@ public:
      * @param s Scaling vector
      * @returns {mat4} out
      */
-    static mat4 fromRotationTranslationScale(mat4& out, const quat q, const vec3 v, const vec3 s);
+    static mat4 fromRotationTranslationScale(mat4& out, const quat& q, const vec3& v, const vec3& s);
     /**
      * Creates a matrix from a quaternion rotation, vector translation and vector scale, rotating and scaling around the given origin
      * This is equivalent to (but much faster than):
@@ -1390,7 +1393,7 @@ public:
      * @param o The origin vector around which to scale and rotate
      * @returns {mat4} out
      */
-    static mat4 fromRotationTranslationScaleOrigin(mat4& out, const quat q, const vec3 v, const vec3 s, const vec3 o);
+    static mat4 fromRotationTranslationScaleOrigin(mat4& out, const quat& q, const vec3& v, const vec3& s, const vec3& o);
     /**
      * Calculates a 4x4 matrix from the given quaternion
      *
@@ -1399,7 +1402,7 @@ public:
      *
      * @returns {mat4} out
      */
-    static mat4 fromQuat(mat4& out, const quat q);
+    static mat4 fromQuat(mat4& out, const quat& q);
     /**
      * Generates a frustum matrix with the given bounds
      *
@@ -1446,14 +1449,14 @@ public:
      * @param up vec3 pointing up
      * @returns {mat4} out
      */
-    static mat4 lookAt(mat4& out, const vec3 eye, const vec3 center, const vec3 up);
+    static mat4 lookAt(mat4& out, const vec3& eye, const vec3& center, const vec3& up);
     /**
      * Returns Frobenius norm of a mat4
      *
      * @param a the matrix to calculate Frobenius norm of
      * @returns {Number} Frobenius norm
      */
-    static GLfloat frob(const mat4 a);
+    static GLfloat frob(const mat4& a);
     /**
      * Adds two mat4's
      *
@@ -1462,7 +1465,7 @@ public:
      * @param b the second operand
      * @returns {mat4} out
      */
-    static mat4 add(mat4& out, const mat4 a, const mat4 b);
+    static mat4 add(mat4& out, const mat4& a, const mat4& b);
     /**
      * Subtracts matrix b from matrix a
      *
@@ -1471,7 +1474,7 @@ public:
      * @param b the second operand
      * @returns {mat4} out
      */
-    static mat4 subtract(mat4& out, const mat4 a, const mat4 b);
+    static mat4 subtract(mat4& out, const mat4& a, const mat4& b);
     /**
      * Multiply each element of the matrix by a scalar.
      *
@@ -1480,7 +1483,7 @@ public:
      * @param b amount to scale the matrix's elements by
      * @returns {mat4} out
      */
-    static mat4 multiplyScalar(mat4& out, const mat4 a, const GLfloat b);
+    static mat4 multiplyScalar(mat4& out, const mat4& a, const GLfloat b);
     /**
      * Adds two mat4's after multiplying each element of the second operand by a scalar value.
      *
@@ -1490,7 +1493,7 @@ public:
      * @param scale the amount to scale b's elements by before adding
      * @returns {mat4} out
      */
-    static mat4 multiplyScalarAndAdd(mat4& out, const mat4 a, const mat4 b, const GLfloat scale);
+    static mat4 multiplyScalarAndAdd(mat4& out, const mat4& a, const mat4& b, const GLfloat scale);
     /**
      * Returns whether or not the matrices have exactly the same elements in the same position (when compared with ===)
      *
@@ -1498,7 +1501,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool exactEquals(const mat4 a, const mat4 b);
+    static bool exactEquals(const mat4& a, const mat4& b);
     /**
      * Returns whether or not the matrices have approximately the same elements in the same position.
      *
@@ -1506,7 +1509,7 @@ public:
      * @param b The second matrix.
      * @returns {Boolean} True if the matrices are equal, false otherwise.
      */
-    static bool equals(const mat4 a, const mat4 b);
+    static bool equals(const mat4& a, const mat4& b);
     /**
      * Returns a string representation of a mat4
      *
@@ -1528,7 +1531,7 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniformMatrix(const GLint loc, const mat4 a);
+    static void glUniformMatrix(const GLint loc, const mat4& a);
 };
 /**
  * @class 2 Dimensional Vector
@@ -1600,7 +1603,7 @@ public:
      * @param a vector to clone
      * @returns {vec2} a new 2D vector
      */
-    static vec2 clone(const vec2 a);
+    static vec2 clone(const vec2& a);
     /**
      * Creates a new vec2 initialized with the given values
      *
@@ -1616,7 +1619,7 @@ public:
      * @param a the source vector
      * @returns {vec2} out
      */
-    static vec2 copy(vec2& out, const vec2 a);
+    static vec2 copy(vec2& out, const vec2& a);
     /**
      * Set the components of a vec2 to the given values
      *
@@ -1634,7 +1637,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 add(vec2& out, const vec2 a, const vec2 b);
+    static vec2 add(vec2& out, const vec2& a, const vec2& b);
     /**
      * Subtracts vector b from vector a
      *
@@ -1643,7 +1646,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 subtract(vec2& out, const vec2 a, const vec2 b);
+    static vec2 subtract(vec2& out, const vec2& a, const vec2& b);
     /**
      * Multiplies two vec2's
      *
@@ -1652,7 +1655,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 multiply(vec2& out, const vec2 a, const vec2 b);
+    static vec2 multiply(vec2& out, const vec2& a, const vec2& b);
     /**
      * Divides two vec2's
      *
@@ -1661,7 +1664,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 divide(vec2& out, const vec2 a, const vec2 b);
+    static vec2 divide(vec2& out, const vec2& a, const vec2& b);
     /**
      * Math.ceil the components of a vec2
      *
@@ -1669,7 +1672,7 @@ public:
      * @param a vector to ceil
      * @returns {vec2} out
      */
-    static vec2 ceil(vec2& out, const vec2 a);
+    static vec2 ceil(vec2& out, const vec2& a);
     /**
      * Math.floor the components of a vec2
      *
@@ -1677,7 +1680,7 @@ public:
      * @param a vector to floor
      * @returns {vec2} out
      */
-    static vec2 floor(vec2& out, const vec2 a);
+    static vec2 floor(vec2& out, const vec2& a);
     /**
      * Returns the minimum of two vec2's
      *
@@ -1686,7 +1689,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 min(vec2& out, const vec2 a, const vec2 b);
+    static vec2 min(vec2& out, const vec2& a, const vec2& b);
     /**
      * Returns the maximum of two vec2's
      *
@@ -1695,7 +1698,7 @@ public:
      * @param b the second operand
      * @returns {vec2} out
      */
-    static vec2 max(vec2& out, const vec2 a, const vec2 b);
+    static vec2 max(vec2& out, const vec2& a, const vec2& b);
     /**
      * Math.round the components of a vec2
      *
@@ -1703,7 +1706,7 @@ public:
      * @param a vector to round
      * @returns {vec2} out
      */
-    static vec2 round(vec2& out, const vec2 a);
+    static vec2 round(vec2& out, const vec2& a);
     /**
      * Scales a vec2 by a scalar Number
      *
@@ -1712,7 +1715,7 @@ public:
      * @param b amount to scale the vector by
      * @returns {vec2} out
      */
-    static vec2 scale(vec2& out, const vec2 a, const GLfloat b);
+    static vec2 scale(vec2& out, const vec2& a, const GLfloat b);
     /**
      * Adds two vec2's after scaling the second operand by a scalar value
      *
@@ -1722,7 +1725,7 @@ public:
      * @param scale the amount to scale b by before adding
      * @returns {vec2} out
      */
-    static vec2 scaleAndAdd(vec2& out, const vec2 a, const vec2 b, const GLfloat scale);
+    static vec2 scaleAndAdd(vec2& out, const vec2& a, const vec2& b, const GLfloat scale);
     /**
      * Calculates the euclidian distance between two vec2's
      *
@@ -1730,7 +1733,7 @@ public:
      * @param b the second operand
      * @returns {Number} distance between a and b
      */
-    static GLfloat distance(const vec2 a, const vec2 b);
+    static GLfloat distance(const vec2& a, const vec2& b);
     /**
      * Calculates the squared euclidian distance between two vec2's
      *
@@ -1738,21 +1741,21 @@ public:
      * @param b the second operand
      * @returns {Number} squared distance between a and b
      */
-    static GLfloat squaredDistance(const vec2 a, const vec2 b);
+    static GLfloat squaredDistance(const vec2& a, const vec2& b);
     /**
      * Calculates the length of a vec2
      *
      * @param a vector to calculate length of
      * @returns {Number} length of a
      */
-    static GLfloat length(const vec2 a);
+    static GLfloat length(const vec2& a);
     /**
      * Calculates the squared length of a vec2
      *
      * @param a vector to calculate squared length of
      * @returns {Number} squared length of a
      */
-    static GLfloat squaredLength(const vec2 a);
+    static GLfloat squaredLength(const vec2& a);
     /**
      * Negates the components of a vec2
      *
@@ -1760,7 +1763,7 @@ public:
      * @param a vector to negate
      * @returns {vec2} out
      */
-    static vec2 negate(vec2& out, const vec2 a);
+    static vec2 negate(vec2& out, const vec2& a);
     /**
      * Returns the inverse of the components of a vec2
      *
@@ -1768,7 +1771,7 @@ public:
      * @param a vector to invert
      * @returns {vec2} out
      */
-    static vec2 inverse(vec2& out, const vec2 a);
+    static vec2 inverse(vec2& out, const vec2& a);
     /**
      * Normalize a vec2
      *
@@ -1776,7 +1779,7 @@ public:
      * @param a vector to normalize
      * @returns {vec2} out
      */
-    static vec2 normalize(vec2& out, const vec2 a);
+    static vec2 normalize(vec2& out, const vec2& a);
     /**
      * Calculates the dot product of two vec2's
      *
@@ -1784,7 +1787,7 @@ public:
      * @param b the second operand
      * @returns {Number} dot product of a and b
      */
-    static GLfloat dot(const vec2 a, const vec2 b);
+    static GLfloat dot(const vec2& a, const vec2& b);
     /**
      * Computes the cross product of two vec2's
      * Note that the cross product must by definition produce a 3D vector
@@ -1794,7 +1797,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 cross(vec3& out, const vec2 a, const vec2 b);
+    static vec3 cross(vec3& out, const vec2& a, const vec2& b);
     /**
      * Performs a linear interpolation between two vec2's
      *
@@ -1804,7 +1807,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec2} out
      */
-    static vec2 lerp(vec2& out, const vec2 a, const vec2 b, const GLfloat t);
+    static vec2 lerp(vec2& out, const vec2& a, const vec2& b, const GLfloat t);
     /**
      * Generates a random vector with the given scale
      *
@@ -1821,7 +1824,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec2} out
      */
-    static vec2 transformMat2(vec2& out, const vec2 a, const mat2 m);
+    static vec2 transformMat2(vec2& out, const vec2& a, const mat2& m);
     /**
      * Transforms the vec2 with a mat2d
      *
@@ -1830,7 +1833,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec2} out
      */
-    static vec2 transformMat2d(vec2& out, const vec2 a, const mat2d m);
+    static vec2 transformMat2d(vec2& out, const vec2& a, const mat2d& m);
     /**
      * Transforms the vec2 with a mat3
      * 3rd vector component is implicitly '1'
@@ -1840,7 +1843,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec2} out
      */
-    static vec2 transformMat3(vec2& out, const vec2 a, const mat3 m);
+    static vec2 transformMat3(vec2& out, const vec2& a, const mat3& m);
     /**
      * Transforms the vec2 with a mat4
      * 3rd vector component is implicitly '0'
@@ -1851,7 +1854,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec2} out
      */
-    static vec2 transformMat4(vec2& out, const vec2 a, const mat4 m);
+    static vec2 transformMat4(vec2& out, const vec2& a, const mat4& m);
     /**
      * Returns whether or not the vectors exactly have the same elements in the same position (when compared with ===)
      *
@@ -1859,7 +1862,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool exactEquals(const vec2 a, const vec2 b);
+    static bool exactEquals(const vec2& a, const vec2& b);
     /**
      * Returns whether or not the vectors have approximately the same elements in the same position.
      *
@@ -1867,7 +1870,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool equals(const vec2 a, const vec2 b);
+    static bool equals(const vec2& a, const vec2& b);
     /**
      * Returns a string representation of a vec2
      *
@@ -1888,21 +1891,21 @@ public:
      * @param a
      * @returns {vec2} a new vector
      */
-    static vec2 fromVec(const vec2 a);
+    static vec2 fromVec(const vec2& a);
     /**
      * Creates a new vec2 initialized from the given vec3
      *
      * @param a
      * @returns {vec2} a new vector
      */
-    static vec2 fromVec(const vec3 a);
+    static vec2 fromVec(const vec3& a);
     /**
      * Creates a new vec2 initialized from the given vec4
      *
      * @param a
      * @returns {vec2} a new vector
      */
-    static vec2 fromVec(const vec4 a);
+    static vec2 fromVec(const vec4& a);
     /**
      * Cette méthode calcule le vec2 interpolé par une spline cubique de Hermite entre (p0,t0), (p1,t1)
      * @param out the receiving vector
@@ -1913,7 +1916,7 @@ public:
      * @param k coefficient entre 0 et 1
      * @returns {vec2} out
      */
-    static vec2 hermite(vec2& out, const vec2 p0, const vec2 t0, const vec2 p1, const vec2 t1, const GLfloat k);
+    static vec2 hermite(vec2& out, const vec2& p0, const vec2& t0, const vec2& p1, const vec2& t1, const GLfloat k);
     /**
      * Performs a bezier interpolation with two control points
      *
@@ -1925,7 +1928,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec2} out
      */
-    static vec2 bezier(vec2& out, const vec2 a, const vec2 b, const vec2 c, const vec2 d, const GLfloat t);
+    static vec2 bezier(vec2& out, const vec2& a, const vec2& b, const vec2& c, const vec2& d, const GLfloat t);
     /**
      * calls glUniform2fv for the vector a
      *
@@ -1933,7 +1936,7 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniform(const GLint loc, const vec2 a);
+    static void glUniform(const GLint loc, const vec2& a);
     /**
      * calls glUniform2fv for the vector array a
      *
@@ -2016,7 +2019,7 @@ public:
      * @param a vector to clone
      * @returns {vec3} a new 3D vector
      */
-    static vec3 clone(const vec3 a);
+    static vec3 clone(const vec3& a);
     /**
      * Creates a new vec3 initialized with the given values
      *
@@ -2033,7 +2036,7 @@ public:
      * @param a the source vector
      * @returns {vec3} out
      */
-    static vec3 copy(vec3& out, const vec3 a);
+    static vec3 copy(vec3& out, const vec3& a);
     /**
      * Set the components of a vec3 to the given values
      *
@@ -2052,7 +2055,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 add(vec3& out, const vec3 a, const vec3 b);
+    static vec3 add(vec3& out, const vec3& a, const vec3& b);
     /**
      * Subtracts vector b from vector a
      *
@@ -2061,7 +2064,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 subtract(vec3& out, const vec3 a, const vec3 b);
+    static vec3 subtract(vec3& out, const vec3& a, const vec3& b);
     /**
      * Multiplies two vec3's
      *
@@ -2070,7 +2073,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 multiply(vec3& out, const vec3 a, const vec3 b);
+    static vec3 multiply(vec3& out, const vec3& a, const vec3& b);
     /**
      * Divides two vec3's
      *
@@ -2079,7 +2082,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 divide(vec3& out, const vec3 a, const vec3 b);
+    static vec3 divide(vec3& out, const vec3& a, const vec3& b);
     /**
      * Math.ceil the components of a vec3
      *
@@ -2087,7 +2090,7 @@ public:
      * @param a vector to ceil
      * @returns {vec3} out
      */
-    static vec3 ceil(vec3& out, const vec3 a);
+    static vec3 ceil(vec3& out, const vec3& a);
     /**
      * Math.floor the components of a vec3
      *
@@ -2095,7 +2098,7 @@ public:
      * @param a vector to floor
      * @returns {vec3} out
      */
-    static vec3 floor(vec3& out, const vec3 a);
+    static vec3 floor(vec3& out, const vec3& a);
     /**
      * Returns the minimum of two vec3's
      *
@@ -2104,7 +2107,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 min(vec3& out, const vec3 a, const vec3 b);
+    static vec3 min(vec3& out, const vec3& a, const vec3& b);
     /**
      * Returns the maximum of two vec3's
      *
@@ -2113,7 +2116,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 max(vec3& out, const vec3 a, const vec3 b);
+    static vec3 max(vec3& out, const vec3& a, const vec3& b);
     /**
      * Math.round the components of a vec3
      *
@@ -2121,7 +2124,7 @@ public:
      * @param a vector to round
      * @returns {vec3} out
      */
-    static vec3 round(vec3& out, const vec3 a);
+    static vec3 round(vec3& out, const vec3& a);
     /**
      * Scales a vec3 by a scalar Number
      *
@@ -2130,7 +2133,7 @@ public:
      * @param b amount to scale the vector by
      * @returns {vec3} out
      */
-    static vec3 scale(vec3& out, const vec3 a, const GLfloat b);
+    static vec3 scale(vec3& out, const vec3& a, const GLfloat b);
     /**
      * Adds two vec3's after scaling the second operand by a scalar value
      *
@@ -2140,7 +2143,7 @@ public:
      * @param scale the amount to scale b by before adding
      * @returns {vec3} out
      */
-    static vec3 scaleAndAdd(vec3& out, const vec3 a, const vec3 b, const GLfloat scale);
+    static vec3 scaleAndAdd(vec3& out, const vec3& a, const vec3& b, const GLfloat scale);
     /**
      * Calculates the euclidian distance between two vec3's
      *
@@ -2148,7 +2151,7 @@ public:
      * @param b the second operand
      * @returns {Number} distance between a and b
      */
-    static GLfloat distance(const vec3 a, const vec3 b);
+    static GLfloat distance(const vec3& a, const vec3& b);
     /**
      * Calculates the squared euclidian distance between two vec3's
      *
@@ -2156,21 +2159,21 @@ public:
      * @param b the second operand
      * @returns {Number} squared distance between a and b
      */
-    static GLfloat squaredDistance(const vec3 a, const vec3 b);
+    static GLfloat squaredDistance(const vec3& a, const vec3& b);
     /**
      * Calculates the length of a vec3
      *
      * @param a vector to calculate length of
      * @returns {Number} length of a
      */
-    static GLfloat length(const vec3 a);
+    static GLfloat length(const vec3& a);
     /**
      * Calculates the squared length of a vec3
      *
      * @param a vector to calculate squared length of
      * @returns {Number} squared length of a
      */
-    static GLfloat squaredLength(const vec3 a);
+    static GLfloat squaredLength(const vec3& a);
     /**
      * Negates the components of a vec3
      *
@@ -2178,7 +2181,7 @@ public:
      * @param a vector to negate
      * @returns {vec3} out
      */
-    static vec3 negate(vec3& out, const vec3 a);
+    static vec3 negate(vec3& out, const vec3& a);
     /**
      * Returns the inverse of the components of a vec3
      *
@@ -2186,7 +2189,7 @@ public:
      * @param a vector to invert
      * @returns {vec3} out
      */
-    static vec3 inverse(vec3& out, const vec3 a);
+    static vec3 inverse(vec3& out, const vec3& a);
     /**
      * Normalize a vec3
      *
@@ -2194,7 +2197,7 @@ public:
      * @param a vector to normalize
      * @returns {vec3} out
      */
-    static vec3 normalize(vec3& out, const vec3 a);
+    static vec3 normalize(vec3& out, const vec3& a);
     /**
      * Calculates the dot product of two vec3's
      *
@@ -2202,7 +2205,7 @@ public:
      * @param b the second operand
      * @returns {Number} dot product of a and b
      */
-    static GLfloat dot(const vec3 a, const vec3 b);
+    static GLfloat dot(const vec3& a, const vec3& b);
     /**
      * Computes the cross product of two vec3's
      *
@@ -2211,7 +2214,7 @@ public:
      * @param b the second operand
      * @returns {vec3} out
      */
-    static vec3 cross(vec3& out, const vec3 a, const vec3 b);
+    static vec3 cross(vec3& out, const vec3& a, const vec3& b);
     /**
      * Performs a linear interpolation between two vec3's
      *
@@ -2221,7 +2224,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec3} out
      */
-    static vec3 lerp(vec3& out, const vec3 a, const vec3 b, const GLfloat t);
+    static vec3 lerp(vec3& out, const vec3& a, const vec3& b, const GLfloat t);
     /**
      * Generates a random vector with the given scale
      *
@@ -2239,7 +2242,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec3} out
      */
-    static vec3 transformMat4(vec3& out, const vec3 a, const mat4 m);
+    static vec3 transformMat4(vec3& out, const vec3& a, const mat4& m);
     /**
      * Transforms the vec3 with a mat3.
      *
@@ -2248,7 +2251,7 @@ public:
      * @param m the 3x3 matrix to transform with
      * @returns {vec3} out
      */
-    static vec3 transformMat3(vec3& out, const vec3 a, const mat4 m);
+    static vec3 transformMat3(vec3& out, const vec3& a, const mat4& m);
     /**
      * Transforms the vec3 with a quat
      *
@@ -2257,7 +2260,7 @@ public:
      * @param q quaternion to transform with
      * @returns {vec3} out
      */
-    static vec3 transformQuat(vec3& out, const vec3 a, const quat q);
+    static vec3 transformQuat(vec3& out, const vec3& a, const quat& q);
     /**
      * Rotate a 3D vector around the x-axis
      * @param out The receiving vec3
@@ -2266,7 +2269,7 @@ public:
      * @param c The angle of rotation
      * @returns {vec3} out
      */
-    static vec3 rotateX(vec3& out, const vec3 a, const vec3 b, const GLfloat c);
+    static vec3 rotateX(vec3& out, const vec3& a, const vec3& b, const GLfloat c);
     /**
      * Rotate a 3D vector around the y-axis
      * @param out The receiving vec3
@@ -2275,7 +2278,7 @@ public:
      * @param c The angle of rotation
      * @returns {vec3} out
      */
-    static vec3 rotateY(vec3& out, const vec3 a, const vec3 b, const GLfloat c);
+    static vec3 rotateY(vec3& out, const vec3& a, const vec3& b, const GLfloat c);
     /**
      * Rotate a 3D vector around the z-axis
      * @param out The receiving vec3
@@ -2284,14 +2287,14 @@ public:
      * @param c The angle of rotation
      * @returns {vec3} out
      */
-    static vec3 rotateZ(vec3& out, const vec3 a, const vec3 b, const GLfloat c);
+    static vec3 rotateZ(vec3& out, const vec3& a, const vec3& b, const GLfloat c);
     /**
      * Get the angle between two 3D vectors
      * @param a The first operand
      * @param b The second operand
      * @returns {Number} The angle in radians
      */
-    static GLfloat angle(const vec3 a, const vec3 b);
+    static GLfloat angle(const vec3& a, const vec3& b);
     /**
      * Returns whether or not the vectors have exactly the same elements in the same position (when compared with ===)
      *
@@ -2299,7 +2302,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool exactEquals(const vec3 a, const vec3 b);
+    static bool exactEquals(const vec3& a, const vec3& b);
     /**
      * Returns whether or not the vectors have approximately the same elements in the same position.
      *
@@ -2307,7 +2310,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool equals(const vec3 a, const vec3 b);
+    static bool equals(const vec3& a, const vec3& b);
     /**
      * Returns a string representation of a vec3
      *
@@ -2328,21 +2331,21 @@ public:
      * @param a
      * @returns {vec3} a new vector
      */
-    static vec3 fromVec(const vec2 a);
+    static vec3 fromVec(const vec2& a);
     /**
      * Creates a new vec3 initialized from the given vec3
      *
      * @param a
      * @returns {vec3} a new vector
      */
-    static vec3 fromVec(const vec3 a);
+    static vec3 fromVec(const vec3& a);
     /**
      * Creates a new vec3 initialized from the given vec4
      *
      * @param a
      * @returns {vec3} a new vector
      */
-    static vec3 fromVec(const vec4 a);
+    static vec3 fromVec(const vec4& a);
     /**
      * Cette méthode calcule le vec3 interpolé par une spline cubique de Hermite entre (p0,t0), (p1,t1)
      * @param out the receiving vector
@@ -2353,7 +2356,7 @@ public:
      * @param k coefficient entre 0 et 1
      * @returns {vec3} out
      */
-    static vec3 hermite(vec3& out, const vec3 p0, const vec3 t0, const vec3 p1, const vec3 t1, const GLfloat k);
+    static vec3 hermite(vec3& out, const vec3& p0, const vec3& t0, const vec3& p1, const vec3& t1, const GLfloat k);
     /**
      * Performs a bezier interpolation with two control points
      *
@@ -2365,7 +2368,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec3} out
      */
-    static vec3 bezier(vec3& out, const vec3 a, const vec3 b, const vec3 c, const vec3 d, const GLfloat t);
+    static vec3 bezier(vec3& out, const vec3& a, const vec3& b, const vec3& c, const vec3& d, const GLfloat t);
     /**
      * calls glUniform3fv for the vector a
      *
@@ -2373,7 +2376,7 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniform(const GLint loc, const vec3 a);
+    static void glUniform(const GLint loc, const vec3& a);
     /**
      * calls glUniform3fv for the vector array a
      *
@@ -2387,7 +2390,7 @@ public:
  * @class 4 Dimensional Vector
  * @name vec4
  */
-class vec4 {
+class alignas(16) vec4 {
 
 private:
 
@@ -2459,7 +2462,7 @@ public:
      * @param a vector to clone
      * @returns {vec4} a new 4D vector
      */
-    static vec4 clone(const vec4 a);
+    static vec4 clone(const vec4& a);
     /**
      * Creates a new vec4 initialized with the given values
      *
@@ -2477,7 +2480,7 @@ public:
      * @param a the source vector
      * @returns {vec4} out
      */
-    static vec4 copy(vec4& out, const vec4 a);
+    static vec4 copy(vec4& out, const vec4& a);
     /**
      * Set the components of a vec4 to the given values
      *
@@ -2497,7 +2500,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 add(vec4& out, const vec4 a, const vec4 b);
+    static vec4 add(vec4& out, const vec4& a, const vec4& b);
     /**
      * Subtracts vector b from vector a
      *
@@ -2506,7 +2509,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 subtract(vec4& out, const vec4 a, const vec4 b);
+    static vec4 subtract(vec4& out, const vec4& a, const vec4& b);
     /**
      * Multiplies two vec4's
      *
@@ -2515,7 +2518,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 multiply(vec4& out, const vec4 a, const vec4 b);
+    static vec4 multiply(vec4& out, const vec4& a, const vec4& b);
     /**
      * Divides two vec4's
      *
@@ -2524,7 +2527,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 divide(vec4& out, const vec4 a, const vec4 b);
+    static vec4 divide(vec4& out, const vec4& a, const vec4& b);
     /**
      * Math.ceil the components of a vec4
      *
@@ -2532,7 +2535,7 @@ public:
      * @param a vector to ceil
      * @returns {vec4} out
      */
-    static vec4 ceil(vec4& out, const vec4 a);
+    static vec4 ceil(vec4& out, const vec4& a);
     /**
      * Math.floor the components of a vec4
      *
@@ -2540,7 +2543,7 @@ public:
      * @param a vector to floor
      * @returns {vec4} out
      */
-    static vec4 floor(vec4& out, const vec4 a);
+    static vec4 floor(vec4& out, const vec4& a);
     /**
      * Returns the minimum of two vec4's
      *
@@ -2549,7 +2552,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 min(vec4& out, const vec4 a, const vec4 b);
+    static vec4 min(vec4& out, const vec4& a, const vec4& b);
     /**
      * Returns the maximum of two vec4's
      *
@@ -2558,7 +2561,7 @@ public:
      * @param b the second operand
      * @returns {vec4} out
      */
-    static vec4 max(vec4& out, const vec4 a, const vec4 b);
+    static vec4 max(vec4& out, const vec4& a, const vec4& b);
     /**
      * Math.round the components of a vec4
      *
@@ -2566,7 +2569,7 @@ public:
      * @param a vector to round
      * @returns {vec4} out
      */
-    static vec4 round(vec4& out, const vec4 a);
+    static vec4 round(vec4& out, const vec4& a);
     /**
      * Scales a vec4 by a scalar Number
      *
@@ -2575,7 +2578,7 @@ public:
      * @param b amount to scale the vector by
      * @returns {vec4} out
      */
-    static vec4 scale(vec4& out, const vec4 a, const GLfloat b);
+    static vec4 scale(vec4& out, const vec4& a, const GLfloat b);
     /**
      * Adds two vec4's after scaling the second operand by a scalar value
      *
@@ -2585,7 +2588,7 @@ public:
      * @param scale the amount to scale b by before adding
      * @returns {vec4} out
      */
-    static vec4 scaleAndAdd(vec4& out, const vec4 a, const vec4 b, const GLfloat scale);
+    static vec4 scaleAndAdd(vec4& out, const vec4& a, const vec4& b, const GLfloat scale);
     /**
      * Calculates the euclidian distance between two vec4's
      *
@@ -2593,7 +2596,7 @@ public:
      * @param b the second operand
      * @returns {Number} distance between a and b
      */
-    static GLfloat distance(const vec4 a, const vec4 b);
+    static GLfloat distance(const vec4& a, const vec4& b);
     /**
      * Calculates the squared euclidian distance between two vec4's
      *
@@ -2601,21 +2604,21 @@ public:
      * @param b the second operand
      * @returns {Number} squared distance between a and b
      */
-    static GLfloat squaredDistance(const vec4 a, const vec4 b);
+    static GLfloat squaredDistance(const vec4& a, const vec4& b);
     /**
      * Calculates the length of a vec4
      *
      * @param a vector to calculate length of
      * @returns {Number} length of a
      */
-    static GLfloat length(const vec4 a);
+    static GLfloat length(const vec4& a);
     /**
      * Calculates the squared length of a vec4
      *
      * @param a vector to calculate squared length of
      * @returns {Number} squared length of a
      */
-    static GLfloat squaredLength(const vec4 a);
+    static GLfloat squaredLength(const vec4& a);
     /**
      * Negates the components of a vec4
      *
@@ -2623,7 +2626,7 @@ public:
      * @param a vector to negate
      * @returns {vec4} out
      */
-    static vec4 negate(vec4& out, const vec4 a);
+    static vec4 negate(vec4& out, const vec4& a);
     /**
      * Returns the inverse of the components of a vec4
      *
@@ -2631,7 +2634,7 @@ public:
      * @param a vector to invert
      * @returns {vec4} out
      */
-    static vec4 inverse(vec4& out, const vec4 a);
+    static vec4 inverse(vec4& out, const vec4& a);
     /**
      * Normalize a vec4
      *
@@ -2639,7 +2642,7 @@ public:
      * @param a vector to normalize
      * @returns {vec4} out
      */
-    static vec4 normalize(vec4& out, const vec4 a);
+    static vec4 normalize(vec4& out, const vec4& a);
     /**
      * Calculates the dot product of two vec4's
      *
@@ -2647,7 +2650,7 @@ public:
      * @param b the second operand
      * @returns {Number} dot product of a and b
      */
-    static GLfloat dot(const vec4 a, const vec4 b);
+    static GLfloat dot(const vec4& a, const vec4& b);
     /**
      * Performs a linear interpolation between two vec4's
      *
@@ -2657,7 +2660,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec4} out
      */
-    static vec4 lerp(vec4& out, const vec4 a, const vec4 b, const GLfloat t);
+    static vec4 lerp(vec4& out, const vec4& a, const vec4& b, const GLfloat t);
     /**
      * Generates a random vector with the given scale
      *
@@ -2674,7 +2677,7 @@ public:
      * @param m matrix to transform with
      * @returns {vec4} out
      */
-    static vec4 transformMat4(vec4& out, const vec4 a, const mat4 m);
+    static vec4 transformMat4(vec4& out, const vec4& a, const mat4& m);
     /**
      * Transforms the vec4 with a quat
      *
@@ -2683,7 +2686,7 @@ public:
      * @param q quaternion to transform with
      * @returns {vec4} out
      */
-    static vec4 transformQuat(vec4& out, const vec4 a, const quat q);
+    static vec4 transformQuat(vec4& out, const vec4& a, const quat& q);
     /**
      * Returns whether or not the vectors have exactly the same elements in the same position (when compared with ===)
      *
@@ -2691,7 +2694,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool exactEquals(const vec4 a, const vec4 b);
+    static bool exactEquals(const vec4& a, const vec4& b);
     /**
      * Returns whether or not the vectors have approximately the same elements in the same position.
      *
@@ -2699,7 +2702,7 @@ public:
      * @param b The second vector.
      * @returns {Boolean} True if the vectors are equal, false otherwise.
      */
-    static bool equals(const vec4 a, const vec4 b);
+    static bool equals(const vec4& a, const vec4& b);
     /**
      * Returns a string representation of a vec4
      *
@@ -2720,21 +2723,21 @@ public:
      * @param a
      * @returns {vec4} a new vector
      */
-    static vec4 fromVec(const vec2 a);
+    static vec4 fromVec(const vec2& a);
     /**
      * Creates a new vec4 initialized from the given vec3
      *
      * @param a
      * @returns {vec4} a new vector
      */
-    static vec4 fromVec(const vec3 a);
+    static vec4 fromVec(const vec3& a);
     /**
      * Creates a new vec4 initialized from the given vec4
      *
      * @param a
      * @returns {vec4} a new vector
      */
-    static vec4 fromVec(const vec4 a);
+    static vec4 fromVec(const vec4& a);
     /**
      * Cette méthode calcule le vec4 interpolé par une spline cubique de Hermite entre (p0,t0), (p1,t1)
      * @param out the receiving vector
@@ -2745,7 +2748,7 @@ public:
      * @param k coefficient entre 0 et 1
      * @returns {vec4} out
      */
-    static vec4 hermite(vec4& out, const vec4 p0, const vec4 t0, const vec4 p1, const vec4 t1, const GLfloat k);
+    static vec4 hermite(vec4& out, const vec4& p0, const vec4& t0, const vec4& p1, const vec4& t1, const GLfloat k);
     /**
      * Performs a bezier interpolation with two control points
      *
@@ -2757,7 +2760,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {vec4} out
      */
-    static vec4 bezier(vec4& out, const vec4 a, const vec4 b, const vec4 c, const vec4 d, const GLfloat t);
+    static vec4 bezier(vec4& out, const vec4& a, const vec4& b, const vec4& c, const vec4& d, const GLfloat t);
     /**
      * calls glUniform4fv for the vector a
      *
@@ -2765,7 +2768,7 @@ public:
      * @param a the vector to send to OpenGL shader
      * @returns {void}
      */
-    static void glUniform(const GLint loc, const vec4 a);
+    static void glUniform(const GLint loc, const vec4& a);
     /**
      * calls glUniform4fv for the vector array a
      *
@@ -2861,7 +2864,7 @@ public:
      * @param rad the angle in radians
      * @returns {quat} out
      **/
-    static quat setAxisAngle(quat& out, const vec3 axis, const GLfloat rad);
+    static quat setAxisAngle(quat& out, const vec3& axis, const GLfloat rad);
     /**
      * Gets the rotation axis and angle for a given
      *  quaternion. If a quaternion is created with
@@ -2875,7 +2878,7 @@ public:
      * @param  {quat} q     Quaternion to be decomposed
      * @returns {Number}     Angle, in radians, of the rotation
      */
-    static GLfloat getAxisAngle(vec3& out_axis, const quat q);
+    static GLfloat getAxisAngle(vec3& out_axis, const quat& q);
     /**
      * Multiplies two quat's
      *
@@ -2884,7 +2887,7 @@ public:
      * @param b the second operand
      * @returns {quat} out
      */
-    static quat multiply(quat& out, const quat a, const quat b);
+    static quat multiply(quat& out, const quat& a, const quat& b);
     /**
      * Rotates a quaternion by the given angle about the X axis
      *
@@ -2893,7 +2896,7 @@ public:
      * @param rad angle (in radians) to rotate
      * @returns {quat} out
      */
-    static quat rotateX(quat& out, const quat a, const GLfloat rad);
+    static quat rotateX(quat& out, const quat& a, const GLfloat rad);
     /**
      * Rotates a quaternion by the given angle about the Y axis
      *
@@ -2902,7 +2905,7 @@ public:
      * @param rad angle (in radians) to rotate
      * @returns {quat} out
      */
-    static quat rotateY(quat& out, const quat a, const GLfloat rad);
+    static quat rotateY(quat& out, const quat& a, const GLfloat rad);
     /**
      * Rotates a quaternion by the given angle about the Z axis
      *
@@ -2911,7 +2914,7 @@ public:
      * @param rad angle (in radians) to rotate
      * @returns {quat} out
      */
-    static quat rotateZ(quat& out, const quat a, const GLfloat rad);
+    static quat rotateZ(quat& out, const quat& a, const GLfloat rad);
     /**
      * Calculates the W component of a quat from the X, Y, and Z components.
      * Assumes that quaternion is 1 unit in length.
@@ -2921,7 +2924,7 @@ public:
      * @param a quat to calculate W component of
      * @returns {quat} out
      */
-    static quat calculateW(quat& out, const quat a);
+    static quat calculateW(quat& out, const quat& a);
     /**
      * Performs a spherical linear interpolation between two quat
      *
@@ -2931,7 +2934,7 @@ public:
      * @param t interpolation amount between the two inputs
      * @returns {quat} out
      */
-    static quat slerp(quat& out, const quat a, const quat b, const GLfloat t);
+    static quat slerp(quat& out, const quat& a, const quat& b, const GLfloat t);
     /**
      * Calculates the inverse of a quat
      *
@@ -2939,7 +2942,7 @@ public:
      * @param a quat to calculate inverse of
      * @returns {quat} out
      */
-    static quat invert(quat& out, const quat a);
+    static quat invert(quat& out, const quat& a);
     /**
      * Calculates the conjugate of a quat
      * If the quaternion is normalized, this function is faster than quat.inverse and produces the same result.
@@ -2948,7 +2951,7 @@ public:
      * @param a quat to calculate conjugate of
      * @returns {quat} out
      */
-    static quat conjugate(quat& out, const quat a);
+    static quat conjugate(quat& out, const quat& a);
     /**
      * Creates a quaternion from the given 3x3 rotation matrix.
      *
@@ -2960,7 +2963,7 @@ public:
      * @returns {quat} out
      * @function
      */
-    static quat fromMat3(quat& out, const mat3 m);
+    static quat fromMat3(quat& out, const mat3& m);
     /**
      * Returns a string representation of a quat
      *
@@ -2986,7 +2989,7 @@ public:
      * @param b the destination vector
      * @returns {quat} out
      */
-    static quat rotationTo(quat& out, const vec3 a, const vec3 b);
+    static quat rotationTo(quat& out, const vec3& a, const vec3& b);
     /**
      * Sets the specified quaternion with values corresponding to the given
      * axes. Each axis is a vec3 and is expected to be unit length and
@@ -2998,7 +3001,7 @@ public:
      * @param up    the vector representing the local "up" direction
      * @returns {quat} out
      */
-    static quat setAxes(quat& out, const vec3 view, const vec3 right, const vec3 up);
+    static quat setAxes(quat& out, const vec3& view, const vec3& right, const vec3& up);
     /**
      * Performs a spherical linear interpolation with two control points
      *
@@ -3010,7 +3013,7 @@ public:
      * @param t interpolation amount
      * @returns {quat} out
      */
-    static quat sqlerp(quat& out, const quat a, const quat b, const quat c, const quat d, const GLfloat t);
+    static quat sqlerp(quat& out, const quat& a, const quat& b, const quat& c, const quat& d, const GLfloat t);
     /**
      * Normalize a quat
      *
@@ -3018,7 +3021,210 @@ public:
      * @param a quaternion to normalize
      * @returns {quat} out
      */
-    static quat normalize(quat& out, const quat a);
+    static quat normalize(quat& out, const quat& a);
 };
+
+/*
+ * The most used functions are defined inline here, after all the classes,
+ * so that the compiler can see through them in the hot loops. When SSE is
+ * available, mat4 products and transforms work on whole columns; the sums
+ * are done in the same order as the scalar code, so results are identical.
+ * Loads and stores are unaligned because these classes are often mapped on
+ * float arrays (vertex attributes, VBO data).
+ */
+
+/**
+ * Multiplies two mat4's
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {mat4} a the first operand
+ * @param {mat4} b the second operand
+ * @returns {mat4} out
+ */
+inline mat4 mat4::multiply(mat4& out, const mat4& a, const mat4& b)
+{
+#ifdef __SSE__
+    __m128 a0 = _mm_loadu_ps(a.m_Cells+0);
+    __m128 a1 = _mm_loadu_ps(a.m_Cells+4);
+    __m128 a2 = _mm_loadu_ps(a.m_Cells+8);
+    __m128 a3 = _mm_loadu_ps(a.m_Cells+12);
+
+    // each column of b is read before the same column of out is written
+    for (int i=0; i<16; i+=4) {
+        __m128 r = _mm_mul_ps(_mm_set1_ps(b.m_Cells[i+0]), a0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(b.m_Cells[i+1]), a1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(b.m_Cells[i+2]), a2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(b.m_Cells[i+3]), a3));
+        _mm_storeu_ps(out.m_Cells+i, r);
+    }
+#else
+    GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
+    a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
+    a20 = a.m_Cells[8], a21 = a.m_Cells[9], a22 = a.m_Cells[10], a23 = a.m_Cells[11],
+    a30 = a.m_Cells[12], a31 = a.m_Cells[13], a32 = a.m_Cells[14], a33 = a.m_Cells[15];
+
+    // Cache only the current line of the second matrix
+    for (int i=0; i<16; i+=4) {
+        GLfloat b0 = b.m_Cells[i+0], b1 = b.m_Cells[i+1], b2 = b.m_Cells[i+2], b3 = b.m_Cells[i+3];
+        out.m_Cells[i+0] = b0*a00 + b1*a10 + b2*a20 + b3*a30;
+        out.m_Cells[i+1] = b0*a01 + b1*a11 + b2*a21 + b3*a31;
+        out.m_Cells[i+2] = b0*a02 + b1*a12 + b2*a22 + b3*a32;
+        out.m_Cells[i+3] = b0*a03 + b1*a13 + b2*a23 + b3*a33;
+    }
+#endif
+    return out;
+}
+
+/**
+ * Inverts a mat4
+ *
+ * @param {mat4} out the receiving matrix
+ * @param {mat4} a the source matrix
+ * @returns {mat4} out, or mat4::null if a is not invertible
+ */
+inline mat4 mat4::invert(mat4& out, const mat4& a)
+{
+    GLfloat a00 = a.m_Cells[0], a01 = a.m_Cells[1], a02 = a.m_Cells[2], a03 = a.m_Cells[3],
+    a10 = a.m_Cells[4], a11 = a.m_Cells[5], a12 = a.m_Cells[6], a13 = a.m_Cells[7],
+    a20 = a.m_Cells[8], a21 = a.m_Cells[9], a22 = a.m_Cells[10], a23 = a.m_Cells[11],
+    a30 = a.m_Cells[12], a31 = a.m_Cells[13], a32 = a.m_Cells[14], a33 = a.m_Cells[15],
+
+    b00 = a00 * a11 - a01 * a10,
+    b01 = a00 * a12 - a02 * a10,
+    b02 = a00 * a13 - a03 * a10,
+    b03 = a01 * a12 - a02 * a11,
+    b04 = a01 * a13 - a03 * a11,
+    b05 = a02 * a13 - a03 * a12,
+    b06 = a20 * a31 - a21 * a30,
+    b07 = a20 * a32 - a22 * a30,
+    b08 = a20 * a33 - a23 * a30,
+    b09 = a21 * a32 - a22 * a31,
+    b10 = a21 * a33 - a23 * a31,
+    b11 = a22 * a33 - a23 * a32,
+
+    // Calculate the determinant
+    det = b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
+
+    if (!det) {
+        return null;
+    }
+    det = 1.0 / det;
+
+#ifdef __SSE__
+    // each column of the result is (x*p - y*q + z*r) * (+det,-det,+det,-det) or
+    // its opposite, x, y, z being columns of a taken in the order (1,0,3,2)
+    __m128 c0 = _mm_setr_ps(a10, a00, a30, a20);
+    __m128 c1 = _mm_setr_ps(a11, a01, a31, a21);
+    __m128 c2 = _mm_setr_ps(a12, a02, a32, a22);
+    __m128 c3 = _mm_setr_ps(a13, a03, a33, a23);
+    __m128 pn = _mm_setr_ps( det, -det,  det, -det);
+    __m128 np = _mm_setr_ps(-det,  det, -det,  det);
+    __m128 r0 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(
+        _mm_mul_ps(c1, _mm_setr_ps(b11, b11, b05, b05)),
+        _mm_mul_ps(c2, _mm_setr_ps(b10, b10, b04, b04))),
+        _mm_mul_ps(c3, _mm_setr_ps(b09, b09, b03, b03))), pn);
+    __m128 r1 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(
+        _mm_mul_ps(c0, _mm_setr_ps(b11, b11, b05, b05)),
+        _mm_mul_ps(c2, _mm_setr_ps(b08, b08, b02, b02))),
+        _mm_mul_ps(c3, _mm_setr_ps(b07, b07, b01, b01))), np);
+    __m128 r2 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(
+        _mm_mul_ps(c0, _mm_setr_ps(b10, b10, b04, b04)),
+        _mm_mul_ps(c1, _mm_setr_ps(b08, b08, b02, b02))),
+        _mm_mul_ps(c3, _mm_setr_ps(b06, b06, b00, b00))), pn);
+    __m128 r3 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(
+        _mm_mul_ps(c0, _mm_setr_ps(b09, b09, b03, b03)),
+        _mm_mul_ps(c1, _mm_setr_ps(b07, b07, b01, b01))),
+        _mm_mul_ps(c2, _mm_setr_ps(b06, b06, b00, b00))), np);
+    _mm_storeu_ps(out.m_Cells+0,  r0);
+    _mm_storeu_ps(out.m_Cells+4,  r1);
+    _mm_storeu_ps(out.m_Cells+8,  r2);
+    _mm_storeu_ps(out.m_Cells+12, r3);
+#else
+    out.m_Cells[0] = (a11 * b11 - a12 * b10 + a13 * b09) * det;
+    out.m_Cells[1] = (a02 * b10 - a01 * b11 - a03 * b09) * det;
+    out.m_Cells[2] = (a31 * b05 - a32 * b04 + a33 * b03) * det;
+    out.m_Cells[3] = (a22 * b04 - a21 * b05 - a23 * b03) * det;
+    out.m_Cells[4] = (a12 * b08 - a10 * b11 - a13 * b07) * det;
+    out.m_Cells[5] = (a00 * b11 - a02 * b08 + a03 * b07) * det;
+    out.m_Cells[6] = (a32 * b02 - a30 * b05 - a33 * b01) * det;
+    out.m_Cells[7] = (a20 * b05 - a22 * b02 + a23 * b01) * det;
+    out.m_Cells[8] = (a10 * b10 - a11 * b08 + a13 * b06) * det;
+    out.m_Cells[9] = (a01 * b08 - a00 * b10 - a03 * b06) * det;
+    out.m_Cells[10] = (a30 * b04 - a31 * b02 + a33 * b00) * det;
+    out.m_Cells[11] = (a21 * b02 - a20 * b04 - a23 * b00) * det;
+    out.m_Cells[12] = (a11 * b07 - a10 * b09 - a12 * b06) * det;
+    out.m_Cells[13] = (a00 * b09 - a01 * b07 + a02 * b06) * det;
+    out.m_Cells[14] = (a31 * b01 - a30 * b03 - a32 * b00) * det;
+    out.m_Cells[15] = (a20 * b03 - a21 * b01 + a22 * b00) * det;
 #endif
+    return out;
+}
 
+/**
+ * Normalize a vec3
+ *
+ * @param {vec3} out the receiving vector
+ * @param {vec3} a vector to normalize
+ * @returns {vec3} out
+ */
+inline vec3 vec3::normalize(vec3& out, const vec3& a)
+{
+    GLfloat x = a.m_Cells[0],
+    y = a.m_Cells[1],
+    z = a.m_Cells[2];
+    GLfloat len = x*x + y*y + z*z;
+    if (len > 0) {
+        len = 1 / sqrt(len);
+        out.m_Cells[0] = x * len;
+        out.m_Cells[1] = y * len;
+        out.m_Cells[2] = z * len;
+    }
+    return out;
+}
+
+/**
+ * Transforms the vec3 with a mat4.
+ * NB: the 4th coordinate of the result is ignored, there is no perspective division
+ *
+ * @param {vec3} out the receiving vector
+ * @param {vec3} a the vector to transform
+ * @param {mat4} m matrix to transform with
+ * @returns {vec3} out
+ */
+inline vec3 vec3::transformMat4(vec3& out, const vec3& a, const mat4& m)
+{
+    // with only 3 cells, SSE is slower than the scalar code, once inlined
+    GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2];
+    out.m_Cells[0] = m.m_Cells[0] * x + m.m_Cells[4] * y + m.m_Cells[8] * z + m.m_Cells[12];
+    out.m_Cells[1] = m.m_Cells[1] * x + m.m_Cells[5] * y + m.m_Cells[9] * z + m.m_Cells[13];
+    out.m_Cells[2] = m.m_Cells[2] * x + m.m_Cells[6] * y + m.m_Cells[10] * z + m.m_Cells[14];
+    return out;
+}
+
+/**
+ * Transforms the vec4 with a mat4.
+ *
+ * @param {vec4} out the receiving vector
+ * @param {vec4} a the vector to transform
+ * @param {mat4} m matrix to transform with
+ * @returns {vec4} out
+ */
+inline vec4 vec4::transformMat4(vec4& out, const vec4& a, const mat4& m)
+{
+#ifdef __SSE__
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(m.m_Cells+0), _mm_set1_ps(a.m_Cells[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.m_Cells+4), _mm_set1_ps(a.m_Cells[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.m_Cells+8), _mm_set1_ps(a.m_Cells[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m.m_Cells+12), _mm_set1_ps(a.m_Cells[3])));
+    _mm_storeu_ps(out.m_Cells, r);
+#else
+    GLfloat x = a.m_Cells[0], y = a.m_Cells[1], z = a.m_Cells[2], w = a.m_Cells[3];
+    out.m_Cells[0] = m.m_Cells[0] * x + m.m_Cells[4] * y + m.m_Cells[8] * z + m.m_Cells[12] * w;
+    out.m_Cells[1] = m.m_Cells[1] * x + m.m_Cells[5] * y + m.m_Cells[9] * z + m.m_Cells[13] * w;
+    out.m_Cells[2] = m.m_Cells[2] * x + m.m_Cells[6] * y + m.m_Cells[10] * z + m.m_Cells[14] * w;
+    out.m_Cells[3] = m.m_Cells[3] * x + m.m_Cells[7] * y + m.m_Cells[11] * z + m.m_Cells[15] * w;
+#endif
+    return out;
+}
+
+#endif
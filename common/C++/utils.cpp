@@ -6,9 +6,19 @@
 #include <stdlib.h>
 #include <math.h>
 
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <direct.h>
+#endif
+
 #include <SDL_image.h>
 
 #include <utils.h>
+#include <GLState.h>
 
 static const char kPathSeparator =
 #if defined(WIN32) || defined(_WIN32)
@@ -195,9 +205,184 @@ static GLint compileShader(GLenum shaderType, const GLchar* source, std::string
 }
 
 
+/**
+ * retourne un dossier du cache de l'utilisateur réservé à ces exemples,
+ * $XDG_CACHE_HOME ou ~/.cache sous Linux, %LOCALAPPDATA% sous Windows
+ * @param name : nom du sous-dossier, ex: "meshes"
+ * @return nom complet du dossier, "" si le cache de l'utilisateur n'est pas connu
+ */
+static std::string getUserCacheFolder(std::string name)
+{
+#ifdef _WIN32
+    const char* cache = getenv("LOCALAPPDATA");
+    if (cache != nullptr && cache[0] != '\0') return std::string(cache) + "\\opengl-samples\\" + name;
+#else
+    const char* cache = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (cache != nullptr && cache[0] == '/') return std::string(cache) + "/opengl-samples/" + name;
+    if (home != nullptr && home[0] != '\0') return std::string(home) + "/.cache/opengl-samples/" + name;
+#endif
+    return "";
+}
+
+
+// dossier des programmes de shaders compilés, calculé au premier besoin s'il n'est pas défini
+static std::string ShaderCacheFolder;
+static bool ShaderCacheFolderDefined = false;
+
+// en-tête des fichiers du cache des shaders, suivi de la clé puis du programme compilé
+struct ShaderCacheHeader
+{
+    char magic[4];
+    GLuint format;
+    GLuint keysize;
+    GLuint binarysize;
+};
+static const char SHADER_CACHE_MAGIC[4] = { 'G', 'L', 'P', 'B' };
+
+
+/**
+ * définit le dossier où makeShaderProgram enregistre les programmes compilés pour
+ * les recharger aux lancements suivants sans recompiler leurs sources
+ * @param folder : nom du dossier, créé s'il n'existe pas, "" pour ne pas employer de cache
+ */
+void setShaderCacheFolder(std::string folder)
+{
+    ShaderCacheFolder = folder;
+    ShaderCacheFolderDefined = true;
+}
+
+
+/**
+ * retourne le dossier des programmes compilés : par défaut dans le cache de l'utilisateur,
+ * car le dossier courant peut être partagé ou en lecture seule
+ * @return nom du dossier, "" s'il ne faut pas employer de cache
+ */
+static std::string getShaderCacheFolder()
+{
+    if (! ShaderCacheFolderDefined) {
+        ShaderCacheFolderDefined = true;
+        ShaderCacheFolder = getUserCacheFolder("shaders");
+    }
+    return ShaderCacheFolder;
+}
+
+
+#ifdef GL_PROGRAM_BINARY_LENGTH
+
+/**
+ * retourne la clé d'un programme dans le cache : ses sources et la description du pilote,
+ * car un programme compilé n'est valable que pour le pilote qui l'a produit
+ * @param VSsource : source du vertex shader
+ * @param FSsource : source du fragment shader
+ * @return clé du programme
+ */
+static std::string getShaderCacheKey(std::string& VSsource, std::string& FSsource)
+{
+    std::ostringstream key;
+    key << glGetString(GL_VENDOR) << '\n' << glGetString(GL_RENDERER) << '\n' << glGetString(GL_VERSION) << '\n';
+    key << VSsource << '\0' << FSsource;
+    return key.str();
+}
+
+
+/**
+ * retourne le nom du fichier du cache qui contient le programme ayant cette clé,
+ * le nom est une empreinte FNV-1a de la clé
+ * @param key : clé du programme
+ * @return nom complet du fichier
+ */
+static std::string getShaderCacheFilename(std::string& key)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char c: key) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx.bin", hash);
+    return getShaderCacheFolder() + kPathSeparator + name;
+}
+
+
+/**
+ * crée un programme à partir du fichier du cache
+ * @param filename : nom complet du fichier
+ * @param key : clé que le fichier doit contenir
+ * @return identifiant du programme, 0 si le fichier est absent, d'une autre clé ou refusé par le pilote
+ */
+static GLint loadShaderCache(std::string& filename, std::string& key)
+{
+    MappedFile file(filename);
+    const char* data = file.getData();
+    size_t size = file.getSize();
+    if (data == nullptr || size < sizeof(ShaderCacheHeader)) return 0;
+
+    // vérifier l'en-tête et la clé, deux clés peuvent avoir la même empreinte
+    ShaderCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic)) != 0) return 0;
+    if (sizeof(header) + size_t(header.keysize) + size_t(header.binarysize) != size) return 0;
+    if (header.keysize != key.size() || memcmp(data + sizeof(header), key.data(), key.size()) != 0) return 0;
+
+    // le pilote peut refuser le programme, par exemple après une mise à jour
+    GLint program = glCreateProgram();
+    glProgramBinary(program, header.format, data + sizeof(header) + header.keysize, header.binarysize);
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLState::deleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+
+/**
+ * enregistre le programme dans le fichier du cache
+ * @param filename : nom complet du fichier
+ * @param key : clé du programme
+ * @param program : identifiant du programme, lié avec GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+ */
+static void saveShaderCache(std::string& filename, std::string& key, GLint program)
+{
+    // récupérer le programme compilé
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    // créer le dossier et ses parents s'ils n'existent pas
+    if (! makeFolders(getShaderCacheFolder())) return;
+
+    // écrire un fichier temporaire, renommé seulement s'il est complet
+    ShaderCacheHeader header;
+    memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(header.magic));
+    header.format = format;
+    header.keysize = key.size();
+    header.binarysize = length;
+    std::string tmpfilename = filename+".tmp";
+    std::ofstream file(tmpfilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (! file.is_open()) return;
+    file.write((const char*) &header, sizeof(header));
+    file.write(key.data(), key.size());
+    file.write(binary.data(), length);
+    file.close();
+    remove(filename.c_str());
+    if (file.fail() || rename(tmpfilename.c_str(), filename.c_str()) != 0) {
+        remove(tmpfilename.c_str());
+    }
+}
+
+#endif
+
+
 /**
  * cette fonction compile les deux sources, vertex et fragment shader
- * et les relie en tant que programme de shaders complet
+ * et les relie en tant que programme de shaders complet.
+ * Si un dossier de cache est défini, voir setShaderCacheFolder, le programme compilé y est
+ * enregistré et il est rechargé tel quel aux lancements suivants.
  * @param VSsource : source du vertex shader
  * @param FSsource : source du fragment shader
  * @param name : nom du shader pour les messages d'erreurs ou le log
@@ -218,6 +403,22 @@ GLint makeShaderProgram(std::string VSsource, std::string FSsource, std::string
         fsfile.close();
     }
 
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    // chercher le programme compilé dans le cache, si le pilote sait en fournir
+    std::string key;
+    std::string cachefilename;
+    GLint formats = 0;
+    if (! getShaderCacheFolder().empty()) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    if (formats > 0) {
+        key = getShaderCacheKey(VSsource, FSsource);
+        cachefilename = getShaderCacheFilename(key);
+        GLint program = loadShaderCache(cachefilename, key);
+        if (program > 0) return program;
+    }
+#endif
+
     // compiler les shaders séparément
     GLint vertexShader   = compileShader(GL_VERTEX_SHADER,   VSsource.c_str(), "Vertex Shader of "+name);
     GLint fragmentShader = compileShader(GL_FRAGMENT_SHADER, FSsource.c_str(), "Fragment Shader of "+name);
@@ -232,6 +433,9 @@ GLint makeShaderProgram(std::string VSsource, std::string FSsource, std::string
     glBindAttribLocation(program, 0, "glVertex");
 
     // lier le programme
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    if (formats > 0) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
     glLinkProgram(program);
 
     // vérifier l'état
@@ -255,6 +459,11 @@ GLint makeShaderProgram(std::string VSsource, std::string FSsource, std::string
         throw std::invalid_argument(name);
     }
 
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    // enregistrer le programme compilé pour les prochains lancements
+    if (formats > 0) saveShaderCache(cachefilename, key, program);
+#endif
+
     return program;
 }
 
@@ -268,7 +477,7 @@ void deleteShaderProgram(GLint id)
     // détacher et supprimer tous ses shaders
 
     // supprimer le programme
-    glDeleteProgram(id);
+    GLState::deleteProgram(id);
 }
 
 
@@ -326,6 +535,8 @@ GLuint makeShortVBO(std::vector<int> values, int vbo_type, int usage)
     // recopier les int dans un tableau de short
     std::vector<GLshort> copy(values.size());
     copy.assign(values.begin(), values.end());
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
     // créer un VBO et le remplir avec les données
     GLuint id;
     glGenBuffers(1, &id);
@@ -357,6 +568,8 @@ GLuint makeShortVBO(std::vector<GLshort> values, int vbo_type, int usage)
         throw std::invalid_argument("Utils::makeShortVBO: third parameter, usage is neither GL_STATIC_DRAW or GL_DYNAMIC_DRAW");
     }
     /*****DEBUG*****/
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
     // créer un VBO et le remplir avec les données
     GLuint id;
     glGenBuffers(1, &id);
@@ -388,6 +601,8 @@ GLuint makeShortVBO(std::vector<GLushort> values, int vbo_type, int usage)
         throw std::invalid_argument("Utils::makeUShortVBO: third parameter, usage is neither GL_STATIC_DRAW or GL_DYNAMIC_DRAW");
     }
     /*****DEBUG*****/
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
     // créer un VBO et le remplir avec les données
     GLuint id;
     glGenBuffers(1, &id);
@@ -418,6 +633,8 @@ GLuint makeIntVBO(std::vector<GLint> values, int vbo_type, int usage)
         throw std::invalid_argument("Utils::makeIntVBO: third parameter, usage is neither GL_STATIC_DRAW or GL_DYNAMIC_DRAW");
     }
     /*****DEBUG*****/
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
     // créer un VBO et le remplir avec les données
     GLuint id;
     glGenBuffers(1, &id);
@@ -449,6 +666,8 @@ GLuint makeIntVBO(std::vector<GLuint> values, int vbo_type, int usage)
         throw std::invalid_argument("Utils::makeUIntVBO: third parameter, usage is neither GL_STATIC_DRAW or GL_DYNAMIC_DRAW");
     }
     /*****DEBUG*****/
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
     // créer un VBO et le remplir avec les données
     GLuint id;
     glGenBuffers(1, &id);
@@ -460,6 +679,41 @@ GLuint makeIntVBO(std::vector<GLuint> values, int vbo_type, int usage)
 }
 
 
+/**
+ * cette fonction crée un VBO à partir d'un bloc de données brutes, par exemple
+ * projeté depuis un fichier : les données sont transmises sans copie intermédiaire
+ * @param data : adresse des données à mettre dans le VBO
+ * @param size : nombre d'octets des données
+ * @param vbo_type : type OpenGL du VBO, par exemple GL_ARRAY_BUFFER
+ * @param usage : type de stockage OpenGL des données, par exemple GL_STATIC_DRAW
+ * @return identifiant OpenGL du VBO
+ */
+GLuint makeRawVBO(const void* data, size_t size, int vbo_type, int usage)
+{
+    /*****DEBUG*****/
+    if (data == nullptr || size < 1) {
+        throw std::invalid_argument("Utils::makeRawVBO: data is empty");
+    }
+    if (vbo_type != GL_ARRAY_BUFFER && vbo_type != GL_ELEMENT_ARRAY_BUFFER) {
+        throw std::invalid_argument("Utils::makeRawVBO: third parameter, vbo_type is neither GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER");
+    }
+    if (usage != GL_STATIC_DRAW && usage != GL_DYNAMIC_DRAW) {
+        throw std::invalid_argument("Utils::makeRawVBO: fourth parameter, usage is neither GL_STATIC_DRAW or GL_DYNAMIC_DRAW");
+    }
+    /*****DEBUG*****/
+    // un VBO d'indices serait enregistré dans le VAO actif, il ne faut en modifier aucun
+    if (vbo_type == GL_ELEMENT_ARRAY_BUFFER) GLState::bindVertexArray(0);
+    // créer un VBO et le remplir avec les données
+    GLuint id;
+    glGenBuffers(1, &id);
+    glBindBuffer(vbo_type, id);
+    glBufferData(vbo_type, size, data, usage);
+    glBindBuffer(vbo_type, 0);
+
+    return id;
+}
+
+
 /**
  * supprime un buffer VBO dont on fournit l'identifiant
  * @param id : identifiant du VBO
@@ -566,7 +820,7 @@ void ScreenShotPPM(const char* filename, int width, int height)
     const char* pixels = new char[taille];
 
     // lire les pixels de l'écran
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
     glReadBuffer(GL_BACK);
     glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, (GLvoid*)pixels);
 
@@ -612,7 +866,7 @@ void ScreenShotPAM(const char* filename, int width, int height)
     const char* pixels = new char[taille];
 
     // lire les pixels de l'écran
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, 0);
     glReadBuffer(GL_BACK);
     glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)pixels);
 
@@ -650,5 +904,160 @@ void ScreenShotPAM(const char* filename, int width, int height)
     delete[] pixels;
 }
 
+
+/**
+ * retourne la taille et la date de dernière modification d'un fichier
+ * @param filename : nom complet du fichier
+ * @param size : reçoit la taille du fichier en octets
+ * @param mtime : reçoit la date de modification en secondes
+ * @return false si le fichier n'existe pas
+ */
+bool getFileStamp(std::string filename, long long& size, long long& mtime)
+{
+    struct stat infos;
+    if (stat(filename.c_str(), &infos) != 0) return false;
+    size = infos.st_size;
+    mtime = infos.st_mtime;
+    return true;
+}
+
+
+/**
+ * retourne le chemin absolu d'un fichier
+ * @param filename : nom du fichier, relatif au dossier courant ou non
+ * @return chemin absolu, ou filename s'il ne peut pas être déterminé
+ */
+std::string getAbsolutePath(std::string filename)
+{
+#ifndef _WIN32
+    char* path = realpath(filename.c_str(), nullptr);
+#else
+    char* path = _fullpath(nullptr, filename.c_str(), 0);
+#endif
+    if (path == nullptr) return filename;
+    std::string result = path;
+    free(path);
+    return result;
+}
+
+
+/**
+ * crée un dossier ainsi que ses parents s'ils n'existent pas
+ * @param folder : nom du dossier
+ * @return false si le dossier n'existe toujours pas
+ */
+bool makeFolders(std::string folder)
+{
+    // créer chaque dossier du chemin, les erreurs sont vues à la fin
+    for (size_t pos = folder.find_first_of("/\\", 1); ; pos = folder.find_first_of("/\\", pos+1)) {
+        std::string parent = folder.substr(0, pos);
+#ifdef _WIN32
+        _mkdir(parent.c_str());
+#else
+        mkdir(parent.c_str(), 0755);
+#endif
+        if (pos == std::string::npos) break;
+    }
+    struct stat infos;
+    return stat(folder.c_str(), &infos) == 0 && (infos.st_mode & S_IFDIR) != 0;
+}
+
+
+// dossier des maillages déjà construits, calculé au premier besoin s'il n'est pas défini
+static std::string MeshCacheFolder;
+static bool MeshCacheFolderDefined = false;
+
+
+/**
+ * définit le dossier où MeshObjectFromObj enregistre les maillages déjà construits
+ * @param folder : nom du dossier, créé s'il n'existe pas, "" pour ne pas employer de cache
+ */
+void setMeshCacheFolder(std::string folder)
+{
+    MeshCacheFolder = folder;
+    MeshCacheFolderDefined = true;
+}
+
+
+/**
+ * retourne le dossier des maillages déjà construits : par défaut dans le cache de l'utilisateur,
+ * car le dossier des données peut être partagé ou en lecture seule
+ * @return nom du dossier, "" s'il ne faut pas employer de cache
+ */
+std::string getMeshCacheFolder()
+{
+    if (! MeshCacheFolderDefined) {
+        MeshCacheFolderDefined = true;
+        MeshCacheFolder = getUserCacheFolder("meshes");
+    }
+    return MeshCacheFolder;
+}
+
+
+/**
+ * ouvre le fichier et rend son contenu accessible en lecture seule
+ * @param filename : nom complet du fichier
+ */
+MappedFile::MappedFile(std::string filename)
+{
+    m_IsOpen = false;
+    m_IsMapped = false;
+    m_Data = nullptr;
+    m_Size = 0;
+
+#ifndef _WIN32
+    // ouverture et taille du fichier
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat infos;
+    if (fstat(fd, &infos) < 0) {
+        close(fd);
+        return;
+    }
+    m_IsOpen = true;
+    m_Size = infos.st_size;
+
+    // projection du fichier en mémoire, sauf s'il est vide
+    if (m_Size > 0) {
+        void* address = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, m_Size, MADV_SEQUENTIAL);
+            m_Data = (const char*) address;
+            m_IsMapped = true;
+        } else {
+            m_IsOpen = false;
+            m_Size = 0;
+        }
+    }
+    close(fd);
+#else
+    // lecture complète du fichier dans un tableau
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (! file.is_open()) return;
+    m_IsOpen = true;
+    m_Size = file.tellg();
+    if (m_Size > 0) {
+        char* buffer = new char[m_Size];
+        file.seekg(0, std::ios::beg);
+        file.read(buffer, m_Size);
+        m_Data = buffer;
+    }
+    file.close();
+#endif
+}
+
+
+/**
+ * destructeur, libère la projection ou le tableau
+ */
+MappedFile::~MappedFile()
+{
+    if (m_Data == nullptr) return;
+#ifndef _WIN32
+    if (m_IsMapped) munmap((void*) m_Data, m_Size);
+#endif
+    if (! m_IsMapped) delete[] m_Data;
+}
+
 };
 
@@ -57,6 +57,7 @@ namespace Utils
      */
     GLfloat degrees(const GLfloat rad);
 
+    double getAbsoluteTime();
     extern double Time;
     extern bool TimeChange;
     extern double TimePause;
@@ -67,7 +68,8 @@ namespace Utils
 
     /**
      * cette fonction compile les deux sources, vertex et fragment shader
-     * et les relie en tant que programme de shaders complet
+     * et les relie en tant que programme de shaders complet, ou le recharge
+     * du dossier de cache s'il a déjà été compilé, voir setShaderCacheFolder
      * @param VSsource : source du vertex shader
      * @param FSsource : source du fragment shader
      * @param name : nom du shader pour les messages d'erreurs ou le log
@@ -82,6 +84,15 @@ namespace Utils
      */
     void deleteShaderProgram(GLint id);
 
+    /**
+     * définit le dossier où makeShaderProgram enregistre les programmes compilés pour
+     * les recharger aux lancements suivants sans recompiler leurs sources
+     * NB : par défaut, c'est le dossier "opengl-samples/shaders" du cache de l'utilisateur,
+     * voir setMeshCacheFolder
+     * @param folder : nom du dossier, créé s'il n'existe pas, "" pour ne pas employer de cache
+     */
+    void setShaderCacheFolder(std::string folder);
+
     /**
      * cette fonction crée un VBO contenant des GLfloat
      * @param values : std::vector de GLfloat à mettre dans le VBO
@@ -136,6 +147,17 @@ namespace Utils
      */
     GLuint makeIntVBO(std::vector<GLuint> values, int vbo_type, int usage);
 
+    /**
+     * cette fonction crée un VBO à partir d'un bloc de données brutes, par exemple
+     * projeté depuis un fichier : les données sont transmises sans copie intermédiaire
+     * @param data : adresse des données à mettre dans le VBO
+     * @param size : nombre d'octets des données
+     * @param vbo_type : type OpenGL du VBO, par exemple GL_ARRAY_BUFFER
+     * @param usage : type de stockage OpenGL des données, par exemple GL_STATIC_DRAW
+     * @return identifiant OpenGL du VBO
+     */
+    GLuint makeRawVBO(const void* data, size_t size, int vbo_type, int usage);
+
     /**
      * supprime un buffer VBO dont on fournit l'identifiant
      * @param id : identifiant du VBO
@@ -178,6 +200,108 @@ namespace Utils
      * @param height : hauteur de la vue OpenGL
      */
     void ScreenShotPAM(const char* filename, int width, int height);
+
+
+    /**
+     * retourne la taille et la date de dernière modification d'un fichier
+     * @param filename : nom complet du fichier
+     * @param size : reçoit la taille du fichier en octets
+     * @param mtime : reçoit la date de modification en secondes
+     * @return false si le fichier n'existe pas
+     */
+    bool getFileStamp(std::string filename, long long& size, long long& mtime);
+
+    /**
+     * retourne le chemin absolu d'un fichier, pour le désigner sans ambiguïté
+     * @param filename : nom du fichier, relatif au dossier courant ou non
+     * @return chemin absolu, ou filename s'il ne peut pas être déterminé
+     */
+    std::string getAbsolutePath(std::string filename);
+
+    /**
+     * crée un dossier ainsi que ses parents s'ils n'existent pas
+     * @param folder : nom du dossier
+     * @return false si le dossier n'existe toujours pas
+     */
+    bool makeFolders(std::string folder);
+
+    /**
+     * définit le dossier où MeshObjectFromObj enregistre les maillages déjà construits
+     * NB : par défaut, c'est le dossier "opengl-samples/meshes" du cache de l'utilisateur,
+     * $XDG_CACHE_HOME ou ~/.cache sous Linux, %LOCALAPPDATA% sous Windows
+     * @param folder : nom du dossier, créé s'il n'existe pas, "" pour ne pas employer de cache
+     */
+    void setMeshCacheFolder(std::string folder);
+
+    /**
+     * retourne le dossier des maillages déjà construits, voir setMeshCacheFolder
+     * @return nom du dossier, "" s'il ne faut pas employer de cache
+     */
+    std::string getMeshCacheFolder();
+
+
+    /**
+     * Cette classe donne accès en lecture seule au contenu complet d'un fichier.
+     * Sous Linux, le fichier est projeté en mémoire (mmap) : aucune copie n'est faite,
+     * sinon il est lu entièrement dans un tableau.
+     * NB : les données ne sont pas terminées par un '\0', employer getSize()
+     */
+    class MappedFile
+    {
+    public:
+
+        /**
+         * ouvre le fichier et rend son contenu accessible
+         * @param filename : nom complet du fichier
+         */
+        MappedFile(std::string filename);
+
+        /** destructeur, libère la projection ou le tableau */
+        ~MappedFile();
+
+        /**
+         * indique si le fichier a pu être ouvert
+         * @return true si le contenu est accessible
+         */
+        bool isOpen()
+        {
+            return m_IsOpen;
+        }
+
+        /**
+         * retourne l'adresse du premier octet du fichier
+         * @return début des données, nullptr si le fichier est vide ou absent
+         */
+        const char* getData()
+        {
+            return m_Data;
+        }
+
+        /**
+         * retourne la taille du fichier
+         * @return nombre d'octets
+         */
+        size_t getSize()
+        {
+            return m_Size;
+        }
+
+    private:
+
+        // pas de copie possible
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// vrai si le fichier a pu être ouvert
+        bool m_IsOpen;
+
+        /// vrai si m_Data est une projection mmap, sinon c'est un tableau alloué
+        bool m_IsMapped;
+
+        /// contenu et taille du fichier
+        const char* m_Data;
+        size_t m_Size;
+    };
 };
 
 